@@ -0,0 +1,103 @@
+#pragma once
+
+#include <core/CoreComponent.hpp>
+#include <core/thread/ThreadPool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+
+namespace benchmark {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Measures the wall clock time it takes to run a callable.
+///
+/// @return
+/// Elapsed time in seconds.
+template<typename CallableType>
+double										MeasureSeconds(
+	CallableType						&&	callable
+)
+{
+	auto begin = std::chrono::steady_clock::now();
+	callable();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>( end - begin ).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Runs a callable several times and returns the fastest run, used to filter out noise from other processes.
+///
+/// @return
+/// Fastest elapsed time in seconds.
+template<typename CallableType>
+double										MeasureBestSeconds(
+	size_t									repeat_count,
+	CallableType						&&	callable
+)
+{
+	auto best = MeasureSeconds( callable );
+	for( size_t i = 1; i < repeat_count; ++i )
+	{
+		best = std::min( best, MeasureSeconds( callable ) );
+	}
+	return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Prints a single benchmark result line.
+inline void									Report(
+	const char							*	benchmark_name,
+	const char							*	variant_name,
+	double									value,
+	const char							*	unit
+)
+{
+	std::printf( "%-40s %-32s %16.2f %s\n", benchmark_name, variant_name, value, unit );
+	std::fflush( stdout );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gets the list of worker thread counts to benchmark, doubling from 1 up to the number of hardware threads.
+inline std::vector<size_t>					GetWorkerThreadCounts()
+{
+	auto hardware_thread_count = std::max<size_t>( 1, std::thread::hardware_concurrency() );
+	auto result = std::vector<size_t> {};
+	for( size_t i = 1; i < hardware_thread_count; i *= 2 ) result.push_back( i );
+	result.push_back( hardware_thread_count );
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Creates a core component with logging disabled, benchmarks should not measure console output.
+inline std::unique_ptr<bc::CoreComponent>	CreateCore()
+{
+	auto core_create_info = bc::CoreComponentCreateInfo {};
+	core_create_info.logger_create_info.disabled = true;
+	return std::make_unique<bc::CoreComponent>( core_create_info );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class BenchmarkThread : public bc::thread::Thread
+{
+public:
+	BenchmarkThread() = default;
+	void ThreadBegin() override {}
+	void ThreadEnd() noexcept override {}
+};
+
+
+
+} // benchmark
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/containers/FlatMap.hpp>
+#include <core/containers/HashMap.hpp>
+#include <core/containers/List.hpp>
+#include <core/containers/Map.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr bc::u64 flat_map_key_count				= 1000000;
+constexpr bc::u64 flat_map_single_insert_count		= 20000;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Unique keys in random order.
+static std::vector<bc::u64> MakeShuffledKeys(
+	bc::u64									count
+)
+{
+	auto keys = std::vector<bc::u64> {};
+	keys.reserve( count );
+	for( bc::u64 i = 0; i < count; ++i ) keys.push_back( i * 0x9E3779B97F4A7C15ULL );
+	std::shuffle( keys.begin(), keys.end(), std::default_random_engine( 1234 ) );
+	return keys;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Looks up every key once in the order given.
+template<typename MapType>
+static double MeasureLookupSeconds(
+	const MapType						&	map,
+	const std::vector<bc::u64>			&	keys
+)
+{
+	bc::u64 found_sum = 0;
+	auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			for( auto key : keys )
+			{
+				auto it = map.Find( key );
+				found_sum += it != map.end() ? it->second : 0;
+			}
+		}
+	);
+	EXPECT_GT( found_sum, 0 );
+	return seconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapBenchmark, Build1M )
+{
+	using P = bc::Pair<bc::u64, bc::u64>;
+
+	auto keys = MakeShuffledKeys( flat_map_key_count );
+	auto sorted_pairs = bc::List<P> {};
+	sorted_pairs.Reserve( keys.size() );
+	for( auto key : keys ) sorted_pairs.PushBack( P( key, key + 1 ) );
+	std::sort( sorted_pairs.Data(), sorted_pairs.Data() + sorted_pairs.Size(), []( const P & a, const P & b ) { return a.first < b.first; } );
+
+	auto map_insert_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto map = bc::Map<bc::u64, bc::u64> {};
+			for( auto & pair : sorted_pairs ) map.Insert( pair );
+			EXPECT_EQ( map.Size(), flat_map_key_count );
+		}
+	);
+	auto map_from_sorted_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto map = bc::Map<bc::u64, bc::u64>::FromSorted( sorted_pairs );
+			EXPECT_EQ( map.Size(), flat_map_key_count );
+		}
+	);
+	auto flat_map_append_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto batch = bc::List<P> {};
+			batch.Reserve( keys.size() );
+			for( auto key : keys ) batch.PushBack( P( key, key + 1 ) );
+
+			auto map = bc::FlatMap<bc::u64, bc::u64> {};
+			map.Append( batch );
+			EXPECT_EQ( map.Size(), flat_map_key_count );
+		}
+	);
+
+	benchmark::Report( "sorted u64 pairs 1M build", "bc::Map Insert", map_insert_seconds * 1000.0, "ms" );
+	benchmark::Report( "sorted u64 pairs 1M build", "bc::Map::FromSorted", map_from_sorted_seconds * 1000.0, "ms" );
+	benchmark::Report( "shuffled u64 pairs 1M build", "bc::FlatMap Append", flat_map_append_seconds * 1000.0, "ms" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapBenchmark, BatchVersusSingleInsert )
+{
+	auto keys = MakeShuffledKeys( flat_map_single_insert_count );
+
+	auto single_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto map = bc::FlatMap<bc::u64, bc::u64> {};
+			for( auto key : keys ) map.Emplace( key + 0, key + 1 );
+			EXPECT_EQ( map.Size(), flat_map_single_insert_count );
+		}
+	);
+	auto batch_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto batch = bc::List<bc::Pair<bc::u64, bc::u64>> {};
+			batch.Reserve( keys.size() );
+			for( auto key : keys ) batch.PushBack( bc::Pair<bc::u64, bc::u64>( key, key + 1 ) );
+
+			auto map = bc::FlatMap<bc::u64, bc::u64> {};
+			map.Append( batch );
+			EXPECT_EQ( map.Size(), flat_map_single_insert_count );
+		}
+	);
+
+	benchmark::Report( "shuffled u64 pairs 20k build", "bc::FlatMap Emplace", single_seconds * 1000.0, "ms" );
+	benchmark::Report( "shuffled u64 pairs 20k build", "bc::FlatMap Append", batch_seconds * 1000.0, "ms" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapBenchmark, Lookup1M )
+{
+	using P = bc::Pair<bc::u64, bc::u64>;
+
+	auto keys = MakeShuffledKeys( flat_map_key_count );
+	auto pairs = bc::List<P> {};
+	pairs.Reserve( keys.size() );
+	for( auto key : keys ) pairs.PushBack( P( key, key + 1 ) );
+
+	auto flat_map = bc::FlatMap<bc::u64, bc::u64> {};
+	flat_map.Append( pairs );
+	auto map = bc::Map<bc::u64, bc::u64>::FromSorted( flat_map );
+	auto hash_map = bc::HashMap<bc::u64, bc::u64> {};
+	for( auto & pair : pairs ) hash_map.Insert( pair );
+
+	benchmark::Report( "u64 keys 1M find existing", "bc::Map", MeasureLookupSeconds( map, keys ) * 1000.0, "ms" );
+	benchmark::Report( "u64 keys 1M find existing", "bc::FlatMap", MeasureLookupSeconds( flat_map, keys ) * 1000.0, "ms" );
+	benchmark::Report( "u64 keys 1M find existing", "bc::HashMap", MeasureLookupSeconds( hash_map, keys ) * 1000.0, "ms" );
+}
+
+
+
+} // containers
+} // core
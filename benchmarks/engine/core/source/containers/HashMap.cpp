@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/containers/HashMap.hpp>
+#include <core/containers/Map.hpp>
+#include <core/containers/Text.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr bc::u64 hash_map_integer_key_count	= 1000000;
+constexpr bc::u64 hash_map_text_key_count		= 100000;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Unique keys in random order, the second half is never inserted and used for failed lookups.
+static std::vector<bc::u64> MakeIntegerKeys(
+	bc::u64									count
+)
+{
+	auto keys = std::vector<bc::u64> {};
+	keys.reserve( count * 2 );
+	for( bc::u64 i = 0; i < count * 2; ++i ) keys.push_back( i * 0x9E3779B97F4A7C15ULL );
+	std::shuffle( keys.begin(), keys.end(), std::default_random_engine( 1234 ) );
+	return keys;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Inserts the first half of the keys, then looks up every inserted key and every key that was not inserted.
+template<typename MapType, typename KeyType, typename InsertType, typename FindType>
+static void ReportLookupBenchmark(
+	const char							*	benchmark_name,
+	const char							*	variant_name,
+	const std::vector<KeyType>			&	keys,
+	InsertType							&&	insert,
+	FindType							&&	find
+)
+{
+	auto count = keys.size() / 2;
+
+	auto insert_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto map = MapType {};
+			for( bc::u64 i = 0; i < count; ++i ) insert( map, keys[ i ], i );
+			EXPECT_GT( map.size(), 0 );
+		}
+	);
+
+	auto map = MapType {};
+	for( bc::u64 i = 0; i < count; ++i ) insert( map, keys[ i ], i );
+
+	bc::u64 found_sum = 0;
+	auto find_hit_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			for( bc::u64 i = 0; i < count; ++i ) found_sum += find( map, keys[ i ] );
+		}
+	);
+
+	bc::u64 missed_sum = 0;
+	auto find_miss_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			for( bc::u64 i = count; i < count * 2; ++i ) missed_sum += find( map, keys[ i ] );
+		}
+	);
+	EXPECT_GT( found_sum, 0 );
+	EXPECT_EQ( missed_sum, 0 );
+
+	auto insert_name = std::string( benchmark_name ) + " insert";
+	auto find_hit_name = std::string( benchmark_name ) + " find existing";
+	auto find_miss_name = std::string( benchmark_name ) + " find missing";
+	benchmark::Report( insert_name.c_str(), variant_name, insert_seconds * 1000.0, "ms" );
+	benchmark::Report( find_hit_name.c_str(), variant_name, find_hit_seconds * 1000.0, "ms" );
+	benchmark::Report( find_miss_name.c_str(), variant_name, find_miss_seconds * 1000.0, "ms" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Adapts bc containers to the size() call used by ReportLookupBenchmark.
+template<typename ContainerType>
+struct SizeAdapter : public ContainerType
+{
+	bc::u64 size() const { return this->Size(); }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapBenchmark, IntegerKeys1M )
+{
+	auto keys = MakeIntegerKeys( hash_map_integer_key_count );
+
+	ReportLookupBenchmark<SizeAdapter<bc::Map<bc::u64, bc::u64>>>( "u64 keys 1M", "bc::Map", keys,
+		[]( auto & map, bc::u64 key, bc::u64 value ) { map.Emplace( key + 0, value + 1 ); },
+		[]( auto & map, bc::u64 key ) -> bc::u64 { auto it = map.Find( key ); return it != map.end() ? it->second : 0; }
+	);
+	ReportLookupBenchmark<std::unordered_map<bc::u64, bc::u64>>( "u64 keys 1M", "std::unordered_map", keys,
+		[]( auto & map, bc::u64 key, bc::u64 value ) { map.emplace( key, value + 1 ); },
+		[]( auto & map, bc::u64 key ) -> bc::u64 { auto it = map.find( key ); return it != map.end() ? it->second : 0; }
+	);
+	ReportLookupBenchmark<SizeAdapter<bc::HashMap<bc::u64, bc::u64>>>( "u64 keys 1M", "bc::HashMap", keys,
+		[]( auto & map, bc::u64 key, bc::u64 value ) { map.Emplace( key + 0, value + 1 ); },
+		[]( auto & map, bc::u64 key ) -> bc::u64 { auto it = map.Find( key ); return it != map.end() ? it->second : 0; }
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapBenchmark, TextKeys100k )
+{
+	auto integer_keys = MakeIntegerKeys( hash_map_text_key_count );
+	auto keys = std::vector<bc::Text> {};
+	keys.reserve( integer_keys.size() );
+	for( auto integer_key : integer_keys )
+	{
+		auto number = "benchmark/resource/" + std::to_string( integer_key );
+		keys.push_back( bc::Text( bc::TextView( number.c_str(), number.size() ) ) );
+	}
+
+	ReportLookupBenchmark<SizeAdapter<bc::Map<bc::Text, bc::u64>>>( "Text keys 100k", "bc::Map", keys,
+		[]( auto & map, const bc::Text & key, bc::u64 value ) { map.Emplace( key, value + 1 ); },
+		[]( auto & map, const bc::Text & key ) -> bc::u64 { auto it = map.Find( key ); return it != map.end() ? it->second : 0; }
+	);
+	ReportLookupBenchmark<SizeAdapter<bc::HashMap<bc::Text, bc::u64>>>( "Text keys 100k", "bc::HashMap", keys,
+		[]( auto & map, const bc::Text & key, bc::u64 value ) { map.Emplace( key, value + 1 ); },
+		[]( auto & map, const bc::Text & key ) -> bc::u64 { auto it = map.Find( key ); return it != map.end() ? it->second : 0; }
+	);
+}
+
+
+
+} // containers
+} // core
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/containers/List.hpp>
+#include <core/containers/Text.hpp>
+#include <core/containers/UniquePtr.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+#include <core/thread/Task.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr bc::u64 grow_start_size			= 1024;
+constexpr bc::u64 grow_end_size				= bc::u64( 1 ) << 30;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Vertex
+{
+	float									position[ 3 ];
+	float									normal[ 3 ];
+	float									uv[ 2 ];
+};
+static_assert( sizeof( Vertex ) == 32 );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reallocation before remapping and bulk copies, a new block is allocated and the payload copied one byte at a time.
+static bc::u8 * ReallocateByteLoop(
+	bc::u8								*	old_location,
+	bc::u64									old_size,
+	bc::u64									new_size
+)
+{
+	auto new_location = bc::memory::AllocateMemory<bc::u8>( new_size, 1 );
+	auto volatile_new_location = reinterpret_cast<volatile bc::u8*>( new_location );
+	for( bc::u64 i = 0; i < old_size; ++i ) volatile_new_location[ i ] = old_location[ i ];
+	bc::memory::FreeMemory( old_location, old_size );
+	return new_location;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reallocation when remapping is not possible, a new block is allocated and the payload copied with memcpy.
+static bc::u8 * ReallocateMemcpy(
+	bc::u8								*	old_location,
+	bc::u64									old_size,
+	bc::u64									new_size
+)
+{
+	auto new_location = bc::memory::AllocateMemory<bc::u8>( new_size, 1 );
+	std::memcpy( new_location, old_location, old_size );
+	bc::memory::FreeMemory( old_location, old_size );
+	return new_location;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Doubles a block from 1 KiB to 1 GiB, the new half is written every time like a growing list would.
+template<typename ReallocateType>
+static double MeasureGrowBlock(
+	ReallocateType						&&	reallocate
+)
+{
+	return benchmark::MeasureBestSeconds( 2, [ & ]()
+		{
+			auto size = grow_start_size;
+			auto data = bc::memory::AllocateMemory<bc::u8>( size, 1 );
+			std::memset( data, 1, size );
+			while( size < grow_end_size )
+			{
+				data = reallocate( data, size, size * 2 );
+				std::memset( data + size, 1, size );
+				size *= 2;
+			}
+			EXPECT_EQ( data[ grow_end_size - 1 ], 1 );
+			bc::memory::FreeMemory( data, size );
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ListBenchmark, GrowBlock1KiBTo1GiB )
+{
+	benchmark::Report( "Grow block 1 KiB -> 1 GiB", "byte loop copy", MeasureGrowBlock( ReallocateByteLoop ), "seconds" );
+	benchmark::Report( "Grow block 1 KiB -> 1 GiB", "memcpy", MeasureGrowBlock( ReallocateMemcpy ), "seconds" );
+	benchmark::Report( "Grow block 1 KiB -> 1 GiB", "ReallocateMemory", MeasureGrowBlock(
+		[]( bc::u8 * old_location, bc::u64 old_size, bc::u64 new_size ) { return bc::memory::ReallocateMemory( old_location, old_size, new_size ); }
+	), "seconds" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ListBenchmark, GrowVertexList1KiBTo1GiB )
+{
+	constexpr bc::u64 start_count = grow_start_size / sizeof( Vertex );
+	constexpr bc::u64 end_count = grow_end_size / sizeof( Vertex );
+
+	auto list_seconds = benchmark::MeasureBestSeconds( 2, [ & ]()
+		{
+			auto list = bc::List<Vertex> {};
+			list.Resize( start_count );
+			for( auto count = start_count; count < end_count; count *= 2 ) list.Resize( count * 2 );
+			EXPECT_EQ( list.Size(), end_count );
+		}
+	);
+	benchmark::Report( "Grow List<Vertex> 1 KiB -> 1 GiB", "bc::List", list_seconds, "seconds" );
+
+	auto vector_seconds = benchmark::MeasureBestSeconds( 2, [ & ]()
+		{
+			auto vector = std::vector<Vertex> {};
+			vector.resize( start_count );
+			for( auto count = start_count; count < end_count; count *= 2 ) vector.resize( count * 2 );
+			EXPECT_EQ( vector.size(), end_count );
+		}
+	);
+	benchmark::Report( "Grow List<Vertex> 1 KiB -> 1 GiB", "std::vector", vector_seconds, "seconds" );
+
+	auto push_back_seconds = benchmark::MeasureBestSeconds( 2, [ & ]()
+		{
+			auto list = bc::List<Vertex> {};
+			for( bc::u64 i = 0; i < end_count; ++i ) list.PushBack( Vertex { { float( i ) }, {}, {} } );
+			EXPECT_EQ( list.Size(), end_count );
+		}
+	);
+	benchmark::Report( "Grow List<Vertex> 1 KiB -> 1 GiB", "bc::List PushBack", push_back_seconds, "seconds" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr bc::u64 relocate_grow_count		= 1000000;
+constexpr bc::u64 relocate_shift_count		= 20000;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class RelocateBenchmarkTask : public bc::thread::Task
+{
+public:
+	RelocateBenchmarkTask( bc::u64 value ) : value( value ) {}
+	bc::thread::TaskExecutionResult operator()( bc::thread::Thread & thread ) override { return bc::thread::TaskExecutionResult::FINISHED; }
+	bc::u64 value;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Same value without the trivially relocatable trait, the list moves and destructs it one value at a time.
+template<typename ValueType>
+struct ElementWiseRelocated
+{
+	ElementWiseRelocated() = default;
+	ElementWiseRelocated( ValueType && value ) : value( std::move( value ) ) {}
+	ElementWiseRelocated( ElementWiseRelocated && other ) noexcept : value( std::move( other.value ) ) {}
+	ElementWiseRelocated & operator=( ElementWiseRelocated && other ) noexcept { value = std::move( other.value ); return *this; }
+	ValueType value;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Grows a list one value at a time, then fills it from the front and empties it from the front.
+template<typename WrapperType, typename MakeValueType>
+static void ReportRelocateBenchmark(
+	const char							*	benchmark_name,
+	const char							*	variant_name,
+	MakeValueType						&&	make_value
+)
+{
+	auto grow_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto list = bc::List<WrapperType> {};
+			for( bc::u64 i = 0; i < relocate_grow_count; ++i ) list.PushBack( WrapperType( make_value( i ) ) );
+			EXPECT_EQ( list.Size(), relocate_grow_count );
+		}
+	);
+
+	auto values = bc::List<WrapperType> {};
+	for( bc::u64 i = 0; i < relocate_shift_count; ++i ) values.PushBack( WrapperType( make_value( i ) ) );
+
+	auto insert_front_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto list = bc::List<WrapperType> {};
+			for( bc::u64 i = 0; i < relocate_shift_count; ++i ) list.PushFront( std::move( values[ i ] ) );
+			for( bc::u64 i = 0; i < relocate_shift_count; ++i ) values[ i ] = std::move( list[ relocate_shift_count - 1 - i ] );
+		}
+	);
+
+	auto erase_front_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			auto list = bc::List<WrapperType> {};
+			for( bc::u64 i = 0; i < relocate_shift_count; ++i ) list.PushBack( std::move( values[ i ] ) );
+			for( bc::u64 i = 0; i < relocate_shift_count; ++i )
+			{
+				values[ i ] = std::move( list.Front() );
+				list.Erase( list.begin() );
+			}
+		}
+	);
+
+	auto grow_name = std::string( benchmark_name ) + " PushBack 1M";
+	auto insert_name = std::string( benchmark_name ) + " PushFront 20k";
+	auto erase_name = std::string( benchmark_name ) + " Erase front 20k";
+	benchmark::Report( grow_name.c_str(), variant_name, grow_seconds * 1000.0, "ms" );
+	benchmark::Report( insert_name.c_str(), variant_name, insert_front_seconds * 1000.0, "ms" );
+	benchmark::Report( erase_name.c_str(), variant_name, erase_front_seconds * 1000.0, "ms" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ListBenchmark, TriviallyRelocatableUniquePtr )
+{
+	using ValueType = bc::UniquePtr<RelocateBenchmarkTask>;
+	auto make_value = []( bc::u64 i ) { return bc::MakeUniquePtr<RelocateBenchmarkTask>( i ); };
+
+	ReportRelocateBenchmark<ElementWiseRelocated<ValueType>>( "List<UniquePtr<Task>>", "element-wise move", make_value );
+	ReportRelocateBenchmark<ValueType>( "List<UniquePtr<Task>>", "trivially relocatable", make_value );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ListBenchmark, TriviallyRelocatableText )
+{
+	using ValueType = bc::Text;
+	auto make_value = []( bc::u64 i ) { return bc::Text( "Benchmark text value long enough to be on the heap" ); };
+
+	ReportRelocateBenchmark<ElementWiseRelocated<ValueType>>( "List<Text>", "element-wise move", make_value );
+	ReportRelocateBenchmark<ValueType>( "List<Text>", "trivially relocatable", make_value );
+}
+
+
+
+} // containers
+} // core
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/containers/List.hpp>
+#include <core/containers/MpmcQueue.hpp>
+#include <core/containers/SpscQueue.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bounded ring guarded by a mutex, what the lock-free queues replace.
+class MutexQueue
+{
+public:
+	MutexQueue( bc::u64 capacity ) : values( capacity ) {}
+
+	bool TryPush( bc::u64 value )
+	{
+		auto lock_guard = std::lock_guard( mutex );
+		if( tail - head == values.Size() ) return false;
+		values[ tail++ % values.Size() ] = value;
+		return true;
+	}
+
+	bool TryPop( bc::u64 & out_value )
+	{
+		auto lock_guard = std::lock_guard( mutex );
+		if( tail == head ) return false;
+		out_value = values[ head++ % values.Size() ];
+		return true;
+	}
+
+private:
+	std::mutex								mutex;
+	bc::List<bc::u64>						values;
+	bc::u64									head				= 0;
+	bc::u64									tail				= 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Producer threads push value_count values each while the same number of consumer threads pop them. Returns values per
+// second through the queue.
+template<typename PushFunctionType, typename PopFunctionType>
+static double MeasureQueueThroughput(
+	size_t									producer_count,
+	size_t									consumer_count,
+	PushFunctionType					&&	push,
+	PopFunctionType						&&	pop
+)
+{
+	constexpr bc::u64 value_count = 1'000'000;
+
+	auto total_value_count = value_count * producer_count;
+	auto popped_count = std::atomic<bc::u64> { 0 };
+	auto checksum_sink = std::atomic<bc::u64> { 0 };
+	auto seconds = benchmark::MeasureSeconds( [ & ]()
+		{
+			auto threads = std::vector<std::thread> {};
+			for( size_t p = 0; p < producer_count; ++p )
+			{
+				threads.emplace_back( [ & ]()
+					{
+						for( bc::u64 i = 0; i < value_count; )
+						{
+							auto pushed_count = push( i, value_count - i );
+							if( pushed_count == 0 ) std::this_thread::yield();
+							i += pushed_count;
+						}
+					}
+				);
+			}
+			for( size_t c = 0; c < consumer_count; ++c )
+			{
+				threads.emplace_back( [ & ]()
+					{
+						bc::u64 checksum = 0;
+						while( popped_count.load( std::memory_order_relaxed ) < total_value_count )
+						{
+							auto count = pop( checksum );
+							if( count == 0 ) std::this_thread::yield();
+							popped_count.fetch_add( count, std::memory_order_relaxed );
+						}
+						checksum_sink += checksum;
+					}
+				);
+			}
+			for( auto & thread : threads ) thread.join();
+		}
+	);
+	return total_value_count / seconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( QueueBenchmark, SingleProducerSingleConsumer )
+{
+	constexpr bc::u64 capacity = 1024;
+	constexpr bc::u64 batch_size = 32;
+
+	auto mutex_queue = MutexQueue( capacity );
+	auto mutex_rate = MeasureQueueThroughput( 1, 1,
+		[ & ]( bc::u64 i, bc::u64 ) -> bc::u64 { return mutex_queue.TryPush( i ); },
+		[ & ]( bc::u64 & checksum ) -> bc::u64 { bc::u64 v; if( !mutex_queue.TryPop( v ) ) return 0; checksum += v; return 1; }
+	);
+	benchmark::Report( "Queue SPSC", "mutex", mutex_rate, "values/s" );
+
+	auto spsc_queue = bc::SpscQueue<bc::u64>( capacity );
+	auto spsc_rate = MeasureQueueThroughput( 1, 1,
+		[ & ]( bc::u64 i, bc::u64 ) -> bc::u64 { return spsc_queue.TryPush( i ); },
+		[ & ]( bc::u64 & checksum ) -> bc::u64 { bc::u64 v; if( !spsc_queue.TryPop( v ) ) return 0; checksum += v; return 1; }
+	);
+	benchmark::Report( "Queue SPSC", "SpscQueue", spsc_rate, "values/s" );
+
+	auto spsc_batch_rate = MeasureQueueThroughput( 1, 1,
+		[ & ]( bc::u64 i, bc::u64 remaining ) -> bc::u64
+		{
+			bc::u64 batch[ batch_size ];
+			auto count = std::min( batch_size, remaining );
+			for( bc::u64 b = 0; b < count; ++b ) batch[ b ] = i + b;
+			return spsc_queue.TryPushBatch( batch, count );
+		},
+		[ & ]( bc::u64 & checksum ) -> bc::u64
+		{
+			bc::u64 batch[ batch_size ];
+			auto count = spsc_queue.TryPopBatch( batch, batch_size );
+			for( bc::u64 b = 0; b < count; ++b ) checksum += batch[ b ];
+			return count;
+		}
+	);
+	benchmark::Report( "Queue SPSC", "SpscQueue batch 32", spsc_batch_rate, "values/s" );
+
+	EXPECT_GT( spsc_rate, 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( QueueBenchmark, MultipleProducerMultipleConsumer )
+{
+	constexpr bc::u64 capacity = 1024;
+	constexpr bc::u64 batch_size = 32;
+
+	for( auto thread_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto variant = std::to_string( thread_count ) + "P " + std::to_string( thread_count ) + "C ";
+
+		auto mutex_queue = MutexQueue( capacity );
+		auto mutex_rate = MeasureQueueThroughput( thread_count, thread_count,
+			[ & ]( bc::u64 i, bc::u64 ) -> bc::u64 { return mutex_queue.TryPush( i ); },
+			[ & ]( bc::u64 & checksum ) -> bc::u64 { bc::u64 v; if( !mutex_queue.TryPop( v ) ) return 0; checksum += v; return 1; }
+		);
+		benchmark::Report( "Queue MPMC", ( variant + "mutex" ).c_str(), mutex_rate, "values/s" );
+
+		auto mpmc_queue = bc::MpmcQueue<bc::u64>( capacity );
+		auto mpmc_rate = MeasureQueueThroughput( thread_count, thread_count,
+			[ & ]( bc::u64 i, bc::u64 ) -> bc::u64 { return mpmc_queue.TryPush( i ); },
+			[ & ]( bc::u64 & checksum ) -> bc::u64 { bc::u64 v; if( !mpmc_queue.TryPop( v ) ) return 0; checksum += v; return 1; }
+		);
+		benchmark::Report( "Queue MPMC", ( variant + "MpmcQueue" ).c_str(), mpmc_rate, "values/s" );
+
+		auto mpmc_batch_rate = MeasureQueueThroughput( thread_count, thread_count,
+			[ & ]( bc::u64 i, bc::u64 remaining ) -> bc::u64
+			{
+				bc::u64 batch[ batch_size ];
+				auto count = std::min( batch_size, remaining );
+				for( bc::u64 b = 0; b < count; ++b ) batch[ b ] = i + b;
+				return mpmc_queue.TryPushBatch( batch, count );
+			},
+			[ & ]( bc::u64 & checksum ) -> bc::u64
+			{
+				bc::u64 batch[ batch_size ];
+				auto count = mpmc_queue.TryPopBatch( batch, batch_size );
+				for( bc::u64 b = 0; b < count; ++b ) checksum += batch[ b ];
+				return count;
+			}
+		);
+		benchmark::Report( "Queue MPMC", ( variant + "MpmcQueue batch 32" ).c_str(), mpmc_batch_rate, "values/s" );
+
+		EXPECT_GT( mpmc_rate, 0.0 );
+	}
+}
+
+
+
+} // containers
+} // core
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/conversion/text/utf/UTFConversion.hpp>
+#include <core/file/AsyncFileReader.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+
+namespace core {
+namespace file {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Files read by the benchmark, created once in a temporary directory. They are read once before measuring so that every
+// variant reads from the page cache, the benchmark measures the cost of issuing reads rather than the disk.
+class BenchmarkFiles
+{
+public:
+	BenchmarkFiles( const char * name, size_t file_count, size_t file_size )
+	{
+		directory = std::filesystem::temp_directory_path() / name;
+		std::filesystem::create_directories( directory );
+		auto contents = std::vector<char>( file_size, 'x' );
+		for( size_t i = 0; i < file_count; ++i )
+		{
+			auto path = directory / ( std::to_string( i ) + ".bin" );
+			std::ofstream( path, std::ios::binary ).write( contents.data(), std::streamsize( file_size ) );
+			std_paths.push_back( path.string() );
+			auto & std_path = std_paths.back();
+			paths.PushBack( bc::conversion::ToUTF32( bc::TextView( std_path.data(), std_path.size() ) ) );
+		}
+		total_size = file_count * file_size;
+	}
+
+	~BenchmarkFiles()
+	{
+		std::filesystem::remove_all( directory );
+	}
+
+	std::filesystem::path				directory;
+	std::vector<std::string>			std_paths;
+	bc::List<bc::Text32>				paths;
+	size_t								total_size			= 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reads every file on the calling thread with blocking reads into its own buffer, what loading looks like without a file
+// service. Buffers are kept until every file has been read, as the async reads keep theirs.
+static size_t ReadFilesBlocking(
+	const BenchmarkFiles			&	files
+)
+{
+	size_t total_read = 0;
+	auto buffers = std::vector<std::unique_ptr<char[]>>();
+	buffers.reserve( files.std_paths.size() );
+	for( auto & path : files.std_paths )
+	{
+		auto file = std::ifstream( path, std::ios::binary | std::ios::ate );
+		auto size = size_t( file.tellg() );
+		buffers.push_back( std::unique_ptr<char[]>( new char[ size ] ) );
+		file.seekg( 0 );
+		file.read( buffers.back().get(), std::streamsize( size ) );
+		total_read += size_t( file.gcount() );
+	}
+	return total_read;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reads every file with one batch of async reads. Reads go to the given destinations if there are any, otherwise to pooled
+// buffers.
+static size_t ReadFilesAsync(
+	bc::file::AsyncFileReader		&	reader,
+	const BenchmarkFiles			&	files,
+	std::vector<char>				*	destinations
+)
+{
+	auto requests = bc::List<bc::file::FileReadRequest> {};
+	requests.Reserve( files.paths.Size() );
+	for( size_t i = 0; i < files.paths.Size(); ++i )
+	{
+		auto request = bc::file::FileReadRequest { files.paths[ i ] };
+		if( destinations )
+		{
+			request.size		= destinations[ i ].size();
+			request.destination	= destinations[ i ].data();
+		}
+		requests.PushBack( request );
+	}
+
+	size_t total_read = 0;
+	auto handles = reader.ReadFilesAsync( requests );
+	for( auto & handle : handles )
+	{
+		handle.Wait();
+		total_read += handle.GetSize();
+	}
+	return total_read;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void BenchmarkReadFiles(
+	const char						*	benchmark_name,
+	const BenchmarkFiles			&	files,
+	size_t								repeat_count
+)
+{
+	auto core = benchmark::CreateCore();
+	auto thread_pool = core->GetThreadPool();
+	for( size_t i = 0; i < std::thread::hardware_concurrency(); ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+	ReadFilesBlocking( files );
+	size_t total_read = 0;
+	auto blocking_seconds = benchmark::MeasureBestSeconds( repeat_count, [ & ]() { total_read = ReadFilesBlocking( files ); } );
+	EXPECT_EQ( total_read, files.total_size );
+	benchmark::Report( benchmark_name, "blocking std::ifstream", files.paths.Size() / blocking_seconds, "files/s" );
+
+	auto destinations = std::vector<std::vector<char>>( files.paths.Size(), std::vector<char>( files.total_size / files.paths.Size() ) );
+	for( auto use_io_uring : { true, false } )
+	{
+		auto create_info = bc::file::AsyncFileReaderCreateInfo {};
+		create_info.use_io_uring = use_io_uring;
+		auto reader = bc::file::AsyncFileReader( *thread_pool, create_info );
+		if( use_io_uring && !reader.IsUsingIoUring() ) continue;
+
+		auto pooled_seconds = benchmark::MeasureBestSeconds( repeat_count, [ & ]() { total_read = ReadFilesAsync( reader, files, nullptr ); } );
+		EXPECT_EQ( total_read, files.total_size );
+		benchmark::Report( benchmark_name, use_io_uring ? "io_uring pooled buffers" : "thread pool pooled buffers", files.paths.Size() / pooled_seconds, "files/s" );
+
+		auto destination_seconds = benchmark::MeasureBestSeconds( repeat_count, [ & ]() { total_read = ReadFilesAsync( reader, files, destinations.data() ); } );
+		EXPECT_EQ( total_read, files.total_size );
+		benchmark::Report( benchmark_name, use_io_uring ? "io_uring caller buffers" : "thread pool caller buffers", files.paths.Size() / destination_seconds, "files/s" );
+	}
+	thread_pool->WaitIdle();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReaderBenchmark, ManySmallFiles )
+{
+	auto files = BenchmarkFiles( "bitcrafte_benchmark_small_files", 4000, 4096 );
+	BenchmarkReadFiles( "AsyncFileReader 4000 x 4 KiB", files, 5 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReaderBenchmark, FewHugeFiles )
+{
+	auto files = BenchmarkFiles( "bitcrafte_benchmark_huge_files", 4, size_t( 64 ) << 20 );
+	BenchmarkReadFiles( "AsyncFileReader 4 x 64 MiB", files, 3 );
+}
+
+
+
+} // file
+} // core
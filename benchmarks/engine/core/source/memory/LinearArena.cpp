@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/memory/allocator/LinearArena.hpp>
+#include <core/memory/allocator/StackAllocator.hpp>
+#include <core/containers/List.hpp>
+#include <core/containers/Map.hpp>
+#include <core/containers/Text.hpp>
+
+#include <atomic>
+
+
+
+namespace core {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr bc::u64 frame_count				= 2000;
+constexpr bc::u64 scratch_lists_per_frame	= 64;
+constexpr bc::u64 list_size					= 256;
+constexpr bc::u64 texts_per_frame			= 256;
+constexpr bc::u64 map_size					= 512;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Simulates per-frame scratch work: a batch of short lived lists, texts and a lookup map which are all discarded at the end of
+// the frame. allocator_for_frame() is called at the start of every frame and end_frame() at the end of it.
+template<typename ListType, typename TextType, typename MapType, typename MakeAllocatorType, typename EndFrameType>
+static double MeasureScratchFrames(
+	MakeAllocatorType					&&	allocator_for_frame,
+	EndFrameType						&&	end_frame
+)
+{
+	auto sink = std::atomic<bc::u64> { 0 };
+	auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			bc::u64 checksum = 0;
+			for( bc::u64 frame = 0; frame < frame_count; ++frame )
+			{
+				{
+					auto allocator = allocator_for_frame();
+					for( bc::u64 l = 0; l < scratch_lists_per_frame; ++l )
+					{
+						auto list = ListType( allocator );
+						for( bc::u64 i = 0; i < list_size; ++i ) list.PushBack( bc::u32( i + frame ) );
+						checksum += list[ list_size / 2 ];
+					}
+
+					for( bc::u64 t = 0; t < texts_per_frame; ++t )
+					{
+						auto text = TextType( allocator );
+						text += "entity_";
+						text += "name_with_some_length";
+						text += "_suffix";
+						checksum += text.Size();
+					}
+
+					auto map = MapType( allocator );
+					for( bc::u32 i = 0; i < map_size; ++i ) map.Insert( bc::Pair( i * 7919, i ) );
+					checksum += map.Size();
+				}
+				end_frame();
+			}
+			sink += checksum;
+		}
+	);
+	return double( frame_count ) / seconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArenaBenchmark, ScratchContainersPerFrame )
+{
+	auto heap_rate = MeasureScratchFrames<bc::List<bc::u32>, bc::Text, bc::Map<bc::u32, bc::u32>>(
+		[]() { return bc::memory::HeapAllocator {}; },
+		[]() {}
+	);
+	benchmark::Report( "Scratch List/Text/Map per frame", "heap", heap_rate, "frames/s" );
+
+	auto arena = bc::memory::LinearArena();
+	auto arena_rate = MeasureScratchFrames<bc::ArenaList<bc::u32>, bc::ArenaText, bc::ArenaMap<bc::u32, bc::u32>>(
+		[ & ]() { return bc::memory::LinearArenaAllocator { &arena }; },
+		[ & ]() { arena.Reset(); }
+	);
+	benchmark::Report( "Scratch List/Text/Map per frame", "LinearArena", arena_rate, "frames/s" );
+
+	auto stack = bc::memory::StackAllocator( 4 * 1024 * 1024 );
+	auto stack_rate = MeasureScratchFrames<bc::StackList<bc::u32>, bc::StackText, bc::StackMap<bc::u32, bc::u32>>(
+		[ & ]() { return bc::memory::StackArenaAllocator { &stack }; },
+		[ & ]() { stack.RewindToMarker( 0 ); }
+	);
+	benchmark::Report( "Scratch List/Text/Map per frame", "StackAllocator", stack_rate, "frames/s" );
+
+	EXPECT_EQ( arena.GetUsedSize(), 0 );
+	EXPECT_EQ( stack.GetUsedSize(), 0 );
+}
+
+
+
+} // memory
+} // core
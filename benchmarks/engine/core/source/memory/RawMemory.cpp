@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Runtime allocation path before the memory pool, every allocation went to new[] with the full allocation header in front.
+// Alignment of 64 matches the padding the full header always used and keeps the compact header out.
+static void * AllocateWithNewAndHeader(
+	bc::u64									size
+)
+{
+	auto system_size = bc::memory::internal_::CalculateMinimumRequiredSystemMemoryAllocationSize( size, 64 );
+	auto system_ptr = new bc::u8[ system_size ];
+	auto allocation_header = bc::memory::internal_::CreateMemoryAllocationHeader( system_ptr, system_size, size, 64 );
+	bc::memory::internal_::SetMemoryAllocationHeader( allocation_header );
+	return allocation_header.payload_location;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void FreeWithNewAndHeader(
+	void								*	location
+)
+{
+	auto allocation_header = bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( location );
+	delete[] reinterpret_cast<bc::u8*>( allocation_header->system_allocated_location );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Allocator
+{
+	const char							*	name;
+	void								*	( *allocate )( bc::u64 size );
+	void									( *free )( void * location );
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const Allocator allocators[] = {
+	{ "new[] + header",		&AllocateWithNewAndHeader,	&FreeWithNewAndHeader },
+	{ "malloc",				[]( bc::u64 size ) { return std::malloc( size ); },	[]( void * location ) { std::free( location ); } },
+	{ "bc::memory",			[]( bc::u64 size ) -> void * { return bc::memory::AllocateMemory<bc::u8>( size, 1 ); },
+							[]( void * location ) { bc::memory::FreeMemory( reinterpret_cast<bc::u8*>( location ), 1 ); } },
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static std::vector<bc::u64> MakeRandomSizes(
+	bc::u64									count,
+	bc::u64									max_size,
+	bc::u64									seed
+)
+{
+	auto random = std::mt19937_64( seed );
+	auto distribution = std::uniform_int_distribution<bc::u64>( 8, max_size );
+	auto sizes = std::vector<bc::u64>( count );
+	for( auto & size : sizes ) size = distribution( random );
+	return sizes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocates live_count blocks of random sizes, touches them and frees them in random order. Returns allocations per second.
+static double MeasureAllocateAndFree(
+	const Allocator						&	allocator,
+	bc::u64									live_count,
+	bc::u64									round_count,
+	bc::u64									max_size,
+	bc::u64									seed
+)
+{
+	auto sizes = MakeRandomSizes( live_count, max_size, seed );
+	auto free_order = std::vector<bc::u64>( live_count );
+	for( bc::u64 i = 0; i < live_count; ++i ) free_order[ i ] = i;
+	std::shuffle( free_order.begin(), free_order.end(), std::mt19937_64( seed + 1 ) );
+
+	auto blocks = std::vector<bc::u8*>( live_count );
+	auto seconds = benchmark::MeasureSeconds( [ & ]()
+		{
+			for( bc::u64 round = 0; round < round_count; ++round )
+			{
+				for( bc::u64 i = 0; i < live_count; ++i )
+				{
+					blocks[ i ] = reinterpret_cast<bc::u8*>( allocator.allocate( sizes[ i ] ) );
+					blocks[ i ][ 0 ] = bc::u8( i );
+				}
+				for( auto i : free_order ) allocator.free( blocks[ i ] );
+			}
+		}
+	);
+	return double( live_count * round_count ) / seconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemoryBenchmark, AllocateFreePairs )
+{
+	constexpr bc::u64 allocation_count = 2'000'000;
+
+	auto sizes = MakeRandomSizes( 4096, 512, 1 );
+	for( auto & allocator : allocators )
+	{
+		auto sink = std::atomic<bc::u64> { 0 };
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				bc::u64 checksum = 0;
+				for( bc::u64 i = 0; i < allocation_count; ++i )
+				{
+					auto block = reinterpret_cast<bc::u8*>( allocator.allocate( sizes[ i % sizes.size() ] ) );
+					block[ 0 ] = bc::u8( i );
+					checksum += block[ 0 ];
+					allocator.free( block );
+				}
+				sink += checksum;
+			}
+		);
+		benchmark::Report( "RawMemory allocate/free pairs", allocator.name, allocation_count / seconds, "allocations/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemoryBenchmark, ManyLiveAllocations )
+{
+	for( auto & allocator : allocators )
+	{
+		auto small_rate = MeasureAllocateAndFree( allocator, 100'000, 10, 256, 2 );
+		benchmark::Report( "RawMemory 100k live 8-256 B", allocator.name, small_rate, "allocations/s" );
+
+		auto medium_rate = MeasureAllocateAndFree( allocator, 20'000, 10, 16 * 1024, 3 );
+		benchmark::Report( "RawMemory 20k live 8 B-16 KiB", allocator.name, medium_rate, "allocations/s" );
+
+		auto large_rate = MeasureAllocateAndFree( allocator, 200, 10, 4 * 1024 * 1024, 4 );
+		benchmark::Report( "RawMemory 200 live 8 B-4 MiB", allocator.name, large_rate, "allocations/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Many tiny allocations, like short Lists, walked in allocation order. Header size decides how many payloads share a cache line.
+TEST( RawMemoryBenchmark, SmallAllocationFootprint )
+{
+	constexpr bc::u64 allocation_count = 200'000;
+	constexpr bc::u64 element_count = 3;
+
+	auto allocations = std::vector<bc::u32*>( allocation_count );
+	for( auto & allocation : allocations )
+	{
+		allocation = bc::memory::AllocateMemory<bc::u32>( element_count, alignof( bc::u32 ) );
+		for( bc::u64 i = 0; i < element_count; ++i ) allocation[ i ] = bc::u32( i );
+	}
+
+	auto header = bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( allocations[ 0 ] );
+	benchmark::Report( "RawMemory 3 x u32 allocation", "bytes reserved", double( header->system_allocation_size ), "bytes" );
+
+	auto sink = std::atomic<bc::u64> { 0 };
+	auto seconds = benchmark::MeasureBestSeconds( 5, [ & ]()
+		{
+			bc::u64 sum = 0;
+			for( auto allocation : allocations )
+			{
+				for( bc::u64 i = 0; i < element_count; ++i ) sum += allocation[ i ];
+			}
+			sink += sum;
+		}
+	);
+	benchmark::Report( "RawMemory 3 x u32 allocation", "walk", allocation_count / seconds, "allocations/s" );
+
+	for( auto allocation : allocations ) bc::memory::FreeMemory( allocation, element_count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemoryBenchmark, Multithreaded )
+{
+	for( auto thread_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto variant_prefix = std::to_string( thread_count ) + " threads ";
+		for( auto & allocator : allocators )
+		{
+			auto seconds = benchmark::MeasureSeconds( [ & ]()
+				{
+					auto threads = std::vector<std::thread> {};
+					for( size_t t = 0; t < thread_count; ++t )
+					{
+						threads.emplace_back( [ &, t ]() { MeasureAllocateAndFree( allocator, 20'000, 10, 1024, 10 + t ); } );
+					}
+					for( auto & thread : threads ) thread.join();
+				}
+			);
+			benchmark::Report( "RawMemory 20k live 8 B-1 KiB per thread", ( variant_prefix + allocator.name ).c_str(), 200'000 * thread_count / seconds, "allocations/s" );
+		}
+	}
+}
+
+
+
+} // memory
+} // core
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/thread/GuardedValue.hpp>
+#include <core/thread/SharedGuardedValue.hpp>
+#include <core/thread/SeqLockGuardedValue.hpp>
+#include <core/thread/RcuGuardedValue.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Settings snapshot polled by every reader, small enough for the sequence lock.
+struct GuardedSettings
+{
+	bc::u64 values[ 8 ] = {};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reader threads read the value as fast as they can while one writer updates it every 100 microseconds. Returns reads per
+// second summed over all reader threads.
+template<typename ReadFunctionType, typename WriteFunctionType>
+static double MeasureReadThroughput(
+	size_t									reader_count,
+	ReadFunctionType					&&	read,
+	WriteFunctionType					&&	write
+)
+{
+	constexpr auto measure_duration = std::chrono::milliseconds( 200 );
+
+	auto start = std::atomic_bool { false };
+	auto stop = std::atomic_bool { false };
+	auto total_read_count = std::atomic<size_t> { 0 };
+	auto checksum_sink = std::atomic<bc::u64> { 0 };
+	auto readers = std::vector<std::thread> {};
+	for( size_t i = 0; i < reader_count; ++i )
+	{
+		readers.emplace_back( [ & ]()
+			{
+				while( !start ) std::this_thread::yield();
+				size_t read_count = 0;
+				bc::u64 checksum = 0;
+				while( !stop )
+				{
+					checksum += read();
+					++read_count;
+				}
+				// Checksum is only kept so that reads cannot be optimized away.
+				total_read_count += read_count;
+				checksum_sink += checksum;
+			}
+		);
+	}
+
+	auto writer = std::thread( [ & ]()
+		{
+			while( !start ) std::this_thread::yield();
+			bc::u64 i = 0;
+			while( !stop )
+			{
+				write( ++i );
+				std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+			}
+		}
+	);
+
+	auto seconds = benchmark::MeasureSeconds( [ & ]()
+		{
+			start = true;
+			std::this_thread::sleep_for( measure_duration );
+			stop = true;
+			for( auto & reader : readers ) reader.join();
+		}
+	);
+	writer.join();
+	return total_read_count / seconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( GuardedValueBenchmark, ReadThroughput )
+{
+	auto Sum = []( const GuardedSettings & settings )
+		{
+			bc::u64 sum = 0;
+			for( auto value : settings.values ) sum += value;
+			return sum;
+		};
+	auto Fill = []( GuardedSettings & settings, bc::u64 value )
+		{
+			for( auto & v : settings.values ) v = value;
+		};
+
+	for( auto reader_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto variant = std::to_string( reader_count ) + " readers";
+
+		auto mutex_value = bc::thread::GuardedValue<GuardedSettings>();
+		auto mutex_reads = MeasureReadThroughput( reader_count,
+			[ & ]() { bc::u64 sum = 0; mutex_value( [ & ]( GuardedSettings & settings ) { sum = Sum( settings ); } ); return sum; },
+			[ & ]( bc::u64 i ) { mutex_value( [ & ]( GuardedSettings & settings ) { Fill( settings, i ); } ); }
+		);
+		benchmark::Report( "GuardedValue mutex", variant.c_str(), mutex_reads, "reads/s" );
+
+		auto shared_value = bc::thread::SharedGuardedValue<GuardedSettings>();
+		auto shared_reads = MeasureReadThroughput( reader_count,
+			[ & ]() { return shared_value.Read( Sum ); },
+			[ & ]( bc::u64 i ) { shared_value( [ & ]( GuardedSettings & settings ) { Fill( settings, i ); } ); }
+		);
+		benchmark::Report( "GuardedValue shared_mutex", variant.c_str(), shared_reads, "reads/s" );
+
+		auto seqlock_value = bc::thread::SeqLockGuardedValue<GuardedSettings>();
+		auto seqlock_reads = MeasureReadThroughput( reader_count,
+			[ & ]() { return seqlock_value.Read( Sum ); },
+			[ & ]( bc::u64 i ) { seqlock_value( [ & ]( GuardedSettings & settings ) { Fill( settings, i ); } ); }
+		);
+		benchmark::Report( "GuardedValue seqlock", variant.c_str(), seqlock_reads, "reads/s" );
+
+		auto rcu_value = bc::thread::RcuGuardedValue<GuardedSettings>();
+		auto rcu_reads = MeasureReadThroughput( reader_count,
+			[ & ]() { return rcu_value.Read( Sum ); },
+			[ & ]( bc::u64 i ) { rcu_value( [ & ]( GuardedSettings & settings ) { Fill( settings, i ); } ); }
+		);
+		benchmark::Report( "GuardedValue rcu", variant.c_str(), rcu_reads, "reads/s" );
+
+		EXPECT_GT( mutex_reads, 0.0 );
+		EXPECT_GT( rcu_reads, 0.0 );
+	}
+}
+
+
+
+} // thread
+} // core
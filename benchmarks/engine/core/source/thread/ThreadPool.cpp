@@ -0,0 +1,608 @@
+
+#include <gtest/gtest.h>
+
+#include "../BenchmarkCommon.hpp"
+
+#include <core/thread/TaskGraph.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+
+
+namespace core {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reproduction of the scheduler the thread pool used before work stealing, a single contiguous task list guarded by one mutex
+// that every worker scans for work and erases completed tasks from. Used as a baseline for the thread pool benchmarks.
+class LegacyScheduler
+{
+public:
+	LegacyScheduler(
+		size_t											worker_count
+	)
+	{
+		for( size_t i = 0; i < worker_count; ++i )
+		{
+			workers.emplace_back( [ this ]() { WorkerLoop(); } );
+		}
+	}
+
+	~LegacyScheduler()
+	{
+		should_exit = true;
+		wakeup.notify_all();
+		for( auto & worker : workers ) worker.join();
+	}
+
+	size_t												Schedule(
+		std::function<void()>							function,
+		std::vector<size_t>								dependencies		= {}
+	)
+	{
+		auto id = ++id_counter;
+		{
+			auto lock_guard = std::lock_guard( task_list_mutex );
+			task_list.push_back( std::make_unique<LegacyTask>( std::move( function ), std::move( dependencies ), id, false ) );
+		}
+		wakeup.notify_one();
+		return id;
+	}
+
+	void												WaitIdle()
+	{
+		while( true )
+		{
+			{
+				auto lock_guard = std::lock_guard( task_list_mutex );
+				if( task_list.empty() ) return;
+			}
+			wakeup.notify_all();
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+	}
+
+private:
+	struct LegacyTask
+	{
+		std::function<void()>							function;
+		std::vector<size_t>								dependencies;
+		size_t											id;
+		bool											running;
+	};
+
+	void												WorkerLoop()
+	{
+		while( !should_exit )
+		{
+			LegacyTask * task = nullptr;
+			{
+				auto lock_guard = std::lock_guard( task_list_mutex );
+				for( auto & t : task_list )
+				{
+					if( t->running ) continue;
+					if( std::any_of( task_list.begin(), task_list.end(), [ &t ]( auto & other )
+						{
+							return std::find( t->dependencies.begin(), t->dependencies.end(), other->id ) != t->dependencies.end();
+						} ) )
+					{
+						continue;
+					}
+					t->running = true;
+					task = t.get();
+					break;
+				}
+			}
+
+			if( task )
+			{
+				wakeup.notify_all();
+				task->function();
+				auto lock_guard = std::lock_guard( task_list_mutex );
+				task_list.erase( std::find_if( task_list.begin(), task_list.end(), [ task ]( auto & t ) { return t.get() == task; } ) );
+				continue;
+			}
+
+			auto unique_lock = std::unique_lock( wakeup_mutex );
+			wakeup.wait_for( unique_lock, std::chrono::milliseconds( 10 ) );
+		}
+	}
+
+	std::mutex											task_list_mutex;
+	std::vector<std::unique_ptr<LegacyTask>>			task_list;
+	size_t												id_counter			= 0;
+
+	std::mutex											wakeup_mutex;
+	std::condition_variable								wakeup;
+	std::atomic_bool									should_exit			= false;
+	std::vector<std::thread>							workers;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Small amount of work per task so that the benchmark measures scheduling overhead rather than the work itself.
+static void SimulateWork(
+	std::atomic<size_t>									&	counter
+)
+{
+	volatile size_t accumulator = 0;
+	for( size_t i = 0; i < 64; ++i ) accumulator += i;
+	counter.fetch_add( 1, std::memory_order_relaxed );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, ScheduleFromMainThread )
+{
+	constexpr size_t task_count = 200'000;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t i = 0; i < task_count; ++i )
+				{
+					thread_pool->ScheduleLambdaTask( [ &counter ]() { SimulateWork( counter ); } );
+				}
+				thread_pool->WaitIdle();
+			}
+		);
+		EXPECT_EQ( counter, task_count * 3 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "ThreadPool schedule from main thread", variant.c_str(), task_count / seconds, "tasks/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, ScheduleBatch )
+{
+	constexpr size_t batch_size = 5'000;
+	constexpr size_t batch_count = 40;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto work = [ &counter ]() { SimulateWork( counter ); };
+		auto lambdas = std::vector<decltype( work )>( batch_size, work );
+
+		auto per_task_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t b = 0; b < batch_count; ++b )
+				{
+					for( size_t i = 0; i < batch_size; ++i ) thread_pool->ScheduleLambdaTask( work );
+				}
+				thread_pool->WaitIdle();
+			}
+		);
+		auto batch_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t b = 0; b < batch_count; ++b )
+				{
+					thread_pool->ScheduleLambdaTaskBatch( lambdas );
+				}
+				thread_pool->WaitIdle();
+			}
+		);
+		EXPECT_EQ( counter, batch_size * batch_count * 6 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "ThreadPool schedule 5000 one by one", variant.c_str(), batch_size * batch_count / per_task_seconds, "tasks/s" );
+		benchmark::Report( "ThreadPool schedule 5000 as batch", variant.c_str(), batch_size * batch_count / batch_seconds, "tasks/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, ScheduleFromTasks )
+{
+	constexpr size_t parent_task_count = 1'000;
+	constexpr size_t child_task_count = 200;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t i = 0; i < parent_task_count; ++i )
+				{
+					thread_pool->ScheduleLambdaTask( [ &counter, thread_pool ]()
+						{
+							for( size_t c = 0; c < child_task_count; ++c )
+							{
+								thread_pool->ScheduleLambdaTask( [ &counter ]() { SimulateWork( counter ); } );
+							}
+						}
+					);
+				}
+				thread_pool->WaitIdle();
+			}
+		);
+		EXPECT_EQ( counter, parent_task_count * child_task_count * 3 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "ThreadPool schedule from tasks", variant.c_str(), parent_task_count * child_task_count / seconds, "tasks/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, LegacyScheduleFromMainThread )
+{
+	// Legacy scheduler erases from a shared list and scans it on every lookup, fewer tasks keep the run time reasonable.
+	constexpr size_t task_count = 20'000;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto scheduler = LegacyScheduler( worker_count );
+
+		auto counter = std::atomic<size_t> {};
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t i = 0; i < task_count; ++i )
+				{
+					scheduler.Schedule( [ &counter ]() { SimulateWork( counter ); } );
+				}
+				scheduler.WaitIdle();
+			}
+		);
+		EXPECT_EQ( counter, task_count * 3 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "Legacy schedule from main thread", variant.c_str(), task_count / seconds, "tasks/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, FanIn )
+{
+	// Groups of tasks that all feed into a single task, the shape of a typical frame graph.
+	constexpr size_t group_count = 100;
+	constexpr size_t group_size = 100;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				auto dependencies = bc::List<bc::thread::TaskIdentifier> {};
+				for( size_t g = 0; g < group_count; ++g )
+				{
+					dependencies.Clear();
+					for( size_t i = 0; i < group_size; ++i )
+					{
+						dependencies.PushBack( thread_pool->ScheduleLambdaTask( [ &counter ]() { SimulateWork( counter ); } ) );
+					}
+					thread_pool->ScheduleLambdaTaskWithDependencies( dependencies, [ &counter ]() { SimulateWork( counter ); } );
+				}
+				thread_pool->WaitIdle();
+			}
+		);
+		EXPECT_EQ( counter, group_count * ( group_size + 1 ) * 3 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "ThreadPool fan-in", variant.c_str(), group_count * ( group_size + 1 ) / seconds, "tasks/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, TaskGraphFrame )
+{
+	// Same fan-in frame shape as above, scheduled from scratch every frame versus recorded once as a task graph.
+	constexpr size_t group_count = 100;
+	constexpr size_t group_size = 100;
+	constexpr size_t frame_count = 10;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto rebuilt_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				auto dependencies = bc::List<bc::thread::TaskIdentifier> {};
+				for( size_t frame = 0; frame < frame_count; ++frame )
+				{
+					for( size_t g = 0; g < group_count; ++g )
+					{
+						dependencies.Clear();
+						for( size_t i = 0; i < group_size; ++i )
+						{
+							dependencies.PushBack( thread_pool->ScheduleLambdaTask( [ &counter ]() { SimulateWork( counter ); } ) );
+						}
+						thread_pool->ScheduleLambdaTaskWithDependencies( dependencies, [ &counter ]() { SimulateWork( counter ); } );
+					}
+					thread_pool->WaitIdle();
+				}
+			}
+		);
+
+		auto graph = bc::thread::TaskGraph {};
+		for( size_t g = 0; g < group_count; ++g )
+		{
+			auto sink = graph.AddNode( [ &counter ]() { SimulateWork( counter ); } );
+			for( size_t i = 0; i < group_size; ++i )
+			{
+				graph.AddEdge( graph.AddNode( [ &counter ]() { SimulateWork( counter ); } ), sink );
+			}
+		}
+		graph.Compile();
+
+		auto graph_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t frame = 0; frame < frame_count; ++frame )
+				{
+					graph.Execute( *thread_pool );
+					graph.Wait();
+				}
+			}
+		);
+		EXPECT_EQ( counter, group_count * ( group_size + 1 ) * frame_count * 6 );
+
+		auto rebuilt_variant = std::to_string( worker_count ) + " workers, rebuilt every frame";
+		auto graph_variant = std::to_string( worker_count ) + " workers, task graph";
+		benchmark::Report( "Frame graph", rebuilt_variant.c_str(), frame_count / rebuilt_seconds, "frames/s" );
+		benchmark::Report( "Frame graph", graph_variant.c_str(), frame_count / graph_seconds, "frames/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, LegacyFanIn )
+{
+	// Fewer groups than the thread pool fan-in benchmark, dependency checks in the legacy scheduler scan the whole task list.
+	constexpr size_t group_count = 10;
+	constexpr size_t group_size = 100;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto scheduler = LegacyScheduler( worker_count );
+
+		auto counter = std::atomic<size_t> {};
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				auto dependencies = std::vector<size_t> {};
+				for( size_t g = 0; g < group_count; ++g )
+				{
+					dependencies.clear();
+					for( size_t i = 0; i < group_size; ++i )
+					{
+						dependencies.push_back( scheduler.Schedule( [ &counter ]() { SimulateWork( counter ); } ) );
+					}
+					scheduler.Schedule( [ &counter ]() { SimulateWork( counter ); }, dependencies );
+				}
+				scheduler.WaitIdle();
+			}
+		);
+		EXPECT_EQ( counter, group_count * ( group_size + 1 ) * 3 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "Legacy fan-in", variant.c_str(), group_count * ( group_size + 1 ) / seconds, "tasks/s" );
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, WaitLatency )
+{
+	// Round trip of scheduling a single task to parked worker threads and waiting for it, the shape of frame end synchronization.
+	constexpr size_t round_trip_count = 10'000;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t i = 0; i < round_trip_count; ++i )
+				{
+					thread_pool->WaitForTask( thread_pool->ScheduleLambdaTask( [ &counter ]() { SimulateWork( counter ); } ) );
+				}
+			}
+		);
+		EXPECT_EQ( counter, round_trip_count * 3 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "ThreadPool wait latency", variant.c_str(), seconds / round_trip_count * 1'000'000.0, "us" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, LegacyWaitLatency )
+{
+	// Legacy scheduler polls with a millisecond sleep, fewer round trips keep the run time reasonable.
+	constexpr size_t round_trip_count = 100;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto scheduler = LegacyScheduler( worker_count );
+
+		auto counter = std::atomic<size_t> {};
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				for( size_t i = 0; i < round_trip_count; ++i )
+				{
+					scheduler.Schedule( [ &counter ]() { SimulateWork( counter ); } );
+					scheduler.WaitIdle();
+				}
+			}
+		);
+		EXPECT_EQ( counter, round_trip_count * 3 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "Legacy wait latency", variant.c_str(), seconds / round_trip_count * 1'000'000.0, "us" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, PendingTimers )
+{
+	// Throughput of ordinary tasks while many delayed tasks wait, either in the timer wheel or by pausing and being polled again
+	// as delays were emulated before the timer wheel.
+	constexpr size_t task_count = 100'000;
+	constexpr size_t pending_count = 2'000;
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		for( auto variant_name : { "no pending", "timer wheel", "pause polling" } )
+		{
+			auto core = benchmark::CreateCore();
+			auto thread_pool = core->GetThreadPool();
+			for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+			auto stop_polling = std::atomic_bool { false };
+			for( size_t i = 0; i < pending_count; ++i )
+			{
+				if( variant_name == std::string_view( "timer wheel" ) )
+				{
+					thread_pool->ScheduleLambdaTaskAfter( bc::thread::TaskPriority::BACKGROUND, std::chrono::milliseconds( 1500 ), [](){} );
+				}
+				else if( variant_name == std::string_view( "pause polling" ) )
+				{
+					thread_pool->ScheduleLambdaTask( bc::thread::TaskPriority::BACKGROUND, [ &stop_polling ]()
+						{
+							return stop_polling ? bc::thread::TaskExecutionResult::FINISHED : bc::thread::TaskExecutionResult::PAUSED;
+						}
+					);
+				}
+			}
+
+			auto counter = std::atomic<size_t> {};
+			auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+				{
+					// Not waiting for idle, the pending tasks keep the thread pool busy.
+					auto target_count = counter.load() + task_count;
+					for( size_t i = 0; i < task_count; ++i )
+					{
+						thread_pool->ScheduleLambdaTask( [ &counter ]() { SimulateWork( counter ); } );
+					}
+					while( counter.load() < target_count ) std::this_thread::yield();
+				}
+			);
+			stop_polling = true;
+			thread_pool->WaitIdle();
+			EXPECT_EQ( counter, task_count * 3 );
+
+			auto variant = std::to_string( worker_count ) + " workers, " + variant_name;
+			benchmark::Report( "ThreadPool throughput with 2000 delayed tasks", variant.c_str(), task_count / seconds, "tasks/s" );
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Per element work for the parallel for benchmarks, a few dozen nanoseconds like transforming a vertex or culling a meshlet.
+static float TransformElement(
+	float						value
+)
+{
+	for( size_t i = 0; i < 8; ++i )
+	{
+		value = std::sqrt( value * value + 1.0f ) * 0.5f;
+	}
+	return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, ParallelFor )
+{
+	constexpr size_t element_count = 4'000'000;
+
+	auto elements = std::vector<float>( element_count, 1.0f );
+
+	auto serial_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			for( size_t i = 0; i < element_count; ++i ) elements[ i ] = TransformElement( elements[ i ] );
+		}
+	);
+	benchmark::Report( "Serial loop", "calling thread", element_count / serial_seconds, "elements/s" );
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				thread_pool->ParallelFor( 0, element_count, 1024, [ &elements ]( bc::u64 index )
+					{
+						elements[ index ] = TransformElement( elements[ index ] );
+					}
+				);
+			}
+		);
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "ParallelFor", variant.c_str(), element_count / seconds, "elements/s" );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPoolBenchmark, ParallelReduce )
+{
+	constexpr size_t element_count = 4'000'000;
+
+	auto elements = std::vector<float>( element_count, 1.0f );
+
+	auto serial_result = 0.0;
+	auto serial_seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+		{
+			serial_result = 0.0;
+			for( size_t i = 0; i < element_count; ++i ) serial_result += TransformElement( elements[ i ] );
+		}
+	);
+	benchmark::Report( "Serial reduce", "calling thread", element_count / serial_seconds, "elements/s" );
+
+	for( auto worker_count : benchmark::GetWorkerThreadCounts() )
+	{
+		auto core = benchmark::CreateCore();
+		auto thread_pool = core->GetThreadPool();
+		for( size_t i = 0; i < worker_count; ++i ) thread_pool->AddThread<benchmark::BenchmarkThread>();
+
+		auto result = 0.0;
+		auto seconds = benchmark::MeasureBestSeconds( 3, [ & ]()
+			{
+				result = thread_pool->ParallelReduce( 0, element_count, 1024, 0.0,
+					[ &elements ]( bc::u64 index ) { return double( TransformElement( elements[ index ] ) ); },
+					[]( double a, double b ) { return a + b; }
+				);
+			}
+		);
+		EXPECT_NEAR( result, serial_result, serial_result * 1e-9 );
+
+		auto variant = std::to_string( worker_count ) + " workers";
+		benchmark::Report( "ParallelReduce", variant.c_str(), element_count / seconds, "elements/s" );
+	}
+}
+
+
+} // thread
+} // core
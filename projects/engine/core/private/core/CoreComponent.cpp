@@ -3,6 +3,7 @@
 #include <core/CoreComponent.hpp>
 #include <core/diagnostic/logger/Logger.hpp>
 #include <core/thread/ThreadPool.hpp>
+#include <core/memory/tracking/MemoryTracking.hpp>
 
 #include <locale>
 #include <clocale>
@@ -36,6 +37,11 @@ void SetGlobalLocale()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bc::CoreComponent		*	global_core			= nullptr;
 
+#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+bool													report_memory_leaks					= false;
+bc::memory::MemoryStatisticsSnapshot					memory_statistics_at_core_start		= {};
+#endif
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -46,6 +52,11 @@ bc::CoreComponent::CoreComponent(
 	BHardAssert( global_core == nullptr, "More than one core instance is not allowed" );
 	global_core = this;
 
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	report_memory_leaks = create_info.report_memory_leaks;
+	if( report_memory_leaks ) memory_statistics_at_core_start = memory::GetMemoryStatisticsSnapshot();
+	#endif
+
 	internal_::SetGlobalLocale();
 
 	// TODO: Start memory pool.
@@ -67,6 +78,10 @@ bc::CoreComponent::~CoreComponent()
 	logger				= nullptr;
 
 	global_core			= nullptr;
+
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	if( report_memory_leaks ) memory::internal_::ReportMemoryLeaks( memory_statistics_at_core_start );
+	#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
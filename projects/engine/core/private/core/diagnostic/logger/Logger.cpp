@@ -3,6 +3,7 @@
 #include <core/diagnostic/logger/Logger.hpp>
 #include <core/diagnostic/logger/LogReportSeverityToOther.hpp>
 #include <core/diagnostic/system_console/SystemConsole.hpp>
+#include <core/memory/tracking/MemoryTracking.hpp>
 
 
 
@@ -135,6 +136,7 @@ void bc::diagnostic::Logger::PushLogEntry(
 #endif
 
 	auto lock_guard = std::lock_guard( log_mutex );
+	auto memory_tag_scope = memory::MemoryTagScope( memory::MemoryTag::LOGGING );
 
 	if( std::to_underlying( log_entry.severity ) < std::to_underlying( LogReportSeverity::CRITICAL_ERROR ) &&
 		std::to_underlying( log_entry.severity ) < std::to_underlying( create_info.minimum_report_severity ) )
@@ -0,0 +1,946 @@
+#include <core/PreCompiledHeader.hpp>
+#include <core/file/AsyncFileReader.hpp>
+
+#include <core/CoreComponent.hpp>
+#include <core/containers/MpmcQueue.hpp>
+#include <core/conversion/text/utf/UTFConversion.hpp>
+#include <core/diagnostic/logger/Logger.hpp>
+#include <core/diagnostic/print_record/PrintRecordFactory.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+#include <core/thread/ThreadPool.hpp>
+
+#if defined( BITCRAFTE_PLATFORM_WINDOWS )
+#include <core/platform/windows/Windows.hpp>
+#elif defined( BITCRAFTE_PLATFORM_LINUX )
+#include <core/platform/linux/Linux.hpp>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#else
+#error "Please add platform support here."
+#endif
+
+#include <algorithm>
+#include <bit>
+
+
+
+namespace bc {
+namespace file {
+namespace internal_ {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Largest single read handed to the operating system, both Linux and Windows limit reads to a bit under 2 GiB.
+constexpr u64 MAX_READ_CHUNK_SIZE = u64( 1 ) << 30;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Keeps freed read buffers in power of 2 size classes so that reading many similarly sized files does not allocate every time.
+// Buffers larger than the largest size class are allocated and freed directly.
+class FileBufferPool
+{
+public:
+
+	static constexpr u64 MIN_SIZE_CLASS_SHIFT		= 12;
+	static constexpr u64 MAX_SIZE_CLASS_SHIFT		= 22;
+	static constexpr u64 SIZE_CLASS_COUNT			= MAX_SIZE_CLASS_SHIFT - MIN_SIZE_CLASS_SHIFT + 1;
+	static constexpr u64 BUFFER_ALIGNMENT			= 4096;
+
+	FileBufferPool(
+		u32						buffers_per_size_class
+	)
+	{
+		for( u64 i = 0; i < SIZE_CLASS_COUNT; ++i )
+		{
+			free_buffers.PushBack( MakeUniquePtr<MpmcQueue<u8*>>( std::max<u64>( 1, buffers_per_size_class ) ) );
+		}
+	}
+
+	~FileBufferPool()
+	{
+		for( u64 i = 0; i < SIZE_CLASS_COUNT; ++i )
+		{
+			u8 * buffer = nullptr;
+			while( free_buffers[ i ]->TryPop( buffer ) ) memory::FreeMemory( buffer, GetSizeClassSize( i ) );
+		}
+	}
+
+	u8 * Allocate(
+		u64						size
+	)
+	{
+		auto size_class = GetSizeClass( size );
+		if( size_class == SIZE_CLASS_COUNT ) return memory::AllocateMemory<u8>( size, BUFFER_ALIGNMENT );
+
+		u8 * buffer = nullptr;
+		if( free_buffers[ size_class ]->TryPop( buffer ) ) return buffer;
+		return memory::AllocateMemory<u8>( GetSizeClassSize( size_class ), BUFFER_ALIGNMENT );
+	}
+
+	void Free(
+		u8					*	buffer,
+		u64						size
+	)
+	{
+		auto size_class = GetSizeClass( size );
+		if( size_class == SIZE_CLASS_COUNT )
+		{
+			memory::FreeMemory( buffer, size );
+			return;
+		}
+		if( !free_buffers[ size_class ]->TryPush( buffer ) ) memory::FreeMemory( buffer, GetSizeClassSize( size_class ) );
+	}
+
+private:
+
+	static u64 GetSizeClass(
+		u64						size
+	)
+	{
+		auto shift = std::max<u64>( MIN_SIZE_CLASS_SHIFT, std::bit_width( std::max<u64>( size, 1 ) - 1 ) );
+		if( shift > MAX_SIZE_CLASS_SHIFT ) return SIZE_CLASS_COUNT;
+		return shift - MIN_SIZE_CLASS_SHIFT;
+	}
+
+	static u64 GetSizeClassSize(
+		u64						size_class
+	)
+	{
+		return u64( 1 ) << ( size_class + MIN_SIZE_CLASS_SHIFT );
+	}
+
+	List<UniquePtr<MpmcQueue<u8*>>>	free_buffers;
+};
+
+
+
+#if defined( BITCRAFTE_PLATFORM_WINDOWS )
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static i64 OpenFileForReading(
+	TextView32						file_path,
+	i32							&	out_error_code
+)
+{
+	auto wide_path = conversion::ToUTF16( file_path );
+	wide_path.PushBack( u'\0' );
+	auto handle = CreateFileW(
+		reinterpret_cast<const wchar_t*>( wide_path.Data() ),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr
+	);
+	if( handle == INVALID_HANDLE_VALUE )
+	{
+		out_error_code = i32( GetLastError() );
+		return -1;
+	}
+	return i64( reinterpret_cast<std::intptr_t>( handle ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static i64 GetOpenFileSize(
+	i64								file_handle,
+	i32							&	out_error_code
+)
+{
+	LARGE_INTEGER file_size;
+	if( !GetFileSizeEx( reinterpret_cast<HANDLE>( std::intptr_t( file_handle ) ), &file_size ) )
+	{
+		out_error_code = i32( GetLastError() );
+		return -1;
+	}
+	return i64( file_size.QuadPart );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void CloseOpenFile(
+	i64								file_handle
+)
+{
+	CloseHandle( reinterpret_cast<HANDLE>( std::intptr_t( file_handle ) ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reads until size bytes have been read, the end of the file is reached or an error occurs.
+static u64 ReadOpenFile(
+	i64								file_handle,
+	u8							*	destination,
+	u64								size,
+	u64								offset,
+	i32							&	out_error_code
+)
+{
+	u64 total_read = 0;
+	while( total_read < size )
+	{
+		auto position = offset + total_read;
+		auto overlapped = OVERLAPPED {};
+		overlapped.Offset		= DWORD( position & 0xFFFFFFFF );
+		overlapped.OffsetHigh	= DWORD( position >> 32 );
+
+		DWORD chunk_read = 0;
+		auto chunk_size = DWORD( std::min( size - total_read, MAX_READ_CHUNK_SIZE ) );
+		if( !ReadFile( reinterpret_cast<HANDLE>( std::intptr_t( file_handle ) ), destination + total_read, chunk_size, &chunk_read, &overlapped ) )
+		{
+			auto error = GetLastError();
+			if( error != ERROR_HANDLE_EOF ) out_error_code = i32( error );
+			break;
+		}
+		if( chunk_read == 0 ) break;
+		total_read += chunk_read;
+	}
+	return total_read;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// io_uring is Linux only, Windows always uses blocking reads in thread pool tasks.
+class IoUringQueue
+{
+public:
+
+	static UniquePtr<IoUringQueue> Create(
+		AsyncFileReader			&	reader,
+		u32							queue_depth
+	)
+	{
+		return {};
+	}
+
+	bool Submit(
+		FileReadState	* const	*	states,
+		u64							count
+	)
+	{
+		return false;
+	}
+
+	bool IsDead() const
+	{
+		return true;
+	}
+};
+
+
+
+#elif defined( BITCRAFTE_PLATFORM_LINUX )
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static i64 OpenFileForReading(
+	TextView32						file_path,
+	i32							&	out_error_code
+)
+{
+	auto utf8_path = conversion::ToUTF8( file_path );
+	utf8_path.PushBack( u8'\0' );
+	int file_descriptor = -1;
+	do
+	{
+		file_descriptor = open( reinterpret_cast<const char*>( utf8_path.Data() ), O_RDONLY | O_CLOEXEC );
+	} while( file_descriptor < 0 && errno == EINTR );
+
+	if( file_descriptor < 0 ) out_error_code = errno;
+	return file_descriptor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static i64 GetOpenFileSize(
+	i64								file_handle,
+	i32							&	out_error_code
+)
+{
+	struct stat file_status;
+	if( fstat( int( file_handle ), &file_status ) != 0 )
+	{
+		out_error_code = errno;
+		return -1;
+	}
+	return i64( file_status.st_size );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void CloseOpenFile(
+	i64								file_handle
+)
+{
+	close( int( file_handle ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reads until size bytes have been read, the end of the file is reached or an error occurs.
+static u64 ReadOpenFile(
+	i64								file_handle,
+	u8							*	destination,
+	u64								size,
+	u64								offset,
+	i32							&	out_error_code
+)
+{
+	u64 total_read = 0;
+	while( total_read < size )
+	{
+		auto chunk_size = std::min( size - total_read, MAX_READ_CHUNK_SIZE );
+		auto chunk_read = pread( int( file_handle ), destination + total_read, chunk_size, off_t( offset + total_read ) );
+		if( chunk_read < 0 )
+		{
+			if( errno == EINTR ) continue;
+			out_error_code = errno;
+			break;
+		}
+		if( chunk_read == 0 ) break;
+		total_read += u64( chunk_read );
+	}
+	return total_read;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Submission and completion queues of an io_uring instance, driven through raw system calls.
+//
+// Any thread may submit, submissions are serialized with a mutex since the submission queue has a single producer. One
+// completion thread blocks in the kernel waiting for completions, reaps them in batches and resubmits reads that came back
+// short. Reads beyond the completion queue size wait in a pending list so that completions can never overflow.
+//
+// If waiting for completions fails, every outstanding read fails with the error and the queue is dead. Reads submitted after
+// that are refused and fall back to blocking reads.
+class IoUringQueue
+{
+public:
+
+	static UniquePtr<IoUringQueue> Create(
+		AsyncFileReader			&	reader,
+		u32							queue_depth
+	)
+	{
+		auto queue = MakeUniquePtr<IoUringQueue>( reader );
+		if( !queue->Initialize( queue_depth ) ) return {};
+		return queue;
+	}
+
+	IoUringQueue(
+		AsyncFileReader			&	reader
+	) :
+		reader( reader )
+	{}
+
+	~IoUringQueue()
+	{
+		if( completion_thread.joinable() )
+		{
+			// Nop without a read state wakes up the completion thread, which exits once everything in flight has completed. Nop
+			// needs the same room as a read, the completion thread makes room as it reaps completions.
+			while( true )
+			{
+				{
+					auto lock_guard = std::lock_guard( submission_mutex );
+					if( is_dead ) break;
+					if( HasSubmissionRoom() )
+					{
+						stop_requested = true;
+						PushSubmission( IORING_OP_NOP, -1, nullptr, 0, 0, 0 );
+						++in_flight_count;
+						FlushSubmissions();
+						break;
+					}
+				}
+				std::this_thread::yield();
+			}
+			CompleteFailedReads();
+			completion_thread.join();
+		}
+		if( submission_queue_entries != MAP_FAILED ) munmap( submission_queue_entries, submission_queue_entries_size );
+		if( completion_ring != MAP_FAILED && completion_ring != submission_ring ) munmap( completion_ring, completion_ring_size );
+		if( submission_ring != MAP_FAILED ) munmap( submission_ring, submission_ring_size );
+		if( ring_file_descriptor >= 0 ) close( ring_file_descriptor );
+	}
+
+	// Returns false without taking the reads if the queue is dead.
+	bool Submit(
+		FileReadState	* const	*	states,
+		u64							count
+	)
+	{
+		{
+			auto lock_guard = std::lock_guard( submission_mutex );
+			if( is_dead ) return false;
+			for( u64 i = 0; i < count; ++i ) pending_states.PushBack( states[ i ] );
+			SubmitPending();
+		}
+		CompleteFailedReads();
+		return true;
+	}
+
+	bool IsDead() const
+	{
+		return is_dead.load( std::memory_order_relaxed );
+	}
+
+private:
+
+	bool Initialize(
+		u32							queue_depth
+	)
+	{
+		auto parameters = io_uring_params {};
+		ring_file_descriptor = int( syscall( __NR_io_uring_setup, std::max( 1U, queue_depth ), &parameters ) );
+		if( ring_file_descriptor < 0 )
+		{
+			LogWarning( U"Cannot create io_uring, file reads fall back to blocking reads", errno );
+			return false;
+		}
+
+		submission_ring_size	= parameters.sq_off.array + parameters.sq_entries * sizeof( u32 );
+		completion_ring_size	= parameters.cq_off.cqes + parameters.cq_entries * sizeof( io_uring_cqe );
+		if( parameters.features & IORING_FEAT_SINGLE_MMAP )
+		{
+			submission_ring_size = std::max( submission_ring_size, completion_ring_size );
+			completion_ring_size = submission_ring_size;
+		}
+
+		submission_ring = mmap( nullptr, submission_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_file_descriptor, IORING_OFF_SQ_RING );
+		if( submission_ring == MAP_FAILED ) return LogWarning( U"Cannot map io_uring submission ring", errno );
+
+		if( parameters.features & IORING_FEAT_SINGLE_MMAP )
+		{
+			completion_ring = submission_ring;
+		}
+		else
+		{
+			completion_ring = mmap( nullptr, completion_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_file_descriptor, IORING_OFF_CQ_RING );
+			if( completion_ring == MAP_FAILED ) return LogWarning( U"Cannot map io_uring completion ring", errno );
+		}
+
+		submission_queue_entries_size = parameters.sq_entries * sizeof( io_uring_sqe );
+		submission_queue_entries = mmap( nullptr, submission_queue_entries_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_file_descriptor, IORING_OFF_SQES );
+		if( submission_queue_entries == MAP_FAILED ) return LogWarning( U"Cannot map io_uring submission queue entries", errno );
+
+		auto submission_bytes	= static_cast<u8*>( submission_ring );
+		submission_head			= reinterpret_cast<u32*>( submission_bytes + parameters.sq_off.head );
+		submission_tail			= reinterpret_cast<u32*>( submission_bytes + parameters.sq_off.tail );
+		submission_mask			= *reinterpret_cast<u32*>( submission_bytes + parameters.sq_off.ring_mask );
+		submission_array		= reinterpret_cast<u32*>( submission_bytes + parameters.sq_off.array );
+		submission_capacity		= parameters.sq_entries;
+
+		auto completion_bytes	= static_cast<u8*>( completion_ring );
+		completion_head			= reinterpret_cast<u32*>( completion_bytes + parameters.cq_off.head );
+		completion_tail			= reinterpret_cast<u32*>( completion_bytes + parameters.cq_off.tail );
+		completion_mask			= *reinterpret_cast<u32*>( completion_bytes + parameters.cq_off.ring_mask );
+		completion_entries		= reinterpret_cast<io_uring_cqe*>( completion_bytes + parameters.cq_off.cqes );
+		completion_capacity		= parameters.cq_entries;
+
+		completion_thread = std::thread( [ this ]() { CompletionThreadMain(); } );
+		return true;
+	}
+
+	bool LogWarning(
+		bc::internal_::SimpleTextView32	message,
+		int							error_code
+	)
+	{
+		if( auto core = GetCore() )
+		{
+			core->GetLogger()->LogWarning(
+				diagnostic::MakePrintRecord_AssertText(
+					message,
+					U"Error code", i64( error_code )
+				)
+			);
+		}
+		return false;
+	}
+
+	// Writes one submission queue entry, the kernel does not see it before FlushSubmissions(). Caller makes sure there is room.
+	void PushSubmission(
+		u8							operation,
+		i64							file_handle,
+		u8						*	destination,
+		u64							size,
+		u64							offset,
+		u64							user_data
+	)
+	{
+		auto index = local_submission_tail & submission_mask;
+		auto & entry = static_cast<io_uring_sqe*>( submission_queue_entries )[ index ];
+		std::memset( &entry, 0, sizeof( entry ) );
+		entry.opcode		= operation;
+		entry.fd			= i32( file_handle );
+		entry.addr			= u64( reinterpret_cast<std::uintptr_t>( destination ) );
+		entry.len			= u32( size );
+		entry.off			= offset;
+		entry.user_data		= user_data;
+		submission_array[ index ] = index;
+		++local_submission_tail;
+	}
+
+	// True if both the submission queue and the completion queue have room for one more entry. Called with submission_mutex
+	// locked.
+	bool HasSubmissionRoom() const
+	{
+		auto submission_head_value = std::atomic_ref( *submission_head ).load( std::memory_order_acquire );
+		return in_flight_count < completion_capacity && local_submission_tail - submission_head_value < submission_capacity;
+	}
+
+	// Publishes pushed entries and enters the kernel once for all of them. Called with submission_mutex locked.
+	//
+	// If the kernel refuses the entries, they are taken back out of the ring and their reads fail with the error code, see
+	// CompleteFailedReads(). Without SQPOLL the kernel only reads the submission queue inside io_uring_enter, so rewinding the
+	// tail is safe.
+	void FlushSubmissions()
+	{
+		std::atomic_ref( *submission_tail ).store( local_submission_tail, std::memory_order_release );
+		while( true )
+		{
+			auto unsubmitted_count = local_submission_tail - std::atomic_ref( *submission_head ).load( std::memory_order_acquire );
+			if( unsubmitted_count == 0 ) return;
+
+			auto result = syscall( __NR_io_uring_enter, ring_file_descriptor, unsubmitted_count, 0, 0, nullptr, 0 );
+			if( result < 0 )
+			{
+				if( errno == EINTR ) continue;
+				if( errno == EAGAIN || errno == EBUSY )
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				auto error_code = errno;
+				auto head = std::atomic_ref( *submission_head ).load( std::memory_order_acquire );
+				for( auto i = head; i != local_submission_tail; ++i )
+				{
+					auto & entry = static_cast<io_uring_sqe*>( submission_queue_entries )[ i & submission_mask ];
+					auto state = reinterpret_cast<FileReadState*>( std::uintptr_t( entry.user_data ) );
+					if( state == nullptr ) continue;
+
+					RemoveInFlight( state );
+					state->error_code = error_code;
+					failed_states.PushBack( state );
+				}
+				in_flight_count -= local_submission_tail - head;
+				local_submission_tail = head;
+				std::atomic_ref( *submission_tail ).store( local_submission_tail, std::memory_order_release );
+				return;
+			}
+		}
+	}
+
+	// Completes reads the kernel refused in FlushSubmissions(). Called with submission_mutex unlocked, completing a read may
+	// destroy its state.
+	void CompleteFailedReads()
+	{
+		auto states = List<FileReadState*> {};
+		{
+			auto lock_guard = std::lock_guard( submission_mutex );
+			if( failed_states.IsEmpty() ) return;
+			std::swap( states, failed_states );
+		}
+		for( auto state : states ) reader.CompleteRead( state );
+	}
+
+	// Reads handed to the kernel are tracked so that they can be failed if the queue dies. Called with submission_mutex locked.
+	void AddInFlight(
+		FileReadState			*	state
+	)
+	{
+		state->in_flight_index = in_flight_states.Size();
+		in_flight_states.PushBack( state );
+	}
+
+	void RemoveInFlight(
+		FileReadState			*	state
+	)
+	{
+		auto last = in_flight_states.Back();
+		last->in_flight_index = state->in_flight_index;
+		in_flight_states[ state->in_flight_index ] = last;
+		in_flight_states.PopBack();
+	}
+
+	// Fails every read in the kernel or waiting to be submitted and refuses further reads. Called from the completion thread
+	// when waiting for completions fails, the ring cannot be used anymore.
+	void FailOutstandingReads(
+		int							error_code
+	)
+	{
+		LogWarning( U"Waiting for io_uring completions failed, file reads fall back to blocking reads", error_code );
+		{
+			auto lock_guard = std::lock_guard( submission_mutex );
+			is_dead = true;
+			for( auto state : in_flight_states ) failed_states.PushBack( state );
+			for( auto state : pending_states ) failed_states.PushBack( state );
+			in_flight_states.Clear();
+			pending_states.Clear();
+			in_flight_count = 0;
+			for( auto state : failed_states ) state->error_code = error_code;
+		}
+		CompleteFailedReads();
+	}
+
+	// Moves as many pending reads into the submission queue as there is room for. Called with submission_mutex locked.
+	void SubmitPending()
+	{
+		u64 submitted_count = 0;
+		while( submitted_count < pending_states.Size() && HasSubmissionRoom() )
+		{
+			auto state = pending_states[ submitted_count++ ];
+			auto remaining = state->size - state->bytes_read;
+			PushSubmission(
+				IORING_OP_READ,
+				state->file_handle,
+				state->buffer + state->bytes_read,
+				std::min( remaining, MAX_READ_CHUNK_SIZE ),
+				state->offset + state->bytes_read,
+				u64( reinterpret_cast<std::uintptr_t>( state ) )
+			);
+			AddInFlight( state );
+			++in_flight_count;
+		}
+		if( submitted_count == 0 ) return;
+
+		// Pending list is short, the kernel holds at most twice the queue depth.
+		auto left_count = pending_states.Size() - submitted_count;
+		for( u64 i = 0; i < left_count; ++i ) pending_states[ i ] = pending_states[ submitted_count + i ];
+		pending_states.Resize( left_count );
+
+		FlushSubmissions();
+	}
+
+	void CompletionThreadMain()
+	{
+		auto completed_states = List<FileReadState*> {};
+		auto resubmitted_states = List<FileReadState*> {};
+		while( true )
+		{
+			auto head = *completion_head;
+			auto tail = std::atomic_ref( *completion_tail ).load( std::memory_order_acquire );
+			if( head == tail )
+			{
+				// Stop is checked before waiting as well, in case the kernel refused the nop that would have woken this thread up.
+				{
+					auto lock_guard = std::lock_guard( submission_mutex );
+					if( stop_requested && in_flight_count == 0 ) break;
+				}
+				auto result = syscall( __NR_io_uring_enter, ring_file_descriptor, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0 );
+				if( result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY )
+				{
+					FailOutstandingReads( errno );
+					break;
+				}
+				continue;
+			}
+
+			u32 reaped_count = 0;
+			for( ; head != tail; ++head, ++reaped_count )
+			{
+				auto & completion = completion_entries[ head & completion_mask ];
+				auto state = reinterpret_cast<FileReadState*>( std::uintptr_t( completion.user_data ) );
+				if( state == nullptr ) continue;
+
+				if( completion.res < 0 )
+				{
+					if( completion.res == -EAGAIN || completion.res == -EINTR )
+					{
+						resubmitted_states.PushBack( state );
+						continue;
+					}
+					state->error_code = -completion.res;
+					completed_states.PushBack( state );
+					continue;
+				}
+
+				// Reads can come back short, the rest is read by resubmitting unless the end of the file was reached.
+				state->bytes_read += u64( completion.res );
+				if( completion.res == 0 || state->bytes_read == state->size )
+				{
+					completed_states.PushBack( state );
+					continue;
+				}
+				resubmitted_states.PushBack( state );
+			}
+			std::atomic_ref( *completion_head ).store( head, std::memory_order_release );
+
+			bool is_finished = false;
+			{
+				auto lock_guard = std::lock_guard( submission_mutex );
+				in_flight_count -= reaped_count;
+				for( auto state : completed_states ) RemoveInFlight( state );
+				for( auto state : resubmitted_states ) RemoveInFlight( state );
+				for( auto state : resubmitted_states ) pending_states.PushBack( state );
+				SubmitPending();
+				is_finished = stop_requested && in_flight_count == 0;
+			}
+			resubmitted_states.Clear();
+			CompleteFailedReads();
+
+			for( auto state : completed_states ) reader.CompleteRead( state );
+			completed_states.Clear();
+
+			if( is_finished ) break;
+		}
+	}
+
+	AsyncFileReader				&	reader;
+	std::thread						completion_thread;
+
+	int								ring_file_descriptor			= -1;
+	void						*	submission_ring					= MAP_FAILED;
+	void						*	completion_ring					= MAP_FAILED;
+	void						*	submission_queue_entries		= MAP_FAILED;
+	u64								submission_ring_size			= 0;
+	u64								completion_ring_size			= 0;
+	u64								submission_queue_entries_size	= 0;
+
+	u32							*	submission_head					= nullptr;
+	u32							*	submission_tail					= nullptr;
+	u32							*	submission_array				= nullptr;
+	u32								submission_mask					= 0;
+	u32								submission_capacity				= 0;
+
+	u32							*	completion_head					= nullptr;
+	u32							*	completion_tail					= nullptr;
+	io_uring_cqe				*	completion_entries				= nullptr;
+	u32								completion_mask					= 0;
+	u32								completion_capacity				= 0;
+
+	std::mutex						submission_mutex;
+	u32								local_submission_tail			= 0;
+	u32								in_flight_count					= 0;
+	bool							stop_requested					= false;
+	std::atomic_bool				is_dead							= false;	// Only set with submission_mutex locked.
+	List<FileReadState*>			in_flight_states;
+	List<FileReadState*>			pending_states;
+	List<FileReadState*>			failed_states;
+};
+
+
+
+#endif
+
+
+
+} // internal_
+} // file
+} // bc
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::file::internal_::FileReadState::RemoveReference()
+{
+	if( reference_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+	{
+		reader->DestroyReadState( this );
+	}
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::file::AsyncFileReader::AsyncFileReader(
+	thread::ThreadPool					&	thread_pool,
+	const AsyncFileReaderCreateInfo		&	create_info
+) :
+	thread_pool( thread_pool ),
+	create_info( create_info )
+{
+	buffer_pool = MakeUniquePtr<internal_::FileBufferPool>( create_info.pooled_buffers_per_size_class );
+	if( create_info.use_io_uring )
+	{
+		io_uring_queue = internal_::IoUringQueue::Create( *this, create_info.queue_depth );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::file::AsyncFileReader::~AsyncFileReader()
+{
+	{
+		auto lock = std::unique_lock( active_read_mutex );
+		active_read_condition.wait( lock, [ this ]() { return active_read_count == 0; } );
+	}
+
+	BHardAssert( live_state_count.load() == 0, U"All file read handles must be destroyed before the async file reader" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::file::FileReadHandle bc::file::AsyncFileReader::ReadFileAsync(
+	TextView32							file_path,
+	u64									offset,
+	u64									size
+)
+{
+	return ReadFileAsync( file_path, offset, size, nullptr );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::file::FileReadHandle bc::file::AsyncFileReader::ReadFileAsync(
+	TextView32							file_path,
+	u64									offset,
+	u64									size,
+	void							*	destination
+)
+{
+	auto request = FileReadRequest { file_path, offset, size, destination };
+	auto handle = FileReadHandle {};
+	auto state = PrepareRead( request, handle );
+	if( state ) SubmitReads( &state, 1 );
+	return handle;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::List<bc::file::FileReadHandle> bc::file::AsyncFileReader::ReadFilesAsync(
+	const List<FileReadRequest>			&	requests
+)
+{
+	auto handles = List<FileReadHandle>( requests.Size() );
+	auto states = List<internal_::FileReadState*> {};
+	states.Reserve( requests.Size() );
+	for( u64 i = 0; i < requests.Size(); ++i )
+	{
+		auto state = PrepareRead( requests[ i ], handles[ i ] );
+		if( state ) states.PushBack( state );
+	}
+	if( !states.IsEmpty() ) SubmitReads( states.Data(), states.Size() );
+	return handles;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::file::AsyncFileReader::IsUsingIoUring() const
+{
+	return !io_uring_queue.IsEmpty() && !io_uring_queue->IsDead();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::file::internal_::FileReadState * bc::file::AsyncFileReader::PrepareRead(
+	const FileReadRequest				&	request,
+	FileReadHandle						&	out_handle
+)
+{
+	BAssert( request.destination == nullptr || request.size != READ_TO_END, U"Reading into a destination requires a read size" );
+
+	auto state = memory::AllocateMemory<internal_::FileReadState>( 1, alignof( internal_::FileReadState ) );
+	std::construct_at( state );
+	state->reader	= this;
+	state->offset	= request.offset;
+	live_state_count.fetch_add( 1, std::memory_order_relaxed );
+	{
+		auto lock_guard = std::lock_guard( active_read_mutex );
+		++active_read_count;
+	}
+	out_handle = FileReadHandle( state );
+
+	state->file_handle = internal_::OpenFileForReading( request.file_path, state->error_code );
+	if( state->file_handle < 0 )
+	{
+		CompleteRead( state );
+		return nullptr;
+	}
+
+	state->size = request.size;
+	if( state->size == READ_TO_END || request.destination == nullptr )
+	{
+		// Pooled buffers are never larger than what is left of the file.
+		auto file_size = internal_::GetOpenFileSize( state->file_handle, state->error_code );
+		if( file_size < 0 )
+		{
+			CompleteRead( state );
+			return nullptr;
+		}
+		auto left_size = u64( file_size ) > request.offset ? u64( file_size ) - request.offset : 0;
+		state->size = std::min( state->size, left_size );
+	}
+	if( state->size == 0 )
+	{
+		CompleteRead( state );
+		return nullptr;
+	}
+
+	if( request.destination )
+	{
+		state->buffer = static_cast<u8*>( request.destination );
+	}
+	else
+	{
+		state->buffer			= buffer_pool->Allocate( state->size );
+		state->is_buffer_pooled	= true;
+	}
+	return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::file::AsyncFileReader::SubmitReads(
+	internal_::FileReadState	* const	*	states,
+	u64										count
+)
+{
+	// Dead io_uring queue refuses the reads, they are read with blocking reads instead.
+	if( !io_uring_queue.IsEmpty() && io_uring_queue->Submit( states, count ) ) return;
+
+	for( u64 i = 0; i < count; ++i )
+	{
+		auto state = states[ i ];
+		auto task_id = thread_pool.ScheduleLambdaTask( create_info.fallback_task_priority, [ this, state ]()
+			{
+				ReadBlocking( state );
+			}
+		);
+		// Thread pool refuses new tasks after a task has thrown, read on this thread so that the read still completes.
+		if( task_id == 0 ) ReadBlocking( state );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::file::AsyncFileReader::ReadBlocking(
+	internal_::FileReadState			*	state
+)
+{
+	state->bytes_read = internal_::ReadOpenFile( state->file_handle, state->buffer, state->size, state->offset, state->error_code );
+	CompleteRead( state );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::file::AsyncFileReader::CompleteRead(
+	internal_::FileReadState			*	state
+)
+{
+	if( state->file_handle >= 0 )
+	{
+		internal_::CloseOpenFile( state->file_handle );
+		state->file_handle = -1;
+	}
+
+	state->is_done.store( true, std::memory_order_release );
+	state->is_done.notify_all();
+	state->completion_event.Signal();
+	state->RemoveReference();
+
+	// Decremented under the lock, the destructor may destroy the reader as soon as it sees no active reads.
+	auto lock_guard = std::lock_guard( active_read_mutex );
+	if( --active_read_count == 0 ) active_read_condition.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::file::AsyncFileReader::DestroyReadState(
+	internal_::FileReadState			*	state
+)
+{
+	if( state->is_buffer_pooled ) buffer_pool->Free( state->buffer, state->size );
+	std::destroy_at( state );
+	memory::FreeMemory( state, 1 );
+	live_state_count.fetch_sub( 1, std::memory_order_relaxed );
+}
@@ -0,0 +1,132 @@
+#include <core/PreCompiledHeader.hpp>
+#include <core/memory/allocator/LinearArena.hpp>
+
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Blocks are allocated with this alignment, the block header is padded to it so the first allocation of a block is aligned too.
+constexpr bc::u64 LINEAR_ARENA_BLOCK_ALIGNMENT = 64;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct bc::memory::LinearArena::BlockHeader
+{
+	BlockHeader										*	previous_block					= nullptr;
+	u64													size							= 0;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::memory::LinearArena::LinearArena(
+	u64													block_size
+) noexcept :
+	block_size( std::max( block_size, LINEAR_ARENA_BLOCK_ALIGNMENT * 2 ) )
+{}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::memory::LinearArena::~LinearArena() noexcept
+{
+	FreeBlocks();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::LinearArena::Reset() noexcept
+{
+	if( current_block == nullptr ) return;
+
+	if( current_block->previous_block != nullptr )
+	{
+		// Last frame did not fit in one block, replace the chain with a single block which holds all of it.
+		auto merged_size = reserved_size;
+		FreeBlocks();
+		StartBlock( merged_size );
+		return;
+	}
+
+	auto block_start = reinterpret_cast<uintptr_t>( current_block ) + LINEAR_ARENA_BLOCK_ALIGNMENT;
+
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	// Fill released memory with byte 0xDD. This is used to catch use of reset memory in development builds.
+	std::memset( reinterpret_cast<void*>( block_start ), 0xDD, position - block_start );
+	#endif
+
+	position			= block_start;
+	last_allocation		= 0;
+	retired_used_size	= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::memory::LinearArena::GetUsedSize() const noexcept
+{
+	if( current_block == nullptr ) return 0;
+
+	return retired_used_size + ( position - reinterpret_cast<uintptr_t>( current_block ) - LINEAR_ARENA_BLOCK_ALIGNMENT );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::memory::LinearArena::GetReservedSize() const noexcept
+{
+	return reserved_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::memory::LinearArena::AllocateFromNewBlock(
+	u64													size,
+	u64													alignment
+) noexcept
+{
+	if( current_block != nullptr )
+	{
+		retired_used_size += position - reinterpret_cast<uintptr_t>( current_block ) - LINEAR_ARENA_BLOCK_ALIGNMENT;
+	}
+
+	// Oversized allocations get a block of their own, padding is only needed for alignments above the block alignment.
+	auto padding = alignment > LINEAR_ARENA_BLOCK_ALIGNMENT ? alignment : 0;
+	StartBlock( std::max( block_size, size + padding ) );
+
+	auto aligned_position = ( position + alignment - 1 ) & ~uintptr_t( alignment - 1 );
+	BHardAssert( aligned_position + size <= block_end, U"Linear arena block too small for allocation" );
+
+	last_allocation		= aligned_position;
+	position			= aligned_position + size;
+	return reinterpret_cast<void*>( aligned_position );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::LinearArena::StartBlock(
+	u64													size
+) noexcept
+{
+	auto block_memory = AllocateMemory<u8>( LINEAR_ARENA_BLOCK_ALIGNMENT + size, LINEAR_ARENA_BLOCK_ALIGNMENT );
+	auto block = new( block_memory ) BlockHeader {};
+	block->previous_block	= current_block;
+	block->size				= size;
+
+	current_block		= block;
+	reserved_size		+= size;
+	position			= reinterpret_cast<uintptr_t>( block_memory ) + LINEAR_ARENA_BLOCK_ALIGNMENT;
+	block_end			= position + size;
+	last_allocation		= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::LinearArena::FreeBlocks() noexcept
+{
+	while( current_block )
+	{
+		auto previous_block = current_block->previous_block;
+		FreeMemory( reinterpret_cast<u8*>( current_block ), LINEAR_ARENA_BLOCK_ALIGNMENT + current_block->size );
+		current_block = previous_block;
+	}
+
+	position			= 0;
+	block_end			= 0;
+	last_allocation		= 0;
+	reserved_size		= 0;
+	retired_used_size	= 0;
+}
@@ -0,0 +1,49 @@
+#include <core/PreCompiledHeader.hpp>
+#include <core/memory/allocator/StackAllocator.hpp>
+
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <cstring>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Alignment of the stack memory, allocations with an alignment up to this never need padding at the bottom of the stack.
+constexpr bc::u64 STACK_ALLOCATOR_ALIGNMENT = 64;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::memory::StackAllocator::StackAllocator(
+	u64													capacity
+) noexcept
+{
+	BHardAssert( capacity > 0, U"Stack allocator capacity must be larger than 0" );
+
+	stack_start		= reinterpret_cast<uintptr_t>( AllocateMemory<u8>( capacity, STACK_ALLOCATOR_ALIGNMENT ) );
+	stack_end		= stack_start + capacity;
+	position		= stack_start;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::memory::StackAllocator::~StackAllocator() noexcept
+{
+	FreeMemory( reinterpret_cast<u8*>( stack_start ), stack_end - stack_start );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::StackAllocator::RewindToMarker(
+	StackAllocatorMarker								marker
+) noexcept
+{
+	auto marker_position = stack_start + marker;
+	BHardAssert( marker_position <= position, U"Cannot rewind stack allocator, marker is above the top of the stack" );
+
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	// Fill released memory with byte 0xDD. This is used to catch use of released memory in development builds.
+	std::memset( reinterpret_cast<void*>( marker_position ), 0xDD, position - marker_position );
+	#endif
+
+	position		= marker_position;
+	last_allocation	= 0;
+}
@@ -0,0 +1,444 @@
+#include <core/PreCompiledHeader.hpp>
+#include <core/memory/raw/MemoryPool.hpp>
+
+#if defined( BITCRAFTE_PLATFORM_WINDOWS )
+#include <core/platform/windows/Windows.hpp>
+#elif defined( BITCRAFTE_PLATFORM_LINUX )
+#include <core/platform/linux/Linux.hpp>
+#include <sys/mman.h>
+#else
+#error "Please add platform support here."
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+#include <mutex>
+
+
+
+namespace bc {
+namespace memory {
+namespace internal_ {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Size classes are 64, 128, 192 and 256 bytes, after which every power of 2 is split into 4 evenly spaced classes up to
+// 256 KiB. Every class is a multiple of 64 so that blocks carved out of a page aligned slab stay 64 byte aligned.
+constexpr u64 SIZE_CLASS_COUNT				= 44;
+constexpr u64 MAX_SIZE_CLASS_SIZE			= u64( 1 ) << 18;
+
+// Blocks moved between a thread cache and the central list at once are limited to about this many bytes.
+constexpr u64 TRANSFER_BATCH_BYTES			= 32 * 1024;
+constexpr u64 MAX_TRANSFER_BATCH_COUNT		= 64;
+
+// Slabs are at least this large and hold at least SLAB_MIN_BLOCK_COUNT blocks.
+constexpr u64 SLAB_MIN_SIZE					= 256 * 1024;
+constexpr u64 SLAB_MIN_BLOCK_COUNT			= 8;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static constexpr u64 GetSizeClass(
+	u64									size
+)
+{
+	size = std::max<u64>( size, 1 );
+	if( size <= 256 ) return ( size - 1 ) / 64;
+
+	auto shift = u64( std::bit_width( size - 1 ) ) - 1;
+	auto step = u64( 1 ) << ( shift - 2 );
+	auto sub_class = ( size - ( u64( 1 ) << shift ) + step - 1 ) / step;
+	return 4 + ( shift - 8 ) * 4 + sub_class - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static constexpr u64 GetSizeClassSize(
+	u64									size_class
+)
+{
+	if( size_class < 4 ) return ( size_class + 1 ) * 64;
+
+	auto shift = 8 + ( size_class - 4 ) / 4;
+	auto sub_class = ( size_class - 4 ) % 4 + 1;
+	return ( u64( 1 ) << shift ) + sub_class * ( u64( 1 ) << ( shift - 2 ) );
+}
+static_assert( GetSizeClass( MAX_SIZE_CLASS_SIZE ) == SIZE_CLASS_COUNT - 1 );
+static_assert( GetSizeClassSize( SIZE_CLASS_COUNT - 1 ) == MAX_SIZE_CLASS_SIZE );
+static_assert( GetSizeClassSize( GetSizeClass( 1000 ) ) == 1024 && GetSizeClassSize( GetSizeClass( 1025 ) ) == 1280 );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Number of blocks moved between a thread cache and the central list at once, a thread cache holds at most twice this many.
+static constexpr auto transfer_batch_counts = []()
+	{
+		std::array<u64, SIZE_CLASS_COUNT> result {};
+		for( u64 i = 0; i < SIZE_CLASS_COUNT; ++i )
+		{
+			result[ i ] = std::clamp<u64>( TRANSFER_BATCH_BYTES / GetSizeClassSize( i ), 2, MAX_TRANSFER_BATCH_COUNT );
+		}
+		return result;
+	}();
+
+
+
+#if defined( BITCRAFTE_PLATFORM_WINDOWS )
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void * AllocateSystemPages(
+	u64									size
+)
+{
+	return VirtualAlloc( nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void FreeSystemPages(
+	void							*	location,
+	u64									size
+)
+{
+	VirtualFree( location, 0, MEM_RELEASE );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Windows cannot move pages of a reservation to a new address, reallocation falls back to copying.
+static void * ResizeSystemPages(
+	void							*	location,
+	u64									old_size,
+	u64									new_size
+)
+{
+	return nullptr;
+}
+
+
+
+#elif defined( BITCRAFTE_PLATFORM_LINUX )
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void * AllocateSystemPages(
+	u64									size
+)
+{
+	auto location = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	if( location == MAP_FAILED ) return nullptr;
+	return location;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void FreeSystemPages(
+	void							*	location,
+	u64									size
+)
+{
+	munmap( location, size );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void * ResizeSystemPages(
+	void							*	location,
+	u64									old_size,
+	u64									new_size
+)
+{
+	auto new_location = mremap( location, old_size, new_size, MREMAP_MAYMOVE );
+	if( new_location == MAP_FAILED ) return nullptr;
+	return new_location;
+}
+
+
+
+#else
+#error "Please add platform support here."
+#endif
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Free blocks are linked through their first bytes.
+struct FreeBlock
+{
+	FreeBlock						*	next;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Shared by all threads, refills thread caches and takes back blocks they have too many of. Memory given to a size class is
+// never returned to the operating system, it is reused by that size class.
+struct CentralSizeClass
+{
+	std::mutex							mutex;
+	FreeBlock						*	free_blocks						= nullptr;
+	u8								*	slab_position					= nullptr;
+	u8								*	slab_end						= nullptr;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructed on first use and never destroyed, blocks may still be freed by static destructors and exiting threads.
+static std::array<CentralSizeClass, SIZE_CLASS_COUNT> & GetCentralSizeClasses()
+{
+	alignas( std::array<CentralSizeClass, SIZE_CLASS_COUNT> ) static u8 storage[ sizeof( std::array<CentralSizeClass, SIZE_CLASS_COUNT> ) ];
+	static auto central_size_classes = std::construct_at( reinterpret_cast<std::array<CentralSizeClass, SIZE_CLASS_COUNT>*>( storage ) );
+	return *central_size_classes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Takes up to max_count blocks from the central list, carving new blocks from slabs as needed. Returns the number of blocks
+// linked from out_first, 0 if the operating system ran out of memory.
+static u64 TakeCentralBlocks(
+	u64									size_class,
+	u64									max_count,
+	FreeBlock						*&	out_first
+)
+{
+	auto & central = GetCentralSizeClasses()[ size_class ];
+	auto block_size = GetSizeClassSize( size_class );
+
+	auto lock_guard = std::lock_guard( central.mutex );
+	FreeBlock * first = nullptr;
+	u64 count = 0;
+	while( count < max_count )
+	{
+		FreeBlock * block = nullptr;
+		if( central.free_blocks )
+		{
+			block = central.free_blocks;
+			central.free_blocks = block->next;
+		}
+		else
+		{
+			if( central.slab_position == central.slab_end )
+			{
+				auto slab_size = std::max( SLAB_MIN_SIZE, block_size * SLAB_MIN_BLOCK_COUNT );
+				auto slab = reinterpret_cast<u8*>( AllocateSystemPages( slab_size ) );
+				if( slab == nullptr ) break;
+				central.slab_position = slab;
+				central.slab_end = slab + slab_size / block_size * block_size;
+			}
+			block = reinterpret_cast<FreeBlock*>( central.slab_position );
+			central.slab_position += block_size;
+		}
+		block->next = first;
+		first = block;
+		++count;
+	}
+	out_first = first;
+	return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void GiveCentralBlocks(
+	u64									size_class,
+	FreeBlock						*	first,
+	FreeBlock						*	last
+)
+{
+	auto & central = GetCentralSizeClasses()[ size_class ];
+
+	auto lock_guard = std::lock_guard( central.mutex );
+	last->next = central.free_blocks;
+	central.free_blocks = first;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Per thread free lists, constant initialized and trivially destructible so that accessing them costs no initialization check.
+struct ThreadCache
+{
+	struct SizeClassList
+	{
+		FreeBlock					*	first							= nullptr;
+		u64								count							= 0;
+	};
+
+	SizeClassList						size_classes[ SIZE_CLASS_COUNT ]	= {};
+	bool								is_release_registered			= false;
+	bool								is_released						= false;
+};
+static thread_local constinit ThreadCache thread_cache;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Moves count blocks from the front of a thread cache list to the central list.
+static void FlushThreadCacheList(
+	ThreadCache						&	cache,
+	u64									size_class,
+	u64									count
+)
+{
+	auto & list = cache.size_classes[ size_class ];
+	auto first = list.first;
+	auto last = first;
+	for( u64 i = 1; i < count; ++i ) last = last->next;
+
+	list.first = last->next;
+	list.count -= count;
+	GiveCentralBlocks( size_class, first, last );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Gives every cached block back to the central lists when the thread exits. Anything the thread allocates or frees after this
+// goes straight to the central lists.
+struct ThreadCacheRelease
+{
+	~ThreadCacheRelease()
+	{
+		auto & cache = thread_cache;
+		for( u64 i = 0; i < SIZE_CLASS_COUNT; ++i )
+		{
+			auto count = cache.size_classes[ i ].count;
+			if( count ) FlushThreadCacheList( cache, i, count );
+		}
+		cache.is_released = true;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void RegisterThreadCacheRelease(
+	ThreadCache						&	cache
+)
+{
+	static thread_local ThreadCacheRelease thread_cache_release;
+	cache.is_release_registered = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void * RefillThreadCacheList(
+	ThreadCache						&	cache,
+	u64									size_class
+)
+{
+	if( cache.is_released )
+	{
+		FreeBlock * block = nullptr;
+		TakeCentralBlocks( size_class, 1, block );
+		return block;
+	}
+	if( !cache.is_release_registered ) RegisterThreadCacheRelease( cache );
+
+	FreeBlock * first = nullptr;
+	auto count = TakeCentralBlocks( size_class, transfer_batch_counts[ size_class ], first );
+	if( count == 0 ) return nullptr;
+
+	auto & list = cache.size_classes[ size_class ];
+	list.first = first->next;
+	list.count = count - 1;
+	return first;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void * AllocateSizeClassBlock(
+	u64									size_class
+)
+{
+	// Thread local lookups are not free when the engine is built as a shared library, look the cache up only once.
+	auto & cache = thread_cache;
+	auto & list = cache.size_classes[ size_class ];
+	if( list.first ) [[likely]]
+	{
+		auto block = list.first;
+		list.first = block->next;
+		--list.count;
+		return block;
+	}
+	return RefillThreadCacheList( cache, size_class );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void FreeSizeClassBlock(
+	void							*	location,
+	u64									size_class
+)
+{
+	auto block = reinterpret_cast<FreeBlock*>( location );
+	auto & cache = thread_cache;
+	if( cache.is_released ) [[unlikely]]
+	{
+		GiveCentralBlocks( size_class, block, block );
+		return;
+	}
+
+	auto & list = cache.size_classes[ size_class ];
+	block->next = list.first;
+	list.first = block;
+	++list.count;
+
+	auto batch_count = transfer_batch_counts[ size_class ];
+	if( list.count > batch_count * 2 ) [[unlikely]]
+	{
+		if( !cache.is_release_registered ) RegisterThreadCacheRelease( cache );
+		FlushThreadCacheList( cache, size_class, batch_count );
+	}
+}
+
+
+
+} // internal_
+} // memory
+} // bc
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::memory::internal_::AllocateFromMemoryPool(
+	u64									size,
+	u64								&	out_allocated_size
+) noexcept
+{
+	if( size > MAX_SIZE_CLASS_SIZE )
+	{
+		auto allocated_size = ( size + SYSTEM_PAGE_SIZE - 1 ) / SYSTEM_PAGE_SIZE * SYSTEM_PAGE_SIZE;
+		auto location = AllocateSystemPages( allocated_size );
+		out_allocated_size = location ? allocated_size : 0;
+		return location;
+	}
+
+	auto size_class = GetSizeClass( size );
+	auto location = AllocateSizeClassBlock( size_class );
+	out_allocated_size = location ? GetSizeClassSize( size_class ) : 0;
+	return location;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::internal_::FreeToMemoryPool(
+	void							*	location,
+	u64									allocated_size
+) noexcept
+{
+	if( location == nullptr ) return;
+
+	if( allocated_size > MAX_SIZE_CLASS_SIZE )
+	{
+		FreeSystemPages( location, allocated_size );
+		return;
+	}
+
+	FreeSizeClassBlock( location, GetSizeClass( allocated_size ) );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::memory::internal_::ResizeMemoryPoolBlock(
+	void							*	location,
+	u64									allocated_size,
+	u64									size,
+	u64								&	out_allocated_size
+) noexcept
+{
+	if( location == nullptr || allocated_size <= MAX_SIZE_CLASS_SIZE || size <= MAX_SIZE_CLASS_SIZE ) return nullptr;
+
+	auto new_allocated_size = ( size + SYSTEM_PAGE_SIZE - 1 ) / SYSTEM_PAGE_SIZE * SYSTEM_PAGE_SIZE;
+	auto new_location = ResizeSystemPages( location, allocated_size, new_allocated_size );
+	if( new_location == nullptr ) return nullptr;
+
+	out_allocated_size = new_allocated_size;
+	return new_location;
+}
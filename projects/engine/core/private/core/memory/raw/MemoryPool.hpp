@@ -0,0 +1,100 @@
+#pragma once
+
+#include <core/data_types/FundamentalTypes.hpp>
+
+
+
+namespace bc {
+namespace memory {
+namespace internal_ {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Blocks allocated directly from the operating system are aligned to and rounded up to this size.
+constexpr u64							SYSTEM_PAGE_SIZE					= 4096;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Allocates a system memory block from the engine memory pool.
+///
+/// Small blocks are rounded up to a size class and served from a per-thread cache of free blocks of that class, the cache
+/// is refilled in batches from a central list per size class which carves new blocks out of slabs allocated from the operating
+/// system. Blocks larger than the largest size class are allocated directly from the operating system.
+///
+/// Returned blocks are aligned to at least 64 bytes.
+///
+/// @note
+/// Multithreading: Any thread. A block may be freed from a different thread than it was allocated on.
+///
+/// @param size
+/// Minimum size of the block in bytes.
+///
+/// @param out_allocated_size
+/// Receives the actual usable size of the block, this must be given back to FreeToMemoryPool.
+///
+/// @return
+/// Pointer to the start of the block, nullptr if the operating system ran out of memory.
+void								*	AllocateFromMemoryPool(
+	u64									size,
+	u64								&	out_allocated_size
+) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gives a block allocated with AllocateFromMemoryPool back to the engine memory pool.
+///
+/// @note
+/// Multithreading: Any thread.
+///
+/// @param location
+/// Pointer to the start of the block.
+///
+/// @param allocated_size
+/// Allocated size received from AllocateFromMemoryPool.
+void									FreeToMemoryPool(
+	void							*	location,
+	u64									allocated_size
+) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Resizes a block without copying its contents.
+///
+/// Only blocks which were allocated directly from the operating system, and stay large enough to be, can be resized this way.
+/// The operating system remaps the pages of the block to the new size, the block may move to a new address but its contents
+/// move along with it. Resized blocks are aligned to SYSTEM_PAGE_SIZE.
+///
+/// @note
+/// Multithreading: Any thread.
+///
+/// @param location
+/// Pointer to the start of the block.
+///
+/// @param allocated_size
+/// Allocated size received from AllocateFromMemoryPool.
+///
+/// @param size
+/// New minimum size of the block in bytes.
+///
+/// @param out_allocated_size
+/// Receives the actual usable size of the resized block, this must be given back to FreeToMemoryPool.
+///
+/// @return
+/// Pointer to the start of the resized block. nullptr if the block cannot be resized this way, the original block is
+/// left untouched and must be reallocated by allocating a new block and copying.
+void								*	ResizeMemoryPoolBlock(
+	void							*	location,
+	u64									allocated_size,
+	u64									size,
+	u64								&	out_allocated_size
+) noexcept;
+
+
+
+} // internal_
+} // memory
+} // bc
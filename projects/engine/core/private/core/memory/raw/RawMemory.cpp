@@ -1,8 +1,12 @@
 
 #include <core/PreCompiledHeader.hpp>
 #include <core/memory/raw/RawMemory.hpp>
+#include <core/memory/raw/MemoryPool.hpp>
+#include <core/memory/tracking/MemoryTracking.hpp>
 #include <core/diagnostic/crash_handling/Panic.hpp>
 
+#include <cstring>
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -15,8 +19,11 @@ void bc::memory::internal_::FreeRawMemory_Runtime(
 	auto allocation_header = GetMemoryAllocationHeaderFromUserPointer( location );
 	BHardAssert( allocation_header, "Couldn't free runtime memory, memory pointer was not allocated from bc::memory utilities" );
 
-	// TODO: Free from memory pool once it's implemented.
-	delete[] reinterpret_cast<u8*>( allocation_header->system_allocated_location );
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	TrackFree_Runtime( allocation_header->tag, allocation_header->payload_size );
+	#endif
+
+	FreeToMemoryPool( allocation_header->system_allocated_location, allocation_header->system_allocation_size );
 }
 
 
@@ -26,25 +33,48 @@ void * bc::memory::internal_::AllocateRawMemory_Runtime(
 	u64				size,
 	u64				alignment_requirement
 ) noexcept
+{
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	return AllocateRawMemory_Runtime( size, alignment_requirement, GetCurrentMemoryTag() );
+	#else
+	return AllocateRawMemory_Runtime( size, alignment_requirement, MemoryTag::UNTAGGED );
+	#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::memory::internal_::AllocateRawMemory_Runtime(
+	u64				size,
+	u64				alignment_requirement,
+	MemoryTag		tag
+) noexcept
 {
 	auto minimum_required_allocation_size = CalculateMinimumRequiredSystemMemoryAllocationSize(
 		size,
 		alignment_requirement
 	);
 
-	// TODO: Allocate from memory pool once it's implemented.
-	auto system_ptr = new u8[ minimum_required_allocation_size ];
+	// Memory pool rounds the allocation up to its size class, recording the whole block in the header leaves the extra space
+	// available for in-place reallocation.
+	u64 system_allocation_size = 0;
+	auto system_ptr = AllocateFromMemoryPool( minimum_required_allocation_size, system_allocation_size );
 	if( system_ptr == nullptr ) std::abort();
 	BHardAssert( ( reinterpret_cast<uintptr_t>( system_ptr ) & 0xFFFF000000000000ULL ) == 0ULL, "Allocated memory from system needs to have high 16 bits unused" );
 
 	auto allocation_header = CreateMemoryAllocationHeader(
 		system_ptr,
-		minimum_required_allocation_size,
+		system_allocation_size,
 		size, 
-		alignment_requirement
+		alignment_requirement,
+		tag
 	);
 	SetMemoryAllocationHeader( allocation_header );
 
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	TrackAllocation_Runtime( tag, size );
+	#endif
+
 	return allocation_header.payload_location;
 }
 
@@ -68,20 +98,51 @@ void * bc::memory::internal_::ReallocateRawMemory_Runtime(
 		return InPlaceReallocateMemory_Runtime( *old_allocation_info, new_size );
 	}
 
-	// TODO: Once memory pool is implemented, test if new size fits inside the old allocation size in the memory pool,
-	// if it does, update memory pool allocation tracker, update SystemMemoryAllocationInfo, and return old_location.
+	// Large allocations have system pages of their own which the memory pool can remap to the new size, the payload moves along
+	// with the pages without being copied. The payload keeps its offset from the start of the block, so this only works if the
+	// payload alignment is not larger than the alignment of the remapped block.
+	if( old_allocation_info->payload_alignment_requirement <= SYSTEM_PAGE_SIZE )
+	{
+		u64 new_system_allocation_size = 0;
+		auto new_system_ptr = ResizeMemoryPoolBlock(
+			old_allocation_info->system_allocated_location,
+			old_allocation_info->system_allocation_size,
+			CalculateMinimumRequiredSystemMemoryAllocationSize( new_size, old_allocation_info->payload_alignment_requirement ),
+			new_system_allocation_size
+		);
+		if( new_system_ptr )
+		{
+			auto new_allocation_header = CreateMemoryAllocationHeader(
+				new_system_ptr,
+				new_system_allocation_size,
+				new_size,
+				old_allocation_info->payload_alignment_requirement,
+				old_allocation_info->tag
+			);
+			assert(
+				reinterpret_cast<uintptr_t>( new_allocation_header.payload_location ) - reinterpret_cast<uintptr_t>( new_system_ptr ) ==
+				reinterpret_cast<uintptr_t>( old_location ) - reinterpret_cast<uintptr_t>( old_allocation_info->system_allocated_location ) &&
+				"Expected payload offset to stay the same when remapping"
+			);
+			SetMemoryAllocationHeader( new_allocation_header );
+
+			#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+			TrackResize_Runtime( old_allocation_info->tag, old_size, new_size );
+			#endif
+
+			return new_allocation_header.payload_location;
+		}
+	}
 
 	// We need to make sure that we have enough space for correct alignment requirement, so we allocate extra.
 	auto new_ptr = AllocateRawMemory_Runtime(
 		new_size,
-		old_allocation_info->payload_alignment_requirement
+		old_allocation_info->payload_alignment_requirement,
+		old_allocation_info->tag
 	);
 
 	auto common_size = ( old_size < new_size ) ? old_size : new_size;
-	for( u64 i = 0; i < common_size; ++i )
-	{
-		reinterpret_cast<u8*>( new_ptr )[ i ] = reinterpret_cast<u8*>( old_location )[ i ];
-	}
+	std::memcpy( new_ptr, old_location, common_size );
 
 	FreeRawMemory_Runtime( old_location );
 	return new_ptr;
@@ -0,0 +1,365 @@
+#include <core/PreCompiledHeader.hpp>
+#include <core/memory/tracking/MemoryTracking.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+#include <core/diagnostic/system_console/SystemConsole.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+
+
+namespace bc {
+namespace memory {
+namespace internal_ {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static constexpr const char * memory_tag_names[ MEMORY_TAG_COUNT ] = {
+	"UNTAGGED",
+	"CORE",
+	"LOGGING",
+	"THREAD",
+	"FILE",
+	"WINDOW_MANAGER",
+	"RHI",
+	"SCENE",
+	"UI",
+	"ENGINE",
+	"EDITOR",
+	"GAME",
+};
+
+
+
+#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Threads publish the counters of a tag to the shared counters once its unpublished size or allocation count reaches these.
+constexpr i64 PUBLISH_SIZE_THRESHOLD		= 64 * 1024;
+constexpr i64 PUBLISH_COUNT_THRESHOLD		= 256;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocations freed on another thread than they were allocated on are subtracted from the counters of the freeing thread, so
+// the counters of a single thread may be negative.
+struct TagCounters
+{
+	std::atomic<i64>					live_size						= 0;
+	std::atomic<i64>					live_allocation_count			= 0;
+	std::atomic<i64>					total_allocation_count			= 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Only written by the owning thread, other threads read them when taking a snapshot. Constant initialized and trivially
+// destructible so that accessing them costs no initialization check and they stay usable while the thread exits.
+struct ThreadMemoryCounters
+{
+	TagCounters							tags[ MEMORY_TAG_COUNT ]		= {};
+	MemoryTag							current_tag						= MemoryTag::UNTAGGED;
+
+	ThreadMemoryCounters			*	previous						= nullptr;
+	ThreadMemoryCounters			*	next							= nullptr;
+	bool								is_registered					= false;
+	bool								is_released						= false;
+};
+static thread_local constinit ThreadMemoryCounters thread_counters;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Counters published by every thread, and the list of threads which still have unpublished counters.
+struct SharedMemoryCounters
+{
+	std::mutex							mutex;
+	ThreadMemoryCounters			*	first_thread					= nullptr;
+
+	TagCounters							tags[ MEMORY_TAG_COUNT ]		= {};
+	std::atomic<i64>					peak_live_sizes[ MEMORY_TAG_COUNT ]	= {};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructed on first use and never destroyed, memory may still be freed by static destructors and exiting threads.
+static SharedMemoryCounters & GetSharedMemoryCounters()
+{
+	alignas( SharedMemoryCounters ) static u8 storage[ sizeof( SharedMemoryCounters ) ];
+	static auto shared_counters = std::construct_at( reinterpret_cast<SharedMemoryCounters*>( storage ) );
+	return *shared_counters;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void RaisePeakLiveSize(
+	SharedMemoryCounters			&	shared,
+	u64									tag_index,
+	i64									live_size
+)
+{
+	auto & peak = shared.peak_live_sizes[ tag_index ];
+	auto current_peak = peak.load( std::memory_order_relaxed );
+	while( live_size > current_peak && !peak.compare_exchange_weak( current_peak, live_size, std::memory_order_relaxed ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Adds counter changes straight to the shared counters.
+static void AddToSharedCounters(
+	u64									tag_index,
+	i64									size,
+	i64									allocation_count,
+	i64									total_allocation_count
+)
+{
+	auto & shared = GetSharedMemoryCounters();
+	auto & tag = shared.tags[ tag_index ];
+	auto live_size = tag.live_size.fetch_add( size, std::memory_order_relaxed ) + size;
+	tag.live_allocation_count.fetch_add( allocation_count, std::memory_order_relaxed );
+	tag.total_allocation_count.fetch_add( total_allocation_count, std::memory_order_relaxed );
+	RaisePeakLiveSize( shared, tag_index, live_size );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Moves the counters of a single tag of the current thread to the shared counters.
+static void PublishThreadCounters(
+	ThreadMemoryCounters			&	counters,
+	u64									tag_index
+)
+{
+	auto & tag = counters.tags[ tag_index ];
+	AddToSharedCounters(
+		tag_index,
+		tag.live_size.load( std::memory_order_relaxed ),
+		tag.live_allocation_count.load( std::memory_order_relaxed ),
+		tag.total_allocation_count.load( std::memory_order_relaxed )
+	);
+	tag.live_size.store( 0, std::memory_order_relaxed );
+	tag.live_allocation_count.store( 0, std::memory_order_relaxed );
+	tag.total_allocation_count.store( 0, std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Publishes every counter of the thread and removes it from the thread list when the thread exits. Anything the thread
+// allocates or frees after this goes straight to the shared counters.
+struct ThreadMemoryCountersRelease
+{
+	~ThreadMemoryCountersRelease()
+	{
+		auto & counters = thread_counters;
+		auto & shared = GetSharedMemoryCounters();
+		auto lock_guard = std::lock_guard( shared.mutex );
+
+		for( u64 i = 0; i < MEMORY_TAG_COUNT; ++i ) PublishThreadCounters( counters, i );
+
+		if( counters.previous ) counters.previous->next = counters.next;
+		else shared.first_thread = counters.next;
+		if( counters.next ) counters.next->previous = counters.previous;
+		counters.is_released = true;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void RegisterThreadMemoryCounters(
+	ThreadMemoryCounters			&	counters
+)
+{
+	static thread_local ThreadMemoryCountersRelease thread_counters_release;
+
+	auto & shared = GetSharedMemoryCounters();
+	auto lock_guard = std::lock_guard( shared.mutex );
+	counters.next = shared.first_thread;
+	if( shared.first_thread ) shared.first_thread->previous = &counters;
+	shared.first_thread = &counters;
+	counters.is_registered = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void TrackChange(
+	MemoryTag							tag,
+	i64									size,
+	i64									allocation_count,
+	i64									total_allocation_count
+)
+{
+	auto tag_index = u64( tag ) < MEMORY_TAG_COUNT ? u64( tag ) : u64( MemoryTag::UNTAGGED );
+
+	// Thread local lookups are not free when the engine is built as a shared library, look the counters up only once.
+	auto & counters = thread_counters;
+	if( counters.is_released ) [[unlikely]]
+	{
+		AddToSharedCounters( tag_index, size, allocation_count, total_allocation_count );
+		return;
+	}
+	if( !counters.is_registered ) [[unlikely]] RegisterThreadMemoryCounters( counters );
+
+	// Only this thread writes its own counters, a plain load and store is enough.
+	auto & counter = counters.tags[ tag_index ];
+	auto live_size = counter.live_size.load( std::memory_order_relaxed ) + size;
+	auto live_allocation_count = counter.live_allocation_count.load( std::memory_order_relaxed ) + allocation_count;
+	auto new_total_allocation_count = counter.total_allocation_count.load( std::memory_order_relaxed ) + total_allocation_count;
+	counter.live_size.store( live_size, std::memory_order_relaxed );
+	counter.live_allocation_count.store( live_allocation_count, std::memory_order_relaxed );
+	counter.total_allocation_count.store( new_total_allocation_count, std::memory_order_relaxed );
+
+	if( live_size >= PUBLISH_SIZE_THRESHOLD || live_size <= -PUBLISH_SIZE_THRESHOLD ||
+		new_total_allocation_count >= PUBLISH_COUNT_THRESHOLD ) [[unlikely]]
+	{
+		PublishThreadCounters( counters, tag_index );
+	}
+}
+
+#endif // BITCRAFTE_GAME_DEVELOPMENT_BUILD
+
+
+
+} // internal_
+} // memory
+} // bc
+
+
+
+#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::internal_::TrackAllocation_Runtime(
+	MemoryTag							tag,
+	u64									size
+) noexcept
+{
+	TrackChange( tag, i64( size ), 1, 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::internal_::TrackFree_Runtime(
+	MemoryTag							tag,
+	u64									size
+) noexcept
+{
+	TrackChange( tag, -i64( size ), -1, 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::memory::internal_::TrackResize_Runtime(
+	MemoryTag							tag,
+	u64									old_size,
+	u64									new_size
+) noexcept
+{
+	TrackChange( tag, i64( new_size ) - i64( old_size ), 0, 0 );
+}
+
+#endif // BITCRAFTE_GAME_DEVELOPMENT_BUILD
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::memory::MemoryTag bc::memory::internal_::ExchangeCurrentMemoryTag(
+	MemoryTag							tag
+) noexcept
+{
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	return std::exchange( thread_counters.current_tag, tag );
+	#else
+	return MemoryTag::UNTAGGED;
+	#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::memory::internal_::ReportMemoryLeaks(
+	const MemoryStatisticsSnapshot	&	baseline
+) noexcept
+{
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	auto snapshot = GetMemoryStatisticsSnapshot();
+
+	bool is_leak_found = false;
+	for( u64 i = 0; i < MEMORY_TAG_COUNT; ++i )
+	{
+		auto & before = baseline.tags[ i ];
+		auto & after = snapshot.tags[ i ];
+		if( after.live_size <= before.live_size && after.live_allocation_count <= before.live_allocation_count ) continue;
+
+		if( !is_leak_found )
+		{
+			constexpr char8_t title[] = u8"Memory leaks found at core shutdown:\n";
+			diagnostic::internal_::SystemConsolePrintRawUTF8( title, sizeof( title ) - 1, diagnostic::PrintRecordColor::YELLOW );
+			is_leak_found = true;
+		}
+
+		char line[ 256 ];
+		auto line_length = std::snprintf(
+			line, sizeof( line ), "    %s: %lld bytes in %lld allocations\n",
+			memory_tag_names[ i ],
+			static_cast<long long>( after.live_size ) - static_cast<long long>( before.live_size ),
+			static_cast<long long>( after.live_allocation_count ) - static_cast<long long>( before.live_allocation_count )
+		);
+		diagnostic::internal_::SystemConsolePrintRawUTF8(
+			reinterpret_cast<const char8_t*>( line ),
+			u64( std::clamp( line_length, 0, int( sizeof( line ) - 1 ) ) ),
+			diagnostic::PrintRecordColor::YELLOW
+		);
+	}
+	return is_leak_found;
+
+	#else
+
+	return false;
+
+	#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::memory::MemoryTag bc::memory::GetCurrentMemoryTag() noexcept
+{
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	return internal_::thread_counters.current_tag;
+	#else
+	return MemoryTag::UNTAGGED;
+	#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::memory::MemoryStatisticsSnapshot bc::memory::GetMemoryStatisticsSnapshot() noexcept
+{
+	auto snapshot = MemoryStatisticsSnapshot {};
+
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	auto & shared = internal_::GetSharedMemoryCounters();
+	auto lock_guard = std::lock_guard( shared.mutex );
+
+	for( u64 i = 0; i < MEMORY_TAG_COUNT; ++i )
+	{
+		auto live_size = shared.tags[ i ].live_size.load( std::memory_order_relaxed );
+		auto live_allocation_count = shared.tags[ i ].live_allocation_count.load( std::memory_order_relaxed );
+		auto total_allocation_count = shared.tags[ i ].total_allocation_count.load( std::memory_order_relaxed );
+		for( auto thread = shared.first_thread; thread; thread = thread->next )
+		{
+			live_size += thread->tags[ i ].live_size.load( std::memory_order_relaxed );
+			live_allocation_count += thread->tags[ i ].live_allocation_count.load( std::memory_order_relaxed );
+			total_allocation_count += thread->tags[ i ].total_allocation_count.load( std::memory_order_relaxed );
+		}
+
+		// Counters of other threads are read while they change, keep the results sensible.
+		live_size = std::max<i64>( live_size, 0 );
+		live_allocation_count = std::max<i64>( live_allocation_count, 0 );
+		internal_::RaisePeakLiveSize( shared, i, live_size );
+
+		auto & tag = snapshot.tags[ i ];
+		tag.live_size				= u64( live_size );
+		tag.live_allocation_count	= u64( live_allocation_count );
+		tag.peak_live_size			= u64( shared.peak_live_sizes[ i ].load( std::memory_order_relaxed ) );
+		tag.total_allocation_count	= u64( std::max<i64>( total_allocation_count, 0 ) );
+	}
+	#endif
+
+	return snapshot;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::TextView bc::memory::MemoryTagToText(
+	MemoryTag							tag
+) noexcept
+{
+	if( u64( tag ) >= MEMORY_TAG_COUNT ) return "<unknown>";
+
+	return TextView( internal_::memory_tag_names[ u64( tag ) ] );
+}
@@ -0,0 +1,53 @@
+
+#include <core/PreCompiledHeader.hpp>
+#include <core/thread/CoroutineTask.hpp>
+#include <core/thread/ThreadSharedData.hpp>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskEvent::Awaiter::Arm(
+	ThreadSharedData	&	thread_shared_data,
+	Task				&	task
+)
+{
+	waiting_thread_shared_data	= &thread_shared_data;
+	waiting_task				= &task;
+
+	auto head = event.waiters.load( std::memory_order_acquire );
+	do
+	{
+		if( head == SignaledMarker() ) return false;
+		next_waiter = head;
+	} while( !event.waiters.compare_exchange_weak( head, this, std::memory_order_release, std::memory_order_acquire ) );
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskEvent::Signal()
+{
+	auto waiter = waiters.exchange( SignaledMarker(), std::memory_order_acq_rel );
+	if( waiter == SignaledMarker() ) return;
+
+	while( waiter )
+	{
+		// Awaiter lives in the coroutine frame of the waiting task, it can be gone as soon as the task has been resumed.
+		auto next = waiter->next_waiter;
+		waiter->waiting_thread_shared_data->ResumeTask( waiter->waiting_task );
+		waiter = next;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskEvent::IsSignaled() const
+{
+	return waiters.load( std::memory_order_acquire ) == SignaledMarker();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskEvent::Reset()
+{
+	auto expected = SignaledMarker();
+	waiters.compare_exchange_strong( expected, nullptr, std::memory_order_acq_rel );
+	BAssert( expected == SignaledMarker() || expected == nullptr, U"Cannot reset task event, coroutine tasks are waiting for it" );
+}
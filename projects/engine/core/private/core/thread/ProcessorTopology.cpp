@@ -0,0 +1,407 @@
+
+#include <core/PreCompiledHeader.hpp>
+#include <core/thread/ProcessorTopology.hpp>
+
+#include <core/CoreComponent.hpp>
+#include <core/diagnostic/logger/Logger.hpp>
+#include <core/diagnostic/print_record/PrintRecordFactory.hpp>
+
+#if defined( BITCRAFTE_PLATFORM_WINDOWS )
+#include <core/platform/windows/Windows.hpp>
+#elif defined( BITCRAFTE_PLATFORM_LINUX )
+#include <core/platform/linux/Linux.hpp>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <fstream>
+#include <sstream>
+#include <cerrno>
+#include <cstring>
+#else
+#error "Please add platform support here."
+#endif
+
+#include <algorithm>
+#include <thread>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u32 bc::thread::GetLogicalProcessorCount()
+{
+	return std::max( 1U, std::thread::hardware_concurrency() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u32 bc::thread::GetDefaultWorkerThreadCount()
+{
+	auto physical_core_count = u32( GetPhysicalCoreProcessors().Size() );
+	return std::max( 1U, physical_core_count - 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Keeps the affinity list sorted and free of duplicates.
+static bc::List<bc::u32> CombineProcessorAffinity(
+	const bc::thread::ThreadCreateInfo	&	create_info
+)
+{
+	using namespace bc;
+
+	auto processors = create_info.processor_affinity;
+	std::sort( processors.begin(), processors.end() );
+	processors.Resize( u64( std::unique( processors.begin(), processors.end() ) - processors.begin() ) );
+
+	if( create_info.numa_node < 0 ) return processors;
+
+	auto numa_processors = thread::GetNumaNodeProcessors( u32( create_info.numa_node ) );
+	if( numa_processors.IsEmpty() )
+	{
+		diagnostic::Throw(
+			diagnostic::MakePrintRecord_AssertText(
+				U"Cannot place thread on NUMA node, node does not exist",
+				U"NUMA node", create_info.numa_node
+			)
+		);
+	}
+	if( processors.IsEmpty() ) return numa_processors;
+
+	auto combined = List<u32> {};
+	for( auto processor : processors )
+	{
+		if( std::binary_search( numa_processors.begin(), numa_processors.end(), processor ) ) combined.PushBack( processor );
+	}
+	if( combined.IsEmpty() )
+	{
+		diagnostic::Throw(
+			diagnostic::MakePrintRecord_AssertText(
+				U"Cannot place thread on NUMA node, none of the affinity processors belong to the node",
+				U"NUMA node", create_info.numa_node
+			)
+		);
+	}
+	return combined;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void LogThreadSetupWarning(
+	bc::internal_::SimpleTextView32		message,
+	bc::TextView						thread_name,
+	bc::i64								error_code
+)
+{
+	bc::GetCore()->GetLogger()->LogWarning(
+		bc::diagnostic::MakePrintRecord_AssertText(
+			message,
+			U"Thread name", thread_name,
+			U"Error code", error_code
+		)
+	);
+}
+
+
+
+#if defined( BITCRAFTE_PLATFORM_WINDOWS )
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::List<bc::u32> bc::thread::GetPhysicalCoreProcessors()
+{
+	auto result = List<u32> {};
+
+	DWORD buffer_size = 0;
+	GetLogicalProcessorInformationEx( RelationProcessorCore, nullptr, &buffer_size );
+	auto buffer = List<u8>( buffer_size );
+	if( buffer_size && GetLogicalProcessorInformationEx(
+		RelationProcessorCore,
+		reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>( buffer.Data() ),
+		&buffer_size
+	) )
+	{
+		for( DWORD offset = 0; offset < buffer_size; )
+		{
+			auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>( buffer.Data() + offset );
+			auto & group_mask = info->Processor.GroupMask[ 0 ];
+			if( group_mask.Mask )
+			{
+				result.PushBack( u32( group_mask.Group ) * 64 + u32( std::countr_zero( u64( group_mask.Mask ) ) ) );
+			}
+			offset += info->Size;
+		}
+	}
+
+	if( result.IsEmpty() )
+	{
+		for( u32 i = 0; i < GetLogicalProcessorCount(); ++i ) result.PushBack( i );
+	}
+	std::sort( result.begin(), result.end() );
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::List<bc::u32> bc::thread::GetNumaNodeProcessors(
+	u32 numa_node
+)
+{
+	auto result = List<u32> {};
+
+	GROUP_AFFINITY affinity = {};
+	if( numa_node > 0xFFFF || !GetNumaNodeProcessorMaskEx( USHORT( numa_node ), &affinity ) ) return result;
+
+	for( u32 i = 0; i < 64; ++i )
+	{
+		if( u64( affinity.Mask ) & ( u64( 1 ) << i ) ) result.PushBack( u32( affinity.Group ) * 64 + i );
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::internal_::ApplyThreadCreateInfo(
+	const ThreadCreateInfo	&	create_info,
+	TextView					default_name
+)
+{
+	auto thread_name = create_info.name.IsEmpty() ? default_name : TextView( create_info.name );
+
+	auto processors = CombineProcessorAffinity( create_info );
+	if( !processors.IsEmpty() )
+	{
+		// Windows threads can only be bound to processors of a single processor group.
+		auto group_affinity = GROUP_AFFINITY {};
+		group_affinity.Group = WORD( processors.Front() / 64 );
+		for( auto processor : processors )
+		{
+			if( processor / 64 != group_affinity.Group )
+			{
+				diagnostic::Throw(
+					diagnostic::MakePrintRecord_AssertText(
+						U"Cannot set thread affinity, processors must belong to the same processor group",
+						U"Thread name", thread_name
+					)
+				);
+			}
+			group_affinity.Mask |= KAFFINITY( 1 ) << ( processor % 64 );
+		}
+		if( !SetThreadGroupAffinity( GetCurrentThread(), &group_affinity, nullptr ) )
+		{
+			diagnostic::Throw(
+				diagnostic::MakePrintRecord_AssertText(
+					U"Cannot set thread affinity",
+					U"Thread name", thread_name,
+					U"Error code", i64( GetLastError() )
+				)
+			);
+		}
+	}
+
+	if( create_info.priority != ThreadPriority::NORMAL )
+	{
+		int windows_priority = THREAD_PRIORITY_NORMAL;
+		switch( create_info.priority )
+		{
+		case ThreadPriority::LOWEST:		windows_priority = THREAD_PRIORITY_LOWEST;			break;
+		case ThreadPriority::BELOW_NORMAL:	windows_priority = THREAD_PRIORITY_BELOW_NORMAL;	break;
+		case ThreadPriority::NORMAL:		windows_priority = THREAD_PRIORITY_NORMAL;			break;
+		case ThreadPriority::ABOVE_NORMAL:	windows_priority = THREAD_PRIORITY_ABOVE_NORMAL;	break;
+		case ThreadPriority::HIGHEST:		windows_priority = THREAD_PRIORITY_HIGHEST;			break;
+		}
+		if( !SetThreadPriority( GetCurrentThread(), windows_priority ) )
+		{
+			LogThreadSetupWarning( U"Cannot set thread priority", thread_name, i64( GetLastError() ) );
+		}
+	}
+
+	auto wide_name_length = MultiByteToWideChar( CP_UTF8, 0, thread_name.Data(), int( thread_name.Size() ), nullptr, 0 );
+	auto wide_name = List<wchar_t>( u64( wide_name_length ) + 1 );
+	MultiByteToWideChar( CP_UTF8, 0, thread_name.Data(), int( thread_name.Size() ), wide_name.Data(), wide_name_length );
+	wide_name[ u64( wide_name_length ) ] = L'\0';
+	if( FAILED( SetThreadDescription( GetCurrentThread(), wide_name.Data() ) ) )
+	{
+		LogThreadSetupWarning( U"Cannot set thread name", thread_name, i64( GetLastError() ) );
+	}
+}
+
+
+
+#elif defined( BITCRAFTE_PLATFORM_LINUX )
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reads a single number from a sysfs file, returns -1 if the file cannot be read.
+static bc::i64 ReadSystemFileNumber(
+	const char		*	path
+)
+{
+	auto file = std::ifstream( path );
+	bc::i64 value = -1;
+	if( !( file >> value ) ) return -1;
+	return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parses a Linux cpu list, eg. "0-3,8,10-11".
+static bc::List<bc::u32> ParseProcessorList(
+	const std::string	&	cpu_list
+)
+{
+	auto result = bc::List<bc::u32> {};
+
+	auto stream = std::istringstream( cpu_list );
+	auto range = std::string {};
+	while( std::getline( stream, range, ',' ) )
+	{
+		if( range.empty() || range == "\n" ) continue;
+
+		auto separator = range.find( '-' );
+		auto first = bc::u32( std::stoul( range.substr( 0, separator ) ) );
+		auto last = separator == std::string::npos ? first : bc::u32( std::stoul( range.substr( separator + 1 ) ) );
+		for( auto processor = first; processor <= last; ++processor ) result.PushBack( processor );
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::List<bc::u32> bc::thread::GetPhysicalCoreProcessors()
+{
+	auto allowed_processors = List<u32> {};
+	cpu_set_t process_affinity;
+	CPU_ZERO( &process_affinity );
+	if( sched_getaffinity( 0, sizeof( process_affinity ), &process_affinity ) == 0 )
+	{
+		for( u32 i = 0; i < CPU_SETSIZE; ++i )
+		{
+			if( CPU_ISSET( i, &process_affinity ) ) allowed_processors.PushBack( i );
+		}
+	}
+	if( allowed_processors.IsEmpty() )
+	{
+		for( u32 i = 0; i < GetLogicalProcessorCount(); ++i ) allowed_processors.PushBack( i );
+	}
+
+	// Processors sharing a package and a core id are hardware threads of the same physical core.
+	auto seen_cores = List<Pair<i64, i64>> {};
+	auto result = List<u32> {};
+	for( auto processor : allowed_processors )
+	{
+		char path[ 128 ];
+		std::snprintf( path, sizeof( path ), "/sys/devices/system/cpu/cpu%u/topology/core_id", processor );
+		auto core_id = ReadSystemFileNumber( path );
+		std::snprintf( path, sizeof( path ), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", processor );
+		auto package_id = ReadSystemFileNumber( path );
+
+		if( core_id >= 0 )
+		{
+			auto core = Pair<i64, i64>{ package_id, core_id };
+			if( std::find( seen_cores.begin(), seen_cores.end(), core ) != seen_cores.end() ) continue;
+			seen_cores.PushBack( core );
+		}
+		result.PushBack( processor );
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::List<bc::u32> bc::thread::GetNumaNodeProcessors(
+	u32 numa_node
+)
+{
+	char path[ 128 ];
+	std::snprintf( path, sizeof( path ), "/sys/devices/system/node/node%u/cpulist", numa_node );
+
+	auto file = std::ifstream( path );
+	if( !file )
+	{
+		// Kernels without NUMA support have no node directory, every processor then belongs to node 0.
+		auto result = List<u32> {};
+		if( numa_node == 0 && ReadSystemFileNumber( "/sys/devices/system/node/online" ) < 0 )
+		{
+			for( u32 i = 0; i < GetLogicalProcessorCount(); ++i ) result.PushBack( i );
+		}
+		return result;
+	}
+
+	auto cpu_list = std::string {};
+	std::getline( file, cpu_list );
+	return ParseProcessorList( cpu_list );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::internal_::ApplyThreadCreateInfo(
+	const ThreadCreateInfo	&	create_info,
+	TextView					default_name
+)
+{
+	auto thread_name = create_info.name.IsEmpty() ? default_name : TextView( create_info.name );
+
+	auto processors = CombineProcessorAffinity( create_info );
+	if( !processors.IsEmpty() )
+	{
+		cpu_set_t affinity;
+		CPU_ZERO( &affinity );
+		for( auto processor : processors )
+		{
+			if( processor >= CPU_SETSIZE )
+			{
+				diagnostic::Throw(
+					diagnostic::MakePrintRecord_AssertText(
+						U"Cannot set thread affinity, processor index out of range",
+						U"Thread name", thread_name,
+						U"Processor", processor
+					)
+				);
+			}
+			CPU_SET( processor, &affinity );
+		}
+		auto error = pthread_setaffinity_np( pthread_self(), sizeof( affinity ), &affinity );
+		if( error != 0 )
+		{
+			diagnostic::Throw(
+				diagnostic::MakePrintRecord_AssertText(
+					U"Cannot set thread affinity",
+					U"Thread name", thread_name,
+					U"Error code", i64( error )
+				)
+			);
+		}
+	}
+
+	if( create_info.priority != ThreadPriority::NORMAL )
+	{
+		// Linux threads are scheduled individually, nice value of a thread is set through its thread id.
+		int nice_value = 0;
+		switch( create_info.priority )
+		{
+		case ThreadPriority::LOWEST:		nice_value = 19;	break;
+		case ThreadPriority::BELOW_NORMAL:	nice_value = 5;		break;
+		case ThreadPriority::NORMAL:		nice_value = 0;		break;
+		case ThreadPriority::ABOVE_NORMAL:	nice_value = -5;	break;
+		case ThreadPriority::HIGHEST:		nice_value = -10;	break;
+		}
+		if( setpriority( PRIO_PROCESS, id_t( gettid() ), nice_value ) != 0 )
+		{
+			LogThreadSetupWarning( U"Cannot set thread priority", thread_name, i64( errno ) );
+		}
+	}
+
+	// Linux thread names are limited to 15 bytes, cut on a UTF-8 character boundary.
+	char name_buffer[ 16 ] = {};
+	auto name_length = std::min<u64>( thread_name.Size(), sizeof( name_buffer ) - 1 );
+	if( name_length < thread_name.Size() )
+	{
+		while( name_length > 0 && ( u8( thread_name[ name_length ] ) & 0xC0 ) == 0x80 ) --name_length;
+	}
+	std::memcpy( name_buffer, thread_name.Data(), name_length );
+	auto error = pthread_setname_np( pthread_self(), name_buffer );
+	if( error != 0 )
+	{
+		LogThreadSetupWarning( U"Cannot set thread name", thread_name, i64( error ) );
+	}
+}
+
+
+
+#else
+#error "Please add platform support here."
+#endif
@@ -0,0 +1,326 @@
+
+#include <core/PreCompiledHeader.hpp>
+
+#include <core/thread/TaskGraph.hpp>
+#include <core/thread/ThreadPool.hpp>
+#include <core/thread/ThreadSharedData.hpp>
+
+#include <core/diagnostic/print_record/PrintRecordFactory.hpp>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static bc::i64 GetTimestamp()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskExecutionResult bc::thread::internal_::TaskGraphNodeTask::operator()(
+	Thread	&	thread
+)
+{
+	auto start = GetTimestamp();
+	Invoke();
+	auto end = GetTimestamp();
+
+	start_time	= start - graph->execution_start_time;
+	duration	= end - start;
+	was_run		= true;
+	return TaskExecutionResult::FINISHED;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::internal_::TaskGraphNodeTask::OnReleasedByThreadPool()
+{
+	graph->ReleaseNode( this );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskExecutionResult bc::thread::internal_::TaskGraphSinkTask::operator()(
+	Thread	&	thread
+)
+{
+	return TaskExecutionResult::FINISHED;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::internal_::TaskGraphSinkTask::Arm(
+	ThreadSharedData	&	thread_shared_data,
+	Task				&	task
+)
+{
+	// Resumed by the last node to complete.
+	this->thread_shared_data = &thread_shared_data;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::internal_::TaskGraphSinkTask::OnReleasedByThreadPool()
+{
+	// Graph may be executed again or destroyed as soon as this is cleared, nothing can be touched after.
+	graph->sink_in_flight.store( false, std::memory_order_release );
+	graph->sink_in_flight.notify_all();
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskGraph::TaskGraph()
+{
+	sink_task.graph = this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskGraph::~TaskGraph()
+{
+	WaitForPreviousExecution();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskGraph::AddEdge(
+	NodeIndex	before,
+	NodeIndex	after
+)
+{
+	BAssert( !IsExecuting(), U"Cannot add task graph edge, graph is executing" );
+	BAssert( before < nodes.Size() && after < nodes.Size(), U"Cannot add task graph edge, node index out of range" );
+	BAssert( before != after, U"Cannot add task graph edge, node cannot depend on itself" );
+
+	edges.PushBack( Edge { before, after } );
+	is_compiled = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskGraph::Compile()
+{
+	BAssert( !IsExecuting(), U"Cannot compile task graph, graph is executing" );
+
+	auto node_count = nodes.Size();
+
+	// Successors are stored contiguously per node, counted first and then filled in.
+	successor_offsets.Clear();
+	successor_offsets.Resize( node_count + 1 );
+	for( auto & node : nodes ) node->predecessor_count = 0;
+	for( auto & edge : edges )
+	{
+		++successor_offsets[ edge.before + 1 ];
+		++nodes[ edge.after ]->predecessor_count;
+	}
+	for( u64 i = 0; i < node_count; ++i )
+	{
+		successor_offsets[ i + 1 ] += successor_offsets[ i ];
+	}
+
+	successor_indices.Clear();
+	successor_indices.Resize( edges.Size() );
+	auto fill_offsets = successor_offsets;
+	for( auto & edge : edges )
+	{
+		successor_indices[ fill_offsets[ edge.before ]++ ] = edge.after;
+	}
+
+	// Kahn's algorithm, roots are taken first so they end up at the start of the execution order.
+	execution_order.Clear();
+	execution_order.Reserve( node_count );
+	auto pending_counts = List<u32> {};
+	pending_counts.Resize( node_count );
+	for( u64 i = 0; i < node_count; ++i )
+	{
+		pending_counts[ i ] = nodes[ i ]->predecessor_count;
+		if( pending_counts[ i ] == 0 ) execution_order.PushBack( NodeIndex( i ) );
+	}
+	root_node_count = execution_order.Size();
+	root_batch.Clear();
+	root_batch.Resize( root_node_count );
+
+	for( u64 i = 0; i < execution_order.Size(); ++i )
+	{
+		auto node_index = execution_order[ i ];
+		for( auto s = successor_offsets[ node_index ]; s < successor_offsets[ node_index + 1 ]; ++s )
+		{
+			if( --pending_counts[ successor_indices[ s ] ] == 0 ) execution_order.PushBack( successor_indices[ s ] );
+		}
+	}
+
+	if( execution_order.Size() != node_count )
+	{
+		diagnostic::Throw(
+			diagnostic::MakePrintRecord_AssertText(
+				U"Cannot compile task graph, edges form a cycle",
+				U"Nodes in or after a cycle", node_count - execution_order.Size()
+			)
+		);
+	}
+
+	is_compiled = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskIdentifier bc::thread::TaskGraph::Execute(
+	ThreadPool	&	thread_pool
+)
+{
+	BAssert( is_compiled, U"Cannot execute task graph, graph must be compiled after adding nodes or edges" );
+	BHardAssert( !thread_pool.shutting_down, "Cannot execute task graph, thread pool is shutting down" );
+
+	WaitForPreviousExecution();
+	thread_pool.CheckAndHandleThreadThrow();
+
+	this->thread_pool		= &thread_pool;
+	execution_start_time	= GetTimestamp();
+	for( auto & node : nodes )
+	{
+		node->pending_predecessor_count.store( node->predecessor_count, std::memory_order_relaxed );
+		node->start_time	= 0;
+		node->duration		= 0;
+		node->was_run		= false;
+	}
+
+	// Extra count keeps the sink task waiting until every root has been dispatched.
+	remaining_node_count.store( nodes.Size() + 1, std::memory_order_relaxed );
+	sink_in_flight.store( true, std::memory_order_relaxed );
+
+	sink_task_id = thread_pool.DoAddExternallyOwnedTask( &sink_task, TaskPriority::NORMAL, &sink_task );
+	if( sink_task_id == 0 )
+	{
+		sink_in_flight.store( false, std::memory_order_release );
+		return 0;
+	}
+
+	// Roots are queued as one batch, disabled roots are completed after so their successors join the batch's tasks.
+	u64 root_batch_size = 0;
+	for( u64 i = 0; i < root_node_count; ++i )
+	{
+		auto node = nodes[ execution_order[ i ] ].Get();
+		if( !node->is_enabled ) continue;
+		ThreadPool::PrepareExternallyOwnedTask( node, node->node_priority );
+		root_batch[ root_batch_size++ ] = node;
+	}
+	if( thread_pool.DoAddExternallyOwnedTaskBatch( root_batch.Data(), root_batch_size ).task_count != root_batch_size )
+	{
+		for( u64 i = 0; i < root_batch_size; ++i ) ReleaseNode( static_cast<internal_::TaskGraphNodeTask*>( root_batch[ i ] ) );
+	}
+	for( u64 i = 0; i < root_node_count; ++i )
+	{
+		auto node = nodes[ execution_order[ i ] ].Get();
+		if( !node->is_enabled ) ReleaseNode( node );
+	}
+
+	// Sink task may complete as soon as the hold is released, read its identifier before.
+	auto task_id = sink_task_id;
+	CompleteNode();
+	return task_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskGraph::Wait()
+{
+	if( thread_pool == nullptr || sink_task_id == 0 ) return;
+	thread_pool->WaitForTask( sink_task_id );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskGraph::IsExecuting() const
+{
+	return sink_in_flight.load( std::memory_order_acquire );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskGraph::SetNodeEnabled(
+	NodeIndex	node,
+	bool		enabled
+)
+{
+	BAssert( node < nodes.Size(), U"Cannot enable task graph node, node index out of range" );
+	BAssert( !IsExecuting(), U"Cannot enable task graph node, graph is executing" );
+	nodes[ node ]->is_enabled = enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskGraph::IsNodeEnabled(
+	NodeIndex	node
+) const
+{
+	BAssert( node < nodes.Size(), U"Cannot get task graph node state, node index out of range" );
+	return nodes[ node ]->is_enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskGraphNodeTiming bc::thread::TaskGraph::GetNodeTiming(
+	NodeIndex	node
+) const
+{
+	BAssert( node < nodes.Size(), U"Cannot get task graph node timing, node index out of range" );
+	auto & graph_node = *nodes[ node ];
+	return TaskGraphNodeTiming {
+		std::chrono::nanoseconds( graph_node.start_time ),
+		std::chrono::nanoseconds( graph_node.duration ),
+		graph_node.was_run
+	};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::TaskGraph::GetNodeCount() const
+{
+	return nodes.Size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const bc::List<bc::thread::TaskGraph::NodeIndex> & bc::thread::TaskGraph::GetExecutionOrder() const
+{
+	return execution_order;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskGraph::ReleaseNode(
+	internal_::TaskGraphNodeTask	*	node
+)
+{
+	// Successors that cannot be scheduled are completed here as well, they are kept on a stack instead of recursing so that long
+	// chains of disabled nodes cannot overflow the call stack.
+	node->next_released_node = nullptr;
+	auto released_stack = node;
+	while( released_stack )
+	{
+		auto released = released_stack;
+		released_stack = released->next_released_node;
+
+		auto node_index = released->node_index;
+		for( auto s = successor_offsets[ node_index ]; s < successor_offsets[ node_index + 1 ]; ++s )
+		{
+			auto successor = nodes[ successor_indices[ s ] ].Get();
+			if( successor->pending_predecessor_count.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ) continue;
+
+			if( successor->is_enabled && thread_pool->DoAddExternallyOwnedTask( successor, successor->node_priority ) != 0 ) continue;
+			successor->next_released_node = released_stack;
+			released_stack = successor;
+		}
+
+		// Nodes on the stack still hold their own count, this can only complete the execution once the stack is empty.
+		CompleteNode();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskGraph::CompleteNode()
+{
+	if( remaining_node_count.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ) return;
+
+	// After a worker thread exception the thread pool evacuates the sink task instead, which releases it all the same.
+	if( thread_pool->thread_shared_data->thread_exception_raised ) return;
+	sink_task.thread_shared_data->ResumeTask( &sink_task );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskGraph::WaitForPreviousExecution() const
+{
+	while( sink_in_flight.load( std::memory_order_acquire ) )
+	{
+		sink_in_flight.wait( true, std::memory_order_acquire );
+	}
+}
@@ -0,0 +1,132 @@
+
+#include <core/PreCompiledHeader.hpp>
+#include <core/thread/TaskPool.hpp>
+#include <core/thread/WorkerCounters.hpp>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskPool::TaskPool(
+	u64				worker_count
+) :
+	worker_cache_count( worker_count )
+{
+	worker_caches = memory::AllocateMemory<Cache>( worker_count, alignof( Cache ) );
+	for( u64 i = 0; i < worker_count; ++i )
+	{
+		std::construct_at( worker_caches + i );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskPool::~TaskPool()
+{
+	memory::FreeMemory( worker_caches, worker_cache_count );
+	for( auto chunk : chunks )
+	{
+		memory::FreeMemory( chunk, BATCH_SLOT_COUNT * SLOT_SIZE );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::thread::TaskPool::Allocate(
+	u64				cache_index
+)
+{
+	if( cache_index == SHARED_CACHE_INDEX )
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( shared_cache_mutex );
+		return AllocateFromCache( shared_cache );
+	}
+
+	BAssert( cache_index < worker_cache_count, U"Task pool cache index out of range" );
+	return AllocateFromCache( worker_caches[ cache_index ] );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskPool::Free(
+	void		*	slot,
+	u64				cache_index
+)
+{
+	if( cache_index == SHARED_CACHE_INDEX )
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( shared_cache_mutex );
+		FreeToCache( shared_cache, slot );
+		return;
+	}
+
+	BAssert( cache_index < worker_cache_count, U"Task pool cache index out of range" );
+	FreeToCache( worker_caches[ cache_index ], slot );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::thread::TaskPool::AllocateFromCache(
+	Cache		&	cache
+)
+{
+	if( cache.free_slots == nullptr )
+	{
+		cache.free_slots		= TakeBatch();
+		cache.free_slot_count	= BATCH_SLOT_COUNT;
+	}
+
+	auto slot = cache.free_slots;
+	cache.free_slots = slot->next;
+	--cache.free_slot_count;
+	return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskPool::FreeToCache(
+	Cache		&	cache,
+	void		*	slot
+)
+{
+	auto free_slot = static_cast<FreeSlot*>( slot );
+	free_slot->next = cache.free_slots;
+	cache.free_slots = free_slot;
+	++cache.free_slot_count;
+
+	// Tasks are often scheduled on one thread and completed on another, hand surplus slots over to the other threads. Keeping
+	// one batch in reserve avoids moving batches back and forth when the cache hovers around the limit.
+	if( cache.free_slot_count < BATCH_SLOT_COUNT * 2 ) return;
+
+	auto batch = cache.free_slots;
+	auto last = batch;
+	for( u64 i = 1; i < BATCH_SLOT_COUNT; ++i )
+	{
+		last = last->next;
+	}
+	cache.free_slots = last->next;
+	cache.free_slot_count -= BATCH_SLOT_COUNT;
+	last->next = nullptr;
+
+	auto lock_guard = internal_::MeasuredLockGuard( batch_mutex );
+	free_batches.PushBack( batch );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskPool::FreeSlot * bc::thread::TaskPool::TakeBatch()
+{
+	auto lock_guard = internal_::MeasuredLockGuard( batch_mutex );
+
+	if( !free_batches.IsEmpty() )
+	{
+		auto batch = free_batches.Back();
+		free_batches.PopBack();
+		return batch;
+	}
+
+	auto chunk = memory::AllocateMemory<u8>( BATCH_SLOT_COUNT * SLOT_SIZE, SLOT_ALIGNMENT );
+	chunks.PushBack( chunk );
+
+	FreeSlot * batch = nullptr;
+	for( u64 i = BATCH_SLOT_COUNT; i > 0; --i )
+	{
+		auto free_slot = reinterpret_cast<FreeSlot*>( chunk + ( i - 1 ) * SLOT_SIZE );
+		free_slot->next = batch;
+		batch = free_slot;
+	}
+	return batch;
+}
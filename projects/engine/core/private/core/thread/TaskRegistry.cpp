@@ -0,0 +1,110 @@
+
+#include <core/PreCompiledHeader.hpp>
+#include <core/thread/TaskRegistry.hpp>
+#include <core/thread/WorkerCounters.hpp>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskRegistry::Add(
+	Task * task
+)
+{
+	auto & shard = GetShard( task->task_id );
+	auto lock_guard = internal_::MeasuredLockGuard( shard.mutex );
+
+	auto & bucket = GetBucket( shard, task->task_id );
+	if( bucket ) bucket->previous_registered_task = task;
+	task->next_registered_task		= bucket;
+	task->previous_registered_task	= nullptr;
+	bucket = task;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::TaskRegistry::AddBatch(
+	Task	* const	*	tasks,
+	u64					task_count
+)
+{
+	// Consecutive identifiers map to consecutive shards, every SHARD_COUNT:th task lands in the same shard.
+	for( u64 first = 0; first < std::min( task_count, SHARD_COUNT ); ++first )
+	{
+		auto & shard = GetShard( tasks[ first ]->task_id );
+		auto lock_guard = internal_::MeasuredLockGuard( shard.mutex );
+
+		for( u64 i = first; i < task_count; i += SHARD_COUNT )
+		{
+			auto task = tasks[ i ];
+			BAssert( task->task_id == tasks[ 0 ]->task_id + i, U"Task batch identifiers must be consecutive" );
+
+			auto & bucket = GetBucket( shard, task->task_id );
+			if( bucket ) bucket->previous_registered_task = task;
+			task->next_registered_task		= bucket;
+			task->previous_registered_task	= nullptr;
+			bucket = task;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskRegistry::Remove(
+	Task * task
+)
+{
+	auto & shard = GetShard( task->task_id );
+	auto lock_guard = internal_::MeasuredLockGuard( shard.mutex );
+
+	auto & bucket = GetBucket( shard, task->task_id );
+	if( task->previous_registered_task == nullptr && bucket != task ) return false;
+
+	if( task->previous_registered_task )	task->previous_registered_task->next_registered_task = task->next_registered_task;
+	else									bucket = task->next_registered_task;
+	if( task->next_registered_task )		task->next_registered_task->previous_registered_task = task->previous_registered_task;
+
+	task->next_registered_task		= nullptr;
+	task->previous_registered_task	= nullptr;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskRegistry::AddSuccessor(
+	TaskIdentifier			task_id,
+	TaskSuccessorLink	*	link
+)
+{
+	auto & shard = GetShard( task_id );
+	auto lock_guard = internal_::MeasuredLockGuard( shard.mutex );
+
+	auto task = FindTask( shard, task_id );
+	if( task == nullptr ) return false;
+
+	link->next = task->successor_list;
+	task->successor_list = link;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskRegistry::AddWaiter(
+	TaskIdentifier			task_id
+)
+{
+	auto & shard = GetShard( task_id );
+	auto lock_guard = internal_::MeasuredLockGuard( shard.mutex );
+
+	auto task = FindTask( shard, task_id );
+	if( task == nullptr ) return false;
+
+	++task->waiter_count;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::TaskRegistry::Contains(
+	TaskIdentifier			task_id
+)
+{
+	auto & shard = GetShard( task_id );
+	auto lock_guard = internal_::MeasuredLockGuard( shard.mutex );
+
+	return FindTask( shard, task_id ) != nullptr;
+}
@@ -13,9 +13,82 @@
 #include <core/diagnostic/print_record/PrintRecordFactory.hpp>
 
 #include <core/diagnostic/system_console/SystemConsole.hpp>
+#include <core/conversion/text/text_format/TextFormat.hpp>
+
+#include <exception>
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static bc::diagnostic::Exception MakeExceptionFromStlException(
+	const std::exception	&	exception
+)
+{
+	auto report = bc::diagnostic::MakePrintRecord( U"stl exception thrown in thread" );
+	report += bc::diagnostic::MakePrintRecord( U"\n" );
+	report += bc::diagnostic::MakePrintRecord_Argument( U"stl exception message", exception.what() ).AddIndent();
+	return bc::diagnostic::Exception{ report };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Runs a task that has been started on the calling thread and hands it back to the thread shared data according to the result.
+// Returns false if the task raised an exception, the exception has then been reported.
+static bool RunTask(
+	bc::thread::Task				*	task,
+	bc::thread::Thread				&	thread,
+	bc::thread::ThreadIdentifier		thread_id,
+	bc::thread::ThreadSharedData	*	thread_shared_data
+)
+{
+	using namespace bc::thread;
+
+	auto task_execution_result = TaskExecutionResult::ERROR;
+
+	try
+	{
+		task_execution_result = task->ThreadRun( thread );
+	}
+	catch( const bc::diagnostic::Exception & e )
+	{
+		thread_shared_data->ReportException( e, thread_id );
+		return false;
+	}
+	catch( const std::exception & e )
+	{
+		thread_shared_data->ReportException( MakeExceptionFromStlException( e ), thread_id );
+		return false;
+	}
+	catch( ... )
+	{
+		thread_shared_data->ReportException( bc::diagnostic::Exception{ "Unknown exception thrown in thread" }, thread_id );
+		return false;
+	}
+
+	switch( task_execution_result )
+	{
+	case bc::thread::TaskExecutionResult::PAUSED:
+		// Push the task to the back of the injection queue.
+		thread_shared_data->RescheduleTask( task );
+		break;
+
+	case bc::thread::TaskExecutionResult::FINISHED:
+		thread_shared_data->TaskCompleted( task );
+		break;
+
+	case bc::thread::TaskExecutionResult::ERROR:
+		bc::GetCore()->GetLogger()->LogWarning(
+			bc::diagnostic::MakePrintRecord_AssertText(
+				U"Thread task failed",
+				U"Task id", task->GetTaskId(),
+				U"Thread id", thread_id
+			)
+		);
+		thread_shared_data->TaskCompleted( task );
+		break;
+	}
+	return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static void ThreadPoolWorker(
 	bc::thread::ThreadDescription	*	thread_description,
@@ -27,10 +100,11 @@ static void ThreadPoolWorker(
 	assert( thread_description );
 	assert( thread_shared_data );
 
-	auto CleanUpThreadForTermination = [ thread_description ](
+	auto CleanUpThreadForTermination = [ thread_description, thread_shared_data ](
 		WorkerThreadState new_thread_state
 		)
 		{
+			thread_shared_data->UnregisterWorkerThread();
 			thread_description->state			= new_thread_state;
 			thread_description->pool_thread->ThreadEnd();
 			thread_description->ready_to_join	= true;
@@ -38,38 +112,18 @@ static void ThreadPoolWorker(
 
 	auto ReportException = [ thread_shared_data, thread_description ]( const bc::diagnostic::Exception & exception )
 		{
-			// If a thread task raises an exception, we exit the application. It won't happen
-			// immediately however and other threads might run parallel to this thread and need
-			// to be cleaned up, best we can do here is to signal the exception.
-			//
-			// Cleanup is done by the main thread whenever the main thread tries to add a new
-			// task or do a general update. It may take a little while however. Once the main
-			// thread notices that there was an exception, EvacuateThreads() is called which
-			// will join all threads and manually clears the task list.
-
-			auto lock_guard = std::lock_guard( thread_shared_data->thread_exception_mutex );
-
-			if( thread_shared_data->thread_exception_raised ) return;
-			thread_shared_data->thread_exception_raised		= true;
-
-			thread_shared_data->thread_exception			= exception;
-			thread_shared_data->thread_exception_id			= thread_description->thread_id;
-			thread_shared_data->threads_should_exit			= true;
-			thread_shared_data->thread_wakeup.notify_all();
-		};
-
-	auto MakeExceptionFromStlException = []( const std::exception & exception )
-		{
-			auto report = bc::diagnostic::MakePrintRecord( U"stl exception thrown in thread" );
-			report += bc::diagnostic::MakePrintRecord( U"\n" );
-			report += bc::diagnostic::MakePrintRecord_Argument( U"stl exception message", exception.what() ).AddIndent();
-			return bc::diagnostic::Exception{ report };
+			thread_shared_data->ReportException( exception, thread_description->thread_id );
 		};
 
-	auto thread_start_result = [ ReportException, MakeExceptionFromStlException, thread_description ]() -> bool
+	auto thread_start_result = [ ReportException, thread_description ]() -> bool
 		{
 			try
 			{
+				auto default_name = bc::text::TextFormat( "Worker {}", thread_description->thread_id );
+				bc::thread::internal_::ApplyThreadCreateInfo(
+					thread_description->create_info,
+					bc::TextView( default_name.Data(), default_name.Size() )
+				);
 				thread_description->pool_thread->ThreadBegin();
 			}
 			catch( const bc::diagnostic::Exception & e )
@@ -95,95 +149,265 @@ static void ThreadPoolWorker(
 		return;
 	}
 
+	thread_shared_data->RegisterWorkerThread( *thread_description );
 	thread_description->state				= WorkerThreadState::RUNNING;
 
+	auto & counters = thread_shared_data->GetWorkerCounters( thread_description->worker_index );
+	auto GetTimestamp = []()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+		};
+
+	// Time at the end of one task is reused as the time the next lookup starts, busy time includes finding the task.
+	auto timestamp = GetTimestamp();
 	while( !thread_shared_data->threads_should_exit && !thread_description->should_exit )
 	{
 		thread_description->state = WorkerThreadState::RUNNING;
 
-		bool found_work			= false;
-		if( auto task			= thread_shared_data->FindWork( *thread_description ) )
+		auto task = thread_shared_data->FindWork( *thread_description, timestamp );
+		if( !task )
 		{
-			// There's more work to be done, let the other threads know about it too.
-			thread_shared_data->thread_wakeup.notify_all();
-
-			auto task_execution_result = TaskExecutionResult::ERROR;
-
-			try
+			// Announce parking before looking for work one last time, work queued after this wakes us up from Park().
+			auto park_epoch = thread_shared_data->PrepareToPark();
+			timestamp = GetTimestamp();
+			task = thread_shared_data->FindWork( *thread_description, timestamp );
+			if( !task )
 			{
-				task_execution_result = task->ThreadRun( *thread_description->pool_thread );
-			}
-			catch( const bc::diagnostic::Exception & e )
-			{
-				// Breaking makes sure we finish this thread here, this makes sure TaskComplete()
-				// below is not called. If TaskComplete() would be called, the task is removed from
-				// the task list and tasks that might depend on this task may run, we need to make
-				// sure all depending tasks do have an opportunity to run before exiting the
-				// application.
+				if( thread_shared_data->threads_should_exit || thread_description->should_exit )
+				{
+					thread_shared_data->CancelPark();
+					break;
+				}
 
-				ReportException( e );
-				break;
-			}
-			catch( const std::exception & e )
-			{
-				ReportException( MakeExceptionFromStlException( e ) );
-				break;
-			}
-			catch( ... )
-			{
-				ReportException( bc::diagnostic::Exception{ "Unknown exception thrown in thread" } );
-				break;
+				thread_description->state = WorkerThreadState::IDLE;
+				thread_shared_data->Park( park_epoch );
+				auto park_end = GetTimestamp();
+				counters.AddIdleTime( park_end - timestamp );
+				timestamp = park_end;
+				continue;
 			}
+			thread_shared_data->CancelPark();
+		}
 
-			switch( task_execution_result )
-			{
-			case bc::thread::TaskExecutionResult::PAUSED:
-				// Push the task to the bottom of the list.
-				thread_shared_data->RescheduleTask( task );
-				break;
-
-			case bc::thread::TaskExecutionResult::FINISHED:
-				thread_shared_data->TaskCompleted( task );
-				break;
-
-			case bc::thread::TaskExecutionResult::ERROR:
-				bc::GetCore()->GetLogger()->LogWarning(
-					bc::diagnostic::MakePrintRecord_AssertText(
-						U"Thread task failed",
-						U"Task id", task->GetTaskId(),
-						U"Thread id", thread_description->thread_id
-					)
-				);
-				thread_shared_data->TaskCompleted( task );
-				break;
-			}
+		auto run_result = RunTask( task, *thread_description->pool_thread, thread_description->thread_id, thread_shared_data );
+		auto run_end = GetTimestamp();
+		counters.AddBusyTime( run_end - timestamp );
+		timestamp = run_end;
+		if( !run_result )
+		{
+			// Breaking makes sure we finish this thread here, this makes sure TaskComplete()
+			// is not called. If TaskComplete() would be called, the task is removed from
+			// the task list and tasks that might depend on this task may run, we need to make
+			// sure all depending tasks do have an opportunity to run before exiting the
+			// application.
+			break;
+		}
+	}
+
+	CleanUpThreadForTermination( WorkerThreadState::IDLE );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Thread resource handed to tasks run on the main thread.
+class MainThread : public bc::thread::Thread
+{
+public:
+	void ThreadBegin() override {}
+	void ThreadEnd() noexcept override {}
+};
 
-			found_work = true;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Thread resource of the worker threads created by the thread pool itself.
+class WorkerThread : public bc::thread::Thread
+{
+public:
+	void ThreadBegin() override {}
+	void ThreadEnd() noexcept override {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Shared between the thread calling ParallelFor() and the helper tasks. Reference counted as helper tasks may only start after
+// the whole range has been processed and the calling thread has already returned.
+struct ParallelForState
+{
+	std::atomic<bc::u64>							next_index;
+	std::atomic<bc::u64>							processed_count;
+	std::atomic<bc::u64>							reference_count;
+
+	bc::u64											end;
+	bc::u64											total_count;
+	bc::u64											grain_size;
+	bc::u64											participant_count;
+
+	void										( *	chunk_function )( void * user_data, bc::u64 chunk_begin, bc::u64 chunk_end );
+	void										*	user_data;
+
+	std::atomic_bool								exception_raised;
+	std::exception_ptr								exception;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool ClaimParallelForChunk(
+	ParallelForState	&	state,
+	bc::u64				&	out_chunk_begin,
+	bc::u64				&	out_chunk_end
+)
+{
+	auto current = state.next_index.load( std::memory_order_relaxed );
+	while( current < state.end )
+	{
+		// Hand out a share of what is left so chunks get smaller towards the end of the range, large chunks keep the number of
+		// claims low and small chunks at the end let every thread finish at about the same time.
+		auto remaining = state.end - current;
+		auto chunk_size = std::min( remaining, std::max( state.grain_size, remaining / ( state.participant_count * 2 ) ) );
+		if( state.next_index.compare_exchange_weak( current, current + chunk_size, std::memory_order_relaxed ) )
+		{
+			out_chunk_begin	= current;
+			out_chunk_end	= current + chunk_size;
+			return true;
 		}
+	}
+	return false;
+}
 
-		// If we found work previously there might be more waiting, check until we run out of tasks.
-		if( !found_work )
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void MarkParallelForProcessed(
+	ParallelForState	&	state,
+	bc::u64					count
+)
+{
+	if( state.processed_count.fetch_add( count, std::memory_order_acq_rel ) + count == state.total_count )
+	{
+		state.processed_count.notify_all();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void SkipRemainingParallelForChunks(
+	ParallelForState	&	state
+)
+{
+	auto skipped_begin = state.next_index.exchange( state.end, std::memory_order_relaxed );
+	if( skipped_begin < state.end )
+	{
+		MarkParallelForProcessed( state, state.end - skipped_begin );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void RunParallelForParticipant(
+	ParallelForState	&	state
+)
+{
+	bc::u64 chunk_begin = 0;
+	bc::u64 chunk_end = 0;
+	while( ClaimParallelForChunk( state, chunk_begin, chunk_end ) )
+	{
+		try
+		{
+			state.chunk_function( state.user_data, chunk_begin, chunk_end );
+		}
+		catch( ... )
 		{
-			std::unique_lock<std::mutex> unique_lock( thread_shared_data->thread_wakeup_mutex );
-			thread_description->state = WorkerThreadState::IDLE;
-			thread_shared_data->thread_wakeup.wait_for( unique_lock, std::chrono::milliseconds( 10 ) );	// periodically wake up and check for work
+			// First exception is rethrown on the thread that called ParallelFor().
+			if( !state.exception_raised.exchange( true ) ) state.exception = std::current_exception();
+			SkipRemainingParallelForChunks( state );
 		}
+		MarkParallelForProcessed( state, chunk_end - chunk_begin );
 	}
+}
 
-	CleanUpThreadForTermination( WorkerThreadState::IDLE );
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WaitForParallelFor(
+	ParallelForState	&	state
+)
+{
+	auto processed_count = state.processed_count.load( std::memory_order_acquire );
+	while( processed_count != state.total_count )
+	{
+		state.processed_count.wait( processed_count, std::memory_order_acquire );
+		processed_count = state.processed_count.load( std::memory_order_acquire );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void ReleaseParallelForState(
+	ParallelForState	*	state
+)
+{
+	if( state->reference_count.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ) return;
+
+	std::destroy_at( state );
+	bc::memory::FreeMemory( state, 1 );
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper task processing ParallelFor() chunks on a worker thread. Holds a reference to the shared state until destroyed, which
+// also covers helper tasks that are destroyed without ever running.
+class ParallelForTask : public bc::thread::Task
+{
+public:
+	ParallelForTask(
+		ParallelForState						*	shared_state
+	) :
+		parallel_for_state( shared_state )
+	{
+		parallel_for_state->reference_count.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	~ParallelForTask()
+	{
+		ReleaseParallelForState( parallel_for_state );
+	}
+
+	bc::thread::TaskExecutionResult					operator()(
+		bc::thread::Thread						&	thread
+	) override
+	{
+		RunParallelForParticipant( *parallel_for_state );
+		return bc::thread::TaskExecutionResult::FINISHED;
+	}
+
+private:
+	ParallelForState							*	parallel_for_state;
+};
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bc::thread::ThreadPool::ThreadPool(
 	const bc::thread::ThreadPoolCreateInfo & create_info
-)
+) :
+	create_info( create_info )
 {
 	main_thread_id = std::this_thread::get_id();
+	main_thread = MakeUniquePtr<MainThread>();
 
 	thread_shared_data = MakeUniquePtr<ThreadSharedData>();
 	thread_description_list.Reserve( 32 );
+
+	if( create_info.create_worker_threads )
+	{
+		auto worker_thread_count = create_info.worker_thread_count ? create_info.worker_thread_count : GetDefaultWorkerThreadCount();
+
+		// First core is left for the main thread unless there is nothing else to pin to.
+		auto core_processors = create_info.pin_worker_threads ? GetPhysicalCoreProcessors() : List<u32> {};
+		auto first_pinned_core = core_processors.Size() > 1 ? u64( 1 ) : u64( 0 );
+
+		for( u32 i = 0; i < worker_thread_count; ++i )
+		{
+			auto worker_create_info = ThreadCreateInfo {};
+			worker_create_info.priority = create_info.default_thread_create_info.priority;
+			if( !core_processors.IsEmpty() )
+			{
+				auto core_index = first_pinned_core + i % ( core_processors.Size() - first_pinned_core );
+				worker_create_info.processor_affinity.PushBack( core_processors[ core_index ] );
+			}
+			AddThreadWithCreateInfo<WorkerThread>( worker_create_info );
+		}
+	}
 }
 
 
@@ -193,6 +417,9 @@ bc::thread::ThreadPool::~ThreadPool()
 {
 	shutting_down = true;
 
+	// Periodic tasks waiting for their next run would hold up shutting down for up to a whole period, they stop right away.
+	thread_shared_data->FireShutdownTimers();
+
 	auto CheckAndReportThreadException = [ this ]()
 		{
 			auto lock_guard = std::lock_guard( thread_shared_data->thread_exception_mutex );
@@ -210,11 +437,13 @@ bc::thread::ThreadPool::~ThreadPool()
 
 	CheckAndReportThreadException();
 
-	// Wait for all the work to be done.
+	// Wait for all the work to be done, waiting is interrupted if a worker thread raises an exception in which case the
+	// remaining tasks are evacuated. Main thread keeps running its own tasks until then.
+	auto is_main_thread = std::this_thread::get_id() == main_thread_id;
 	while( !thread_shared_data->IsTaskListEmpty() )
 	{
-		thread_shared_data->thread_wakeup.notify_all();
-		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		thread_shared_data->WaitIdle( is_main_thread );
+		if( is_main_thread ) RunMainThreadTasks();
 		CheckAndReportThreadException();
 	}
 	assert( thread_shared_data->IsTaskListEmpty() );
@@ -223,23 +452,11 @@ bc::thread::ThreadPool::~ThreadPool()
 
 	if( !thread_shared_data->thread_exception_raised )
 	{
-		// Signal all threads to exit.
+		// Signal all threads to exit, parked threads are woken up and exit once they notice.
 		thread_shared_data->threads_should_exit	= true;
-
-		// Wait for all threads to be ready for joining.
-		while( !std::all_of( thread_description_list.begin(), thread_description_list.end(), []( auto & thread_description ) -> bool
-			{
-				return thread_description->ready_to_join.load();
-			} ) )
-		{
-
-			// Keep signaling all threads until they're ready to join.
-			thread_shared_data->thread_wakeup.notify_all();
-			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
-		}
+		thread_shared_data->NotifyAllWorkers();
 	}
 
-	// All threads ready to join
 	for( auto & t : thread_description_list )
 	{
 		t->stl_thread.join();
@@ -257,23 +474,33 @@ void bc::thread::ThreadPool::RemoveThread(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bc::u64 bc::thread::ThreadPool::GetTaskQueueCount() const
 {
-	auto lock_guard = std::lock_guard( thread_shared_data->task_list_mutex );
-
-	return thread_shared_data->task_list.Size();
+	return thread_shared_data->GetTaskCount();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bc::u64 bc::thread::ThreadPool::GetTaskRunningCount() const
 {
-	auto lock_guard = std::lock_guard( thread_shared_data->task_list_mutex );
+	return thread_shared_data->GetRunningTaskCount();
+}
 
-	auto result = u64 {};
-	for( auto & t : thread_shared_data->task_list )
-	{
-		if( t->state == TaskState::RUNNING ) ++result;
-	}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::ThreadPoolStatistics bc::thread::ThreadPool::GetStatistics() const
+{
+	return thread_shared_data->GetStatistics();
+}
 
-	return result;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::ResetStatistics()
+{
+	thread_shared_data->ResetStatistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadPool::GetTaskQueueDepth(
+	TaskPriority priority
+) const
+{
+	return thread_shared_data->GetQueuedTaskCount( priority );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -289,8 +516,9 @@ std::thread::id bc::thread::ThreadPool::GetThreadSystemID(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void bc::thread::ThreadPool::Run()
 {
-	thread_shared_data->thread_wakeup.notify_all();
+	BHardAssert( std::this_thread::get_id() == main_thread_id, "Cannot run thread pool, Run() can only be called from the main thread" );
 
+	RunMainThreadTasks();
 	if( thread_shared_data->thread_exception_raised )
 	{
 		CheckAndHandleThreadThrow();
@@ -298,42 +526,256 @@ void bc::thread::ThreadPool::Run()
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void bc::thread::ThreadPool::WaitIdle()
+void bc::thread::ThreadPool::WaitForTask(
+	TaskIdentifier task_id
+)
 {
-	while( !thread_shared_data->IsTaskListEmpty() )
+	auto is_main_thread = std::this_thread::get_id() == main_thread_id;
+	while( true )
+	{
+		thread_shared_data->WaitForTasks( &task_id, 1, is_main_thread );
+		if( thread_shared_data->thread_exception_raised )
+		{
+			CheckAndHandleThreadThrow();
+			return;
+		}
+		if( !is_main_thread || !thread_shared_data->HasMainThreadWork() ) return;
+
+		// Awaited task may depend on main thread tasks, run them and keep waiting.
+		RunMainThreadTasks();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::WaitForTasks(
+	const List<TaskIdentifier> & task_ids
+)
+{
+	auto is_main_thread = std::this_thread::get_id() == main_thread_id;
+	while( true )
 	{
-		thread_shared_data->thread_wakeup.notify_all();
+		thread_shared_data->WaitForTasks( task_ids.Data(), task_ids.Size(), is_main_thread );
+		if( thread_shared_data->thread_exception_raised )
+		{
+			CheckAndHandleThreadThrow();
+			return;
+		}
+		if( !is_main_thread || !thread_shared_data->HasMainThreadWork() ) return;
 
+		RunMainThreadTasks();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::WaitIdle()
+{
+	auto is_main_thread = std::this_thread::get_id() == main_thread_id;
+	while( true )
+	{
+		thread_shared_data->WaitIdle( is_main_thread );
 		if( thread_shared_data->thread_exception_raised )
 		{
 			CheckAndHandleThreadThrow();
+			return;
 		}
+		if( !is_main_thread || !thread_shared_data->HasMainThreadWork() ) break;
 
-		// TODO: Instead of waiting for a time, wait for a signal from any of the worker threads to finish execution.
-		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		RunMainThreadTasks();
 	}
 	assert( thread_shared_data->IsTaskListEmpty() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bc::u64 bc::thread::ThreadPool::DoAddTask(
-	UniquePtr<Task>	&&	new_task
+	Task	*	new_task
 )
 {
 	BHardAssert( !shutting_down, "Failed to schedule task, trying to add tasks while shutting down the thread pool" );
 	if( thread_shared_data->thread_exception_raised )
 	{
+		thread_shared_data->DestroyTask( new_task );
 		return 0;
 	}
 	CheckAndHandleThreadThrow();
 
 	auto task_id = new_task->task_id = ++task_id_counter;
-	thread_shared_data->AddTask( std::move( new_task ) );
-	thread_shared_data->thread_wakeup.notify_one();
+	thread_shared_data->AddTask( new_task );
+
+	return task_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadPool::DoAddExternallyOwnedTask(
+	Task					*	task,
+	TaskPriority				priority,
+	TaskResumeCondition		*	resume_condition
+)
+{
+	if( thread_shared_data->thread_exception_raised ) return 0;
+
+	PrepareExternallyOwnedTask( task, priority, resume_condition );
+	auto task_id = task->task_id = ++task_id_counter;
+	thread_shared_data->AddTask( task );
 
 	return task_id;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskIdentifierRange bc::thread::ThreadPool::DoAddExternallyOwnedTaskBatch(
+	Task	* const	*	tasks,
+	u64					task_count
+)
+{
+	if( thread_shared_data->thread_exception_raised || task_count == 0 ) return {};
+
+	auto task_range = TaskIdentifierRange {};
+	task_range.task_count		= task_count;
+	task_range.first_task_id	= task_id_counter.fetch_add( task_count ) + 1;
+	for( u64 i = 0; i < task_count; ++i )
+	{
+		tasks[ i ]->task_id = task_range.first_task_id + i;
+	}
+
+	thread_shared_data->AddTaskBatch( tasks, task_count );
+	return task_range;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::PrepareExternallyOwnedTask(
+	Task					*	task,
+	TaskPriority				priority,
+	TaskResumeCondition		*	resume_condition
+)
+{
+	task->is_externally_owned		= true;
+	task->state						= TaskState::NOT_STARTED;
+	task->successor_list			= nullptr;
+	task->waiter_count				= 0;
+	task->priority					= priority;
+	task->resume_condition			= resume_condition;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::TaskIdentifierRange bc::thread::ThreadPool::DoAddTaskBatch(
+	List<Task*>	&	new_tasks
+)
+{
+	BHardAssert( !shutting_down, "Failed to schedule tasks, trying to add tasks while shutting down the thread pool" );
+	if( thread_shared_data->thread_exception_raised )
+	{
+		DestroyUnscheduledTasks( new_tasks );
+		return {};
+	}
+	CheckAndHandleThreadThrow();
+	if( new_tasks.IsEmpty() ) return {};
+
+	// Whole batch gets its identifiers with a single atomic operation.
+	auto task_range = TaskIdentifierRange {};
+	task_range.task_count		= new_tasks.Size();
+	task_range.first_task_id	= task_id_counter.fetch_add( task_range.task_count ) + 1;
+	for( u64 i = 0; i < new_tasks.Size(); ++i )
+	{
+		new_tasks[ i ]->task_id = task_range.first_task_id + i;
+	}
+
+	thread_shared_data->AddTaskBatch( new_tasks.Data(), new_tasks.Size() );
+	return task_range;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::DestroyUnscheduledTasks(
+	List<Task*>	&	tasks
+)
+{
+	for( auto task : tasks )
+	{
+		thread_shared_data->DestroyTask( task );
+	}
+	tasks.Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadPool::GetThreadCount() const
+{
+	return thread_count.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::DoParallelFor(
+	TaskPriority				priority,
+	u64							begin,
+	u64							end,
+	u64							grain_size,
+	ParallelForChunkFunction	chunk_function,
+	void					*	user_data
+)
+{
+	if( begin >= end ) return;
+
+	grain_size = std::max<u64>( grain_size, 1 );
+	auto total_count = end - begin;
+	auto chunk_count = ( total_count + grain_size - 1 ) / grain_size;
+	auto helper_count = std::min( GetThreadCount(), chunk_count - 1 );
+	if( helper_count == 0 )
+	{
+		chunk_function( user_data, begin, end );
+		return;
+	}
+
+	auto state = memory::AllocateMemory<ParallelForState>( 1, alignof( ParallelForState ) );
+	std::construct_at( state );
+	state->next_index			= begin;
+	state->processed_count		= 0;
+	state->reference_count		= 1;
+	state->end					= end;
+	state->total_count			= total_count;
+	state->grain_size			= grain_size;
+	state->participant_count	= helper_count + 1;
+	state->chunk_function		= chunk_function;
+	state->user_data			= user_data;
+	state->exception_raised		= false;
+
+	try
+	{
+		for( u64 i = 0; i < helper_count; ++i )
+		{
+			auto helper_task = CreateTask<ParallelForTask>( state );
+			helper_task->priority = priority;
+			DoAddTask( helper_task );
+		}
+	}
+	catch( ... )
+	{
+		// Helper tasks that were scheduled may already be running chunks, they must finish before the callable goes away.
+		SkipRemainingParallelForChunks( *state );
+		WaitForParallelFor( *state );
+		ReleaseParallelForState( state );
+		throw;
+	}
+
+	// Calling thread works on chunks too instead of blocking, then waits for the chunks other threads are still running.
+	RunParallelForParticipant( *state );
+	WaitForParallelFor( *state );
+
+	auto exception = state->exception;
+	ReleaseParallelForState( state );
+	if( exception ) std::rethrow_exception( exception );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::thread::ThreadPool::AllocateTaskSlot()
+{
+	return thread_shared_data->AllocateTaskSlot();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::FreeTaskSlot(
+	void	*	slot
+)
+{
+	thread_shared_data->FreeTaskSlot( slot );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bc::thread::ThreadIdentifier bc::thread::ThreadPool::DoAddThread(
 	UniquePtr<ThreadDescription> && thread_description
@@ -346,6 +788,7 @@ bc::thread::ThreadIdentifier bc::thread::ThreadPool::DoAddThread(
 	thread_description->state			= WorkerThreadState::UNINITIALIZED;
 	thread_description->ready_to_join	= false;
 	thread_description->thread_id		= ++thread_id_counter;
+	thread_description->worker_index	= thread_shared_data->AcquireWorkerQueue();
 	thread_description->stl_thread		= std::thread(
 		ThreadPoolWorker,
 		thread_description.Get(),
@@ -369,6 +812,7 @@ bc::thread::ThreadIdentifier bc::thread::ThreadPool::DoAddThread(
 		diagnostic::Throw( exception );
 	}
 
+	thread_count.fetch_add( 1, std::memory_order_relaxed );
 	return thread_description_ptr->thread_id;
 }
 
@@ -378,7 +822,6 @@ void bc::thread::ThreadPool::DoRemoveThread(
 )
 {
 	BHardAssert( !shutting_down, "Cannot remove thread, trying to remove threads while shutting down the thread pool" );
-	BHardAssert( GetTaskQueueCount() == 0, "Cannot remove thread, threads cannot be removed when there are any tasks queued" );
 	BHardAssert( std::this_thread::get_id() == main_thread_id, "Cannot remove thread, threads can only be removed by the main thread" );
 
 	// Find the thread from thread description list.
@@ -390,16 +833,14 @@ void bc::thread::ThreadPool::DoRemoveThread(
 	);
 	if( thread == thread_description_list.end() ) return;
 
-	// Signal the thread to exit, keep waking up threads until the thread is ready to join.
+	// Signal the thread to exit, parked threads cannot be woken up individually so all of them are woken up.
 	( *thread )->should_exit = true;
-	while( !( *thread )->ready_to_join )
-	{
-		thread_shared_data->thread_wakeup.notify_all();
-		std::this_thread::sleep_for( std::chrono::microseconds( 10 ) );
-	}
+	thread_shared_data->NotifyAllWorkers();
 	( *thread )->stl_thread.join();
 
+	thread_shared_data->ReleaseWorkerQueue( ( *thread )->worker_index );
 	thread_description_list.Erase( thread );
+	thread_count.fetch_sub( 1, std::memory_order_relaxed );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -424,24 +865,34 @@ void bc::thread::ThreadPool::CheckAndHandleThreadThrow()
 	}
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadPool::RunMainThreadTasks()
+{
+	assert( std::this_thread::get_id() == main_thread_id );
+
+	while( !thread_shared_data->thread_exception_raised )
+	{
+		auto task = thread_shared_data->FindMainThreadWork();
+		if( task == nullptr ) return;
+		if( !RunTask( task, *main_thread, MAIN_THREAD_ID, thread_shared_data.Get() ) ) return;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void bc::thread::ThreadPool::EvacuateThreads()
 {
 	BHardAssert( std::this_thread::get_id() == main_thread_id, "Cannot evacuate threads, threads can only be evacuated by the main thread" );
 
 	thread_shared_data->threads_should_exit = true;
-	while( std::any_of( thread_description_list.begin(), thread_description_list.end(), [](const auto & thread_description) { return !thread_description->ready_to_join.load(); }) )
-	{
-		thread_shared_data->thread_wakeup.notify_all();
-		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
-	}
+	thread_shared_data->NotifyAllWorkers();
 
-	// All threads ready to join
 	for( auto & t : thread_description_list )
 	{
 		t->stl_thread.join();
+		thread_shared_data->ReleaseWorkerQueue( t->worker_index );
 	}
 
 	thread_description_list.Clear();
-	thread_shared_data->task_list.Clear();
+	thread_count = 0;
+	thread_shared_data->EvacuateTasks();
 }
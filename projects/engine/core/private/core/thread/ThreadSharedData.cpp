@@ -2,135 +2,1033 @@
 #include <core/PreCompiledHeader.hpp>
 #include <core/thread/ThreadSharedData.hpp>
 #include <core/thread/Task.hpp>
+#include <core/CoreComponent.hpp>
+#include <core/diagnostic/logger/Logger.hpp>
+#include <core/diagnostic/print_record/PrintRecordFactory.hpp>
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Set for worker threads so that tasks scheduled from within a task can be pushed to the worker thread's own deque.
+static thread_local bc::thread::ThreadSharedData	*	current_worker_shared_data			= nullptr;
+static thread_local bc::thread::ThreadDescription	*	current_worker_thread_description	= nullptr;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// How long a priority level may go without being served before it is served ahead of higher priority levels, in nanoseconds.
+static constexpr bc::i64 priority_aging_thresholds[ bc::thread::TASK_PRIORITY_COUNT ] = {
+	0,				// REALTIME, always served first.
+	2'000'000,		// HIGH
+	4'000'000,		// ABOVE_NORMAL
+	8'000'000,		// NORMAL
+	16'000'000,		// BELOW_NORMAL
+	50'000'000,		// LOW
+	100'000'000,	// BACKGROUND
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static bc::i64 GetTimestamp()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::ThreadSharedData::~ThreadSharedData()
+{
+	EvacuateTasks();
+
+	for( auto & worker_queue : worker_queues )
+	{
+		auto queue = worker_queue.load();
+		if( queue == nullptr ) continue;
+
+		std::destroy_at( queue );
+		memory::FreeMemory( queue, 1 );
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bc::thread::Task * bc::thread::ThreadSharedData::FindWork(
-	bc::thread::ThreadDescription	&	thread_description
+	bc::thread::ThreadDescription	&	thread_description,
+	i64									timestamp
 )
 {
-	std::lock_guard<std::mutex> lock_guard( task_list_mutex );
+	if( timestamp >= next_timer_deadline.load( std::memory_order_relaxed ) )
+	{
+		FireExpiredTimers( timestamp );
+	}
+
+	// Only tasks whose dependencies have all completed are ever queued, any task found here can be run immediately.
+	auto & own_queues = *worker_queues[ thread_description.worker_index ].load( std::memory_order_acquire );
 
-	auto it = task_list.begin();
-	while( it != task_list.end() )
+	// Tasks locked to this thread can only be run by us, other threads never see them.
+	if( auto task = own_queues.mailbox.Pop() )
 	{
-		auto task = it->Get();
+		own_queues.counters.AddQueueLatency( timestamp - task->queued_timestamp );
+		MarkTaskRunning( task, thread_description.thread_id );
+		return task;
+	}
+
+	Task * task = nullptr;
 
-		// Check to see if the task is already running.
-		if( task->GetState() == TaskState::RUNNING )
+	// Aging, serve the lowest priority level that has waited past its threshold first.
+	for( u64 priority_index = TASK_PRIORITY_COUNT - 1; priority_index > 0; --priority_index )
+	{
+		auto & priority_level = priority_levels[ priority_index ];
+		if( priority_level.queued_task_count.load( std::memory_order_relaxed ) == 0 ) continue;
+		if( timestamp - priority_level.last_served_time.load( std::memory_order_relaxed ) < priority_aging_thresholds[ priority_index ] ) continue;
+
+		if( FindWorkAtPriority( own_queues, thread_description.worker_index, priority_index, task ) )
 		{
-			++it;
-			continue;
+			StartTask( task, thread_description, timestamp );
+			return task;
 		}
+	}
 
-		// Check if this thread is allowed to run this code
-		if( task->IsThreadLocked() )
+	for( u64 priority_index = 0; priority_index < TASK_PRIORITY_COUNT; ++priority_index )
+	{
+		if( priority_levels[ priority_index ].queued_task_count.load( std::memory_order_relaxed ) == 0 ) continue;
+
+		if( FindWorkAtPriority( own_queues, thread_description.worker_index, priority_index, task ) )
+		{
+			StartTask( task, thread_description, timestamp );
+			return task;
+		}
+	}
+
+	// No work available
+	own_queues.counters.AddFailedLookup();
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::Task * bc::thread::ThreadSharedData::FindMainThreadWork()
+{
+	auto task = main_thread_mailbox.Pop();
+	if( task ) MarkTaskRunning( task, MAIN_THREAD_ID );
+	return task;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::HasMainThreadWork() const
+{
+	return main_thread_mailbox.GetTaskCount() > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::TaskCompleted(
+	bc::thread::Task	*	task
+)
+{
+	// Once removed from the registry no more successors can be added to the task. Successors are queued as soon as their last
+	// dependency completes, on a worker thread they go to the worker's own deque.
+	task_registry.Remove( task );
+	auto has_waiters = task->waiter_count > 0;
+
+	auto link = task->successor_list;
+	while( link )
+	{
+		auto next = link->next;
+		auto successor = link->successor;
+		if( successor->pending_dependency_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
 		{
-			if( std::none_of( task->GetThreadLocks().begin(), task->GetThreadLocks().end(),
-				[ &thread_description, &task ]( ThreadIdentifier thread_lock_id )
+			QueueTask( successor );
+		}
+		link = next;
+	}
+	DestroyTask( task );
+
+	running_task_count.fetch_sub( 1, std::memory_order_relaxed );
+	auto remaining_task_count = task_count.fetch_sub( 1, std::memory_order_seq_cst ) - 1;
+
+	// Waking up waiting threads is only done when someone is known to be waiting for this exact event.
+	if( has_waiters || ( remaining_task_count == 0 && idle_waiter_count.load( std::memory_order_seq_cst ) > 0 ) )
+	{
+		NotifyTaskWaiters();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::NotifyWork()
+{
+	// Pairs with the fence in PrepareToPark(), either the parking worker thread sees the queued work when it looks for work the
+	// last time, or we see the worker thread as parked here.
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	// Notifying a condition variable is a system call when there are waiters, skip it when every worker thread is busy.
+	if( parked_thread_count.load( std::memory_order_relaxed ) == 0 ) return;
+
+	park_epoch.fetch_add( 1, std::memory_order_seq_cst );
+	{
+		// Worker thread may have checked the epoch but not yet started waiting, taking the lock makes sure it has.
+		auto lock_guard = internal_::MeasuredLockGuard( park_mutex );
+	}
+	park_condition.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::NotifyWorkers(
+	u64		worker_count
+)
+{
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	auto parked_count = parked_thread_count.load( std::memory_order_relaxed );
+	if( parked_count == 0 || worker_count == 0 ) return;
+
+	park_epoch.fetch_add( 1, std::memory_order_seq_cst );
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( park_mutex );
+	}
+	if( worker_count >= parked_count )
+	{
+		park_condition.notify_all();
+		return;
+	}
+	for( u64 i = 0; i < worker_count; ++i )
+	{
+		park_condition.notify_one();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::NotifyAllWorkers()
+{
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	park_epoch.fetch_add( 1, std::memory_order_seq_cst );
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( park_mutex );
+	}
+	park_condition.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadSharedData::PrepareToPark()
+{
+	parked_thread_count.fetch_add( 1, std::memory_order_seq_cst );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	return park_epoch.load( std::memory_order_seq_cst );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::CancelPark()
+{
+	parked_thread_count.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::Park(
+	u64		prepared_park_epoch
+)
+{
+	{
+		auto is_notified = [ this, prepared_park_epoch ]()
 			{
-				return thread_description.thread_id == thread_lock_id;
-			} ) )
+				return park_epoch.load( std::memory_order_seq_cst ) != prepared_park_epoch;
+			};
+
+		// Timers added after this point advance the park epoch, the deadline read here can only be replaced by an earlier one
+		// through a notification. Only one parked worker thread waits for the earliest deadline, a worker thread parking with an
+		// earlier deadline than the one being watched takes over.
+		auto unique_lock = std::unique_lock( park_mutex );
+		while( !is_notified() )
+		{
+			auto deadline = next_timer_deadline.load( std::memory_order_seq_cst );
+			if( deadline >= watched_timer_deadline )
 			{
-				++it;
+				park_condition.wait( unique_lock );
 				continue;
 			}
+
+			watched_timer_deadline = deadline;
+			auto wakeup_time = std::chrono::steady_clock::time_point( std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::nanoseconds( deadline ) ) );
+			auto wait_status = park_condition.wait_until( unique_lock, wakeup_time );
+			if( watched_timer_deadline != deadline ) continue;
+
+			watched_timer_deadline = std::numeric_limits<i64>::max();
+			if( wait_status == std::cv_status::timeout ) break;
+
+			// Notified while watching the timers, hand the watch over to another parked worker thread before leaving.
+			if( is_notified() && parked_thread_count.load( std::memory_order_relaxed ) > 1 ) park_condition.notify_one();
 		}
+	}
+	parked_thread_count.fetch_sub( 1, std::memory_order_relaxed );
+}
 
-		// Look for dependencies, if task is depending on another task that isn't yet finished we should not execute it.
-		// Finished tasks are removed from task_list.
-		const auto & dependencies = task->GetDependencies();
-		if( std::any_of( task_list.begin(), task_list.end(), [ &dependencies ](
-			UniquePtr<Task> & t )
-		{
-			return std::any_of( dependencies.begin(), dependencies.end(), [ &t ]( u64 task_dependency )
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::HasQueuedWork() const
+{
+	for( auto & priority_level : priority_levels )
+	{
+		if( priority_level.queued_task_count.load( std::memory_order_relaxed ) > 0 ) return true;
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::WaitForTasks(
+	const TaskIdentifier	*	task_ids,
+	u64							task_id_count,
+	bool						wake_for_main_thread_work
+)
+{
+	// Registering as a waiter makes the task signal us when it completes. Tasks that are no longer registered have completed.
+	for( u64 i = 0; i < task_id_count; ++i )
+	{
+		task_registry.AddWaiter( task_ids[ i ] );
+	}
+
+	auto unique_lock = std::unique_lock( task_waiter_mutex );
+	for( u64 i = 0; i < task_id_count; ++i )
+	{
+		auto task_id = task_ids[ i ];
+		task_waiter_condition.wait( unique_lock, [ this, task_id, wake_for_main_thread_work ]()
 			{
-				return t->GetTaskId() == task_dependency;
-			} );
-		} ) )
+				return
+					thread_exception_raised.load() ||
+					( wake_for_main_thread_work && main_thread_mailbox.GetTaskCount() > 0 ) ||
+					!task_registry.Contains( task_id );
+			}
+		);
+		if( thread_exception_raised ) return;
+		if( wake_for_main_thread_work && main_thread_mailbox.GetTaskCount() > 0 ) return;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::WaitIdle(
+	bool		wake_for_main_thread_work
+)
+{
+	// Pairs with the task count decrement in TaskCompleted(), either we see the task count reach zero or the last task to
+	// complete sees us waiting.
+	idle_waiter_count.fetch_add( 1, std::memory_order_seq_cst );
+	{
+		auto unique_lock = std::unique_lock( task_waiter_mutex );
+		task_waiter_condition.wait( unique_lock, [ this, wake_for_main_thread_work ]()
+			{
+				return
+					thread_exception_raised.load() ||
+					( wake_for_main_thread_work && main_thread_mailbox.GetTaskCount() > 0 ) ||
+					task_count.load( std::memory_order_seq_cst ) == 0;
+			}
+		);
+	}
+	idle_waiter_count.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::NotifyTaskWaiters()
+{
+	{
+		// Waiting thread may have checked its condition but not yet started waiting, taking the lock makes sure it has.
+		auto lock_guard = std::lock_guard( task_waiter_mutex );
+	}
+	task_waiter_condition.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::WorkerCounters & bc::thread::ThreadSharedData::GetWorkerCounters(
+	u64		worker_index
+)
+{
+	return worker_queues[ worker_index ].load( std::memory_order_acquire )->counters;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::thread::ThreadPoolStatistics bc::thread::ThreadSharedData::GetStatistics() const
+{
+	auto statistics = ThreadPoolStatistics {};
+	auto total_values = WorkerCounterValues {};
+
+	auto count = worker_queue_count.load( std::memory_order_acquire );
+	for( u64 i = 0; i < count; ++i )
+	{
+		auto queues = worker_queues[ i ].load( std::memory_order_acquire );
+		if( queues == nullptr ) continue;
+
+		// Released worker queues keep their counters until reused, only worker threads still running are reported.
+		auto thread_id = queues->thread_id.load( std::memory_order_acquire );
+		if( thread_id == 0 ) continue;
+
+		auto values = queues->counters.Read();
+		statistics.worker_threads.PushBack( values.ToStatistics( thread_id ) );
+		total_values += values;
+	}
+	statistics.total = total_values.ToStatistics( 0 );
+	return statistics;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::ResetStatistics()
+{
+	auto count = worker_queue_count.load( std::memory_order_acquire );
+	for( u64 i = 0; i < count; ++i )
+	{
+		if( auto queues = worker_queues[ i ].load( std::memory_order_acquire ) ) queues->counters.Reset();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::ReportException(
+	const diagnostic::Exception		&	exception,
+	ThreadIdentifier					thread_id
+)
+{
+	// If a task raises an exception, we exit the application. It won't happen immediately however and other threads might run
+	// parallel to this thread and need to be cleaned up, best we can do here is to signal the exception.
+	//
+	// Cleanup is done by the main thread whenever the main thread tries to add a new task or do a general update. It may take a
+	// little while however. Once the main thread notices that there was an exception, EvacuateThreads() is called which will
+	// join all threads and manually clears the task list.
+
+	auto lock_guard = std::lock_guard( thread_exception_mutex );
+
+	if( thread_exception_raised ) return;
+	thread_exception_raised		= true;
+
+	thread_exception			= exception;
+	thread_exception_id			= thread_id;
+	threads_should_exit			= true;
+	NotifyAllWorkers();
+	NotifyTaskWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::IsTaskListEmpty() const
+{
+	return task_count.load( std::memory_order_acquire ) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadSharedData::GetTaskCount() const
+{
+	return task_count.load( std::memory_order_acquire );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadSharedData::GetRunningTaskCount() const
+{
+	return running_task_count.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadSharedData::GetQueuedTaskCount(
+	TaskPriority		priority
+) const
+{
+	return priority_levels[ u64( priority ) ].queued_task_count.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::AddTask(
+	Task	*	new_task
+)
+{
+	assert( !thread_exception_raised );
+	if( thread_exception_raised )
+	{
+		DestroyTask( new_task );
+		return;
+	}
+
+	task_count.fetch_add( 1, std::memory_order_relaxed );
+	task_registry.Add( new_task );
+	if( LinkDependencies( new_task ) )
+	{
+		QueueTask( new_task );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::AddTaskBatch(
+	Task	* const	*	new_tasks,
+	u64					new_task_count
+)
+{
+	assert( !thread_exception_raised );
+	if( thread_exception_raised )
+	{
+		for( u64 i = 0; i < new_task_count; ++i ) DestroyTask( new_tasks[ i ] );
+		return;
+	}
+
+	task_count.fetch_add( new_task_count, std::memory_order_relaxed );
+	task_registry.AddBatch( new_tasks, new_task_count );
+
+	// Ready tasks are chained newest first per priority level, the same order the injection queues store them in.
+	struct ReadyChain
+	{
+		Task						*	newest					= nullptr;
+		Task						*	oldest					= nullptr;
+		u64								count					= 0;
+	};
+	ReadyChain ready_chains[ TASK_PRIORITY_COUNT ];
+	u64 ready_count = 0;
+	auto timestamp = GetTimestamp();
+
+	for( u64 i = 0; i < new_task_count; ++i )
+	{
+		auto task = new_tasks[ i ];
+		if( !LinkDependencies( task ) ) continue;
+
+		if( task->IsThreadLocked() )
 		{
-			// Task is depending on some other previous task in the queue
-			++it;
+			QueueThreadLockedTask( task );
 			continue;
 		}
 
-		// TODO: Implement priority checking. This could be done by adding this job to a candidate list, then doing another loop
-		// over the candidate list to see which task has the highest priority.
+		auto & chain = ready_chains[ u64( task->priority ) ];
+		task->queued_timestamp = timestamp;
+		task->next_queued_task = chain.newest;
+		chain.newest = task;
+		if( chain.oldest == nullptr ) chain.oldest = task;
+		++chain.count;
+		++ready_count;
+	}
 
-		// Task is able to be run by the calling thread, set it active and return pointer to it.
-		task->state = TaskState::RUNNING;
-		return task;
+	auto use_own_queue = current_worker_shared_data == this;
+	for( u64 priority_index = 0; priority_index < TASK_PRIORITY_COUNT; ++priority_index )
+	{
+		auto & chain = ready_chains[ priority_index ];
+		if( chain.count == 0 ) continue;
+
+		auto & priority_level = priority_levels[ priority_index ];
+		if( priority_level.queued_task_count.fetch_add( chain.count, std::memory_order_relaxed ) == 0 )
+		{
+			priority_level.last_served_time.store( timestamp, std::memory_order_relaxed );
+		}
+
+		if( use_own_queue )
+		{
+			// Own deque is not shared with other pushers, pushing one by one costs no more than linking the chain. Oldest first
+			// so that other worker threads steal the oldest tasks.
+			auto & own_queue = worker_queues[ current_worker_thread_description->worker_index ].load( std::memory_order_relaxed )->priority_queues[ priority_index ];
+			Task * oldest_first = nullptr;
+			for( auto task = chain.newest; task; )
+			{
+				auto next = task->next_queued_task;
+				task->next_queued_task = oldest_first;
+				oldest_first = task;
+				task = next;
+			}
+			while( oldest_first )
+			{
+				auto next = oldest_first->next_queued_task;
+				oldest_first->next_queued_task = nullptr;
+				own_queue.Push( oldest_first );
+				oldest_first = next;
+			}
+		}
+		else
+		{
+			injection_queues[ priority_index ].PushChain( chain.newest, chain.oldest );
+		}
 	}
 
-	// No work available
-	return nullptr;
+	NotifyWorkers( ready_count );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void bc::thread::ThreadSharedData::TaskCompleted(
-	bc::thread::Task	*	task
+void bc::thread::ThreadSharedData::RescheduleTask(
+	Task * task
+)
+{
+	assert( !thread_exception_raised );
+
+	task->running_thread_id			= {};
+	task->running_thread_system_id	= {};
+	task->state						= TaskState::PAUSED;
+	running_task_count.fetch_sub( 1, std::memory_order_relaxed );
+
+	// Dependencies added with Task::AddDependencyAtRuntime(), if any are still running the last one to complete queues the task.
+	if( !LinkDependencies( task ) ) return;
+
+	// Rescheduled tasks go to the back of the line instead of the calling worker thread's own deque so that the worker thread
+	// does not immediately pick the same task up again.
+	QueueTask( task, false );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::ResumeTask(
+	Task * task
+)
+{
+	if( task->pending_dependency_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+	{
+		QueueTask( task, false );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::AddTimer(
+	Task	*	task
 )
 {
-	std::lock_guard<std::mutex> lock_guard( task_list_mutex );
-	auto it = task_list.begin();
-	while( it != task_list.end() )
+	auto timestamp = GetTimestamp();
+	if( task->resume_deadline <= timestamp )
 	{
-		if( it->Get() == task )
+		task->resume_deadline = 0;
+		return false;
+	}
+
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( timer_mutex );
+		if( task->ends_on_shutdown && are_shutdown_timers_fired )
 		{
-			task_list.Erase( it );
-			return;
+			task->resume_deadline = 0;
+			return false;
 		}
-		++it;
+		timer_wheel.Add( task, timestamp );
+		auto next_deadline = timer_wheel.GetNextDeadline();
+		if( next_deadline >= next_timer_deadline.load( std::memory_order_relaxed ) ) return true;
+
+		next_timer_deadline.store( next_deadline, std::memory_order_seq_cst );
 	}
+
+	// Parked worker threads sleep until the previous earliest deadline, one of them needs to wake up earlier now.
+	NotifyWork();
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool bc::thread::ThreadSharedData::IsTaskListEmpty()
+void bc::thread::ThreadSharedData::FireShutdownTimers()
 {
-	std::lock_guard<std::mutex> lock_guard( task_list_mutex );
-	return task_list.IsEmpty();
+	Task * expired_task = nullptr;
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( timer_mutex );
+		are_shutdown_timers_fired = true;
+		expired_task = timer_wheel.TakeIf( []( const Task & task ) { return task.ends_on_shutdown; } );
+		next_timer_deadline.store( timer_wheel.GetNextDeadline(), std::memory_order_seq_cst );
+	}
+
+	while( expired_task )
+	{
+		auto next_expired_task = expired_task->next_queued_task;
+		ResumeTask( expired_task );
+		expired_task = next_expired_task;
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void bc::thread::ThreadSharedData::AddTask(
-	UniquePtr<Task>	&&	new_task )
+bc::u64 bc::thread::ThreadSharedData::AcquireWorkerQueue()
 {
-	assert( !thread_exception_raised );
-	if( thread_exception_raised ) return;
+	if( !free_worker_queue_indices.IsEmpty() )
+	{
+		auto worker_index = free_worker_queue_indices.Back();
+		free_worker_queue_indices.PopBack();
+		return worker_index;
+	}
+
+	auto worker_index = worker_queue_count.load( std::memory_order_relaxed );
+	BHardAssert( worker_index < MAX_WORKER_THREAD_COUNT, U"Cannot add thread, maximum number of worker threads reached" );
+
+	auto queues = memory::AllocateMemory<WorkerQueues>( 1, alignof( WorkerQueues ) );
+	std::construct_at( queues );
+	worker_queues[ worker_index ].store( queues, std::memory_order_release );
+	worker_queue_count.store( worker_index + 1, std::memory_order_release );
 
-	std::lock_guard<std::mutex> lock_guard( task_list_mutex );
-	task_list.EmplaceBack( std::move( new_task ) );
+	return worker_index;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void bc::thread::ThreadSharedData::RescheduleTask(
-	Task * task
+void bc::thread::ThreadSharedData::ReleaseWorkerQueue(
+	u64		worker_index
 )
 {
-	assert( !thread_exception_raised );
-	if( thread_exception_raised ) return;
+	// Worker thread has been joined but tasks may still be left in its deques, hand them over to the other worker threads.
+	auto & queues = *worker_queues[ worker_index ].load( std::memory_order_acquire );
+	u64 handed_over_count = 0;
+	for( u64 priority_index = 0; priority_index < TASK_PRIORITY_COUNT; ++priority_index )
+	{
+		Task * task = nullptr;
+		while( queues.priority_queues[ priority_index ].Steal( task ) )
+		{
+			injection_queues[ priority_index ].Push( task );
+			++handed_over_count;
+		}
+	}
+	NotifyWorkers( handed_over_count );
 
-	std::lock_guard<std::mutex> lock_guard( task_list_mutex );
+	// No new tasks are delivered to the mailbox once the thread id is cleared, deliveries that started before that are waited
+	// for. Tasks left in the mailbox go to other threads they are locked to, or fail if there are none, so that their
+	// successors and waiters are released.
+	queues.thread_id.store( 0, std::memory_order_seq_cst );
+	while( queues.mailbox_delivery_count.load( std::memory_order_seq_cst ) != 0 )
+	{
+		std::this_thread::yield();
+	}
+	while( auto task = queues.mailbox.Pop() )
+	{
+		QueueThreadLockedTask( task );
+	}
+
+	free_worker_queue_indices.PushBack( worker_index );
+}
 
-	auto it = task_list.begin();
-	while( it != task_list.end() )
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::RegisterWorkerThread(
+	ThreadDescription	&	thread_description
+)
+{
+	current_worker_shared_data			= this;
+	current_worker_thread_description	= &thread_description;
+
+	auto & counters = GetWorkerCounters( thread_description.worker_index );
+	counters.Reset();
+	internal_::SetCurrentWorkerCounters( &counters );
+
+	worker_queues[ thread_description.worker_index ].load( std::memory_order_acquire )->thread_id.store( thread_description.thread_id, std::memory_order_release );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::UnregisterWorkerThread()
+{
+	current_worker_shared_data			= nullptr;
+	current_worker_thread_description	= nullptr;
+	internal_::SetCurrentWorkerCounters( nullptr );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::EvacuateTasks()
+{
+	// Tasks are destroyed through the registry, queues only hold pointers to the same tasks.
+	for( u64 priority_index = 0; priority_index < TASK_PRIORITY_COUNT; ++priority_index )
 	{
-		if( it->Get() != task )
+		injection_queues[ priority_index ].PopAll();
+		priority_levels[ priority_index ].queued_task_count = 0;
+		for( u64 i = 0; i < worker_queue_count.load(); ++i )
 		{
-			++it;
-			continue;
+			worker_queues[ i ].load()->priority_queues[ priority_index ].Clear();
+		}
+	}
+	for( u64 i = 0; i < worker_queue_count.load(); ++i )
+	{
+		worker_queues[ i ].load()->mailbox.Clear();
+	}
+	main_thread_mailbox.Clear();
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( timer_mutex );
+		timer_wheel.Clear();
+		next_timer_deadline = std::numeric_limits<i64>::max();
+	}
+
+	task_registry.RemoveAll( [ this ]( Task * task ) { DestroyTask( task ); } );
+
+	running_task_count	= 0;
+	task_count			= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void * bc::thread::ThreadSharedData::AllocateTaskSlot()
+{
+	return task_pool.Allocate( GetTaskPoolCacheIndex() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::FreeTaskSlot(
+	void	*	slot
+)
+{
+	task_pool.Free( slot, GetTaskPoolCacheIndex() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::DestroyTask(
+	Task	*	task
+)
+{
+	if( task->is_externally_owned )
+	{
+		task->OnReleasedByThreadPool();
+		return;
+	}
+
+	auto allocated_from_task_pool = task->allocated_from_task_pool;
+	std::destroy_at( task );
+
+	// Completed tasks are usually destroyed by a worker thread, the slot goes to that worker thread's own cache.
+	if( allocated_from_task_pool )	FreeTaskSlot( task );
+	else							memory::FreeMemory( task, 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::FireExpiredTimers(
+	i64		timestamp
+)
+{
+	Task * expired_task = nullptr;
+	{
+		auto lock_guard = internal_::MeasuredLockGuard( timer_mutex );
+		expired_task = timer_wheel.Advance( timestamp );
+		next_timer_deadline.store( timer_wheel.GetNextDeadline(), std::memory_order_seq_cst );
+	}
+
+	// Resumed outside the lock, queueing may wake up other worker threads which then look at the timers as well. Expired
+	// tasks are linked through the queue link which queueing overwrites.
+	while( expired_task )
+	{
+		auto next_expired_task = expired_task->next_queued_task;
+		ResumeTask( expired_task );
+		expired_task = next_expired_task;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bc::u64 bc::thread::ThreadSharedData::GetTaskPoolCacheIndex() const
+{
+	if( current_worker_shared_data == this ) return current_worker_thread_description->worker_index;
+	return TaskPool::SHARED_CACHE_INDEX;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::LinkDependencies(
+	Task	*	task
+)
+{
+	auto & dependencies = task->dependencies;
+	auto first_dependency = task->linked_dependency_count;
+	auto resume_condition = task->resume_condition;
+	auto has_resume_deadline = task->resume_deadline != 0;
+	if( first_dependency == dependencies.Size() && resume_condition == nullptr && !has_resume_deadline ) return true;
+
+	// Pending count starts at one so that dependencies completing while we are still linking cannot queue the task early.
+	task->pending_dependency_count.store( 1, std::memory_order_relaxed );
+
+	if( first_dependency != dependencies.Size() )
+	{
+		// Links from previous runs are no longer referenced, every dependency they were linked to has completed.
+		task->successor_links.Clear();
+		task->successor_links.Resize( dependencies.Size() - first_dependency );
+		task->linked_dependency_count = dependencies.Size();
+
+		for( u64 i = first_dependency; i < dependencies.Size(); ++i )
+		{
+			auto & link = task->successor_links[ i - first_dependency ];
+			link.successor = task;
+
+			task->pending_dependency_count.fetch_add( 1, std::memory_order_relaxed );
+			if( !task_registry.AddSuccessor( dependencies[ i ], &link ) )
+			{
+				// Dependency has already completed, or never existed.
+				task->pending_dependency_count.fetch_sub( 1, std::memory_order_relaxed );
+			}
+		}
+	}
+
+	if( resume_condition )
+	{
+		// Condition counts as one more dependency, it calls ResumeTask() when met.
+		task->resume_condition = nullptr;
+		task->pending_dependency_count.fetch_add( 1, std::memory_order_relaxed );
+		if( !resume_condition->Arm( *this, *task ) )
+		{
+			task->pending_dependency_count.fetch_sub( 1, std::memory_order_relaxed );
+		}
+	}
+	if( has_resume_deadline )
+	{
+		// Deadline counts as one more dependency as well, the timer wheel calls ResumeTask() when it expires.
+		task->pending_dependency_count.fetch_add( 1, std::memory_order_relaxed );
+		if( !AddTimer( task ) )
+		{
+			task->pending_dependency_count.fetch_sub( 1, std::memory_order_relaxed );
 		}
+	}
+	return task->pending_dependency_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::FindWorkAtPriority(
+	WorkerQueues				&	own_queues,
+	u64								own_worker_index,
+	u64								priority_index,
+	Task						*&	out_task
+)
+{
+	auto & own_queue = own_queues.priority_queues[ priority_index ];
+	if( own_queue.Pop( out_task ) || TakeInjectedWork( own_queue, injection_queues[ priority_index ], out_task ) ) return true;
+	if( !StealWork( own_worker_index, priority_index, out_task ) ) return false;
+
+	own_queues.counters.AddSteal();
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::TakeInjectedWork(
+	WorkStealingDeque<Task*>	&	own_queue,
+	TaskInjectionQueue			&	injection_queue,
+	Task						*&	out_task
+)
+{
+	auto task = injection_queue.PopAll();
+	if( task == nullptr ) return false;
+
+	// Run the oldest task, the rest are moved to our own deque where other worker threads can steal them.
+	out_task = task;
+	task = task->next_queued_task;
+	while( task )
+	{
+		auto next = task->next_queued_task;
+		task->next_queued_task = nullptr;
+		own_queue.Push( task );
+		task = next;
+	}
+	out_task->next_queued_task = nullptr;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool bc::thread::ThreadSharedData::StealWork(
+	u64							own_worker_index,
+	u64							priority_index,
+	Task					*&	out_task
+)
+{
+	auto count = worker_queue_count.load( std::memory_order_acquire );
+	for( u64 i = 1; i < count; ++i )
+	{
+		auto victim = worker_queues[ ( own_worker_index + i ) % count ].load( std::memory_order_acquire );
+		if( victim && victim->priority_queues[ priority_index ].Steal( out_task ) ) return true;
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::StartTask(
+	Task				*	task,
+	ThreadDescription	&	thread_description,
+	i64						timestamp
+)
+{
+	auto & priority_level = priority_levels[ u64( task->priority ) ];
+	priority_level.queued_task_count.fetch_sub( 1, std::memory_order_relaxed );
+	priority_level.last_served_time.store( timestamp, std::memory_order_relaxed );
+
+	worker_queues[ thread_description.worker_index ].load( std::memory_order_relaxed )->counters.AddQueueLatency( timestamp - task->queued_timestamp );
+	MarkTaskRunning( task, thread_description.thread_id );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::MarkTaskRunning(
+	Task				*	task,
+	ThreadIdentifier		thread_id
+)
+{
+	task->running_thread_id			= thread_id;
+	task->running_thread_system_id	= std::this_thread::get_id();
+	task->state						= TaskState::RUNNING;
+	running_task_count.fetch_add( 1, std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::QueueTask(
+	Task	*	task,
+	bool		allow_own_queue
+)
+{
+	if( task->IsThreadLocked() )
+	{
+		QueueThreadLockedTask( task );
+		return;
+	}
+
+	auto timestamp = GetTimestamp();
+	task->queued_timestamp = timestamp;
+
+	// Counted before the task becomes visible so that worker threads never skip a level that has tasks in it. A level that was
+	// empty starts aging from now rather than from whenever it was last served.
+	auto priority_index = u64( task->priority );
+	auto & priority_level = priority_levels[ priority_index ];
+	if( priority_level.queued_task_count.fetch_add( 1, std::memory_order_relaxed ) == 0 )
+	{
+		priority_level.last_served_time.store( timestamp, std::memory_order_relaxed );
+	}
+
+	if( allow_own_queue && current_worker_shared_data == this )
+	{
+		auto & own_queues = *worker_queues[ current_worker_thread_description->worker_index ].load( std::memory_order_relaxed );
+		own_queues.priority_queues[ priority_index ].Push( task );
+	}
+	else
+	{
+		injection_queues[ priority_index ].Push( task );
+	}
+
+	NotifyWork();
+}
 
-		auto moved_task = std::move( *it );
-		task_list.Erase( it );
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::ThreadSharedData::QueueThreadLockedTask(
+	Task	*	task
+)
+{
+	task->queued_timestamp = GetTimestamp();
 
-		moved_task->running_thread_id	= {};
-		moved_task->state				= TaskState::PAUSED;
+	auto & thread_locks = task->GetThreadLocks();
+	if( std::find( thread_locks.begin(), thread_locks.end(), MAIN_THREAD_ID ) != thread_locks.end() )
+	{
+		BAssert( thread_locks.Size() == 1, U"Task locked to the main thread cannot be locked to other threads" );
+		main_thread_mailbox.Push( task );
 
-		task_list.PushBack( std::move( moved_task ) );
+		// Main thread may be blocked waiting for tasks, it runs its own tasks while waiting.
+		NotifyTaskWaiters();
 		return;
 	}
 
-	assert( 0 && "Should not get here, task was not found in the task list while rescheduling it" );
+	auto count = worker_queue_count.load( std::memory_order_acquire );
+	while( true )
+	{
+		WorkerQueues * target = nullptr;
+		ThreadIdentifier target_thread_id = 0;
+		auto target_task_count = std::numeric_limits<u64>::max();
+		for( auto thread_id : thread_locks )
+		{
+			for( u64 i = 0; i < count; ++i )
+			{
+				auto queues = worker_queues[ i ].load( std::memory_order_acquire );
+				if( queues == nullptr || queues->thread_id.load( std::memory_order_acquire ) != thread_id ) continue;
+
+				auto task_count_in_mailbox = queues->mailbox.GetTaskCount();
+				if( task_count_in_mailbox < target_task_count )
+				{
+					target				= queues;
+					target_thread_id	= thread_id;
+					target_task_count	= task_count_in_mailbox;
+				}
+				break;
+			}
+		}
+		if( target == nullptr ) break;
+
+		// Pairs with ReleaseWorkerQueue(), either the thread id is still there and the thread is not emptying its mailbox until
+		// we are done, or the thread was just removed and we look for another one.
+		target->mailbox_delivery_count.fetch_add( 1, std::memory_order_seq_cst );
+		if( target->thread_id.load( std::memory_order_seq_cst ) == target_thread_id )
+		{
+			target->mailbox.Push( task );
+			target->mailbox_delivery_count.fetch_sub( 1, std::memory_order_seq_cst );
+
+			// Parked worker threads cannot be woken up individually, the target might not be the one woken up by NotifyWork().
+			NotifyAllWorkers();
+			return;
+		}
+		target->mailbox_delivery_count.fetch_sub( 1, std::memory_order_seq_cst );
+	}
+
+	// Every thread the task is locked to has been removed. Dropping the task would leave it counted in task_count forever and hang
+	// every wait on it, fail it the same way as a task returning TaskExecutionResult::ERROR so that its successors and waiters
+	// are released.
+	if( auto core = bc::GetCore() )
+	{
+		core->GetLogger()->LogWarning(
+			bc::diagnostic::MakePrintRecord_AssertText(
+				U"Thread locked task failed, none of the threads it is locked to exist",
+				U"Task id", task->GetTaskId()
+			)
+		);
+	}
+	running_task_count.fetch_add( 1, std::memory_order_relaxed );	// TaskCompleted expects a running task.
+	TaskCompleted( task );
 }
@@ -0,0 +1,26 @@
+#include <core/PreCompiledHeader.hpp>
+#include <core/thread/WorkerCounters.hpp>
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Set for worker threads while they run, lock wait time of other threads is not recorded.
+static thread_local bc::thread::WorkerCounters	*	current_worker_counters				= nullptr;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::internal_::SetCurrentWorkerCounters(
+	WorkerCounters	*	counters
+)
+{
+	current_worker_counters = counters;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bc::thread::internal_::RecordLockWaitTime(
+	i64		nanoseconds
+)
+{
+	if( current_worker_counters ) current_worker_counters->AddLockWaitTime( nanoseconds );
+}
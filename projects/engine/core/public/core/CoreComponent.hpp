@@ -26,6 +26,8 @@ public:
 	~CoreComponent();
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Runs a single update of the core, tasks scheduled to the main thread are run here.
 	void														Run();
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,10 @@ struct CoreComponentCreateInfo
 {
 	diagnostic::LoggerCreateInfo					logger_create_info;
 	thread::ThreadPoolCreateInfo					thread_pool_create_info;
+
+	/// If true, memory tags which have more memory allocated when the core shuts down than when it started are printed to the
+	/// system console. Only available in development builds.
+	bool											report_memory_leaks				= false;
 };
 
 
@@ -4,5 +4,5 @@
 #include <core/diagnostic/print_record/PrintRecordFactory.hpp>
 
 #define BC_CONTAINER_IMPLEMENTATION_NORMAL 1
-#include <core/containers/backend/ListImpl.hpp>
+#include <core/containers/backend/ListImplNormal.hpp>
 #undef BC_CONTAINER_IMPLEMENTATION_NORMAL
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/diagnostic/assertion/HardAssert.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace bc {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Bounded lock-free multiple producer multiple consumer queue.
+///
+/// Every slot of the ring buffer carries a sequence number telling which lap of the ring it is ready for and whether it holds a
+/// value, producers and consumers claim slots by advancing their own index with a compare exchange and never wait on a lock.
+/// Producer and consumer indices live on their own cache lines. Values come out in the order their slots were claimed.
+///
+/// Batch operations claim a run of consecutive slots with a single compare exchange.
+///
+/// @tparam ValueType
+/// Type of the stored values, must be nothrow move constructible.
+template<typename ValueType>
+class MpmcQueue
+{
+	static_assert( std::is_nothrow_move_constructible_v<ValueType>, "MPMC queue value type must be nothrow move constructible" );
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs the queue.
+	///
+	/// @param capacity
+	/// Maximum number of values the queue can hold, rounded up to the next power of 2 and at least 2.
+	inline MpmcQueue(
+		u64											capacity
+	)
+	{
+		BHardAssert( capacity > 0 && capacity <= ( u64( 1 ) << 62 ), U"MPMC queue capacity must be larger than 0 and at most 2^62" );
+		this->capacity	= std::max<u64>( 2, std::bit_ceil( capacity ) );
+		mask			= this->capacity - 1;
+		slots			= memory::AllocateMemory<Slot>( this->capacity, alignof( Slot ) );
+		for( u64 i = 0; i < this->capacity; ++i )
+		{
+			std::construct_at( &slots[ i ].sequence, i );
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MpmcQueue(
+		const MpmcQueue							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MpmcQueue(
+		MpmcQueue								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~MpmcQueue()
+	{
+		Clear();
+		for( u64 i = 0; i < capacity; ++i )
+		{
+			std::destroy_at( &slots[ i ].sequence );
+		}
+		memory::FreeMemory( slots, capacity );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MpmcQueue									&	operator=(
+		const MpmcQueue							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MpmcQueue									&	operator=(
+		MpmcQueue								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs a value at the back of the queue.
+	///
+	/// Can be called from any thread.
+	///
+	/// @param ...constructor_arguments
+	/// Arguments forwarded to the value constructor.
+	///
+	/// @return
+	/// True if the value was added, false if the queue was full in which case nothing is constructed.
+	template<typename ...ConstructorArgumentTypePack>
+	inline bool										TryEmplace(
+		ConstructorArgumentTypePack				&&	...constructor_arguments
+	)
+	{
+		auto position = ClaimPushRange( 1 );
+		if( position.count == 0 ) return false;
+
+		auto & slot = slots[ position.first & mask ];
+		std::construct_at( slot.GetValue(), std::forward<ConstructorArgumentTypePack>( constructor_arguments )... );
+		slot.sequence.store( position.first + 1, std::memory_order_release );
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a value to the back of the queue.
+	///
+	/// Can be called from any thread.
+	///
+	/// @return
+	/// True if the value was added, false if the queue was full.
+	inline bool										TryPush(
+		const ValueType							&	value
+	)
+	{
+		return TryEmplace( value );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Moves a value to the back of the queue.
+	///
+	/// Can be called from any thread.
+	///
+	/// @return
+	/// True if the value was added, false if the queue was full in which case value is left untouched.
+	inline bool										TryPush(
+		ValueType								&&	value
+	)
+	{
+		return TryEmplace( std::move( value ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Moves as many values as there are consecutive free slots to the back of the queue.
+	///
+	/// Can be called from any thread. Values pushed in one batch come out in order, but values of other producers may be
+	/// interleaved between batches.
+	///
+	/// @param source_values
+	/// Values to move from, values that were pushed are left in moved from state.
+	///
+	/// @param count
+	/// Number of values in source_values.
+	///
+	/// @return
+	/// Number of values pushed from the start of source_values.
+	inline u64										TryPushBatch(
+		ValueType								*	source_values,
+		u64											count
+	)
+	{
+		auto position = ClaimPushRange( count );
+		for( u64 i = 0; i < position.count; ++i )
+		{
+			auto & slot = slots[ ( position.first + i ) & mask ];
+			std::construct_at( slot.GetValue(), std::move( source_values[ i ] ) );
+			slot.sequence.store( position.first + i + 1, std::memory_order_release );
+		}
+		return position.count;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes the value at the front of the queue.
+	///
+	/// Can be called from any thread.
+	///
+	/// @param out_value
+	/// Receives the value on success.
+	///
+	/// @return
+	/// True if a value was taken, false if the queue was empty.
+	inline bool										TryPop(
+		ValueType								&	out_value
+	)
+	{
+		return TryPopBatch( &out_value, 1 ) == 1;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes up to max_count values from the front of the queue.
+	///
+	/// Can be called from any thread.
+	///
+	/// @param out_values
+	/// Receives the values, must have room for max_count values which are assigned to.
+	///
+	/// @param max_count
+	/// Maximum number of values to take.
+	///
+	/// @return
+	/// Number of values taken.
+	inline u64										TryPopBatch(
+		ValueType								*	out_values,
+		u64											max_count
+	)
+	{
+		auto position = ClaimPopRange( max_count );
+		for( u64 i = 0; i < position.count; ++i )
+		{
+			auto & slot = slots[ ( position.first + i ) & mask ];
+			auto value = slot.GetValue();
+			out_values[ i ] = std::move( *value );
+			std::destroy_at( value );
+
+			// Slot becomes free for the producer one lap ahead.
+			slot.sequence.store( position.first + i + capacity, std::memory_order_release );
+		}
+		return position.count;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the approximate number of values in the queue.
+	///
+	/// @return
+	/// Number of claimed slots, may be out of date by the time it is returned if other threads are using the queue.
+	inline u64										ApproximateSize() const
+	{
+		auto head = consumer_index.load( std::memory_order_acquire );
+		auto tail = producer_index.load( std::memory_order_acquire );
+		return tail > head ? tail - head : 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the queue looks empty, may be out of date by the time it is returned.
+	inline bool										IsEmpty() const
+	{
+		return ApproximateSize() == 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the maximum number of values the queue can hold.
+	inline u64										GetCapacity() const
+	{
+		return capacity;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Destroys every value in the queue.
+	///
+	/// @warning
+	/// Must not be called while any other thread is using the queue.
+	inline void										Clear()
+	{
+		auto position = ClaimPopRange( capacity );
+		for( u64 i = 0; i < position.count; ++i )
+		{
+			auto & slot = slots[ ( position.first + i ) & mask ];
+			std::destroy_at( slot.GetValue() );
+			slot.sequence.store( position.first + i + capacity, std::memory_order_relaxed );
+		}
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct Slot
+	{
+		std::atomic<u64>							sequence;
+		alignas( ValueType ) u8						storage[ sizeof( ValueType ) ];
+
+		inline ValueType						*	GetValue()
+		{
+			return std::launder( reinterpret_cast<ValueType*>( storage ) );
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct ClaimedRange
+	{
+		u64											first							= 0;
+		u64											count							= 0;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Slot at position p is free for the producer of lap p when its sequence is p, and holds a value for the consumer of lap p
+	// when its sequence is p + 1. Only the thread claiming position p changes the sequence of that slot, so slots seen ready
+	// before the compare exchange are still ready after it succeeds.
+	template<u64 ReadySequenceOffset>
+	inline ClaimedRange								ClaimRange(
+		std::atomic<u64>						&	index,
+		u64											max_count
+	)
+	{
+		if( max_count == 0 ) return {};
+
+		auto first = index.load( std::memory_order_relaxed );
+		while( true )
+		{
+			auto limit = std::min( max_count, capacity );
+			u64 ready_count = 0;
+			while( ready_count < limit )
+			{
+				auto sequence = slots[ ( first + ready_count ) & mask ].sequence.load( std::memory_order_acquire );
+				if( sequence != first + ready_count + ReadySequenceOffset ) break;
+				++ready_count;
+			}
+
+			if( ready_count == 0 )
+			{
+				// Either the queue is full or empty, or another thread claimed the first slot and we are behind.
+				auto sequence = slots[ first & mask ].sequence.load( std::memory_order_acquire );
+				if( i64( sequence - ( first + ReadySequenceOffset ) ) < 0 ) return {};
+				first = index.load( std::memory_order_relaxed );
+				continue;
+			}
+
+			if( index.compare_exchange_weak( first, first + ready_count, std::memory_order_relaxed, std::memory_order_relaxed ) )
+			{
+				return ClaimedRange { first, ready_count };
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ClaimedRange								ClaimPushRange(
+		u64											max_count
+	)
+	{
+		return ClaimRange<0>( producer_index, max_count );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ClaimedRange								ClaimPopRange(
+		u64											max_count
+	)
+	{
+		return ClaimRange<1>( consumer_index, max_count );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	alignas( 64 ) std::atomic<u64>					producer_index					= 0;
+	alignas( 64 ) std::atomic<u64>					consumer_index					= 0;
+
+	alignas( 64 ) Slot							*	slots							= nullptr;
+	u64												capacity						= 0;
+	u64												mask							= 0;
+};
+
+
+
+} // bc
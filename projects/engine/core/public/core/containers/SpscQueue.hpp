@@ -0,0 +1,322 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/diagnostic/assertion/HardAssert.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace bc {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Bounded lock-free single producer single consumer queue.
+///
+/// Values are stored in a ring buffer allocated once at construction. Producer and consumer indices live on their own cache
+/// lines and each side keeps a cached copy of the other side's index, so the two threads only touch shared cache lines when
+/// the cached index says the queue looks full or empty. Every operation is wait-free.
+///
+/// Batch operations move several values with a single index update, the other side sees the whole batch at once.
+///
+/// @warning
+/// Push functions must only be called by one producer thread and pop functions by one consumer thread at a time.
+///
+/// @tparam ValueType
+/// Type of the stored values, must be nothrow move constructible.
+template<typename ValueType>
+class SpscQueue
+{
+	static_assert( std::is_nothrow_move_constructible_v<ValueType>, "SPSC queue value type must be nothrow move constructible" );
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs the queue.
+	///
+	/// @param capacity
+	/// Maximum number of values the queue can hold, rounded up to the next power of 2.
+	inline SpscQueue(
+		u64											capacity
+	)
+	{
+		BHardAssert( capacity > 0 && capacity <= ( u64( 1 ) << 62 ), U"SPSC queue capacity must be larger than 0 and at most 2^62" );
+		this->capacity	= std::bit_ceil( capacity );
+		mask			= this->capacity - 1;
+		values			= memory::AllocateMemory<ValueType>( this->capacity, alignof( ValueType ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SpscQueue(
+		const SpscQueue							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SpscQueue(
+		SpscQueue								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~SpscQueue()
+	{
+		Clear();
+		memory::FreeMemory( values, capacity );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SpscQueue									&	operator=(
+		const SpscQueue							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SpscQueue									&	operator=(
+		SpscQueue								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs a value at the back of the queue.
+	///
+	/// @warning
+	/// Producer thread only.
+	///
+	/// @param ...constructor_arguments
+	/// Arguments forwarded to the value constructor.
+	///
+	/// @return
+	/// True if the value was added, false if the queue was full in which case nothing is constructed.
+	template<typename ...ConstructorArgumentTypePack>
+	inline bool										TryEmplace(
+		ConstructorArgumentTypePack				&&	...constructor_arguments
+	)
+	{
+		auto tail = producer.index.load( std::memory_order_relaxed );
+		if( tail - producer.cached_other_index == capacity )
+		{
+			producer.cached_other_index = consumer.index.load( std::memory_order_acquire );
+			if( tail - producer.cached_other_index == capacity ) return false;
+		}
+
+		std::construct_at( values + ( tail & mask ), std::forward<ConstructorArgumentTypePack>( constructor_arguments )... );
+		producer.index.store( tail + 1, std::memory_order_release );
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a value to the back of the queue.
+	///
+	/// @warning
+	/// Producer thread only.
+	///
+	/// @return
+	/// True if the value was added, false if the queue was full.
+	inline bool										TryPush(
+		const ValueType							&	value
+	)
+	{
+		return TryEmplace( value );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Moves a value to the back of the queue.
+	///
+	/// @warning
+	/// Producer thread only.
+	///
+	/// @return
+	/// True if the value was added, false if the queue was full in which case value is left untouched.
+	inline bool										TryPush(
+		ValueType								&&	value
+	)
+	{
+		return TryEmplace( std::move( value ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Moves as many values as fit to the back of the queue.
+	///
+	/// @warning
+	/// Producer thread only.
+	///
+	/// @param source_values
+	/// Values to move from, values that were pushed are left in moved from state.
+	///
+	/// @param count
+	/// Number of values in source_values.
+	///
+	/// @return
+	/// Number of values pushed from the start of source_values.
+	inline u64										TryPushBatch(
+		ValueType								*	source_values,
+		u64											count
+	)
+	{
+		auto tail = producer.index.load( std::memory_order_relaxed );
+		auto free_count = capacity - ( tail - producer.cached_other_index );
+		if( free_count < count )
+		{
+			producer.cached_other_index = consumer.index.load( std::memory_order_acquire );
+			free_count = capacity - ( tail - producer.cached_other_index );
+		}
+
+		auto push_count = std::min( count, free_count );
+		for( u64 i = 0; i < push_count; ++i )
+		{
+			std::construct_at( values + ( ( tail + i ) & mask ), std::move( source_values[ i ] ) );
+		}
+		if( push_count ) producer.index.store( tail + push_count, std::memory_order_release );
+		return push_count;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes the value at the front of the queue.
+	///
+	/// @warning
+	/// Consumer thread only.
+	///
+	/// @param out_value
+	/// Receives the value on success.
+	///
+	/// @return
+	/// True if a value was taken, false if the queue was empty.
+	inline bool										TryPop(
+		ValueType								&	out_value
+	)
+	{
+		auto head = consumer.index.load( std::memory_order_relaxed );
+		if( head == consumer.cached_other_index )
+		{
+			consumer.cached_other_index = producer.index.load( std::memory_order_acquire );
+			if( head == consumer.cached_other_index ) return false;
+		}
+
+		auto & value = values[ head & mask ];
+		out_value = std::move( value );
+		std::destroy_at( &value );
+		consumer.index.store( head + 1, std::memory_order_release );
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes up to max_count values from the front of the queue.
+	///
+	/// @warning
+	/// Consumer thread only.
+	///
+	/// @param out_values
+	/// Receives the values, must have room for max_count values which are assigned to.
+	///
+	/// @param max_count
+	/// Maximum number of values to take.
+	///
+	/// @return
+	/// Number of values taken.
+	inline u64										TryPopBatch(
+		ValueType								*	out_values,
+		u64											max_count
+	)
+	{
+		auto head = consumer.index.load( std::memory_order_relaxed );
+		auto available_count = consumer.cached_other_index - head;
+		if( available_count < max_count )
+		{
+			consumer.cached_other_index = producer.index.load( std::memory_order_acquire );
+			available_count = consumer.cached_other_index - head;
+		}
+
+		auto pop_count = std::min( max_count, available_count );
+		for( u64 i = 0; i < pop_count; ++i )
+		{
+			auto & value = values[ ( head + i ) & mask ];
+			out_values[ i ] = std::move( value );
+			std::destroy_at( &value );
+		}
+		if( pop_count ) consumer.index.store( head + pop_count, std::memory_order_release );
+		return pop_count;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the approximate number of values in the queue.
+	///
+	/// @return
+	/// Number of values, may be out of date by the time it is returned if other threads are using the queue.
+	inline u64										ApproximateSize() const
+	{
+		auto head = consumer.index.load( std::memory_order_acquire );
+		auto tail = producer.index.load( std::memory_order_acquire );
+		return tail > head ? tail - head : 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the queue looks empty, may be out of date by the time it is returned.
+	inline bool										IsEmpty() const
+	{
+		return ApproximateSize() == 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the maximum number of values the queue can hold.
+	inline u64										GetCapacity() const
+	{
+		return capacity;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Destroys every value in the queue.
+	///
+	/// @warning
+	/// Must not be called while any other thread is using the queue.
+	inline void										Clear()
+	{
+		auto head = consumer.index.load( std::memory_order_relaxed );
+		auto tail = producer.index.load( std::memory_order_relaxed );
+		for( ; head != tail; ++head )
+		{
+			std::destroy_at( values + ( head & mask ) );
+		}
+		consumer.index.store( head, std::memory_order_relaxed );
+		consumer.cached_other_index = tail;
+		producer.cached_other_index = head;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Index owned by one side, and that side's last seen value of the other side's index.
+	struct alignas( 64 ) SideIndices
+	{
+		std::atomic<u64>							index							= 0;
+		u64											cached_other_index				= 0;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SideIndices										producer;
+	SideIndices										consumer;
+
+	alignas( 64 ) ValueType						*	values							= nullptr;
+	u64												capacity						= 0;
+	u64												mask							= 0;
+};
+
+
+
+} // bc
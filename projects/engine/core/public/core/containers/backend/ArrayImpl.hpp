@@ -33,7 +33,7 @@ BC_CONTAINER_NAMESPACE_START;
 /// Type of the contained element.
 template<BC_CONTAINER_VALUE_TYPENAME ValueType, u64 ValueCount>
 class BC_CONTAINER_NAME( Array ) :
-	public container_bases::ContainerResource
+	public container_bases::ContainerResource<>
 {
 public:
 
@@ -478,7 +478,7 @@ private:
 /// Type of the contained element.
 template<BC_CONTAINER_VALUE_TYPENAME ValueType>
 class BC_CONTAINER_NAME( Array )<ValueType, 0> :
-	public container_bases::ContainerResource
+	public container_bases::ContainerResource<>
 {
 public:
 
@@ -4,9 +4,12 @@
 #include <core/data_types/FundamentalTypes.hpp>
 #include <core/diagnostic/assertion/HardAssert.hpp>
 #include <core/memory/raw/RawMemory.hpp>
+#include <core/memory/allocator/HeapAllocator.hpp>
 #include <core/utility/concepts/ContainerConcepts.hpp>
+#include <core/utility/template/TriviallyRelocatable.hpp>
 
 #include <cstdint>
+#include <cstring>
 
 #include <type_traits>
 #include <memory>
@@ -21,8 +24,33 @@ namespace container_bases {
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-class ContainerResource
+/// @brief
+/// Base for containers which own memory, handles construction, destruction and allocation of contained values.
+///
+/// All memory is allocated through the allocator, which is stored here. Stateless allocators like memory::HeapAllocator
+/// take no space in the container.
+///
+/// @tparam AllocatorType
+/// Allocator used to allocate the container memory, see memory::HeapAllocator.
+template<typename AllocatorType = memory::HeapAllocator>
+class ContainerResource :
+	private AllocatorType
 {
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	using ContainerAllocatorType			= AllocatorType;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ContainerResource() noexcept = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr explicit ContainerResource(
+		const AllocatorType							&	allocator
+	) noexcept :
+		AllocatorType( allocator )
+	{}
+
 private:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -370,6 +398,28 @@ protected:
 		}
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Moves trivially relocatable values to another location as plain memory.
+	///
+	/// Ranges may overlap. Values at the source location are not destructed, they are considered moved to the destination and
+	/// the source memory is left uninitialized. Runtime only, bytes cannot be copied at compile time.
+	template<typename ValueType>
+	void												RelocateRange(
+		ValueType									*	destination,
+		ValueType									*	source,
+		u64												element_count
+	) const noexcept
+	{
+		static_assert( IsTriviallyRelocatable<ValueType>::value, "ValueType must be trivially relocatable for it to be relocated via this function" );
+
+		BHardAssert( destination != nullptr, U"Relocating range, destination is nullptr" );
+		BHardAssert( source != nullptr, U"Relocating range, source is nullptr" );
+		BHardAssert( element_count < 0x0000FFFFFFFFFFFF, U"Relocating range, element count too high, something is not right" );
+
+		std::memmove( static_cast<void*>( destination ), static_cast<const void*>( source ), element_count * sizeof( ValueType ) );
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	template<typename ValueType>
 	constexpr void										DestructRange(
@@ -444,6 +494,16 @@ protected:
 		}
 		else
 		{
+			if constexpr( IsTriviallyRelocatable<ValueType>::value )
+			{
+				// Trivially relocatable values can be moved by the allocator as plain memory, same as trivial values. Bytes
+				// cannot be copied at compile time, there the values are moved one by one below.
+				if( !std::is_constant_evaluated() )
+				{
+					return static_cast<ValueType*>( this->ReallocateMemory( old_location, old_reserved_element_count, new_reserved_element_count ) );
+				}
+			}
+
 			// ValueType is not trivial, we need to do some extra work.
 			if( this->IsInPlaceReallocateable( old_location, new_reserved_element_count ) )
 			{
@@ -469,6 +529,20 @@ protected:
 		}
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr const AllocatorType					&	GetAllocator() const noexcept
+	{
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr void										SwapAllocator(
+		ContainerResource							&	other
+	) noexcept
+	{
+		std::swap( static_cast<AllocatorType&>( *this ), static_cast<AllocatorType&>( other ) );
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	template<typename ValueType>
 	[[nodiscard]]
@@ -476,7 +550,7 @@ protected:
 		u64												new_element_count
 	) const noexcept
 	{
-		return memory::AllocateMemory<ValueType>( new_element_count, alignof( ValueType ) );
+		return this->GetAllocator().template AllocateMemory<ValueType>( new_element_count );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -488,9 +562,9 @@ protected:
 		u64												new_element_count
 	) const noexcept
 	{
-		static_assert( std::is_trivial_v<ValueType>, "ValueType must be trivial for it to be reallocated via this function" );
+		static_assert( std::is_trivial_v<ValueType> || IsTriviallyRelocatable<ValueType>::value, "ValueType must be trivial or trivially relocatable for it to be reallocated via this function" );
 
-		return memory::ReallocateMemory<ValueType>( old_location, old_element_count, new_element_count );
+		return this->GetAllocator().template ReallocateMemory<ValueType>( old_location, old_element_count, new_element_count );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -502,7 +576,7 @@ protected:
 	{
 		if( location == nullptr ) return;
 
-		memory::FreeMemory<ValueType>( location, element_count );
+		this->GetAllocator().template FreeMemory<ValueType>( location, element_count );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -512,7 +586,7 @@ protected:
 		u64												new_reserved_element_count
 	) const
 	{
-		return memory::IsInPlaceReallocateable<ValueType>( location, new_reserved_element_count );
+		return this->GetAllocator().template IsInPlaceReallocateable<ValueType>( location, new_reserved_element_count );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -523,7 +597,7 @@ protected:
 		u64												new_reserved_element_count
 	) const
 	{
-		return memory::InPlaceReallocateMemory<ValueType>( old_location, old_reserved_element_count, new_reserved_element_count );
+		return this->GetAllocator().template InPlaceReallocateMemory<ValueType>( old_location, old_reserved_element_count, new_reserved_element_count );
 	}
 };
 
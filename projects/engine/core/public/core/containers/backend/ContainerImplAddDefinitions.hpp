@@ -5,6 +5,7 @@
 #define BC_CONTAINER_NAMESPACE_END
 #define BC_CONTAINER_NOEXCEPT
 #define BC_CONTAINER_NAME( container_name ) container_name
+#define BC_CONTAINER_QUALIFIED_NAME( container_name ) container_name
 #define BC_CONTAINER_VALUE_TYPENAME typename
 #define BC_CONTAINER_IS_DEFAULT_CONSTRUCTIBLE ::std::is_default_constructible_v
 #define BC_CONTAINER_IS_COPY_CONSTRUCTIBLE ::std::is_copy_constructible_v
@@ -21,6 +22,7 @@
 #define BC_CONTAINER_NAMESPACE_END } // internal_
 #define BC_CONTAINER_NOEXCEPT noexcept
 #define BC_CONTAINER_NAME( container_name ) Simple##container_name
+#define BC_CONTAINER_QUALIFIED_NAME( container_name ) internal_::Simple##container_name
 #define BC_CONTAINER_VALUE_TYPENAME ::bc::utility::SimpleContainerAllowedValueType
 #define BC_CONTAINER_IS_DEFAULT_CONSTRUCTIBLE ::std::is_nothrow_default_constructible_v
 #define BC_CONTAINER_IS_COPY_CONSTRUCTIBLE ::std::is_nothrow_copy_constructible_v
@@ -3,6 +3,7 @@
 #undef BC_CONTAINER_NAMESPACE_END
 #undef BC_CONTAINER_NOEXCEPT
 #undef BC_CONTAINER_NAME
+#undef BC_CONTAINER_QUALIFIED_NAME
 #undef BC_CONTAINER_VALUE_TYPENAME
 #undef BC_CONTAINER_IS_DEFAULT_CONSTRUCTIBLE
 #undef BC_CONTAINER_IS_COPY_CONSTRUCTIBLE
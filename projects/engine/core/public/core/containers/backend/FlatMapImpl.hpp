@@ -0,0 +1,948 @@
+
+#if BC_CONTAINER_IMPLEMENTATION_NORMAL
+#include <core/containers/backend/PairImplNormal.hpp>
+#include <core/containers/backend/ListImplNormal.hpp>
+#elif BC_CONTAINER_IMPLEMENTATION_SIMPLE
+#include <core/containers/backend/PairImplSimple.hpp>
+#include <core/containers/backend/ListImplSimple.hpp>
+#else
+#error "Container implementation type not given"
+#endif
+
+#include <core/containers/backend/ContainerBase.hpp>
+#include <core/memory/allocator/ArenaAllocator.hpp>
+
+#include <algorithm>
+#include <memory>
+
+#include <core/containers/backend/ContainerImplAddDefinitions.hpp>
+
+
+
+namespace bc {
+BC_CONTAINER_NAMESPACE_START;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Flat map container.
+///
+/// Stores key/value pairs in a single List sorted by key, keys must always be unique. Lookups are binary searches over
+/// contiguous memory, which makes this a better fit than Map for read-mostly tables which are built once and then looked up
+/// many times, eg. format tables, key bindings and asset registries.
+///
+/// Inserting a single element shifts every element after it, prefer building the map with Append or the initializer list
+/// constructor, which add all new elements at the end and sort them in one go. Inserting and erasing invalidates iterators.
+///
+/// @tparam KeyType
+///	Key type, must be comparable with operator< and operator==.
+///
+/// @tparam ValueType
+///	value Type
+///
+/// @tparam AllocatorType
+/// Allocator used for the list of pairs, see memory::HeapAllocator and memory::ArenaAllocator.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType = memory::HeapAllocator>
+class BC_CONTAINER_NAME( FlatMap )
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	using Base								= void;
+	using ContainedKeyType					= KeyType;
+	using ContainedValueType				= ValueType;
+	using ContainedPairType					= BC_CONTAINER_NAME( Pair )<KeyType, ValueType>;
+	static constexpr bool IsDataConst		= false;
+
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	using ThisContainerType					= BC_CONTAINER_NAME( FlatMap )<OtherKeyType, OtherValueType, AllocatorType>;
+	using ThisType							= ThisContainerType<KeyType, ValueType>;
+
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
+	using ThisContainerViewType				= void;
+
+	template<bool IsOtherConst>
+	using ThisViewType						= ThisContainerViewType<KeyType, ValueType, IsOtherConst>;
+
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	using ThisContainerFullType				= BC_CONTAINER_NAME( FlatMap )<OtherKeyType, OtherValueType, AllocatorType>;
+	using ThisFullType						= ThisContainerFullType<KeyType, ValueType>;
+
+	using PairListType						= BC_CONTAINER_NAME( List )<ContainedPairType, AllocatorType>;
+	using ConstIterator						= typename PairListType::ConstIterator;
+	using Iterator							= typename PairListType::Iterator;
+
+	using value_type						= ContainedPairType;	// for stl compatibility.
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, typename OtherAllocatorType>
+	friend class BC_CONTAINER_NAME( FlatMap );
+
+protected:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	PairListType				pairs;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( FlatMap )() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs an empty flat map which allocates with the given allocator.
+	///
+	/// @param allocator
+	/// Allocator for the list of pairs, eg. pointer to a memory::LinearArena with ArenaFlatMap.
+	constexpr explicit BC_CONTAINER_NAME( FlatMap )(
+		const AllocatorType																			&	allocator
+	) noexcept :
+		pairs( allocator )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( FlatMap )(
+		const std::initializer_list<ContainedPairType>												&	init_list
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		this->Append( init_list );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( FlatMap )(
+		const BC_CONTAINER_NAME( FlatMap )															&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> ) :
+		pairs( other.pairs )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( FlatMap )(
+		BC_CONTAINER_NAME( FlatMap )																&&	other
+	) noexcept :
+		pairs( std::move( other.pairs ) )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( FlatMap )															&	operator=(
+		const std::initializer_list<ContainedPairType>												&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	{
+		this->Clear();
+		this->Append( other );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( FlatMap )															&	operator=(
+		const BC_CONTAINER_NAME( FlatMap )															&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	{
+		if( &other == this ) return *this;
+
+		this->pairs = other.pairs;
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( FlatMap )															&	operator=(
+		BC_CONTAINER_NAME( FlatMap )																&&	other
+	) noexcept
+	{
+		this->pairs = std::move( other.pairs );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the allocator this flat map allocates its list of pairs with.
+	///
+	/// @return
+	/// Reference to the allocator.
+	constexpr const AllocatorType																	&	GetAllocator() const noexcept
+	{
+		return this->pairs.GetAllocator();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Extends this flat map with elements from an initializer list.
+	///
+	/// @note
+	/// If any key already exists in this flat map, then only the value is updated from the initializer list.
+	///
+	/// @param other
+	///	Another flat map to add to this flat map.
+	///
+	/// @return
+	/// Reference to this.
+	constexpr BC_CONTAINER_NAME( FlatMap )															&	operator+=(
+		const std::initializer_list<ContainedPairType>												&	init_list
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		this->Append( init_list );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check if contents of this flat map matches the contents of another.
+	///
+	/// @param other
+	///	Other flat map to compare contents with.
+	///
+	/// @return
+	/// true if contents match, false if contents do not match.
+	constexpr bool																						operator==(
+		const BC_CONTAINER_NAME( FlatMap )															&	other
+	) const noexcept
+	{
+		if( other.Size() != this->Size() ) return false;
+
+		auto this_data = this->pairs.Data();
+		auto other_data = other.pairs.Data();
+		if( this_data == other_data ) return true;
+
+		for( u64 i = 0; i < this->Size(); ++i )
+		{
+			if( !( this_data[ i ].first == other_data[ i ].first ) ) return false;
+			if( !( this_data[ i ].second == other_data[ i ].second ) ) return false;
+		}
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check if contents of this flat map differ the contents of another.
+	///
+	/// @param other
+	///	Other flat map to compare contents with.
+	///
+	/// @return
+	/// true if contents do not match, false if contents match.
+	constexpr bool																						operator!=(
+		const BC_CONTAINER_NAME( FlatMap )															&	other
+	) const noexcept
+	{
+		return !( *this == other );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Extends this flat map with another.
+	///
+	/// @note
+	/// If any key already exists in this flat map, then only the value is updated from the other flat map.
+	///
+	/// @param other
+	///	Another flat map to add to this flat map.
+	///
+	/// @return
+	/// Reference to this.
+	constexpr BC_CONTAINER_NAME( FlatMap )															&	operator+=(
+		const BC_CONTAINER_NAME( FlatMap )															&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		this->Append( other );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Find or add an element by key name.
+	///
+	///	If key exists, get the value mapped to this key. If key does not exist, construct a new element with given key and return
+	/// its value.
+	///
+	/// @param key
+	///	Key of the element we wish to find or create.
+	///
+	/// @return
+	/// Value paired with with given key.
+	constexpr ValueType																				&	operator[](
+		const KeyType																				&	key
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> && std::is_default_constructible_v<ValueType> )
+	{
+		auto index = this->LowerBound( key );
+		if( !this->IsKeyAt( index, key ) ) {
+			this->pairs.Insert( this->ConstIteratorAt( index ), ContainedPairType( key, ValueType {} ) );
+		}
+		return this->pairs[ index ].second;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get first element.
+	///
+	/// @return
+	/// Reference to the element with the smallest key.
+	constexpr const ContainedPairType																&	Front() const BC_CONTAINER_NOEXCEPT
+	{
+		return this->pairs.Front();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get first element.
+	///
+	/// @return
+	/// Reference to the element with the smallest key.
+	constexpr ContainedPairType																		&	Front() BC_CONTAINER_NOEXCEPT
+	{
+		return this->pairs.Front();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get last element.
+	///
+	/// @return
+	/// Reference to the element with the largest key.
+	constexpr const ContainedPairType																&	Back() const BC_CONTAINER_NOEXCEPT
+	{
+		return this->pairs.Back();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get last element.
+	///
+	/// @return
+	/// Reference to the element with the largest key.
+	constexpr ContainedPairType																		&	Back() BC_CONTAINER_NOEXCEPT
+	{
+		return this->pairs.Back();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Finds an element with specific key.
+	///
+	/// @param key
+	///	Key value of an element we want to find.
+	///
+	/// @return
+	/// Iterator to the element if found, returns end iterator if not found.
+	constexpr Iterator																					Find(
+		const KeyType																				&	key
+	) noexcept
+	{
+		return this->IteratorAt( this->FindIndex( key ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Finds an element with specific key.
+	///
+	/// @param key
+	///	Key value of an element we want to find.
+	///
+	/// @return
+	/// ConstIterator to the element if found, returns end iterator if not found.
+	constexpr ConstIterator																				Find(
+		const KeyType																				&	key
+	) const noexcept
+	{
+		return this->ConstIteratorAt( this->FindIndex( key ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check each member to see if any key match the parameter.
+	///
+	/// @note
+	/// This is exactly the same as <tt>container.Find( <key> ) != container.end()</tt>
+	///
+	/// @param member
+	///	Key value we're looking for.
+	///
+	/// @return
+	/// True if this container has member which key equals what we're searching for, false if not found.
+	constexpr bool																						HasMember(
+		const KeyType																				&	key
+	) const noexcept
+	{
+		return this->FindIndex( key ) != this->Size();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Append elements from another container to this.
+	///
+	///	Other container may be any iteratable Bitcrafte container of pairs, eg. List of pairs or Map. All elements are added at the
+	/// end and sorted in one go, this is considerably faster than inserting them one at a time. If a key is given more than once,
+	/// the last value is kept.
+	///
+	/// @tparam OtherContainerType
+	///	Type of another container which elements are added to this flat map.
+	///
+	/// @param other
+	///	Other container of which elements are appended to this.
+	template<utility::ContainerView OtherContainerType>
+	constexpr void																						Append(
+		const OtherContainerType																	&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && std::is_same_v<ContainedPairType, std::remove_cvref_t<decltype( *other.begin() )>> )
+	{
+		if constexpr( std::is_same_v<OtherContainerType, ThisType> )
+		{
+			if( reinterpret_cast<const void*>( &other ) == reinterpret_cast<const void*>( this ) ) return;
+		}
+
+		auto old_size = this->Size();
+		this->pairs.Reserve( old_size + other.Size() );
+		for( auto & pair : other )
+		{
+			this->pairs.PushBack( pair );
+		}
+		this->SortAppended( old_size );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Append elements from an initializer list to this.
+	///
+	/// All elements are added at the end and sorted in one go. If a key is given more than once, the last value is kept.
+	///
+	/// @param init_list
+	///	Initializer list of which elements are appended to this.
+	constexpr void																						Append(
+		const std::initializer_list<ContainedPairType>												&	init_list
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	{
+		auto old_size = this->Size();
+		this->pairs.Reserve( old_size + init_list.size() );
+		for( auto & pair : init_list )
+		{
+			this->pairs.PushBack( pair );
+		}
+		this->SortAppended( old_size );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Inserts a new key/value pair.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	/// @param pair
+	///	Pair to insert.
+	///
+	/// @return
+	/// Iterator to inserted element.
+	constexpr Iterator																					Insert(
+		const ContainedPairType																		&	pair
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		auto index = this->LowerBound( pair.first );
+		if( this->IsKeyAt( index, pair.first ) ) {
+			this->pairs[ index ].second = pair.second;
+		} else {
+			this->pairs.Insert( this->ConstIteratorAt( index ), ContainedPairType( pair ) );
+		}
+		return this->IteratorAt( index );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Inserts a new key/value pair.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	/// @param pair
+	///	Pair to insert.
+	///
+	/// @return
+	/// Iterator to inserted element.
+	constexpr Iterator																					Insert(
+		ContainedPairType																			&&	pair
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ContainedPairType> && ( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> || BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> ) )
+	{
+		auto index = this->LowerBound( pair.first );
+		if( this->IsKeyAt( index, pair.first ) ) {
+			if constexpr( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> ) {
+				this->pairs[ index ].second = std::move( pair.second );
+			} else {
+				this->pairs[ index ].second = pair.second;
+			}
+		} else {
+			this->pairs.Insert( this->ConstIteratorAt( index ), std::move( pair ) );
+		}
+		return this->IteratorAt( index );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Emplace a key/value pair.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	/// @param key
+	///	Key used to find or create an element.
+	///
+	/// @param value
+	///	Element value to set.
+	///
+	/// @return
+	/// Iterator to created or updated element location.
+	constexpr Iterator																					Emplace(
+		const KeyType																				&	key,
+		const ValueType																				&	value
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		auto index = this->LowerBound( key );
+		if( this->IsKeyAt( index, key ) ) {
+			this->pairs[ index ].second = value;
+		} else {
+			this->pairs.Insert( this->ConstIteratorAt( index ), ContainedPairType( key, value ) );
+		}
+		return this->IteratorAt( index );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Emplace a key/value pair.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	/// @param key
+	///	Key used to find or create an element.
+	///
+	/// @param value
+	///	Element value to set.
+	///
+	/// @return
+	/// Iterator to created or updated element location.
+	constexpr Iterator																					Emplace(
+		KeyType																						&&	key,
+		ValueType																					&&	value
+	) BC_CONTAINER_NOEXCEPT
+	{
+		auto index = this->LowerBound( key );
+		if( this->IsKeyAt( index, key ) ) {
+			if constexpr( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> ) {
+				this->pairs[ index ].second = std::move( value );
+			} else {
+				this->pairs[ index ].second = value;
+			}
+		} else {
+			this->pairs.Insert( this->ConstIteratorAt( index ), ContainedPairType( std::move( key ), std::move( value ) ) );
+		}
+		return this->IteratorAt( index );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Erase an element based on key.
+	///
+	/// @note
+	/// If key does not exist, does nothing.
+	///
+	/// @param key
+	///	Key of an element to erase.
+	///
+	/// @return
+	/// Iterator to the next element which replaced this. Iterator end is returned if the erased element was the last one or key
+	/// was not found.
+	constexpr Iterator																					Erase(
+		const KeyType																				&	key
+	) BC_CONTAINER_NOEXCEPT
+	{
+		auto index = this->FindIndex( key );
+		if( index == this->Size() ) return this->end();
+
+		this->pairs.Erase( this->ConstIteratorAt( index ) );
+		return this->IteratorAt( index );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Erase an element at iterator location.
+	///
+	/// @param at
+	///	Iterator to element location.
+	///
+	/// @return
+	/// Iterator to the next element which replaced this. Iterator end is returned if the erased element was the last one.
+	constexpr Iterator																					Erase(
+		ConstIterator																					at
+	) BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( at.GetContainer() == &this->pairs, U"Cannot erase from container using iterator that doesn't point to the container we're erasing from" );
+		auto index = at.GetIndex();
+		this->pairs.Erase( at );
+		return this->IteratorAt( index );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Erase multiple elements at range.
+	///
+	/// @param from
+	///	Iterator to first erased element location.
+	///
+	/// @param to
+	///	Iterator to position up to which all elements are erased. This is the first element not erased.
+	///
+	/// @return
+	/// Iterator position to the first element not erased.
+	constexpr Iterator																					Erase(
+		ConstIterator																					from,
+		ConstIterator																					to
+	) BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( from.GetContainer() == &this->pairs, U"Cannot erase from container using iterator that doesn't point to the container we're erasing from" );
+		BC_ContainerAssert( to.GetContainer() == &this->pairs, U"Cannot erase from container using iterator that doesn't point to the container we're erasing from" );
+		auto index = from.GetIndex();
+		this->pairs.Erase( from, to );
+		return this->IteratorAt( index );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Clear entire flat map of all contents.
+	///
+	/// @note
+	/// Does not change capacity.
+	constexpr void																						Clear() BC_CONTAINER_NOEXCEPT
+	{
+		this->pairs.Clear();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Reserve space for elements so that the flat map does not need to grow before it holds this many elements.
+	///
+	/// @param element_count
+	/// Number of elements to reserve space for.
+	constexpr void																						Reserve(
+		u64																								element_count
+	) BC_CONTAINER_NOEXCEPT
+	{
+		this->pairs.Reserve( element_count );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get size of the flat map.
+	///
+	/// @return
+	/// Current number of elements stored inside this flat map.
+	constexpr u64																						Size() const noexcept
+	{
+		return this->pairs.Size();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check if this FlatMap has no elements stored.
+	///
+	/// @return
+	/// true if Size == 0, false otherwise.
+	constexpr bool																						IsEmpty() const noexcept
+	{
+		return this->pairs.IsEmpty();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get the sorted list of pairs this flat map is stored in.
+	///
+	/// @return
+	/// Reference to the list of pairs, sorted by key.
+	constexpr const PairListType																	&	GetPairs() const noexcept
+	{
+		return this->pairs;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr Iterator																					begin() noexcept
+	{
+		return this->pairs.begin();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr Iterator																					end() noexcept
+	{
+		return this->pairs.end();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				begin() const noexcept
+	{
+		return this->pairs.begin();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				end() const noexcept
+	{
+		return this->pairs.end();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				cbegin() const noexcept
+	{
+		return this->pairs.cbegin();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				cend() const noexcept
+	{
+		return this->pairs.cend();
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Binary search for the first element which key is not less than the given key.
+	///
+	/// @return
+	/// Index of the element, or Size() if every key is less than the given key.
+	constexpr u64																						LowerBound(
+		const KeyType																				&	key
+	) const noexcept
+	{
+		auto data = this->pairs.Data();
+		u64 first = 0;
+		u64 count = this->pairs.Size();
+		while( count > 0 )
+		{
+			auto half = count / 2;
+			if( data[ first + half ].first < key )
+			{
+				first += half + 1;
+				count -= half + 1;
+			}
+			else
+			{
+				count = half;
+			}
+		}
+		return first;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Iterator arithmetic asserts on empty lists, index may be Size() so build iterators directly from the address.
+	constexpr Iterator																					IteratorAt(
+		u64																								index
+	) noexcept
+	{
+		return Iterator { &this->pairs, this->pairs.Data() + index };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				ConstIteratorAt(
+		u64																								index
+	) const noexcept
+	{
+		return ConstIterator { &this->pairs, this->pairs.Data() + index };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr bool																						IsKeyAt(
+		u64																								index,
+		const KeyType																				&	key
+	) const noexcept
+	{
+		return index < this->pairs.Size() && this->pairs.Data()[ index ].first == key;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr u64																						FindIndex(
+		const KeyType																				&	key
+	) const noexcept
+	{
+		auto index = this->LowerBound( key );
+		return this->IsKeyAt( index, key ) ? index : this->pairs.Size();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Sorts elements appended at the end of the list into the already sorted elements.
+	///
+	/// Appended elements are sorted on their own and merged with the old elements, duplicate keys keep the value which was
+	/// appended last. Scratch space for sorting is taken from the capacity of the list, so that all memory comes from
+	/// AllocatorType, std::stable_sort and std::inplace_merge would allocate their buffers from the global heap.
+	///
+	/// @param old_size
+	/// Number of already sorted elements at the start of the list.
+	constexpr void																						SortAppended(
+		u64																								old_size
+	) BC_CONTAINER_NOEXCEPT
+	{
+		auto data = this->pairs.Data();
+		auto size = this->pairs.Size();
+		if( old_size == size ) return;
+
+		// Stable sorting and merging keep equal keys in the order they were appended, so the last one of them is the newest.
+		auto new_count = size - old_size;
+		auto is_tail_sorted = std::is_sorted( data + old_size, data + size, IsKeyLess );
+		if( !is_tail_sorted || ( old_size && IsKeyLess( data[ old_size ], data[ old_size - 1 ] ) ) ) {
+			// Left side of a merge is moved to scratch space, which is never longer than the old elements or the new elements.
+			this->pairs.Reserve( size + std::max( old_size, new_count ) );
+			data = this->pairs.Data();
+			auto scratch = data + size;
+
+			if( !is_tail_sorted ) {
+				SortPairs( data + old_size, new_count, scratch );
+			}
+			if( old_size && IsKeyLess( data[ old_size ], data[ old_size - 1 ] ) ) {
+				MergePairs( data, old_size, size, scratch );
+			}
+		}
+
+		u64 write = 0;
+		for( u64 read = 0; read < size; ++read ) {
+			if( read + 1 < size && !IsKeyLess( data[ read ], data[ read + 1 ] ) ) continue;
+			if( write != read ) data[ write ] = std::move( data[ read ] );
+			++write;
+		}
+		if( write != size ) {
+			this->pairs.Erase( this->ConstIteratorAt( write ), this->pairs.cend() );
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	static constexpr bool																				IsKeyLess(
+		const ContainedPairType																		&	a,
+		const ContainedPairType																		&	b
+	) noexcept
+	{
+		return a.first < b.first;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Stable bottom-up merge sort. Short runs are insertion sorted in place, scratch must have room for count elements.
+	static constexpr void																				SortPairs(
+		ContainedPairType																			*	pairs_data,
+		u64																								count,
+		ContainedPairType																			*	scratch
+	) BC_CONTAINER_NOEXCEPT
+	{
+		constexpr u64 insertion_sort_run_size = 16;
+
+		for( u64 run_begin = 0; run_begin < count; run_begin += insertion_sort_run_size ) {
+			auto run = pairs_data + run_begin;
+			auto run_size = std::min( insertion_sort_run_size, count - run_begin );
+			for( u64 i = 1; i < run_size; ++i ) {
+				if( !IsKeyLess( run[ i ], run[ i - 1 ] ) ) continue;
+
+				auto value = std::move( run[ i ] );
+				auto j = i;
+				for( ; j > 0 && IsKeyLess( value, run[ j - 1 ] ); --j ) {
+					run[ j ] = std::move( run[ j - 1 ] );
+				}
+				run[ j ] = std::move( value );
+			}
+		}
+
+		for( u64 width = insertion_sort_run_size; width < count; width *= 2 ) {
+			for( u64 run_begin = 0; run_begin + width < count; run_begin += width * 2 ) {
+				MergePairs( pairs_data + run_begin, width, std::min( width * 2, count - run_begin ), scratch );
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Stable merge of sorted ranges [0, middle) and [middle, count). Left range is moved to uninitialized scratch space and merged
+	// back, equal keys keep the left element first.
+	static constexpr void																				MergePairs(
+		ContainedPairType																			*	pairs_data,
+		u64																								middle,
+		u64																								count,
+		ContainedPairType																			*	scratch
+	) BC_CONTAINER_NOEXCEPT
+	{
+		for( u64 i = 0; i < middle; ++i ) {
+			new( &scratch[ i ] ) ContainedPairType( std::move( pairs_data[ i ] ) );
+		}
+
+		u64 left = 0;
+		u64 right = middle;
+		u64 write = 0;
+		while( left < middle && right < count ) {
+			if( IsKeyLess( pairs_data[ right ], scratch[ left ] ) ) {
+				pairs_data[ write++ ] = std::move( pairs_data[ right++ ] );
+			} else {
+				pairs_data[ write++ ] = std::move( scratch[ left++ ] );
+			}
+		}
+		while( left < middle ) {
+			pairs_data[ write++ ] = std::move( scratch[ left++ ] );
+		}
+
+		std::destroy_n( scratch, middle );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Flat map which allocates its list of pairs from an arena, construct it with a pointer to the arena.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename ArenaType = memory::LinearArena>
+using BC_CONTAINER_NAME( ArenaFlatMap ) = BC_CONTAINER_NAME( FlatMap )<KeyType, ValueType, memory::ArenaAllocator<ArenaType>>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Flat map which allocates its list of pairs from a memory::StackAllocator, construct it with a pointer to the stack allocator.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType>
+using BC_CONTAINER_NAME( StackFlatMap ) = BC_CONTAINER_NAME( FlatMap )<KeyType, ValueType, memory::ArenaAllocator<memory::StackAllocator>>;
+
+
+
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Flat map only holds a list of pairs, it can be relocated as plain memory whenever its allocator can.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( FlatMap )<KeyType, ValueType, AllocatorType>> : IsTriviallyRelocatable<AllocatorType> {};
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
+#if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+namespace tests {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if flat map container fulfills size requirements.
+static_assert( sizeof( BC_CONTAINER_NAME( FlatMap )<u32, u32> ) == 24 );
+static_assert( sizeof( BC_CONTAINER_NAME( ArenaFlatMap )<u32, u32> ) == 32 );
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if flat map container fulfills concept requirements.
+static_assert( utility::ContainerView<BC_CONTAINER_NAME( FlatMap )<u32, u32>> );
+static_assert( utility::ContainerEditableView<BC_CONTAINER_NAME( FlatMap )<u32, u32>> );
+static_assert( utility::Container<BC_CONTAINER_NAME( FlatMap )<u32, u32>> );
+static_assert( utility::Container<BC_CONTAINER_NAME( ArenaFlatMap )<u32, u32>> );
+static_assert( !utility::LinearContainerView<BC_CONTAINER_NAME( FlatMap )<u32, u32>> );
+static_assert( !utility::LinearContainerEditableView<BC_CONTAINER_NAME( FlatMap )<u32, u32>> );
+static_assert( !utility::LinearContainer<BC_CONTAINER_NAME( FlatMap )<u32, u32>> );
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if flat map container can be relocated as plain memory.
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( FlatMap )<u32, u32>>::value );
+
+} // tests
+#endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+
+
+
+BC_CONTAINER_NAMESPACE_END;
+} // bc
+
+
+
+#include <core/containers/backend/ContainerImplRemoveDefinitions.hpp>
@@ -365,6 +365,19 @@ BC_CONTAINER_NAME( Function )(FunctorType)
 
 
 
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Function only stores trivially copyable functors locally and the functor manager has no state, the function can always be
+/// relocated as plain memory.
+template<typename Signature>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( Function )<Signature>> : std::true_type {};
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
 #if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 namespace tests {
 
@@ -381,6 +394,12 @@ static_assert( std::is_copy_assignable_v<BC_CONTAINER_NAME( Function )<void()>>
 static_assert( std::is_move_assignable_v<BC_CONTAINER_NAME( Function )<void()>> );
 static_assert( std::is_nothrow_move_assignable_v<BC_CONTAINER_NAME( Function )<void()>> );
 
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if function container can be relocated as plain memory.
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( Function )<void()>>::value );
+
 } // tests
 #endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 
@@ -0,0 +1,1295 @@
+
+#if BC_CONTAINER_IMPLEMENTATION_NORMAL
+#include <core/containers/backend/PairImplNormal.hpp>
+#elif BC_CONTAINER_IMPLEMENTATION_SIMPLE
+#include <core/containers/backend/PairImplSimple.hpp>
+#else
+#error "Container implementation type not given"
+#endif
+
+#include <core/containers/backend/ContainerBase.hpp>
+#include <core/containers/backend/HashMapImplShared.hpp>
+#include <core/memory/allocator/ArenaAllocator.hpp>
+#include <core/utility/hash/Hash.hpp>
+
+#include <core/containers/backend/ContainerImplAddDefinitions.hpp>
+
+
+
+namespace bc {
+BC_CONTAINER_NAMESPACE_START;
+
+
+
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType = memory::HeapAllocator>
+class BC_CONTAINER_NAME( HashMap );
+
+BC_CONTAINER_NAMESPACE_END;
+
+
+
+namespace container_bases {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, bool IsConst, typename AllocatorType = memory::HeapAllocator>
+class BC_CONTAINER_NAME( HashMapIteratorBase )
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	using Base								= void;
+	using ContainedKeyType					= KeyType;
+	using ContainedValueType				= ValueType;
+	using ContainedPairType					= ::bc::BC_CONTAINER_QUALIFIED_NAME( Pair )<KeyType, ValueType>;
+	using value_type						= ContainedPairType;	// for stl compatibility.
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst, typename OtherAllocatorType>
+	friend class BC_CONTAINER_NAME( HashMapIteratorBase );
+
+	using Container				= ::bc::BC_CONTAINER_QUALIFIED_NAME( HashMap )<KeyType, ValueType, AllocatorType>;
+
+public:
+
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )() noexcept = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<bool IsOtherConst>
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )(
+		const BC_CONTAINER_NAME( HashMapIteratorBase )<KeyType, ValueType, IsOtherConst, AllocatorType>			&	other
+	) noexcept requires( utility::IsConstConvertible<IsConst, IsOtherConst> ) :
+		container( other.GetContainer() ),
+		index( other.GetIndex() )
+	{};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )(
+		const Container																				*	container,
+		u64																								index
+	) noexcept :
+		container( container ),
+		index( index )
+	{};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr const ContainedPairType																&	operator*() const BC_CONTAINER_NOEXCEPT
+	{
+		return *this->Get();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ContainedPairType																		&	operator*() BC_CONTAINER_NOEXCEPT requires( IsConst == false )
+	{
+		return *this->Get();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr const ContainedPairType																*	operator->() const BC_CONTAINER_NOEXCEPT
+	{
+		return this->Get();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ContainedPairType																		*	operator->() BC_CONTAINER_NOEXCEPT requires( IsConst == false )
+	{
+		return this->Get();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<bool IsOtherConst>
+	constexpr bool																						operator==(
+		BC_CONTAINER_NAME( HashMapIteratorBase )<KeyType, ValueType, IsOtherConst, AllocatorType>						other
+	) const noexcept
+	{
+		return this->index == other.GetIndex();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<bool IsOtherConst>
+	constexpr bool																						operator!=(
+		BC_CONTAINER_NAME( HashMapIteratorBase )<KeyType, ValueType, IsOtherConst, AllocatorType>						other
+	) const noexcept
+	{
+		return this->index != other.GetIndex();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )												&	operator++() BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		BC_ContainerAssert( this->index < this->container->capacity,
+			U"Tried to increment iterator past end",
+			U"Container size", this->container->Size()
+		);
+		this->index = this->container->FindNextFullSlot( this->index + 1 );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )												&	operator--() BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		auto previous = this->container->FindPreviousFullSlot( this->index );
+		BC_ContainerAssert( previous < this->container->capacity,
+			U"Tried to decrement iterator past begin",
+			U"Container size", this->container->Size()
+		);
+		this->index = previous;
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )												&	operator+=(
+		u64																								value
+	) BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		for( u64 i = 0; i < value; ++i ) {
+			++( *this );
+		}
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )												&	operator-=(
+		u64																								value
+	) BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		for( u64 i = 0; i < value; ++i ) {
+			--( *this );
+		}
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )													operator+(
+		u64																								value
+	) const BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		BC_CONTAINER_NAME( HashMapIteratorBase ) ret = *this;
+		ret += value;
+		return ret;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMapIteratorBase )													operator-(
+		u64																								value
+	) const BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		BC_CONTAINER_NAME( HashMapIteratorBase ) ret = *this;
+		ret -= value;
+		return ret;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr const ContainedPairType																*	Get() const BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		BC_ContainerAssert( this->index < this->container->capacity,
+			U"Iterator out of range",
+			"Container size", this->container->Size()
+		);
+		return std::addressof( this->container->slots[ this->index ] );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ContainedPairType																		*	Get() BC_CONTAINER_NOEXCEPT requires( IsConst == false )
+	{
+		BC_ContainerAssert( this->container, U"Tried using iterator that points to nothing" );
+		BC_ContainerAssert( !this->container->IsEmpty(), U"Container is empty, cannot iterate over nothing" );
+		BC_ContainerAssert( this->index < this->container->capacity,
+			U"Iterator out of range",
+			"Container size", this->container->Size()
+		);
+		return std::addressof( this->container->slots[ this->index ] );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get the slot this iterator points to.
+	///
+	/// @return
+	/// Pointer to the key/value pair, nullptr if this iterator points to the end.
+	constexpr const ContainedPairType																*	GetData() const noexcept
+	{
+		if( this->container == nullptr || this->index >= this->container->capacity ) return nullptr;
+		return std::addressof( this->container->slots[ this->index ] );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ContainedPairType																		*	GetData() noexcept requires( IsConst == false )
+	{
+		if( this->container == nullptr || this->index >= this->container->capacity ) return nullptr;
+		return std::addressof( this->container->slots[ this->index ] );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get the slot index this iterator points to.
+	///
+	/// @return
+	/// Index of the slot, or slot count of the container if this iterator points to the end.
+	constexpr u64																						GetIndex() const noexcept
+	{
+		return this->index;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr const Container																		*	GetContainer() const noexcept
+	{
+		return this->container;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks that the iterator points to valid data.
+	///
+	/// @return
+	/// true if this iterator can be used to get a value, false if this iterator should not be used.
+	constexpr bool																						IsValid() const noexcept
+	{
+		return this->container && !this->container->IsEmpty() && this->index < this->container->capacity;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	const Container																					*	container			= nullptr;
+	u64																									index				= 0;
+};
+
+
+
+} // container_bases
+
+
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Hash map container.
+///
+/// Stores key/value pairs in a single open addressed table, keys must always be unique. Elements are not ordered, iteration
+/// order depends on the key hashes and the history of the map. Use Map if ordered iteration is needed.
+///
+/// Lookups hash the key with bc::Hash and probe the table in groups of 16 slots. Each slot has a control byte holding 7 bits
+/// of the key hash, a whole group of control bytes is compared at once with SIMD instructions so most non-matching keys are
+/// never touched. Erasing leaves other elements in place, iterators to other elements stay valid until the map grows.
+///
+/// @tparam KeyType
+///	Key type, bc::Hash must be specialized for it.
+///
+/// @tparam ValueType
+///	value Type
+///
+/// @tparam AllocatorType
+/// Allocator used for the slots, see memory::HeapAllocator and memory::ArenaAllocator.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
+class BC_CONTAINER_NAME( HashMap ) :
+	protected container_bases::ContainerResource<AllocatorType>
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	using Base								= void;
+	using ContainedKeyType					= KeyType;
+	using ContainedValueType				= ValueType;
+	using ContainedPairType					= BC_CONTAINER_NAME( Pair )<KeyType, ValueType>;
+	static constexpr bool IsDataConst		= false;
+
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	using ThisContainerType					= BC_CONTAINER_NAME( HashMap )<OtherKeyType, OtherValueType, AllocatorType>;
+	using ThisType							= ThisContainerType<KeyType, ValueType>;
+
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
+	using ThisContainerViewType				= void;
+
+	template<bool IsOtherConst>
+	using ThisViewType						= ThisContainerViewType<KeyType, ValueType, IsOtherConst>;
+
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	using ThisContainerFullType				= BC_CONTAINER_NAME( HashMap )<OtherKeyType, OtherValueType, AllocatorType>;
+	using ThisFullType						= ThisContainerFullType<KeyType, ValueType>;
+
+	template<bool IsConst>
+	using IteratorBase						= container_bases::BC_CONTAINER_NAME( HashMapIteratorBase )<KeyType, ValueType, IsConst, AllocatorType>;
+	using ConstIterator						= IteratorBase<true>;
+	using Iterator							= IteratorBase<false>;
+
+	using value_type						= ContainedPairType;	// for stl compatibility.
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst, typename OtherAllocatorType>
+	friend class container_bases::BC_CONTAINER_NAME( HashMapIteratorBase );
+
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, typename OtherAllocatorType>
+	friend class BC_CONTAINER_NAME( HashMap );
+
+	using Control				= internal_::container::HashMapControl;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	static constexpr u64		GroupWidth			= internal_::container::HashMapGroupWidth;
+	static constexpr u64		MinimumCapacity		= 4;
+
+protected:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	ContainedPairType		*	slots				= nullptr;
+	i8						*	controls			= nullptr;
+	u64							capacity			= 0;
+	u64							size				= 0;
+	u64							growth_left			= 0;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMap )() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs an empty hash map which allocates with the given allocator.
+	///
+	/// @param allocator
+	/// Allocator for the slots, eg. pointer to a memory::LinearArena with ArenaHashMap.
+	constexpr explicit BC_CONTAINER_NAME( HashMap )(
+		const AllocatorType																			&	allocator
+	) noexcept :
+		container_bases::ContainerResource<AllocatorType>( allocator )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMap )(
+		const std::initializer_list<ContainedPairType>												&	init_list
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		this->Append( init_list );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMap )(
+		const BC_CONTAINER_NAME( HashMap )															&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> ) :
+		container_bases::ContainerResource<AllocatorType>( other.GetAllocator() )
+	{
+		this->CopyOther( other );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMap )(
+		BC_CONTAINER_NAME( HashMap )																&&	other
+	) noexcept
+	{
+		this->SwapOther( std::move( other ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ~BC_CONTAINER_NAME( HashMap )() BC_CONTAINER_NOEXCEPT
+	{
+		this->Clear();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMap )															&	operator=(
+		const std::initializer_list<ContainedPairType>												&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	{
+		this->Clear();
+		this->Append( other );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMap )															&	operator=(
+		const BC_CONTAINER_NAME( HashMap )															&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	{
+		if( &other == this ) return *this;
+
+		this->Clear();
+		this->CopyOther( other );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr BC_CONTAINER_NAME( HashMap )															&	operator=(
+		BC_CONTAINER_NAME( HashMap )																&&	other
+	) noexcept
+	{
+		this->SwapOther( std::move( other ) );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the allocator this hash map allocates its slots with.
+	///
+	/// @return
+	/// Reference to the allocator.
+	constexpr const AllocatorType																	&	GetAllocator() const noexcept
+	{
+		return container_bases::ContainerResource<AllocatorType>::GetAllocator();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Extends this hash map with elements from an initializer list.
+	///
+	/// @note
+	/// If any key already exists in this hash map, then only the value is updated from the initializer list.
+	///
+	/// @param other
+	///	Another hash map to add to this hash map.
+	///
+	/// @return
+	/// Reference to this.
+	constexpr BC_CONTAINER_NAME( HashMap )															&	operator+=(
+		const std::initializer_list<ContainedPairType>												&	init_list
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		this->Append( init_list );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check if contents of this hash map matches the contents of another.
+	///
+	/// Order of the elements does not matter, every key of this hash map must be found in the other with an equal value.
+	///
+	/// @param other
+	///	Other hash map to compare contents with.
+	///
+	/// @return
+	/// true if contents match, false if contents do not match.
+	constexpr bool																						operator==(
+		const BC_CONTAINER_NAME( HashMap )															&	other
+	) const noexcept
+	{
+		if( other.Size() != this->Size() ) return false;
+		if( other.slots == this->slots ) return true;
+
+		for( auto & pair : *this )
+		{
+			auto other_index = other.FindSlot( pair.first, Hash<KeyType> {}( pair.first ) );
+			if( other_index == other.capacity ) return false;
+			if( !( other.slots[ other_index ].second == pair.second ) ) return false;
+		}
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check if contents of this hash map differ the contents of another.
+	///
+	/// @param other
+	///	Other hash map to compare contents with.
+	///
+	/// @return
+	/// true if contents do not match, false if contents match.
+	constexpr bool																						operator!=(
+		const BC_CONTAINER_NAME( HashMap )															&	other
+	) const noexcept
+	{
+		return !( *this == other );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Extends this hash map with another.
+	///
+	/// @note
+	/// If any key already exists in this hash map, then only the value is updated from the other hash map.
+	///
+	/// @param other
+	///	Another hash map to add to this hash map.
+	///
+	/// @return
+	/// Reference to this.
+	constexpr BC_CONTAINER_NAME( HashMap )															&	operator+=(
+		const BC_CONTAINER_NAME( HashMap )															&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		this->Append( other );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Find or add an element by key name.
+	///
+	///	If key exists, get the value mapped to this key. If key does not exist, construct a new element with given key and return
+	/// its value.
+	///
+	/// @param key
+	///	Key of the element we wish to find or create.
+	///
+	/// @return
+	/// Value paired with with given key.
+	constexpr ValueType																				&	operator[](
+		const KeyType																				&	key
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> && std::is_default_constructible_v<ValueType> )
+	{
+		auto hash = Hash<KeyType> {}( key );
+		auto index = this->FindSlot( key, hash );
+		if( index != this->capacity ) return this->slots[ index ].second;
+
+		index = this->PrepareInsert( hash );
+		this->ConstructRange( &this->slots[ index ], 1, key, ValueType {} );
+		this->CommitInsert( index, hash );
+		return this->slots[ index ].second;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Finds an element with specific key.
+	///
+	/// @param key
+	///	Key value of an element we want to find.
+	///
+	/// @return
+	/// Iterator to the element if found, returns end iterator if not found.
+	constexpr Iterator																					Find(
+		const KeyType																				&	key
+	) noexcept
+	{
+		return Iterator { this, this->FindSlot( key, Hash<KeyType> {}( key ) ) };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Finds an element with specific key.
+	///
+	/// @param key
+	///	Key value of an element we want to find.
+	///
+	/// @return
+	/// ConstIterator to the element if found, returns end iterator if not found.
+	constexpr ConstIterator																				Find(
+		const KeyType																				&	key
+	) const noexcept
+	{
+		return ConstIterator { this, this->FindSlot( key, Hash<KeyType> {}( key ) ) };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check each member to see if any key match the parameter.
+	///
+	/// @note
+	/// This is exactly the same as <tt>container.Find( <key> ) != container.end()</tt>
+	///
+	/// @param member
+	///	Key value we're looking for.
+	///
+	/// @return
+	/// True if this container has member which key equals what we're searching for, false if not found.
+	constexpr bool																						HasMember(
+		const KeyType																				&	key
+	) const noexcept
+	{
+		return this->Find( key ) != this->end();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Append elements from another container to this.
+	///
+	///	Other container may be any iteratable Bitcrafte container.
+	///
+	/// @tparam OtherContainerType
+	///	Type of another container which elements are added to this hash map.
+	///
+	/// @param other
+	///	Other container of which elements are appended to this.
+	///
+	/// @param count
+	///	How many times the other elements are added to this hash map.
+	template<utility::ContainerView OtherContainerType>
+	constexpr void																						Append(
+		const OtherContainerType																	&	other,
+		u64																								count					= 1
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && std::is_same_v<ContainedPairType, typename OtherContainerType::ContainedPairType> )
+	{
+		if constexpr( std::is_same_v<OtherContainerType, ThisType> )
+		{
+			if( reinterpret_cast<const void*>( &other ) == reinterpret_cast<const void*>( this ) ) return;
+		}
+
+		this->Reserve( this->Size() + other.Size() );
+
+		for( u64 c = 0; c < count; ++c )
+		{
+			for( auto & pair : other )
+			{
+				this->Insert( pair );
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Append elements from an initializer list to this.
+	///
+	/// @param init_list
+	///	Initializer list of which elements are appended to this.
+	///
+	/// @param count
+	///	How many times the other elements are added to this hash map.
+	constexpr void																						Append(
+		const std::initializer_list<ContainedPairType>												&	init_list,
+		u64																								count					= 1
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	{
+		this->Reserve( this->Size() + init_list.size() );
+
+		for( u64 c = 0; c < count; ++c ) {
+			for( auto & pair : init_list ) {
+				this->Insert( pair );
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Inserts a new key/value pair.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	/// @param pair
+	///	Pair to insert.
+	///
+	/// @return
+	/// Iterator to inserted element.
+	constexpr Iterator																					Insert(
+		const ContainedPairType																		&	pair
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		auto hash = Hash<KeyType> {}( pair.first );
+		auto index = this->FindSlot( pair.first, hash );
+		if( index != this->capacity ) {
+			this->slots[ index ].second = pair.second;
+			return Iterator { this, index };
+		}
+
+		index = this->PrepareInsert( hash );
+		this->CopyConstructRange( &this->slots[ index ], &pair, 1 );
+		this->CommitInsert( index, hash );
+		return Iterator { this, index };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Inserts a new key/value pair.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	/// @param pair
+	///	Pair to insert.
+	///
+	/// @return
+	/// Iterator to inserted element.
+	constexpr Iterator																					Insert(
+		ContainedPairType																			&&	pair
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ContainedPairType> && ( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> || BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> ) )
+	{
+		auto hash = Hash<KeyType> {}( pair.first );
+		auto index = this->FindSlot( pair.first, hash );
+		if( index != this->capacity ) {
+			if constexpr( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> ) {
+				this->slots[ index ].second = std::move( pair.second );
+			} else {
+				this->slots[ index ].second = pair.second;
+			}
+			return Iterator { this, index };
+		}
+
+		index = this->PrepareInsert( hash );
+		this->MoveConstructRange( &this->slots[ index ], &pair, 1 );
+		this->CommitInsert( index, hash );
+		return Iterator { this, index };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Emplace a key/value pair directly in place.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	///	This is largely the same as insert except Pair data is constructed in place.
+	///
+	/// @param key
+	///	Key used to find or create an element.
+	///
+	/// @param value
+	///	Element value to set.
+	///
+	/// @return
+	/// Iterator to created or updated element location.
+	constexpr Iterator																					Emplace(
+		const KeyType																				&	key,
+		const ValueType																				&	value
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && BC_CONTAINER_IS_COPY_ASSIGNABLE<ValueType> )
+	{
+		auto hash = Hash<KeyType> {}( key );
+		auto index = this->FindSlot( key, hash );
+		if( index != this->capacity ) {
+			this->slots[ index ].second = value;
+			return Iterator { this, index };
+		}
+
+		index = this->PrepareInsert( hash );
+		this->ConstructRange( &this->slots[ index ], 1, key, value );
+		this->CommitInsert( index, hash );
+		return Iterator { this, index };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Emplace a key/value pair directly in place.
+	///
+	///	@note
+	/// If key already exists, then the existing element value is only updated.
+	///
+	///	This is largely the same as insert except key and value are outside of a Pair data and the Pair data is constructed in
+	/// place.
+	///
+	/// @param key
+	///	Key used to find or create an element.
+	///
+	/// @param value
+	///	Element value to set.
+	///
+	/// @return
+	/// Iterator to created or updated element location.
+	constexpr Iterator																					Emplace(
+		KeyType																						&&	key,
+		ValueType																					&&	value
+	) BC_CONTAINER_NOEXCEPT
+	{
+		auto hash = Hash<KeyType> {}( key );
+		auto index = this->FindSlot( key, hash );
+		if( index != this->capacity ) {
+			if constexpr( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> ) {
+				std::swap( this->slots[ index ].second, value );
+			} else {
+				this->slots[ index ].second = value;
+			}
+			return Iterator { this, index };
+		}
+
+		index = this->PrepareInsert( hash );
+		if constexpr( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<KeyType> && BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ValueType> ) {
+			this->ConstructRange( &this->slots[ index ], 1, std::move( key ), std::move( value ) );
+		} else if constexpr( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<KeyType> ) {
+			this->ConstructRange( &this->slots[ index ], 1, std::move( key ), value );
+		} else if constexpr( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ValueType> ) {
+			this->ConstructRange( &this->slots[ index ], 1, key, std::move( value ) );
+		} else {
+			this->ConstructRange( &this->slots[ index ], 1, key, value );
+		}
+		this->CommitInsert( index, hash );
+		return Iterator { this, index };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Erase an element based on key.
+	///
+	/// @note
+	/// If key does not exist, does nothing.
+	///
+	/// @param key
+	///	Key of an element to erase.
+	///
+	/// @return
+	/// Iterator to the next element. Iterator end is returned if the erased element was the last one or key was not found.
+	constexpr Iterator																					Erase(
+		const KeyType																				&	key
+	) BC_CONTAINER_NOEXCEPT
+	{
+		auto index = this->FindSlot( key, Hash<KeyType> {}( key ) );
+		if( index == this->capacity ) return this->end();
+
+		this->EraseSlot( index );
+		return Iterator { this, this->FindNextFullSlot( index + 1 ) };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Erase an element at iterator location.
+	///
+	/// @param at
+	///	Iterator to element location.
+	///
+	/// @return
+	/// Iterator to the next element. Iterator end is returned if the erased element was the last one.
+	constexpr Iterator																					Erase(
+		ConstIterator																					at
+	) BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->size, U"Cannot erase from container, container is already empty" );
+		BC_ContainerAssert( at.GetContainer() == this, U"Cannot erase from container using iterator that doesn't point to the container we're erasing from" );
+		BC_ContainerAssert( at.GetIndex() < this->capacity, U"Cannot erase from container, iterator was at the end" );
+		BC_ContainerAssert( this->IsFull( at.GetIndex() ), U"Cannot erase from container, iterator points to an erased element" );
+		auto index = at.GetIndex();
+		this->EraseSlot( index );
+		return Iterator { this, this->FindNextFullSlot( index + 1 ) };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Erase multiple elements at range.
+	///
+	/// @param from
+	///	Iterator to first erased element location.
+	///
+	/// @param to
+	///	Iterator to position up to which all elements are erased. This is the first element not erased.
+	///
+	/// @return
+	/// Iterator position to the first element not erased.
+	constexpr Iterator																					Erase(
+		ConstIterator																					from,
+		ConstIterator																					to
+	) BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( this->size, U"Cannot erase from container, container is already empty" );
+		BC_ContainerAssert( from.GetContainer() == this, U"Cannot erase from container using iterator that doesn't point to the container we're erasing from" );
+		BC_ContainerAssert( to.GetContainer() == this, U"Cannot erase from container using iterator that doesn't point to the container we're erasing from" );
+		BC_ContainerAssert( from.GetIndex() < this->capacity, U"Cannot erase from container, iterator was at the end" );
+		BC_ContainerAssert( from.GetIndex() <= to.GetIndex(), U"Cannot erase from container, range end is before range begin" );
+		auto it = Iterator { this, from.GetIndex() };
+		auto end = Iterator { this, to.GetIndex() };
+		while( it != end ) {
+			it = this->Erase( it );
+		}
+		return end;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Clear entire hash map of all contents and free its memory.
+	constexpr void																						Clear() BC_CONTAINER_NOEXCEPT
+	{
+		if( this->capacity == 0 ) return;
+
+		if constexpr( !std::is_trivially_destructible_v<ContainedPairType> ) {
+			for( u64 i = 0; i < this->capacity; ++i ) {
+				if( this->IsFull( i ) ) this->DestructRange( &this->slots[ i ], 1 );
+			}
+		}
+		this->FreeMemory( this->slots, this->capacity );
+		this->FreeMemory( this->controls, ControlCount( this->capacity ) );
+		this->slots			= nullptr;
+		this->controls		= nullptr;
+		this->capacity		= 0;
+		this->size			= 0;
+		this->growth_left	= 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Reserve space for elements so that the hash map does not need to grow before it holds this many elements.
+	///
+	/// @param element_count
+	/// Number of elements to reserve space for.
+	constexpr void																						Reserve(
+		u64																								element_count
+	) BC_CONTAINER_NOEXCEPT
+	{
+		if( element_count <= this->size + this->growth_left ) return;
+
+		auto new_capacity = this->capacity ? this->capacity : MinimumCapacity;
+		while( MaxLoad( new_capacity ) < element_count ) new_capacity *= 2;
+		this->Rehash( new_capacity );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get size of the hash map.
+	///
+	/// @return
+	/// Current number of elements stored inside this hash map.
+	constexpr u64																						Size() const noexcept
+	{
+		return this->size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get number of slots in the hash map.
+	///
+	/// @return
+	/// Number of slots currently allocated, the hash map grows before all of the slots are used.
+	constexpr u64																						Capacity() const noexcept
+	{
+		return this->capacity;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Check if this HashMap has no elements stored.
+	///
+	/// @return
+	/// true if Size == 0, false otherwise.
+	constexpr bool																						IsEmpty() const noexcept
+	{
+		return !this->size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr Iterator																					begin() noexcept
+	{
+		return Iterator { this, this->FindNextFullSlot( 0 ) };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr Iterator																					end() noexcept
+	{
+		return Iterator { this, this->capacity };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				begin() const noexcept
+	{
+		return ConstIterator { this, this->FindNextFullSlot( 0 ) };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				end() const noexcept
+	{
+		return ConstIterator { this, this->capacity };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				cbegin() const noexcept
+	{
+		return this->begin();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ConstIterator																				cend() const noexcept
+	{
+		return this->end();
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Small maps still have a whole group of control bytes, slots past the capacity are marked as sentinels.
+	static constexpr u64																				ControlCount(
+		u64																								capacity
+	) noexcept
+	{
+		return capacity < GroupWidth ? GroupWidth : capacity;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Maximum number of used slots, full or deleted, before growing. Leaves at least one empty slot so probing always ends.
+	static constexpr u64																				MaxLoad(
+		u64																								capacity
+	) noexcept
+	{
+		return capacity * 7 / 8;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr bool																						IsFull(
+		u64																								index
+	) const noexcept
+	{
+		return this->controls[ index ] >= 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr u64																						FindNextFullSlot(
+		u64																								from
+	) const noexcept
+	{
+		while( from < this->capacity && !this->IsFull( from ) ) ++from;
+		return from;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Returns slot count if there is no full slot before the given index.
+	constexpr u64																						FindPreviousFullSlot(
+		u64																								from
+	) const noexcept
+	{
+		while( from > 0 ) {
+			--from;
+			if( this->IsFull( from ) ) return from;
+		}
+		return this->capacity;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Probes groups in triangular steps, with a power of two group count every group is visited once.
+	constexpr u64																						FindSlot(
+		const KeyType																				&	key,
+		u64																								hash
+	) const noexcept
+	{
+		if( this->size == 0 ) return this->capacity;
+
+		auto group_mask		= ControlCount( this->capacity ) / GroupWidth - 1;
+		auto group			= internal_::container::HashMapGroupHash( hash ) & group_mask;
+		auto control_hash	= internal_::container::HashMapControlHash( hash );
+		for( u64 step = 1; ; ++step ) {
+			auto group_controls = this->controls + group * GroupWidth;
+			for( auto match = internal_::container::HashMapMatchGroup( group_controls, control_hash ); match; match &= match - 1 ) {
+				auto index = group * GroupWidth + internal_::container::HashMapLowestMatch( match );
+				if( this->slots[ index ].first == key ) return index;
+			}
+			if( internal_::container::HashMapMatchGroup( group_controls, Control::Empty ) ) return this->capacity;
+			group = ( group + step ) & group_mask;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr u64																						FindInsertSlot(
+		u64																								hash
+	) const noexcept
+	{
+		auto group_mask		= ControlCount( this->capacity ) / GroupWidth - 1;
+		auto group			= internal_::container::HashMapGroupHash( hash ) & group_mask;
+		for( u64 step = 1; ; ++step ) {
+			auto match = internal_::container::HashMapMatchGroupEmptyOrDeleted( this->controls + group * GroupWidth );
+			if( match ) return group * GroupWidth + internal_::container::HashMapLowestMatch( match );
+			group = ( group + step ) & group_mask;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Finds a slot for a new element, grows or cleans up deleted slots if needed. Slot is not marked as used until
+	// CommitInsert, if constructing the element throws then the map is left as it was.
+	constexpr u64																						PrepareInsert(
+		u64																								hash
+	) BC_CONTAINER_NOEXCEPT
+	{
+		if( this->capacity == 0 ) {
+			this->Rehash( MinimumCapacity );
+			return this->FindInsertSlot( hash );
+		}
+
+		auto index = this->FindInsertSlot( hash );
+		if( this->growth_left == 0 && this->controls[ index ] != Control::Deleted ) {
+			// Deleted slots use up the growth, rehash in place to drop them as long as live elements fill at most 25/32 of
+			// the slots and leave room for the new element, otherwise grow.
+			auto is_crowded = this->size * 32 > this->capacity * 25 || this->size >= MaxLoad( this->capacity );
+			auto new_capacity = is_crowded ? this->capacity * 2 : this->capacity;
+			this->Rehash( new_capacity );
+			index = this->FindInsertSlot( hash );
+		}
+		return index;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr void																						CommitInsert(
+		u64																								index,
+		u64																								hash
+	) noexcept
+	{
+		if( this->controls[ index ] == Control::Empty ) --this->growth_left;
+		this->controls[ index ] = internal_::container::HashMapControlHash( hash );
+		++this->size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// If the group of the erased slot has an empty slot then no probe sequence ever continued past this group, the slot can be
+	// marked empty instead of deleted.
+	constexpr void																						EraseSlot(
+		u64																								index
+	) BC_CONTAINER_NOEXCEPT
+	{
+		this->DestructRange( &this->slots[ index ], 1 );
+		--this->size;
+
+		auto group_controls = this->controls + ( index & ~( GroupWidth - 1 ) );
+		if( internal_::container::HashMapMatchGroup( group_controls, Control::Empty ) ) {
+			this->controls[ index ] = Control::Empty;
+			++this->growth_left;
+		} else {
+			this->controls[ index ] = Control::Deleted;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr void																						AllocateTable(
+		u64																								new_capacity
+	) BC_CONTAINER_NOEXCEPT
+	{
+		auto control_count = ControlCount( new_capacity );
+		this->slots			= this->template AllocateMemory<ContainedPairType>( new_capacity );
+		this->controls		= this->template AllocateMemory<i8>( control_count );
+		for( u64 i = 0; i < control_count; ++i ) {
+			this->controls[ i ] = i < new_capacity ? Control::Empty : Control::Sentinel;
+		}
+		this->capacity		= new_capacity;
+		this->growth_left	= MaxLoad( new_capacity );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Moves every element to a new table, deleted slots are dropped.
+	constexpr void																						Rehash(
+		u64																								new_capacity
+	) BC_CONTAINER_NOEXCEPT
+	{
+		BC_ContainerAssert( std::has_single_bit( new_capacity ) && new_capacity >= MinimumCapacity, U"Hash map capacity must be a power of two" );
+		BC_ContainerAssert( MaxLoad( new_capacity ) >= this->size, U"Hash map capacity too small for its elements" );
+
+		auto old_slots			= this->slots;
+		auto old_controls		= this->controls;
+		auto old_capacity		= this->capacity;
+
+		this->AllocateTable( new_capacity );
+
+		for( u64 i = 0; i < old_capacity; ++i ) {
+			if( old_controls[ i ] < 0 ) continue;
+
+			auto hash = Hash<KeyType> {}( old_slots[ i ].first );
+			auto index = this->FindInsertSlot( hash );
+			this->controls[ index ] = internal_::container::HashMapControlHash( hash );
+			if constexpr( IsTriviallyRelocatable<ContainedPairType>::value ) {
+				if( !std::is_constant_evaluated() ) {
+					this->RelocateRange( &this->slots[ index ], &old_slots[ i ], 1 );
+					continue;
+				}
+			}
+			if constexpr( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ContainedPairType> ) {
+				this->MoveConstructRange( &this->slots[ index ], &old_slots[ i ], 1 );
+			} else {
+				this->CopyConstructRange( &this->slots[ index ], &old_slots[ i ], 1 );
+			}
+			this->DestructRange( &old_slots[ i ], 1 );
+		}
+		this->growth_left -= this->size;
+
+		this->FreeMemory( old_slots, old_capacity );
+		this->FreeMemory( old_controls, ControlCount( old_capacity ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Copies the table layout as is, no hashing needed. Deleted slots are copied too, probe sequences depend on them.
+	constexpr void																						CopyOther(
+		const BC_CONTAINER_NAME( HashMap )															&	other
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	{
+		if( other.size == 0 ) return;
+
+		this->AllocateTable( other.capacity );
+		for( u64 i = 0; i < other.capacity; ++i ) {
+			if( other.IsFull( i ) ) {
+				this->CopyConstructRange( &this->slots[ i ], &other.slots[ i ], 1 );
+				++this->size;
+			}
+			this->controls[ i ] = other.controls[ i ];
+		}
+		this->growth_left = other.growth_left;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr void																						SwapOther(
+		BC_CONTAINER_NAME( HashMap )																&&	other
+	) noexcept
+	{
+		std::swap( this->slots, other.slots );
+		std::swap( this->controls, other.controls );
+		std::swap( this->capacity, other.capacity );
+		std::swap( this->size, other.size );
+		std::swap( this->growth_left, other.growth_left );
+		this->SwapAllocator( other );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Hash map which allocates its slots from an arena, construct it with a pointer to the arena.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename ArenaType = memory::LinearArena>
+using BC_CONTAINER_NAME( ArenaHashMap ) = BC_CONTAINER_NAME( HashMap )<KeyType, ValueType, memory::ArenaAllocator<ArenaType>>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Hash map which allocates its slots from a memory::StackAllocator, construct it with a pointer to the stack allocator.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType>
+using BC_CONTAINER_NAME( StackHashMap ) = BC_CONTAINER_NAME( HashMap )<KeyType, ValueType, memory::ArenaAllocator<memory::StackAllocator>>;
+
+
+
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Hash map slots live on the heap and do not point back to the hash map, the hash map can be relocated as plain memory if its
+/// allocator can be.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( HashMap )<KeyType, ValueType, AllocatorType>> : IsTriviallyRelocatable<AllocatorType> {};
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
+#if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+namespace tests {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if hash map container fulfills size requirements.
+static_assert( sizeof( container_bases::BC_CONTAINER_NAME( HashMapIteratorBase )<u32, u32, true> ) == 16 );
+static_assert( sizeof( container_bases::BC_CONTAINER_NAME( HashMapIteratorBase )<u32, u32, false> ) == 16 );
+
+static_assert( sizeof( BC_CONTAINER_NAME( HashMap )<u32, u32> ) == 40 );
+static_assert( sizeof( BC_CONTAINER_NAME( ArenaHashMap )<u32, u32> ) == 48 );
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if hash map container fulfills concept requirements.
+static_assert( utility::ContainerView<BC_CONTAINER_NAME( HashMap )<u32, u32>> );
+static_assert( utility::ContainerEditableView<BC_CONTAINER_NAME( HashMap )<u32, u32>> );
+static_assert( utility::Container<BC_CONTAINER_NAME( HashMap )<u32, u32>> );
+static_assert( utility::Container<BC_CONTAINER_NAME( ArenaHashMap )<u32, u32>> );
+static_assert( !utility::LinearContainerView<BC_CONTAINER_NAME( HashMap )<u32, u32>> );
+static_assert( !utility::LinearContainerEditableView<BC_CONTAINER_NAME( HashMap )<u32, u32>> );
+static_assert( !utility::LinearContainer<BC_CONTAINER_NAME( HashMap )<u32, u32>> );
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if hash map container can be relocated as plain memory.
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( HashMap )<u32, u32>>::value );
+
+} // tests
+#endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+
+
+
+BC_CONTAINER_NAMESPACE_END;
+} // bc
+
+
+
+#include <core/containers/backend/ContainerImplRemoveDefinitions.hpp>
@@ -0,0 +1,138 @@
+#pragma once
+
+// The purpose of this file is to add common parts of to both simple and normal versions of the HashMap.
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/data_types/FundamentalTypes.hpp>
+
+#include <bit>
+#include <type_traits>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define BITCRAFTE_HASH_MAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define BITCRAFTE_HASH_MAP_SSE2 0
+#endif
+
+
+
+namespace bc {
+namespace internal_ {
+namespace container {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Control byte values of a hash map slot.
+///
+/// Each slot has one control byte. Full slots store the lowest 7 bits of the key hash so that most of the keys can be
+/// rejected without touching the slot itself. Empty, deleted and sentinel slots have the highest bit set.
+struct HashMapControl
+{
+	static constexpr i8 Empty		= -128;	///< Slot was never used since the last rehash, ends a probe sequence.
+	static constexpr i8 Deleted		= -2;	///< Slot was erased, probe sequences continue past it.
+	static constexpr i8 Sentinel	= -1;	///< Padding after the last slot of a small map, never used.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Number of control bytes probed at once.
+static constexpr u64 HashMapGroupWidth = 16;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Split the hash into the part selecting the first probed group and the part stored in the control byte.
+constexpr u64													HashMapGroupHash(
+	u64															hash
+) noexcept
+{
+	return hash >> 7;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr i8													HashMapControlHash(
+	u64															hash
+) noexcept
+{
+	return static_cast<i8>( hash & 0x7F );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Find control bytes of a group that match a value.
+///
+/// @param group
+/// Pointer to the first of HashMapGroupWidth control bytes.
+///
+/// @param value
+/// Control byte value to look for.
+///
+/// @return
+/// Bit mask where bit n is set if control byte n matched.
+constexpr u32													HashMapMatchGroup(
+	const i8												*	group,
+	i8															value
+) noexcept
+{
+	#if BITCRAFTE_HASH_MAP_SSE2
+	if( !std::is_constant_evaluated() )
+	{
+		auto controls = _mm_loadu_si128( reinterpret_cast<const __m128i*>( group ) );
+		return static_cast<u32>( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( value ), controls ) ) );
+	}
+	#endif
+
+	u32 mask = 0;
+	for( u32 i = 0; i < HashMapGroupWidth; ++i )
+	{
+		if( group[ i ] == value ) mask |= 1U << i;
+	}
+	return mask;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Find control bytes of a group that can be used to insert a new value.
+///
+/// @param group
+/// Pointer to the first of HashMapGroupWidth control bytes.
+///
+/// @return
+/// Bit mask where bit n is set if control byte n is empty or deleted.
+constexpr u32													HashMapMatchGroupEmptyOrDeleted(
+	const i8												*	group
+) noexcept
+{
+	#if BITCRAFTE_HASH_MAP_SSE2
+	if( !std::is_constant_evaluated() )
+	{
+		auto controls = _mm_loadu_si128( reinterpret_cast<const __m128i*>( group ) );
+		return static_cast<u32>( _mm_movemask_epi8( _mm_cmpgt_epi8( _mm_set1_epi8( HashMapControl::Sentinel ), controls ) ) );
+	}
+	#endif
+
+	u32 mask = 0;
+	for( u32 i = 0; i < HashMapGroupWidth; ++i )
+	{
+		if( group[ i ] < HashMapControl::Sentinel ) mask |= 1U << i;
+	}
+	return mask;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Get the index of the lowest set bit of a match mask.
+constexpr u64													HashMapLowestMatch(
+	u32															mask
+) noexcept
+{
+	return static_cast<u64>( std::countr_zero( mask ) );
+}
+
+
+
+} // container
+} // internal_
+} // bc
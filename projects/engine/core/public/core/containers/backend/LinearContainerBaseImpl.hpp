@@ -23,7 +23,7 @@ namespace container_bases {
 template<BC_CONTAINER_VALUE_TYPENAME ValueType, bool IsConst>
 class BC_CONTAINER_NAME( LinearContainerViewBase );
 
-template<BC_CONTAINER_VALUE_TYPENAME ValueType>
+template<BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType = memory::HeapAllocator>
 class BC_CONTAINER_NAME( LinearContainerBase );
 
 
@@ -427,7 +427,7 @@ private:
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
 	friend class BC_CONTAINER_NAME( LinearContainerViewBase );
 
-	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( LinearContainerBase );
 
 public:
@@ -665,10 +665,13 @@ protected:
 /// 
 /// @tparam ValueType
 ///	Type of linear container values.
-template<BC_CONTAINER_VALUE_TYPENAME ValueType>
+///
+/// @tparam AllocatorType
+/// Allocator used for the container memory, see memory::HeapAllocator.
+template<BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
 class BC_CONTAINER_NAME( LinearContainerBase ) :
 	public BC_CONTAINER_NAME( LinearContainerViewBase )<ValueType, false>,
-	protected ContainerResource
+	protected ContainerResource<AllocatorType>
 {
 public:
 
@@ -678,7 +681,7 @@ public:
 	static constexpr bool IsDataConst		= false;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
-	using ThisContainerType					= BC_CONTAINER_NAME( LinearContainerBase )<OtherValueType>;
+	using ThisContainerType					= BC_CONTAINER_NAME( LinearContainerBase )<OtherValueType, AllocatorType>;
 	using ThisType							= ThisContainerType<ValueType>;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
@@ -688,7 +691,7 @@ public:
 	using ThisViewType						= ThisContainerViewType<ValueType, IsOtherConst>;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
-	using ThisContainerFullType				= BC_CONTAINER_NAME( LinearContainerBase )<OtherValueType>;
+	using ThisContainerFullType				= BC_CONTAINER_NAME( LinearContainerBase )<OtherValueType, AllocatorType>;
 	using ThisFullType						= ThisContainerFullType<ValueType>;
 
 	//template<bool IsOtherConst>
@@ -710,13 +713,20 @@ private:
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
 	friend class BC_CONTAINER_NAME( LinearContainerViewBase );
 
-	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( LinearContainerBase );
 
 public:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	//BC_CONTAINER_NAME( LinearContainerBase )() = default;
+	constexpr BC_CONTAINER_NAME( LinearContainerBase )() noexcept = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr explicit BC_CONTAINER_NAME( LinearContainerBase )(
+		const AllocatorType																			&	allocator
+	) noexcept :
+		ContainerResource<AllocatorType>( allocator )
+	{}
 
 public:
 
@@ -727,6 +737,17 @@ public:
 		this->FreeMemory( this->data_ptr, this->data_capacity );
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the allocator this container allocates its memory with.
+	///
+	/// @return
+	/// Reference to the allocator.
+	constexpr const AllocatorType																	&	GetAllocator() const noexcept
+	{
+		return ContainerResource<AllocatorType>::GetAllocator();
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
 	/// Reserves memory for number of values.
@@ -746,7 +767,7 @@ public:
 			new_capacity += headroom;
 			if( this->data_ptr == nullptr )
 			{
-				this->data_ptr		= AllocateMemory<ValueType>( new_capacity );
+				this->data_ptr		= this->template AllocateMemory<ValueType>( new_capacity );
 				this->data_capacity	= new_capacity;
 				return;
 			}
@@ -1114,6 +1135,19 @@ protected:
 		auto to_it				= &this->data_ptr[ to - this->data_ptr ];
 		auto it_end				= this->data_ptr + this->data_size;
 		auto it_last			= this->data_ptr + this->data_size - 1;
+
+		if constexpr( IsTriviallyRelocatable<ValueType>::value )
+		{
+			if( !std::is_constant_evaluated() )
+			{
+				// Destruct the erased values and move the tail over them as plain memory.
+				this->DestructRange( from_it, from_to_range );
+				this->RelocateRange( from_it, to_it, tail_range );
+				this->data_size -= from_to_range;
+				return it_end;
+			}
+		}
+
 		while( to_it != it_end )
 		{
 			if constexpr( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> )
@@ -1157,6 +1191,34 @@ protected:
 		return &this->data_ptr[ at_index + count ];
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ValueType																				*	DoInsert(
+		const ValueType																				*	at,
+		ValueType																					&&	value
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ValueType> || BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ValueType> )
+	{
+		BC_ContainerAssert(
+			( this->data_ptr == nullptr && at == nullptr ) ||
+			( at >= this->data_ptr && at <= this->data_ptr + this->data_size ),
+			U"Iterator out of range"
+		);
+
+		u64 at_index = at - this->data_ptr;
+		this->ShiftRight( at_index, 1, this->data_size + 1 );
+
+		// This test is needed in cases where either the copy constructor or the move constructor has been explicitly deleted.
+		if constexpr( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ValueType> )
+		{
+			new( &this->data_ptr[ at_index ] ) ValueType( std::move( value ) );
+		}
+		else
+		{
+			new( &this->data_ptr[ at_index ] ) ValueType( value );
+		}
+
+		return &this->data_ptr[ at_index + 1 ];
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	template<utility::ContainerView OtherContainerType>
 	constexpr ValueType																				*	DoInsert(
@@ -1257,6 +1319,7 @@ protected:
 		std::swap( this->data_ptr, other.data_ptr );
 		std::swap( this->data_size, other.data_size );
 		std::swap( this->data_capacity, other.data_capacity );
+		this->SwapAllocator( other );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1310,6 +1373,16 @@ protected:
 
 		this->ResizeNoConstruct( new_size, headroom );
 
+		if constexpr( IsTriviallyRelocatable<ValueType>::value )
+		{
+			if( !std::is_constant_evaluated() )
+			{
+				// Move the tail as plain memory, the opened range is left uninitialized for the caller to construct into.
+				this->RelocateRange( this->data_ptr + start_position + amount, this->data_ptr + start_position, distance_to_end );
+				return;
+			}
+		}
+
 		if( old_size > 0 )
 		{
 			// Construct the values assigned to a newly allocated memory from previous ones.
@@ -1360,30 +1433,28 @@ protected:
 
 		if( this->data_size > 0 )
 		{
-			// Destruct first value.
-			this->DestructRange( this->data_ptr, 1 );
-
-			// Construct the first value from the next value.
-			// This test is needed in cases where either the copy constructor or the move constructor has been explicitly deleted.
-			if constexpr( BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ValueType> )
-			{
-				new( &this->data_ptr[ 0 ] ) ValueType( std::move( this->data_ptr[ 1 ] ) );
-			}
-			else
+			if constexpr( IsTriviallyRelocatable<ValueType>::value )
 			{
-				new( &this->data_ptr[ 0 ] ) ValueType( this->data_ptr[ 1 ] );
+				if( !std::is_constant_evaluated() )
+				{
+					this->DestructRange( this->data_ptr, 1 );
+					this->RelocateRange( this->data_ptr, this->data_ptr + 1, this->data_size - 1 );
+					this->data_size -= 1;
+					return;
+				}
 			}
-			// For the rest we can assign.
+
+			// Move every value one position to the front, the last value is left moved from and destructed when shrinking.
 			for( u64 i = 1; i < this->data_size; ++i )
 			{
 				// This test is needed in cases where either the copy constructor or the move constructor has been explicitly deleted.
 				if constexpr( BC_CONTAINER_IS_MOVE_ASSIGNABLE<ValueType> )
 				{
-					this->data_ptr[ i ] = std::move( this->data_ptr[ i + 1 ] );
+					this->data_ptr[ i - 1 ] = std::move( this->data_ptr[ i ] );
 				}
 				else
 				{
-					this->data_ptr[ i ] = this->data_ptr[ i + 1 ];
+					this->data_ptr[ i - 1 ] = this->data_ptr[ i ];
 				}
 			}
 			this->ResizeNoConstruct( this->data_size - 1, 0 );
@@ -11,6 +11,7 @@
 #endif
 
 #include <core/utility/concepts/CallableConcepts.hpp>
+#include <core/memory/allocator/ArenaAllocator.hpp>
 
 #include <core/containers/backend/ContainerImplAddDefinitions.hpp>
 
@@ -19,7 +20,7 @@ namespace bc {
 
 
 
-template<BC_CONTAINER_VALUE_TYPENAME ValueType>
+template<BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType = memory::HeapAllocator>
 class BC_CONTAINER_NAME( List );
 
 
@@ -73,7 +74,7 @@ private:
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
 	friend class BC_CONTAINER_NAME( ListViewBase );
 
-	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( List );
 
 	friend ConstIterator;
@@ -332,19 +333,22 @@ private:
 ///
 /// @tparam ValueType
 /// Type of the contained element.
-template<BC_CONTAINER_VALUE_TYPENAME ValueType>
+///
+/// @tparam AllocatorType
+/// Allocator used for the list memory, see memory::HeapAllocator and memory::ArenaAllocator.
+template<BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
 class BC_CONTAINER_NAME( List ) :
-	public container_bases::BC_CONTAINER_NAME( LinearContainerBase )<ValueType>
+	public container_bases::BC_CONTAINER_NAME( LinearContainerBase )<ValueType, AllocatorType>
 {
 public:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	using Base								= container_bases::BC_CONTAINER_NAME( LinearContainerBase )<ValueType>;
+	using Base								= container_bases::BC_CONTAINER_NAME( LinearContainerBase )<ValueType, AllocatorType>;
 	using ContainedValueType				= ValueType;
 	static constexpr bool IsDataConst		= false;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
-	using ThisContainerType					= BC_CONTAINER_NAME( List )<OtherValueType>;
+	using ThisContainerType					= BC_CONTAINER_NAME( List )<OtherValueType, AllocatorType>;
 	using ThisType							= ThisContainerType<ValueType>;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
@@ -354,7 +358,7 @@ public:
 	using ThisViewType						= ThisContainerViewType<ValueType, IsOtherConst>;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
-	using ThisContainerFullType				= BC_CONTAINER_NAME( List )<OtherValueType>;
+	using ThisContainerFullType				= BC_CONTAINER_NAME( List )<OtherValueType, AllocatorType>;
 	using ThisFullType						= ThisContainerFullType<ValueType>;
 
 	template<bool IsConst>
@@ -373,7 +377,7 @@ private:
 	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
 	friend class BC_CONTAINER_NAME( ListViewBase );
 
-	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	template<BC_CONTAINER_VALUE_TYPENAME OtherValueType, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( List );
 
 	friend ConstIterator;
@@ -384,10 +388,23 @@ public:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( List )() noexcept = default;
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs an empty list which allocates with the given allocator.
+	///
+	/// @param allocator
+	/// Allocator for the list memory, eg. pointer to a memory::LinearArena with ArenaList.
+	constexpr explicit BC_CONTAINER_NAME( List )(
+		const AllocatorType																			&	allocator
+	) noexcept :
+		Base( allocator )
+	{}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( List )(
 		const BC_CONTAINER_NAME( List )																&	other
-	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ValueType> )
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ValueType> ) :
+		Base( other.GetAllocator() )
 	{
 		this->Append( other );
 	}
@@ -456,7 +473,8 @@ public:
 		if( other.Data() >= this->Data() && other.Data() < this->Data() + this->Size() )
 		{
 			// Other data is a part of this container, we'll need to do a copy first.
-			auto other_copy = BC_CONTAINER_NAME( List )<ValueType> { other };
+			auto other_copy = BC_CONTAINER_NAME( List )( this->GetAllocator() );
+			other_copy.Append( other );
 			*this = std::move( other_copy );
 			return *this;
 		}
@@ -783,6 +801,38 @@ public:
 		};
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Inserts another value at position.
+	///
+	///	This insert function moves the value, falls back to copying if move is not possible. Capacity is grown geometrically so
+	/// inserting values one at a time does not reallocate on every insert.
+	///
+	/// @param at
+	///	Iterator location where to insert the new value.
+	///
+	/// @param value
+	/// New value to insert.
+	///
+	/// @return
+	/// Iterator to the next value after inserted value, which is the original value that was occupying the spot that we inserted
+	/// into.
+	constexpr Iterator																					Insert(
+		ConstIterator																					at,
+		ValueType																					&&	value
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ValueType> || BC_CONTAINER_IS_MOVE_CONSTRUCTIBLE<ValueType> )
+	{
+		BC_ContainerAssert( at.GetContainer(), U"Iterator points to nothing" );
+		BC_ContainerAssert( at.GetContainer() == this, U"Iterator points to a wrong container" );
+		return Iterator {
+			this,
+			this->DoInsert(
+				at.GetAddress(),
+				std::move( value )
+			)
+		};
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
 	/// Inserts values from another container at position, optionally multiple times.
@@ -999,6 +1049,29 @@ using BC_CONTAINER_NAME( ListView ) = BC_CONTAINER_NAME( ListViewBase )<ValueTyp
 template<BC_CONTAINER_VALUE_TYPENAME ValueType>
 using BC_CONTAINER_NAME( EditableListView ) = BC_CONTAINER_NAME( ListViewBase )<ValueType, false>;
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// List which allocates from an arena, construct it with a pointer to the arena.
+///
+/// Growing the most recent allocation of the arena happens in place and the memory is freed all at once when the arena is
+/// reset, which makes these well suited for scratch lists.
+template<BC_CONTAINER_VALUE_TYPENAME ValueType, typename ArenaType = memory::LinearArena>
+using BC_CONTAINER_NAME( ArenaList ) = BC_CONTAINER_NAME( List )<ValueType, memory::ArenaAllocator<ArenaType>>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// List which allocates from a memory::StackAllocator, construct it with a pointer to the stack allocator.
+template<BC_CONTAINER_VALUE_TYPENAME ValueType>
+using BC_CONTAINER_NAME( StackList ) = BC_CONTAINER_NAME( List )<ValueType, memory::ArenaAllocator<memory::StackAllocator>>;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// List data lives on the heap, the list can be relocated as plain memory if its allocator can be.
+template<BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
+struct IsTriviallyRelocatable<BC_CONTAINER_NAME( List )<ValueType, AllocatorType>> : IsTriviallyRelocatable<AllocatorType> {};
+
 
 
 #if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
@@ -1009,6 +1082,7 @@ namespace tests {
 static_assert( sizeof( BC_CONTAINER_NAME( ListView )<u32> ) == 16 );
 static_assert( sizeof( BC_CONTAINER_NAME( EditableListView )<u32> ) == 16 );
 static_assert( sizeof( BC_CONTAINER_NAME( List )<u32> ) == 24 );
+static_assert( sizeof( BC_CONTAINER_NAME( ArenaList )<u32> ) == 32 );
 
 
 
@@ -1017,6 +1091,7 @@ static_assert( sizeof( BC_CONTAINER_NAME( List )<u32> ) == 24 );
 static_assert( utility::ContainerView<BC_CONTAINER_NAME( List )<u32>> );
 static_assert( utility::ContainerEditableView<BC_CONTAINER_NAME( List )<u32>> );
 static_assert( utility::Container<BC_CONTAINER_NAME( List )<u32>> );
+static_assert( utility::Container<BC_CONTAINER_NAME( ArenaList )<u32>> );
 
 static_assert( utility::ContainerView<BC_CONTAINER_NAME( EditableListView )<u32>> );
 static_assert( utility::ContainerEditableView<BC_CONTAINER_NAME( EditableListView )<u32>> );
@@ -1050,6 +1125,14 @@ static_assert( !utility::TextContainerView<BC_CONTAINER_NAME( ListView )<char32_
 static_assert( !utility::TextContainerEditableView<BC_CONTAINER_NAME( ListView )<char32_t>> );
 static_assert( !utility::TextContainer<BC_CONTAINER_NAME( ListView )<char32_t>> );
 
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if list containers can be relocated as plain memory.
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( List )<u32>>::value );
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( List )<BC_CONTAINER_NAME( List )<u32>>>::value );
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( ArenaList )<u32>>::value );
+
 } // tests
 #endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 
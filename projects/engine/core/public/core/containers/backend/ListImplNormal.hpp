@@ -0,0 +1,5 @@
+#pragma once
+
+// The purpose of this file is to make sure that the normal version of List is included exactly once, as implementation
+// file is designed to be included more than once for each version of container.
+#include <core/containers/backend/ListImpl.hpp>
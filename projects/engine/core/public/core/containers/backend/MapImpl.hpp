@@ -1,5 +1,6 @@
 
 #include <core/containers/backend/ContainerBase.hpp>
+#include <core/memory/allocator/ArenaAllocator.hpp>
 
 #if BC_CONTAINER_IMPLEMENTATION_NORMAL
 #include <core/containers/backend/PairImplNormal.hpp>
@@ -25,7 +26,7 @@ BC_CONTAINER_NAMESPACE_START;
 
 
 
-template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType>
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType = memory::HeapAllocator>
 class BC_CONTAINER_NAME( Map );
 
 
@@ -45,7 +46,7 @@ struct BC_CONTAINER_NAME( MapNode )
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, bool IsConst>
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, bool IsConst, typename AllocatorType = memory::HeapAllocator>
 class BC_CONTAINER_NAME( MapIteratorBase )
 {
 public:
@@ -60,13 +61,13 @@ public:
 private:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( MapIteratorBase );
 
-	friend class BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, true>;
-	friend class BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, false>;
+	friend class BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, true, AllocatorType>;
+	friend class BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, false, AllocatorType>;
 
-	using Container				= BC_CONTAINER_NAME( Map )<KeyType, ValueType>;
+	using Container				= BC_CONTAINER_NAME( Map )<KeyType, ValueType, AllocatorType>;
 	using Node					= container_bases::BC_CONTAINER_NAME( MapNode )<KeyType, ValueType>;
 
 public:
@@ -76,7 +77,7 @@ public:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	template<bool IsOtherConst>
 	constexpr BC_CONTAINER_NAME( MapIteratorBase )(
-		const BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsOtherConst>				&	other
+		const BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsOtherConst, AllocatorType>				&	other
 	) noexcept requires( utility::IsConstConvertible<IsConst, IsOtherConst> ) :
 		container( other.GetContainer() ),
 		node( const_cast<Node*>( other.GetData() ) )
@@ -118,7 +119,7 @@ public:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	template<bool IsOtherConst>
 	constexpr bool																						operator==(
-		BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsOtherConst>							other
+		BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsOtherConst, AllocatorType>							other
 	) const noexcept
 	{
 		return this->node == other.GetData();
@@ -127,7 +128,7 @@ public:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	template<bool IsOtherConst>
 	constexpr bool																						operator!=(
-		BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsOtherConst>							other
+		BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsOtherConst, AllocatorType>							other
 	) const noexcept
 	{
 		return this->node != other.GetData();
@@ -363,9 +364,12 @@ private:
 /// 
 /// @tparam ValueType
 ///	value Type
-template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType>
+///
+/// @tparam AllocatorType
+/// Allocator used for the map nodes, see memory::HeapAllocator and memory::ArenaAllocator.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
 class BC_CONTAINER_NAME( Map ) :
-	protected container_bases::ContainerResource
+	protected container_bases::ContainerResource<AllocatorType>
 {
 public:
 
@@ -377,7 +381,7 @@ public:
 	static constexpr bool IsDataConst		= false;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType>
-	using ThisContainerType					= BC_CONTAINER_NAME( Map )<OtherKeyType, OtherValueType>;
+	using ThisContainerType					= BC_CONTAINER_NAME( Map )<OtherKeyType, OtherValueType, AllocatorType>;
 	using ThisType							= ThisContainerType<KeyType, ValueType>;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
@@ -387,11 +391,11 @@ public:
 	using ThisViewType						= ThisContainerViewType<KeyType, ValueType, IsOtherConst>;
 
 	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType>
-	using ThisContainerFullType				= BC_CONTAINER_NAME( Map )<OtherKeyType, OtherValueType>;
+	using ThisContainerFullType				= BC_CONTAINER_NAME( Map )<OtherKeyType, OtherValueType, AllocatorType>;
 	using ThisFullType						= ThisContainerFullType<KeyType, ValueType>;
 
 	template<bool IsConst>
-	using IteratorBase						= container_bases::BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsConst>;
+	using IteratorBase						= container_bases::BC_CONTAINER_NAME( MapIteratorBase )<KeyType, ValueType, IsConst, AllocatorType>;
 	using ConstIterator						= IteratorBase<true>;
 	using Iterator							= IteratorBase<false>;
 
@@ -400,10 +404,10 @@ public:
 private:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst>
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, bool IsOtherConst, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( MapIteratorBase );
 
-	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType>
+	template<BC_CONTAINER_VALUE_TYPENAME OtherKeyType, BC_CONTAINER_VALUE_TYPENAME OtherValueType, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( Map );
 
 	friend ConstIterator;
@@ -430,6 +434,18 @@ public:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( Map )() = default;
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs an empty map which allocates with the given allocator.
+	///
+	/// @param allocator
+	/// Allocator for the map nodes, eg. pointer to a memory::LinearArena with ArenaMap.
+	constexpr explicit BC_CONTAINER_NAME( Map )(
+		const AllocatorType																			&	allocator
+	) noexcept :
+		container_bases::ContainerResource<AllocatorType>( allocator )
+	{}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( Map )(
 		const std::initializer_list<ContainedPairType>												&	init_list
@@ -441,7 +457,8 @@ public:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( Map )(
 		const BC_CONTAINER_NAME( Map )																&	other
-	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> )
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> ) :
+		container_bases::ContainerResource<AllocatorType>( other.GetAllocator() )
 	{
 		this->Append( other );
 	}
@@ -460,6 +477,54 @@ public:
 		this->Clear();
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs a map from pairs which are already sorted by key.
+	///
+	/// Builds a perfectly balanced tree in O(n) without comparing keys or rotating nodes, where inserting the pairs one at a
+	/// time would cost O(n log n) and rebalance the tree on every insert.
+	///
+	/// @note
+	/// Keys must be unique and in ascending order, this is checked in development builds only.
+	///
+	/// @tparam OtherContainerType
+	///	Type of container which elements are sorted pairs, eg. List of pairs, FlatMap or another Map.
+	///
+	/// @param sorted_pairs
+	///	Container of pairs in ascending key order.
+	///
+	/// @param allocator
+	/// Allocator for the map nodes.
+	///
+	/// @return
+	/// New map containing copies of the pairs.
+	template<utility::ContainerView OtherContainerType>
+	static constexpr BC_CONTAINER_NAME( Map )															FromSorted(
+		const OtherContainerType																	&	sorted_pairs,
+		const AllocatorType																			&	allocator				= AllocatorType()
+	) BC_CONTAINER_NOEXCEPT requires( BC_CONTAINER_IS_COPY_CONSTRUCTIBLE<ContainedPairType> && std::is_same_v<ContainedPairType, std::remove_cvref_t<decltype( *sorted_pairs.begin() )>> )
+	{
+		auto result = BC_CONTAINER_NAME( Map )( allocator );
+		u64 count = sorted_pairs.Size();
+		if( count == 0 ) return result;
+
+		#if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+		{
+			auto previous = sorted_pairs.begin();
+			auto current = previous;
+			for( ++current; current != sorted_pairs.end(); ++current, ++previous )
+			{
+				BC_ContainerAssert( previous->first < current->first, U"Cannot construct map from sorted pairs, keys must be unique and in ascending order" );
+			}
+		}
+		#endif
+
+		auto it = sorted_pairs.begin();
+		result.root_node = result.BuildBalancedSubtree( it, count, nullptr );
+		result.size = count;
+		return result;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( Map )																&	operator=(
 		const std::initializer_list<ContainedPairType>												&	other
@@ -477,8 +542,8 @@ public:
 	{
 		if( &other == this ) return *this;
 
-		this->Clear();
-		this->Append( other );
+		// Copy and swap, the allocator is copied along with the contents the same way as in the copy constructor.
+		this->SwapOther( BC_CONTAINER_NAME( Map ) { other } );
 		return *this;
 	}
 
@@ -491,6 +556,17 @@ public:
 		return *this;
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the allocator this map allocates its nodes with.
+	///
+	/// @return
+	/// Reference to the allocator.
+	constexpr const AllocatorType																	&	GetAllocator() const noexcept
+	{
+		return container_bases::ContainerResource<AllocatorType>::GetAllocator();
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
 	/// Extends this map with elements from an initializer list.
@@ -1007,7 +1083,7 @@ public:
 	{
 		if( this->size ) {
 			auto temp_node_list_size = this->size;
-			Node ** temp_node_list = this->AllocateMemory<Node*>( temp_node_list_size );
+			Node ** temp_node_list = this->template AllocateMemory<Node*>( temp_node_list_size );
 			auto it = this->begin();
 			for( u64 i = 0; i < this->size; ++i ) {
 				temp_node_list[ i ] = it.GetData();
@@ -1091,6 +1167,7 @@ private:
 	{
 		std::swap( this->size, other.size );
 		std::swap( this->root_node, other.root_node );
+		this->SwapAllocator( other );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1188,6 +1265,28 @@ private:
 		if( this->size > 2 ) this->BalanceTree( node );
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Builds a balanced subtree from the next count sorted pairs, middle pair becomes the subtree root.
+	template<typename SourceIteratorType>
+	constexpr Node																					*	BuildBalancedSubtree(
+		SourceIteratorType																			&	source_it,
+		u64																								count,
+		Node																						*	parent
+	) BC_CONTAINER_NOEXCEPT
+	{
+		if( count == 0 ) return nullptr;
+
+		u64 left_count = count / 2;
+		auto node = this->AllocateNode();
+		node->parent = parent;
+		node->left = this->BuildBalancedSubtree( source_it, left_count, node );
+		this->CopyConstructNode( node, *source_it );
+		++source_it;
+		node->right = this->BuildBalancedSubtree( source_it, count - left_count - 1, node );
+		this->RecalculateHeight( node );
+		return node;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr void																						RemoveNodeFromTree(
 		Node																						*	node
@@ -1352,7 +1451,7 @@ private:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr Node																					*	AllocateNode() BC_CONTAINER_NOEXCEPT
 	{
-		auto new_node = this->AllocateMemory<Node>( 1 );
+		auto new_node = this->template AllocateMemory<Node>( 1 );
 		new_node->parent		= nullptr;
 		new_node->left			= nullptr;
 		new_node->right			= nullptr;
@@ -1567,6 +1666,33 @@ private:
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Map which allocates its nodes from an arena, construct it with a pointer to the arena.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename ArenaType = memory::LinearArena>
+using BC_CONTAINER_NAME( ArenaMap ) = BC_CONTAINER_NAME( Map )<KeyType, ValueType, memory::ArenaAllocator<ArenaType>>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Map which allocates its nodes from a memory::StackAllocator, construct it with a pointer to the stack allocator.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType>
+using BC_CONTAINER_NAME( StackMap ) = BC_CONTAINER_NAME( Map )<KeyType, ValueType, memory::ArenaAllocator<memory::StackAllocator>>;
+
+
+
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Map nodes live on the heap and do not point back to the map, the map can be relocated as plain memory if its allocator can
+/// be.
+template<BC_CONTAINER_VALUE_TYPENAME KeyType, BC_CONTAINER_VALUE_TYPENAME ValueType, typename AllocatorType>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( Map )<KeyType, ValueType, AllocatorType>> : IsTriviallyRelocatable<AllocatorType> {};
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
 #if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 namespace tests {
 
@@ -1576,6 +1702,7 @@ static_assert( sizeof( container_bases::BC_CONTAINER_NAME( MapIteratorBase )<u32
 static_assert( sizeof( container_bases::BC_CONTAINER_NAME( MapIteratorBase )<u32, u32, false> ) == 16 );
 
 static_assert( sizeof( BC_CONTAINER_NAME( Map )<u32, u32> ) == 16 );
+static_assert( sizeof( BC_CONTAINER_NAME( ArenaMap )<u32, u32> ) == 24 );
 
 
 
@@ -1584,10 +1711,17 @@ static_assert( sizeof( BC_CONTAINER_NAME( Map )<u32, u32> ) == 16 );
 static_assert( utility::ContainerView<BC_CONTAINER_NAME( Map )<u32, u32>> );
 static_assert( utility::ContainerEditableView<BC_CONTAINER_NAME( Map )<u32, u32>> );
 static_assert( utility::Container<BC_CONTAINER_NAME( Map )<u32, u32>> );
+static_assert( utility::Container<BC_CONTAINER_NAME( ArenaMap )<u32, u32>> );
 static_assert( !utility::LinearContainerView<BC_CONTAINER_NAME( Map )<u32, u32>> );
 static_assert( !utility::LinearContainerEditableView<BC_CONTAINER_NAME( Map )<u32, u32>> );
 static_assert( !utility::LinearContainer<BC_CONTAINER_NAME( Map )<u32, u32>> );
 
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if map container can be relocated as plain memory.
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( Map )<u32, u32>>::value );
+
 } // tests
 #endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 
@@ -27,7 +27,7 @@ BC_CONTAINER_NAMESPACE_START;
 /// @tparam ValueType
 /// Type of the contained object/element.
 template<BC_CONTAINER_VALUE_TYPENAME ValueType>
-class BC_CONTAINER_NAME( Optional ) : private container_bases::ContainerResource
+class BC_CONTAINER_NAME( Optional ) : private container_bases::ContainerResource<>
 {
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	class NonTrivialType
@@ -308,6 +308,18 @@ private:
 
 
 
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Optional stores its value inline, it can be relocated as plain memory if the value can be.
+template<BC_CONTAINER_VALUE_TYPENAME ValueType>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( Optional )<ValueType>> : IsTriviallyRelocatable<ValueType> {};
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
 #if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 namespace tests {
 
@@ -122,6 +122,20 @@ public:
 
 
 
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Pair can be relocated as plain memory if both of its values can be.
+template<BC_CONTAINER_VALUE_TYPENAME FirstType, BC_CONTAINER_VALUE_TYPENAME SecondType>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( Pair )<FirstType, SecondType>> :
+	std::bool_constant<IsTriviallyRelocatable<FirstType>::value && IsTriviallyRelocatable<SecondType>::value>
+{};
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
 #if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 namespace tests {
 
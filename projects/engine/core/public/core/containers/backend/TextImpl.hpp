@@ -10,6 +10,8 @@
 #endif
 
 #include <core/conversion/text/utf/UTFConversion.hpp>
+#include <core/memory/allocator/ArenaAllocator.hpp>
+#include <core/utility/hash/Hash.hpp>
 
 #include <cuchar>
 #include <limits>
@@ -23,7 +25,7 @@ BC_CONTAINER_NAMESPACE_START;
 
 
 
-template<utility::TextContainerCharacterType CharacterType>
+template<utility::TextContainerCharacterType CharacterType, typename AllocatorType = memory::HeapAllocator>
 class BC_CONTAINER_NAME( TextBase );
 
 
@@ -74,7 +76,7 @@ private:
 	template<utility::TextContainerCharacterType OtherValueType, bool IsOtherConst>
 	friend class BC_CONTAINER_NAME( TextViewBase );
 
-	template<utility::TextContainerCharacterType OtherValueType>
+	template<utility::TextContainerCharacterType OtherValueType, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( TextBase );
 
 public:
@@ -742,20 +744,23 @@ public:
 /// 
 /// @tparam CharacterType
 /// Data type of single character.
-template<utility::TextContainerCharacterType CharacterType>
+///
+/// @tparam AllocatorType
+/// Allocator used for the text memory, see memory::HeapAllocator and memory::ArenaAllocator.
+template<utility::TextContainerCharacterType CharacterType, typename AllocatorType>
 class BC_CONTAINER_NAME( TextBase ) :
-	public container_bases::BC_CONTAINER_NAME( LinearContainerBase )<CharacterType>
+	public container_bases::BC_CONTAINER_NAME( LinearContainerBase )<CharacterType, AllocatorType>
 {
 public:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	using Base								= container_bases::BC_CONTAINER_NAME( LinearContainerBase )<CharacterType>;
+	using Base								= container_bases::BC_CONTAINER_NAME( LinearContainerBase )<CharacterType, AllocatorType>;
 	using ContainedValueType				= CharacterType;
 	using ContainedCharacterType			= CharacterType;
 	static constexpr bool IsDataConst		= false;
 
 	template<utility::TextContainerCharacterType OtherValueType>
-	using ThisContainerType					= BC_CONTAINER_NAME( TextBase )<OtherValueType>;
+	using ThisContainerType					= BC_CONTAINER_NAME( TextBase )<OtherValueType, AllocatorType>;
 	using ThisType							= ThisContainerType<CharacterType>;
 
 	template<utility::TextContainerCharacterType OtherValueType, bool IsOtherConst>
@@ -765,7 +770,7 @@ public:
 	using ThisViewType						= ThisContainerViewType<CharacterType, IsOtherConst>;
 
 	template<utility::TextContainerCharacterType OtherValueType>
-	using ThisContainerFullType				= BC_CONTAINER_NAME( TextBase )<OtherValueType>;
+	using ThisContainerFullType				= BC_CONTAINER_NAME( TextBase )<OtherValueType, AllocatorType>;
 	using ThisFullType						= ThisContainerFullType<CharacterType>;
 
 	template<bool IsOtherConst>
@@ -787,7 +792,7 @@ private:
 	template<utility::TextContainerCharacterType OtherValueType, bool IsOtherConst>
 	friend class BC_CONTAINER_NAME( TextViewBase );
 
-	template<utility::TextContainerCharacterType OtherValueType>
+	template<utility::TextContainerCharacterType OtherValueType, typename OtherAllocatorType>
 	friend class BC_CONTAINER_NAME( TextBase );
 
 public:
@@ -795,10 +800,23 @@ public:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( TextBase )() noexcept = default;
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs an empty text which allocates with the given allocator.
+	///
+	/// @param allocator
+	/// Allocator for the text memory, eg. pointer to a memory::LinearArena with ArenaText.
+	constexpr explicit BC_CONTAINER_NAME( TextBase )(
+		const AllocatorType																			&	allocator
+	) noexcept :
+		Base( allocator )
+	{}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	constexpr BC_CONTAINER_NAME( TextBase )(
 		const BC_CONTAINER_NAME( TextBase )															&	other
-	) BC_CONTAINER_NOEXCEPT
+	) BC_CONTAINER_NOEXCEPT :
+		Base( other.GetAllocator() )
 	{
 		this->Append( other, 1, 0 );
 	}
@@ -898,7 +916,8 @@ public:
 		if( other.Data() >= this->Data() && other.Data() < this->Data() + this->Size() )
 		{
 			// Other data is a part of this container, we'll need to do a copy first.
-			auto other_copy = BC_CONTAINER_NAME( TextBase )<CharacterType> { other };
+			auto other_copy = BC_CONTAINER_NAME( TextBase )( this->GetAllocator() );
+			other_copy.Append( other, 1, 0 );
 			*this = std::move( other_copy );
 			return *this;
 		}
@@ -2054,6 +2073,52 @@ using BC_CONTAINER_NAME( EditableTextView8	) = BC_CONTAINER_NAME( TextViewBase	)
 using BC_CONTAINER_NAME( EditableTextView16	) = BC_CONTAINER_NAME( TextViewBase	)<char16_t, false>;
 using BC_CONTAINER_NAME( EditableTextView32	) = BC_CONTAINER_NAME( TextViewBase	)<char32_t, false>;
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Texts which allocate from an arena, construct them with a pointer to the arena.
+using BC_CONTAINER_NAME( ArenaText			) = BC_CONTAINER_NAME( TextBase		)<char, memory::ArenaAllocator<memory::LinearArena>>;
+using BC_CONTAINER_NAME( ArenaText32		) = BC_CONTAINER_NAME( TextBase		)<char32_t, memory::ArenaAllocator<memory::LinearArena>>;
+using BC_CONTAINER_NAME( StackText			) = BC_CONTAINER_NAME( TextBase		)<char, memory::ArenaAllocator<memory::StackAllocator>>;
+using BC_CONTAINER_NAME( StackText32		) = BC_CONTAINER_NAME( TextBase		)<char32_t, memory::ArenaAllocator<memory::StackAllocator>>;
+
+
+
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Text data lives on the heap, the text can be relocated as plain memory if its allocator can be.
+template<utility::TextContainerCharacterType CharacterType, typename AllocatorType>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( TextBase )<CharacterType, AllocatorType>> : IsTriviallyRelocatable<AllocatorType> {};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Text is hashed by its characters, text and text views with the same characters result in the same hash.
+template<utility::TextContainerCharacterType CharacterType, typename AllocatorType>
+struct Hash<BC_CONTAINER_QUALIFIED_NAME( TextBase )<CharacterType, AllocatorType>>
+{
+	constexpr u64																						operator()(
+		const BC_CONTAINER_QUALIFIED_NAME( TextBase )<CharacterType, AllocatorType>					&	text
+	) const noexcept
+	{
+		return HashCharacters( text.Data(), text.Size() );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<utility::TextContainerCharacterType CharacterType, bool IsConst>
+struct Hash<BC_CONTAINER_QUALIFIED_NAME( TextViewBase )<CharacterType, IsConst>>
+{
+	constexpr u64																						operator()(
+		const BC_CONTAINER_QUALIFIED_NAME( TextViewBase )<CharacterType, IsConst>					&	text
+	) const noexcept
+	{
+		return HashCharacters( text.Data(), text.Size() );
+	}
+};
+
+BC_CONTAINER_NAMESPACE_START;
+
 
 
 #if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
@@ -2065,6 +2130,7 @@ static_assert( sizeof( BC_CONTAINER_NAME( Text ) ) == 24 );
 static_assert( sizeof( BC_CONTAINER_NAME( Text8 ) ) == 24 );
 static_assert( sizeof( BC_CONTAINER_NAME( Text16 ) ) == 24 );
 static_assert( sizeof( BC_CONTAINER_NAME( Text32 ) ) == 24 );
+static_assert( sizeof( BC_CONTAINER_NAME( ArenaText ) ) == 32 );
 
 static_assert( sizeof( BC_CONTAINER_NAME( TextView ) ) == 16 );
 static_assert( sizeof( BC_CONTAINER_NAME( TextView8 ) ) == 16 );
@@ -2079,6 +2145,7 @@ static_assert( utility::Container<BC_CONTAINER_NAME( Text )> );
 static_assert( utility::Container<BC_CONTAINER_NAME( Text8 )> );
 static_assert( utility::Container<BC_CONTAINER_NAME( Text16 )> );
 static_assert( utility::Container<BC_CONTAINER_NAME( Text32 )> );
+static_assert( utility::Container<BC_CONTAINER_NAME( ArenaText )> );
 
 static_assert( utility::ContainerEditableView<BC_CONTAINER_NAME( EditableTextView )> );
 static_assert( utility::ContainerEditableView<BC_CONTAINER_NAME( EditableTextView8 )> );
@@ -2157,6 +2224,14 @@ static_assert( utility::TextContainerView<BC_CONTAINER_NAME( TextView )> );
 static_assert( !utility::TextContainerEditableView<BC_CONTAINER_NAME( TextView )> );
 static_assert( !utility::TextContainer<BC_CONTAINER_NAME( TextView )> );
 
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if text containers can be relocated as plain memory.
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( Text )>::value );
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( Text32 )>::value );
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( StackText )>::value );
+
 } // tests
 #endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 
@@ -36,7 +36,7 @@ BC_CONTAINER_NAMESPACE_START;
 /// @tparam ValueType
 /// Type of the contained object/element.
 template<typename ValueType>
-class BC_CONTAINER_NAME( UniquePtr ) : private container_bases::ContainerResource
+class BC_CONTAINER_NAME( UniquePtr ) : private container_bases::ContainerResource<>
 {
 public:
 
@@ -325,6 +325,18 @@ private:
 
 
 
+BC_CONTAINER_NAMESPACE_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// UniquePtr only holds a pointer to the owned value, it can always be relocated as plain memory.
+template<typename ValueType>
+struct IsTriviallyRelocatable<BC_CONTAINER_QUALIFIED_NAME( UniquePtr )<ValueType>> : std::true_type {};
+
+BC_CONTAINER_NAMESPACE_START;
+
+
+
 #if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 namespace tests {
 
@@ -443,6 +455,12 @@ static_assert(
 
 
 
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check if container can be relocated as plain memory.
+static_assert( IsTriviallyRelocatable<BC_CONTAINER_NAME( UniquePtr )<u32>>::value );
+
 } // tests
 #endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
 
@@ -0,0 +1,5 @@
+#pragma once
+
+#define BC_CONTAINER_IMPLEMENTATION_SIMPLE 1
+#include <core/containers/backend/FlatMapImpl.hpp>
+#undef BC_CONTAINER_IMPLEMENTATION_SIMPLE
@@ -1,5 +1,5 @@
 #pragma once
 
 #define BC_CONTAINER_IMPLEMENTATION_SIMPLE 1
-#include <core/containers/backend/ListImpl.hpp>
+#include <core/containers/backend/ListImplSimple.hpp>
 #undef BC_CONTAINER_IMPLEMENTATION_SIMPLE
@@ -0,0 +1,468 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/diagnostic/assertion/Assert.hpp>
+#include <core/containers/List.hpp>
+#include <core/containers/Text.hpp>
+#include <core/containers/UniquePtr.hpp>
+#include <core/file/AsyncFileReaderCreateInfo.hpp>
+#include <core/thread/CoroutineTask.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+
+
+namespace bc {
+namespace thread {
+class ThreadPool;
+} // thread
+
+namespace file {
+
+
+
+class AsyncFileReader;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Read size meaning everything from the offset to the end of the file.
+constexpr u64											READ_TO_END						= ~u64( 0 );
+
+
+
+namespace internal_ {
+
+class FileBufferPool;
+class IoUringQueue;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// State of a single read, shared between the reader and the handles referring to it.
+///
+/// Reference counted, the reader holds one reference until the read has completed. Buffer is returned to the reader when the
+/// last reference is removed.
+struct BITCRAFTE_ENGINE_API FileReadState
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											AddReference()
+	{
+		reference_count.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void												RemoveReference();
+
+	AsyncFileReader									*	reader							= nullptr;
+	std::atomic<u32>									reference_count					= 1;
+	std::atomic_bool									is_done							= false;
+	thread::TaskEvent									completion_event;
+
+	i64													file_handle						= -1;
+	u8												*	buffer							= nullptr;
+	u64													offset							= 0;
+	u64													size							= 0;
+	u64													bytes_read						= 0;
+	i32													error_code						= 0;
+	bool												is_buffer_pooled				= false;
+
+	/// Position in the list of reads the io_uring queue has handed to the kernel, only valid while handed to the kernel.
+	u64													in_flight_index					= 0;
+};
+
+} // internal_
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Describes a single read for AsyncFileReader::ReadFilesAsync().
+struct FileReadRequest
+{
+	/// Path to the file, only needs to stay valid until the read has been submitted.
+	TextView32											file_path;
+
+	/// Offset in bytes from the start of the file where reading starts.
+	u64													offset							= 0;
+
+	/// Number of bytes to read, READ_TO_END reads the rest of the file. Reads stop early at the end of the file.
+	u64													size							= READ_TO_END;
+
+	/// Memory to read into, must hold at least size bytes and stay valid until the read has completed. If nullptr, the
+	/// reader provides a pooled buffer which lives as long as any handle to the read.
+	void											*	destination						= nullptr;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Handle to a file read started with AsyncFileReader.
+///
+/// Handles are cheap to copy, every copy refers to the same read. Coroutine tasks can co_await a handle, the task is queued again
+/// once the read has completed and worker threads are never blocked while waiting. Other threads can use Wait().
+///
+/// @warning
+/// Handles must not outlive the reader which created them.
+class FileReadHandle
+{
+	friend class AsyncFileReader;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	FileReadHandle() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline FileReadHandle(
+		const FileReadHandle						&	other
+	) :
+		state( other.state )
+	{
+		if( state ) state->AddReference();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline FileReadHandle(
+		FileReadHandle								&&	other
+	) noexcept :
+		state( std::exchange( other.state, nullptr ) )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline FileReadHandle							&	operator=(
+		const FileReadHandle						&	other
+	)
+	{
+		if( this == &other ) return *this;
+		if( other.state ) other.state->AddReference();
+		if( state ) state->RemoveReference();
+		state = other.state;
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline FileReadHandle							&	operator=(
+		FileReadHandle								&&	other
+	) noexcept
+	{
+		if( this == &other ) return *this;
+		if( state ) state->RemoveReference();
+		state = std::exchange( other.state, nullptr );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline												~FileReadHandle()
+	{
+		if( state ) state->RemoveReference();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Suspends a coroutine task until the read has completed.
+	///
+	/// Does not suspend if the read has already completed.
+	inline thread::TaskEvent::Awaiter					operator co_await() const noexcept
+	{
+		BAssert( state, U"Cannot await an empty file read handle" );
+		return thread::TaskEvent::Awaiter( state->completion_event );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the handle refers to a read.
+	inline bool											IsValid() const
+	{
+		return state != nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the read has completed, successfully or not, never blocks.
+	inline bool											IsDone() const
+	{
+		return state != nullptr && state->is_done.load( std::memory_order_acquire );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Blocks the calling thread until the read has completed.
+	///
+	/// @warning
+	/// Blocks a worker thread if called from a task, coroutine tasks should co_await the handle instead.
+	inline void											Wait() const
+	{
+		BAssert( state, U"Cannot wait for an empty file read handle" );
+		while( !state->is_done.load( std::memory_order_acquire ) )
+		{
+			state->is_done.wait( false, std::memory_order_acquire );
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the read failed, Eg. the file could not be opened.
+	///
+	/// @warning
+	/// Only meaningful once the read has completed.
+	inline bool											HasFailed() const
+	{
+		return state == nullptr || state->error_code != 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the operating system error code of a failed read.
+	///
+	/// @return
+	/// errno on Linux, GetLastError() on Windows, 0 if the read did not fail.
+	inline i32											GetErrorCode() const
+	{
+		return state ? state->error_code : 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the memory the file was read into.
+	///
+	/// @warning
+	/// Only meaningful once the read has completed.
+	///
+	/// @return
+	/// Pointer to the destination given to the read, or to the pooled buffer which stays valid as long as any handle to the read
+	/// exists.
+	inline const u8									*	GetData() const
+	{
+		return state ? state->buffer : nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of bytes read.
+	///
+	/// @warning
+	/// Only meaningful once the read has completed.
+	///
+	/// @return
+	/// Requested size, or less if the end of the file was reached or the read failed.
+	inline u64											GetSize() const
+	{
+		return state ? state->bytes_read : 0;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline explicit FileReadHandle(
+		internal_::FileReadState					*	state
+	) :
+		state( state )
+	{
+		state->AddReference();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	internal_::FileReadState						*	state							= nullptr;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads files asynchronously without blocking worker threads.
+///
+/// On Linux reads are batched into an io_uring submission queue, a single completion thread reaps finished reads and queues the
+/// coroutine tasks awaiting them. Where io_uring is not available reads fall back to blocking reads inside thread pool tasks.
+///
+/// Files are read straight into caller provided memory or into pooled buffers, data is never copied after the read. Files are
+/// opened by the thread starting the read.
+///
+/// For example:<br>
+///		auto reader = AsyncFileReader( *thread_pool );
+///		thread_pool->ScheduleCoroutineTask( [ &reader ]() -> CoroutineTask
+///			{
+///				auto handle = reader.ReadFileAsync( U"assets/level.bin" );
+///				co_await handle;
+///				if( !handle.HasFailed() ) LoadLevel( handle.GetData(), handle.GetSize() );
+///			}
+///		);
+class BITCRAFTE_ENGINE_API AsyncFileReader
+{
+	friend struct internal_::FileReadState;
+	friend class internal_::IoUringQueue;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs the reader.
+	///
+	/// @param thread_pool
+	/// Thread pool running the fallback reads, must outlive the reader.
+	///
+	/// @param create_info
+	/// Settings for the reader.
+	AsyncFileReader(
+		thread::ThreadPool							&	thread_pool,
+		const AsyncFileReaderCreateInfo				&	create_info						= {}
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	AsyncFileReader(
+		const AsyncFileReader						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	AsyncFileReader(
+		AsyncFileReader								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits for every read in flight to complete.
+	///
+	/// @warning
+	/// Every handle must have been destroyed by now. Must not be called from a thread pool task, fallback reads may need the
+	/// worker thread to complete.
+	~AsyncFileReader();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	AsyncFileReader								&	operator=(
+		const AsyncFileReader						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	AsyncFileReader								&	operator=(
+		AsyncFileReader								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Starts reading a file into a pooled buffer.
+	///
+	/// @param file_path
+	/// Path to the file.
+	///
+	/// @param offset
+	/// Offset in bytes from the start of the file where reading starts.
+	///
+	/// @param size
+	/// Number of bytes to read, READ_TO_END reads the rest of the file.
+	///
+	/// @return
+	/// Handle to the read. If the file cannot be opened the handle is already done and HasFailed() returns true.
+	FileReadHandle										ReadFileAsync(
+		TextView32										file_path,
+		u64												offset							= 0,
+		u64												size							= READ_TO_END
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Starts reading a file into caller provided memory.
+	///
+	/// @param file_path
+	/// Path to the file.
+	///
+	/// @param offset
+	/// Offset in bytes from the start of the file where reading starts.
+	///
+	/// @param size
+	/// Number of bytes to read, must not be READ_TO_END.
+	///
+	/// @param destination
+	/// Memory to read into, must hold at least size bytes and stay valid until the read has completed.
+	///
+	/// @return
+	/// Handle to the read.
+	FileReadHandle										ReadFileAsync(
+		TextView32										file_path,
+		u64												offset,
+		u64												size,
+		void										*	destination
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Starts several reads at once.
+	///
+	/// Reads are submitted to the kernel together, which is cheaper than starting them one by one.
+	///
+	/// @param requests
+	/// Reads to start.
+	///
+	/// @return
+	/// Handle to each read, in the same order as requests.
+	List<FileReadHandle>								ReadFilesAsync(
+		const List<FileReadRequest>					&	requests
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if reads go through io_uring.
+	///
+	/// @return
+	/// False if io_uring was disabled in the create info, is not supported by the system or has failed. Reads then fall back
+	/// to blocking reads in thread pool tasks.
+	bool												IsUsingIoUring() const;
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Opens the file and prepares the read state, completes the read right away if there is nothing to read.
+	///
+	/// @return
+	/// State with one reference held by the reader, or nullptr if the read already completed.
+	internal_::FileReadState						*	PrepareRead(
+		const FileReadRequest						&	request,
+		FileReadHandle								&	out_handle
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void												SubmitReads(
+		internal_::FileReadState			* const	*	states,
+		u64												count
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Does a blocking read, used when io_uring is not available.
+	void												ReadBlocking(
+		internal_::FileReadState					*	state
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Closes the file, wakes everyone waiting for the read and drops the reference held by the reader.
+	void												CompleteRead(
+		internal_::FileReadState					*	state
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void												DestroyReadState(
+		internal_::FileReadState					*	state
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	thread::ThreadPool								&	thread_pool;
+	AsyncFileReaderCreateInfo							create_info;
+
+	UniquePtr<internal_::FileBufferPool>				buffer_pool;
+	UniquePtr<internal_::IoUringQueue>					io_uring_queue;
+
+	std::atomic<u64>									live_state_count				= 0;
+
+	std::mutex											active_read_mutex;
+	std::condition_variable								active_read_condition;
+	u64													active_read_count				= 0;
+};
+
+
+
+} // file
+} // bc
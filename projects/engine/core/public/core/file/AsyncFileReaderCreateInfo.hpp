@@ -0,0 +1,35 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/thread/TaskPriority.hpp>
+
+
+
+namespace bc {
+namespace file {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct AsyncFileReaderCreateInfo
+{
+	/// If true, reads are submitted to the kernel through io_uring where it is available. Otherwise, or if io_uring cannot be
+	/// set up, every read is a blocking read inside a thread pool task.
+	bool											use_io_uring					= true;
+
+	/// Number of io_uring submission queue entries. Up to twice as many reads can be in flight, further reads wait in a
+	/// pending list until earlier reads complete.
+	u32												queue_depth						= 256;
+
+	/// Number of free buffers kept for reuse in each buffer size class. Buffers are only pooled for reads which do not
+	/// provide their own destination.
+	u32												pooled_buffers_per_size_class	= 32;
+
+	/// Priority of the thread pool tasks doing blocking reads when io_uring is not used.
+	thread::TaskPriority							fallback_task_priority			= thread::TaskPriority::NORMAL;
+};
+
+
+
+} // file
+} // bc
@@ -5,6 +5,7 @@
 #include <core/math/SmallValues.hpp>
 #include <core/math/FundamentalComparison.hpp>
 #include <core/diagnostic/exception/Exception.hpp>
+#include <core/utility/hash/Hash.hpp>
 
 #include <cstdint>
 #include <type_traits>
@@ -964,4 +965,30 @@ static_assert( alignof( Vec4u64 ) == alignof( u64 ) * 4 );
 
 
 } // math
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Vectors are hashed by their components.
+///
+/// @note
+/// Floating point vectors compare equal within a tolerance, but only vectors with exactly the same components are guaranteed
+/// to result in the same hash.
+template<u64 DimensionCount, utility::FundamentalValue ValueType>
+struct Hash<math::VectorBase<DimensionCount, ValueType>>
+{
+	constexpr u64															operator()(
+		math::VectorBase<DimensionCount, ValueType>							value
+	) const noexcept
+	{
+		auto hash = HashCombine( Hash<ValueType> {}( value.x ), Hash<ValueType> {}( value.y ) );
+		if constexpr( DimensionCount >= 3 ) hash = HashCombine( hash, Hash<ValueType> {}( value.z ) );
+		if constexpr( DimensionCount >= 4 ) hash = HashCombine( hash, Hash<ValueType> {}( value.w ) );
+		return hash;
+	}
+};
+
+
+
 } // bc
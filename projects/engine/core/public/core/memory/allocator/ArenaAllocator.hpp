@@ -0,0 +1,167 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/data_types/FundamentalTypes.hpp>
+#include <core/diagnostic/assertion/HardAssert.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+
+
+namespace bc {
+namespace memory {
+
+class LinearArena;
+class StackAllocator;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Container allocator which allocates from an arena, eg. LinearArena or StackAllocator.
+///
+/// Arena allocations have no allocation header and freeing them is usually a no-op, memory is given back all at once when the
+/// arena is reset or rewound. Only the most recent allocation of the arena can grow in place, which is exactly what a single
+/// growing scratch container needs.
+///
+/// Without an arena, or when evaluated at compile time, allocations go to the engine heap like with HeapAllocator.
+///
+/// @warning
+/// Containers using an arena must not be used after the arena has been reset or rewound past their allocations. Copies and
+/// moves take the allocator of the source container with them.
+///
+/// @tparam ArenaType
+/// Arena type, must provide Allocate(), Free(), IsResizeableInPlace() and ResizeInPlace().
+template<typename ArenaType>
+class ArenaAllocator
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ArenaAllocator() noexcept = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ArenaAllocator(
+		ArenaType									*	arena
+	) noexcept :
+		arena( arena )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr bool										operator==(
+		const ArenaAllocator						&	other
+	) const noexcept = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	constexpr ArenaType								*	GetArena() const noexcept
+	{
+		return arena;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	[[nodiscard]]
+	constexpr ValueType								*	AllocateMemory(
+		u64												count
+	) const noexcept
+	{
+		if( std::is_constant_evaluated() || arena == nullptr )
+		{
+			return memory::AllocateMemory<ValueType>( count, alignof( ValueType ) );
+		}
+
+		BHardAssert( count > 0, U"Cannot allocate arena memory, new element count must be larger than 0" );
+		BHardAssert( count < 0x0000FFFFFFFFFFFF, U"Cannot allocate arena memory, new element count too high, something is not right" );
+
+		return reinterpret_cast<ValueType*>( arena->Allocate( count * sizeof( ValueType ), alignof( ValueType ) ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	[[nodiscard]]
+	constexpr ValueType								*	ReallocateMemory(
+		ValueType									*	old_location,
+		u64												old_count,
+		u64												new_count
+	) const noexcept
+	{
+		static_assert( std::is_trivial_v<ValueType> || IsTriviallyRelocatable<ValueType>::value, "Type must be trivial or trivially relocatable for it to be reallocated via this function" );
+
+		if( std::is_constant_evaluated() || arena == nullptr )
+		{
+			return memory::ReallocateMemory<ValueType>( old_location, old_count, new_count );
+		}
+
+		if( arena->IsResizeableInPlace( old_location, new_count * sizeof( ValueType ) ) )
+		{
+			arena->ResizeInPlace( old_location, new_count * sizeof( ValueType ) );
+			return old_location;
+		}
+
+		auto new_location = reinterpret_cast<ValueType*>( arena->Allocate( new_count * sizeof( ValueType ), alignof( ValueType ) ) );
+		std::memcpy( static_cast<void*>( new_location ), static_cast<const void*>( old_location ), std::min( old_count, new_count ) * sizeof( ValueType ) );
+		arena->Free( old_location, old_count * sizeof( ValueType ) );
+		return new_location;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	constexpr void										FreeMemory(
+		ValueType									*	location,
+		u64												count
+	) const noexcept
+	{
+		if( std::is_constant_evaluated() || arena == nullptr )
+		{
+			memory::FreeMemory<ValueType>( location, count );
+			return;
+		}
+
+		arena->Free( location, count * sizeof( ValueType ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	constexpr bool										IsInPlaceReallocateable(
+		const ValueType								*	location,
+		u64												new_count
+	) const
+	{
+		if( std::is_constant_evaluated() || arena == nullptr )
+		{
+			return memory::IsInPlaceReallocateable<ValueType>( location, new_count );
+		}
+
+		return arena->IsResizeableInPlace( location, new_count * sizeof( ValueType ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	constexpr ValueType								*	InPlaceReallocateMemory(
+		ValueType									*	old_location,
+		u64												old_count,
+		u64												new_count
+	) const
+	{
+		if( std::is_constant_evaluated() || arena == nullptr )
+		{
+			return memory::InPlaceReallocateMemory<ValueType>( old_location, old_count, new_count );
+		}
+
+		arena->ResizeInPlace( old_location, new_count * sizeof( ValueType ) );
+		return old_location;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	ArenaType										*	arena								= nullptr;
+};
+
+
+
+} // memory
+} // bc
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/data_types/FundamentalTypes.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <type_traits>
+
+
+
+namespace bc {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Default container allocator, allocates from the engine heap.
+///
+/// Containers take their allocator as a template parameter. Allocators are small value types which are stored inside the
+/// container, HeapAllocator has no state so it takes no space in the container.
+///
+/// Every allocator provides the same set of functions, they work both at runtime and at compile time.
+///
+/// @see
+/// ArenaAllocator.
+class HeapAllocator
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	[[nodiscard]]
+	constexpr ValueType								*	AllocateMemory(
+		u64												count
+	) const noexcept
+	{
+		return memory::AllocateMemory<ValueType>( count, alignof( ValueType ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	[[nodiscard]]
+	constexpr ValueType								*	ReallocateMemory(
+		ValueType									*	old_location,
+		u64												old_count,
+		u64												new_count
+	) const noexcept
+	{
+		return memory::ReallocateMemory<ValueType>( old_location, old_count, new_count );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	constexpr void										FreeMemory(
+		ValueType									*	location,
+		u64												count
+	) const noexcept
+	{
+		memory::FreeMemory<ValueType>( location, count );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	constexpr bool										IsInPlaceReallocateable(
+		const ValueType								*	location,
+		u64												new_count
+	) const
+	{
+		return memory::IsInPlaceReallocateable<ValueType>( location, new_count );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ValueType>
+	constexpr ValueType								*	InPlaceReallocateMemory(
+		ValueType									*	old_location,
+		u64												old_count,
+		u64												new_count
+	) const
+	{
+		return memory::InPlaceReallocateMemory<ValueType>( old_location, old_count, new_count );
+	}
+};
+static_assert( std::is_empty_v<HeapAllocator> );
+
+
+
+} // memory
+} // bc
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/data_types/FundamentalTypes.hpp>
+#include <core/diagnostic/assertion/HardAssert.hpp>
+#include <core/memory/allocator/ArenaAllocator.hpp>
+
+#include <stdint.h>
+
+
+
+namespace bc {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Bump allocator for short lived memory, eg. scratch memory that lives for a single frame.
+///
+/// Allocations are carved out of blocks allocated from the engine heap, a new block is chained when the current one runs out.
+/// Individual allocations are not freed, everything is given back at once with Reset(). When a reset finds more than one block,
+/// the blocks are merged into a single block large enough to hold all of them so the next frame does not need to chain blocks.
+///
+/// Containers can allocate from a LinearArena through ArenaAllocator, eg. ArenaList.
+///
+/// @note
+/// Multithreading: Not thread safe, use one arena per thread.
+class BITCRAFTE_ENGINE_API LinearArena
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Size of the first block if the size is not given.
+	static constexpr u64								DEFAULT_BLOCK_SIZE				= 64 * 1024;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @param block_size
+	/// Minimum size of each block in bytes. Allocations larger than this get a block of their own. Blocks are allocated on first
+	/// use.
+	explicit LinearArena(
+		u64												block_size						= DEFAULT_BLOCK_SIZE
+	) noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	LinearArena(
+		const LinearArena							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	LinearArena(
+		LinearArena									&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	~LinearArena() noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	LinearArena										&	operator=(
+		const LinearArena							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	LinearArena										&	operator=(
+		LinearArena									&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Allocates memory from the arena.
+	///
+	/// @param size
+	/// Size of the allocation in bytes.
+	///
+	/// @param alignment
+	/// Alignment requirement of the allocation, must be a power of two.
+	///
+	/// @return
+	/// Pointer to the allocated memory.
+	[[nodiscard]]
+	inline void										*	Allocate(
+		u64												size,
+		u64												alignment
+	) noexcept
+	{
+		BHardAssert( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0, U"Cannot allocate arena memory, alignment must be a power of two" );
+
+		auto aligned_position = ( position + alignment - 1 ) & ~uintptr_t( alignment - 1 );
+		if( aligned_position <= block_end && size <= block_end - aligned_position ) [[likely]]
+		{
+			last_allocation	= aligned_position;
+			position		= aligned_position + size;
+			return reinterpret_cast<void*>( aligned_position );
+		}
+		return AllocateFromNewBlock( size, alignment );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Frees memory from the arena.
+	///
+	/// Only the most recent allocation is given back to the arena, freeing anything else does nothing until Reset() is called.
+	///
+	/// @param location
+	/// Pointer to the allocated memory.
+	///
+	/// @param size
+	/// Size of the allocation in bytes.
+	inline void											Free(
+		void										*	location,
+		u64												size
+	) noexcept
+	{
+		if( reinterpret_cast<uintptr_t>( location ) != last_allocation ) return;
+
+		position		= last_allocation;
+		last_allocation	= 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if an allocation can be resized without moving it.
+	///
+	/// @param location
+	/// Pointer to the allocated memory.
+	///
+	/// @param new_size
+	/// New size of the allocation in bytes.
+	///
+	/// @return
+	/// True if location is the most recent allocation and the new size fits in the current block.
+	inline bool											IsResizeableInPlace(
+		const void									*	location,
+		u64												new_size
+	) const noexcept
+	{
+		return reinterpret_cast<uintptr_t>( location ) == last_allocation && new_size <= block_end - last_allocation;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Resizes an allocation without moving it, IsResizeableInPlace() must be true.
+	///
+	/// @param location
+	/// Pointer to the allocated memory.
+	///
+	/// @param new_size
+	/// New size of the allocation in bytes.
+	inline void											ResizeInPlace(
+		void										*	location,
+		u64												new_size
+	) noexcept
+	{
+		BHardAssert( IsResizeableInPlace( location, new_size ), U"Cannot resize arena allocation in place, allocation is not the most recent one or it does not fit" );
+
+		position = last_allocation + new_size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gives all allocations back to the arena.
+	///
+	/// @warning
+	/// All memory allocated from this arena becomes invalid, including the memory of containers which allocate from it.
+	void												Reset() noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of bytes allocated since the last reset, including alignment padding.
+	///
+	/// @return
+	/// Number of bytes in use.
+	u64													GetUsedSize() const noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of bytes reserved from the engine heap.
+	///
+	/// @return
+	/// Total size of all blocks.
+	u64													GetReservedSize() const noexcept;
+
+private:
+
+	struct BlockHeader;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void											*	AllocateFromNewBlock(
+		u64												size,
+		u64												alignment
+	) noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void												StartBlock(
+		u64												size
+	) noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void												FreeBlocks() noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	uintptr_t											position						= 0;
+	uintptr_t											block_end						= 0;
+	uintptr_t											last_allocation					= 0;
+	BlockHeader										*	current_block					= nullptr;
+	u64													block_size						= 0;
+	u64													reserved_size					= 0;
+	u64													retired_used_size				= 0;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Container allocator which allocates from a LinearArena.
+using LinearArenaAllocator								= ArenaAllocator<LinearArena>;
+
+
+
+} // memory
+} // bc
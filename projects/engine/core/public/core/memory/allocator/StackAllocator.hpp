@@ -0,0 +1,271 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/data_types/FundamentalTypes.hpp>
+#include <core/diagnostic/assertion/HardAssert.hpp>
+#include <core/memory/allocator/ArenaAllocator.hpp>
+
+#include <stdint.h>
+
+
+
+namespace bc {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Position in a StackAllocator, everything allocated after a marker is freed at once by rewinding to it.
+using StackAllocatorMarker								= u64;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Fixed capacity bump allocator which frees in last in, first out order using markers.
+///
+/// Take a marker with GetMarker() before a group of allocations and rewind to it with RewindToMarker() when they are no longer
+/// needed, or use StackAllocatorScope which does both. Scopes can be nested.
+///
+/// Containers can allocate from a StackAllocator through ArenaAllocator, eg. StackList.
+///
+/// @warning
+/// Running out of capacity is a fatal error, size the allocator for the worst case.
+///
+/// @note
+/// Multithreading: Not thread safe, use one stack allocator per thread.
+class BITCRAFTE_ENGINE_API StackAllocator
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @param capacity
+	/// Size of the stack in bytes, allocated from the engine heap up front.
+	explicit StackAllocator(
+		u64												capacity
+	) noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	StackAllocator(
+		const StackAllocator						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	StackAllocator(
+		StackAllocator								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	~StackAllocator() noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	StackAllocator									&	operator=(
+		const StackAllocator						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	StackAllocator									&	operator=(
+		StackAllocator								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Allocates memory from the top of the stack.
+	///
+	/// @param size
+	/// Size of the allocation in bytes.
+	///
+	/// @param alignment
+	/// Alignment requirement of the allocation, must be a power of two.
+	///
+	/// @return
+	/// Pointer to the allocated memory.
+	[[nodiscard]]
+	inline void										*	Allocate(
+		u64												size,
+		u64												alignment
+	) noexcept
+	{
+		BHardAssert( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0, U"Cannot allocate stack memory, alignment must be a power of two" );
+
+		auto aligned_position = ( position + alignment - 1 ) & ~uintptr_t( alignment - 1 );
+		if( aligned_position > stack_end || size > stack_end - aligned_position ) [[unlikely]]
+		{
+			diagnostic::Panic( U"Stack allocator out of capacity" );
+		}
+
+		last_allocation	= aligned_position;
+		position		= aligned_position + size;
+		return reinterpret_cast<void*>( aligned_position );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Frees memory from the stack.
+	///
+	/// Only the most recent allocation is given back, anything else is freed when rewinding to a marker taken before it.
+	///
+	/// @param location
+	/// Pointer to the allocated memory.
+	///
+	/// @param size
+	/// Size of the allocation in bytes.
+	inline void											Free(
+		void										*	location,
+		u64												size
+	) noexcept
+	{
+		if( reinterpret_cast<uintptr_t>( location ) != last_allocation ) return;
+
+		position		= last_allocation;
+		last_allocation	= 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if an allocation can be resized without moving it.
+	///
+	/// @param location
+	/// Pointer to the allocated memory.
+	///
+	/// @param new_size
+	/// New size of the allocation in bytes.
+	///
+	/// @return
+	/// True if location is the most recent allocation and the new size fits in the remaining capacity.
+	inline bool											IsResizeableInPlace(
+		const void									*	location,
+		u64												new_size
+	) const noexcept
+	{
+		return reinterpret_cast<uintptr_t>( location ) == last_allocation && new_size <= stack_end - last_allocation;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Resizes an allocation without moving it, IsResizeableInPlace() must be true.
+	///
+	/// @param location
+	/// Pointer to the allocated memory.
+	///
+	/// @param new_size
+	/// New size of the allocation in bytes.
+	inline void											ResizeInPlace(
+		void										*	location,
+		u64												new_size
+	) noexcept
+	{
+		BHardAssert( IsResizeableInPlace( location, new_size ), U"Cannot resize stack allocation in place, allocation is not the most recent one or it does not fit" );
+
+		position = last_allocation + new_size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the current top of the stack.
+	///
+	/// @return
+	/// Marker which can be given to RewindToMarker().
+	inline StackAllocatorMarker							GetMarker() const noexcept
+	{
+		return position - stack_start;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Frees everything allocated after the marker was taken.
+	///
+	/// @warning
+	/// Memory allocated after the marker becomes invalid, including the memory of containers which allocate from this stack.
+	///
+	/// @param marker
+	/// Marker received from GetMarker(), must not be above the current top of the stack.
+	void												RewindToMarker(
+		StackAllocatorMarker							marker
+	) noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of bytes in use, including alignment padding.
+	///
+	/// @return
+	/// Number of bytes between the bottom and the top of the stack.
+	inline u64											GetUsedSize() const noexcept
+	{
+		return position - stack_start;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the capacity of the stack.
+	///
+	/// @return
+	/// Size of the stack in bytes.
+	inline u64											GetCapacity() const noexcept
+	{
+		return stack_end - stack_start;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	uintptr_t											stack_start						= 0;
+	uintptr_t											stack_end						= 0;
+	uintptr_t											position						= 0;
+	uintptr_t											last_allocation					= 0;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Frees everything allocated from a StackAllocator during the lifetime of the scope.
+///
+/// Containers which allocate from the stack inside the scope must be destroyed before the scope ends.
+class StackAllocatorScope
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline explicit StackAllocatorScope(
+		StackAllocator								&	stack_allocator
+	) noexcept :
+		stack_allocator( stack_allocator ),
+		marker( stack_allocator.GetMarker() )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	StackAllocatorScope(
+		const StackAllocatorScope					&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~StackAllocatorScope() noexcept
+	{
+		stack_allocator.RewindToMarker( marker );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	StackAllocatorScope								&	operator=(
+		const StackAllocatorScope					&	other
+	) = delete;
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	StackAllocator									&	stack_allocator;
+	StackAllocatorMarker								marker;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Container allocator which allocates from a StackAllocator.
+using StackArenaAllocator								= ArenaAllocator<StackAllocator>;
+
+
+
+} // memory
+} // bc
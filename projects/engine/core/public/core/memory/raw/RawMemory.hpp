@@ -4,9 +4,12 @@
 #include <core/diagnostic/assertion/HardAssert.hpp>
 
 #include <core/data_types/FundamentalTypes.hpp>
+#include <core/memory/tracking/MemoryTag.hpp>
+#include <core/utility/template/TriviallyRelocatable.hpp>
 
 #include <type_traits>
 #include <memory>
+#include <optional>
 #include <stdint.h>
 #include <assert.h>
 
@@ -30,13 +33,73 @@ struct alignas( 64 ) MemoryAllocationHeader
 	u64							payload_size					= 0;
 	u64							payload_alignment_requirement	= 0;
 
-	u64							reserved[ 2 ]					= {};
+	MemoryTag					tag								= MemoryTag::UNTAGGED;
+	u32							reserved_0						= 0;
+	u64							reserved_1						= 0;
 
 	u64							checksum						= 0;
 };
 static_assert( sizeof( MemoryAllocationHeader ) == 64 );
 static_assert( alignof( MemoryAllocationHeader ) == 64 );
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Smaller allocation header used in front of small allocations with an alignment requirement of 16 or less.
+///
+/// Compact headers are only used outside of development builds, development builds always use the full
+/// MemoryAllocationHeader so that the checksum can catch invalid pointers. The system allocation always starts right in front
+/// of the compact header and is aligned to alignof( MemoryAllocationHeader ), so a payload behind a compact header is never
+/// aligned to 64 bytes while a payload behind a full header always is, which tells the two apart.
+struct alignas( 16 ) CompactMemoryAllocationHeader
+{
+	u32							system_allocation_size			= 0;
+	u32							payload_size					= 0;
+	u32							payload_alignment_requirement	= 0;
+	u32							reserved						= 0;
+};
+static_assert( sizeof( CompactMemoryAllocationHeader ) == 16 );
+static_assert( alignof( CompactMemoryAllocationHeader ) == 16 );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Largest system allocation that uses a CompactMemoryAllocationHeader, the full header is insignificant for anything larger.
+constexpr u64											COMPACT_MEMORY_ALLOCATION_HEADER_MAX_SYSTEM_SIZE	= 256 * 1024;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Checks if an allocation uses a CompactMemoryAllocationHeader instead of the full MemoryAllocationHeader.
+///
+/// The decision only depends on values that never change during the lifetime of the allocation so that in-place reallocation
+/// keeps the payload where it is.
+///
+/// @param system_allocated_size
+/// Size of the memory allocated from underlaying system in bytes.
+///
+/// @param payload_alignment_requirement
+/// Alignment requirement for the payload.
+///
+/// @return
+/// True if the allocation uses a compact header, always false in development builds.
+inline bool												IsCompactMemoryAllocationHeaderUsed(
+	u64													system_allocated_size,
+	u64													payload_alignment_requirement
+)
+{
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	// Development builds always use the full header so that the checksum is available.
+	return false;
+
+	#else
+
+	return
+		payload_alignment_requirement <= alignof( CompactMemoryAllocationHeader ) &&
+		system_allocated_size <= COMPACT_MEMORY_ALLOCATION_HEADER_MAX_SYSTEM_SIZE;
+
+	#endif
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +195,9 @@ inline u64												CalculateMinimumRequiredSystemMemoryAllocationSize(
 	u64													payload_alignment_requirement
 )
 {
+	auto compact_allocation_size = payload_size + sizeof( CompactMemoryAllocationHeader );
+	if( IsCompactMemoryAllocationHeaderUsed( compact_allocation_size, payload_alignment_requirement ) ) return compact_allocation_size;
+
 	if( payload_alignment_requirement < alignof( MemoryAllocationHeader ) ) payload_alignment_requirement = alignof( MemoryAllocationHeader );
 	auto minimum_allocation_size = payload_size + payload_alignment_requirement + sizeof( MemoryAllocationHeader );
 
@@ -161,13 +227,17 @@ inline u64												CalculateMinimumRequiredSystemMemoryAllocationSize(
 /// @param payload_alignment_requirement
 /// Alignment requirement for the payload.
 ///
+/// @param tag
+/// Memory tag of the allocation, only stored in the full MemoryAllocationHeader.
+///
 /// @return
 /// New allocation info that can be used to store memory allocation info in front of the pointer given to user.
 inline MemoryAllocationHeader							CreateMemoryAllocationHeader(
 	void											*	system_allocated_location,
 	u64													system_allocated_size,
 	u64													payload_size,
-	u64													payload_alignment_requirement
+	u64													payload_alignment_requirement,
+	MemoryTag											tag								= MemoryTag::UNTAGGED
 )
 {
 	auto is_payload_alignment_requirement_power_of_2 = ( payload_alignment_requirement & ( payload_alignment_requirement - 1 ) ) == 0;
@@ -186,13 +256,25 @@ inline MemoryAllocationHeader							CreateMemoryAllocationHeader(
 
 	auto allocation_header							= MemoryAllocationHeader {};
 	allocation_header.system_allocated_location		= system_allocated_location;
-	allocation_header.payload_location				= AlignMemoryToRequirement(
-		reinterpret_cast<u8*>( system_allocated_location ) + sizeof( MemoryAllocationHeader ),
-		std::max( payload_alignment_requirement, alignof( MemoryAllocationHeader ) )
-	);
+	if( IsCompactMemoryAllocationHeaderUsed( system_allocated_size, payload_alignment_requirement ) )
+	{
+		BHardAssert(
+			!( reinterpret_cast<uintptr_t>( system_allocated_location ) % alignof( MemoryAllocationHeader ) ),
+			U"Cannot calculate system memory allocation info from system allocation, small system allocations must be aligned to 64 bytes"
+		);
+		allocation_header.payload_location			= reinterpret_cast<u8*>( system_allocated_location ) + sizeof( CompactMemoryAllocationHeader );
+	}
+	else
+	{
+		allocation_header.payload_location			= AlignMemoryToRequirement(
+			reinterpret_cast<u8*>( system_allocated_location ) + sizeof( MemoryAllocationHeader ),
+			std::max( payload_alignment_requirement, alignof( MemoryAllocationHeader ) )
+		);
+	}
 	allocation_header.system_allocation_size		= system_allocated_size;
 	allocation_header.payload_size					= payload_size;
 	allocation_header.payload_alignment_requirement	= payload_alignment_requirement;
+	allocation_header.tag							= tag;
 
 	allocation_header.checksum						= CalculateMemoryAllocationHeaderChecksum(
 		allocation_header
@@ -216,11 +298,22 @@ inline MemoryAllocationHeader							CreateMemoryAllocationHeader(
 /// Sets the system memory allocation info in front of user returned pointer.
 ///
 /// @param allocation_header
-/// Allocation info. This contains everything needed to set itself at the proper location.
+/// Allocation info. This contains everything needed to set itself at the proper location, it is stored as a
+/// CompactMemoryAllocationHeader if the allocation uses one.
 inline void												SetMemoryAllocationHeader(
 	MemoryAllocationHeader							&	allocation_header
 )
 {
+	if( IsCompactMemoryAllocationHeaderUsed( allocation_header.system_allocation_size, allocation_header.payload_alignment_requirement ) )
+	{
+		auto compact_header_position = reinterpret_cast<uintptr_t>( allocation_header.payload_location ) - sizeof( CompactMemoryAllocationHeader );
+		auto compact_header_ptr = reinterpret_cast<CompactMemoryAllocationHeader*>( compact_header_position );
+		compact_header_ptr->system_allocation_size			= u32( allocation_header.system_allocation_size );
+		compact_header_ptr->payload_size					= u32( allocation_header.payload_size );
+		compact_header_ptr->payload_alignment_requirement	= u32( allocation_header.payload_alignment_requirement );
+		return;
+	}
+
 	auto allocation_header_position = reinterpret_cast<uintptr_t>( allocation_header.payload_location ) - sizeof( MemoryAllocationHeader );
 	assert( !( allocation_header_position % alignof( MemoryAllocationHeader ) ) && "Allocation info must be aligned to alignof( MemoryAllocationHeader )");
 	auto allocation_header_ptr = reinterpret_cast<MemoryAllocationHeader*>( allocation_header_position );
@@ -233,60 +326,48 @@ inline void												SetMemoryAllocationHeader(
 /// @brief
 /// Used to get the MemoryAllocationHeader residing in front of the memory pointer given to user.
 ///
+/// If the allocation uses a CompactMemoryAllocationHeader, it is expanded into a full MemoryAllocationHeader. Changes to the
+/// returned header must be stored back with SetMemoryAllocationHeader.
+///
 /// @param user_location
 /// Pointer given to user.
 ///
 /// @return
-/// Pointer to allocation info on success, nullptr if something went wrong.
-inline const MemoryAllocationHeader					*	GetMemoryAllocationHeaderFromUserPointer(
+/// Copy of the allocation info on success, empty if something went wrong.
+inline std::optional<MemoryAllocationHeader>			GetMemoryAllocationHeaderFromUserPointer(
 	const void										*	user_location
 )
 {
-	if( user_location == nullptr ) return nullptr; // user_location was nullptr, return.
+	if( user_location == nullptr ) return std::nullopt; // user_location was nullptr, return.
 
 	auto user_ptr_position = reinterpret_cast<uintptr_t>( user_location );
-	if( user_ptr_position % alignof( MemoryAllocationHeader ) ) return nullptr; // user_location isn't aligned to MemoryAllocationHeader, which is the minimum, return.
-
 	auto user_location_bytes = reinterpret_cast<const u8*>( user_location );
 
-	auto allocation_header = reinterpret_cast<const MemoryAllocationHeader*>( user_location_bytes - sizeof( MemoryAllocationHeader ) );
-
-	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
-	auto allocation_header_checksum = CalculateMemoryAllocationHeaderChecksum( *allocation_header );
-	if( allocation_header->checksum != allocation_header_checksum ) return nullptr; // Checksum mismatch, this is not a runtime allocated memory block.
+	#if !BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	if( user_ptr_position % alignof( MemoryAllocationHeader ) == sizeof( CompactMemoryAllocationHeader ) )
+	{
+		auto compact_header = reinterpret_cast<const CompactMemoryAllocationHeader*>( user_location_bytes - sizeof( CompactMemoryAllocationHeader ) );
+
+		auto allocation_header							= MemoryAllocationHeader {};
+		allocation_header.system_allocated_location		= const_cast<u8*>( user_location_bytes - sizeof( CompactMemoryAllocationHeader ) );
+		allocation_header.payload_location				= const_cast<void*>( user_location );
+		allocation_header.system_allocation_size		= compact_header->system_allocation_size;
+		allocation_header.payload_size					= compact_header->payload_size;
+		allocation_header.payload_alignment_requirement	= compact_header->payload_alignment_requirement;
+		return allocation_header;
+	}
 	#endif
 
-	return allocation_header;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// @brief
-/// Used to get the MemoryAllocationHeader residing in front of the memory pointer given to user.
-///
-/// @param user_location
-/// Pointer given to user.
-///
-/// @return
-/// Pointer to allocation info on success, nullptr if something went wrong.
-inline MemoryAllocationHeader						*	GetMemoryAllocationHeaderFromUserPointer(
-	void											*	user_location
-)
-{
-	if( user_location == nullptr ) return nullptr; // user_location was nullptr, return.
+	if( user_ptr_position % alignof( MemoryAllocationHeader ) ) return std::nullopt; // user_location isn't aligned to MemoryAllocationHeader, which is the minimum, return.
 
-	auto user_ptr_position = reinterpret_cast<uintptr_t>( user_location );
-	if( user_ptr_position % alignof( MemoryAllocationHeader ) ) return nullptr; // user_location isn't aligned to MemoryAllocationHeader, which is the minimum, return.
-
-	auto user_location_bytes = reinterpret_cast<u8*>( user_location );
-
-	auto allocation_header = reinterpret_cast<MemoryAllocationHeader*>( user_location_bytes - sizeof( MemoryAllocationHeader ) );
+	auto allocation_header = reinterpret_cast<const MemoryAllocationHeader*>( user_location_bytes - sizeof( MemoryAllocationHeader ) );
 
 	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
 	auto allocation_header_checksum = CalculateMemoryAllocationHeaderChecksum( *allocation_header );
-	if( allocation_header->checksum != allocation_header_checksum ) return nullptr; // Checksum mismatch, this is not a runtime allocated memory block.
+	if( allocation_header->checksum != allocation_header_checksum ) return std::nullopt; // Checksum mismatch, this is not a runtime allocated memory block.
 	#endif
 
-	return allocation_header;
+	return *allocation_header;
 }
 
 
@@ -342,6 +423,68 @@ inline bool												IsInPlaceReallocateable_Runtime(
 
 
 
+#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Adds a new allocation to the live memory statistics of a memory tag.
+///
+/// @note
+/// Internal function, only available in development builds.
+///
+/// @param tag
+/// Memory tag of the allocation.
+///
+/// @param size
+/// Payload size of the allocation in bytes.
+BITCRAFTE_ENGINE_API
+void													TrackAllocation_Runtime(
+	MemoryTag											tag,
+	u64													size
+) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Removes a freed allocation from the live memory statistics of a memory tag.
+///
+/// @note
+/// Internal function, only available in development builds.
+///
+/// @param tag
+/// Memory tag of the allocation.
+///
+/// @param size
+/// Payload size of the allocation in bytes.
+BITCRAFTE_ENGINE_API
+void													TrackFree_Runtime(
+	MemoryTag											tag,
+	u64													size
+) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Updates the live memory statistics of a memory tag after an allocation was resized in place.
+///
+/// @note
+/// Internal function, only available in development builds.
+///
+/// @param tag
+/// Memory tag of the allocation.
+///
+/// @param old_size
+/// Payload size of the allocation before resizing, in bytes.
+///
+/// @param new_size
+/// Payload size of the allocation after resizing, in bytes.
+BITCRAFTE_ENGINE_API
+void													TrackResize_Runtime(
+	MemoryTag											tag,
+	u64													old_size,
+	u64													new_size
+) noexcept;
+#endif
+
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @brief
 /// Do in-place memory allocation.
@@ -369,13 +512,19 @@ inline void											*	InPlaceReallocateMemory_Runtime(
 		allocation_header.system_allocated_location,
 		allocation_header.system_allocation_size,
 		new_size,
-		allocation_header.payload_alignment_requirement
+		allocation_header.payload_alignment_requirement,
+		allocation_header.tag
 	);
 	SetMemoryAllocationHeader( new_allocation_header );
 	assert(
 		allocation_header.payload_location == new_allocation_header.payload_location &&
 		"Expected old payload location to match new payload location."
 	);
+
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	TrackResize_Runtime( allocation_header.tag, allocation_header.payload_size, new_size );
+	#endif
+
 	return new_allocation_header.payload_location;
 }
 
@@ -483,8 +632,18 @@ constexpr ValueType			*	ReallocateMemory_Consteval(
 	auto common_length = old_count < new_count ? old_count : new_count;
 	for( u64 i = 0; i < common_length; i++ )
 	{
-		if constexpr( std::is_move_assignable_v<ValueType> ) new_location[ i ] = std::move( old_location[ i ] );
-		if constexpr( std::is_copy_assignable_v<ValueType> ) new_location[ i ] = old_location[ i ];
+		if constexpr( std::is_trivial_v<ValueType> )
+		{
+			if constexpr( std::is_move_assignable_v<ValueType> ) new_location[ i ] = std::move( old_location[ i ] );
+			if constexpr( std::is_copy_assignable_v<ValueType> ) new_location[ i ] = old_location[ i ];
+		}
+		else
+		{
+			// Trivially relocatable values, bytes cannot be copied at compile time so values are relocated one by one.
+			if constexpr( std::is_move_constructible_v<ValueType> ) std::construct_at( new_location + i, std::move( old_location[ i ] ) );
+			else std::construct_at( new_location + i, old_location[ i ] );
+			std::destroy_at( old_location + i );
+		}
 	}
 	FreeMemory_Consteval<ValueType>( old_location, old_count );
 	return new_location;
@@ -531,6 +690,33 @@ void						*	AllocateRawMemory_Runtime(
 	u64							alignment_requirement
 ) noexcept;
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Allocates memory at runtime with an explicit memory tag.
+///
+/// @note
+/// Internal function, Please use memory::AllocateRawMemory instead, it works in both runtime and compile time.
+///
+/// @param size
+/// Size in bytes of how much raw memory to allocate.
+///
+/// @param alignment_requirement
+/// Alignment in bytes.
+/// @note
+/// Must be above 0, must be below or equal to 32k, must power-of-2.
+///
+/// @param tag
+/// Memory tag of the allocation, used instead of the current memory tag of the thread.
+///
+/// @return
+/// Pointer to beginning of allocated memory.
+BITCRAFTE_ENGINE_API
+void						*	AllocateRawMemory_Runtime(
+	u64							size,
+	u64							alignment_requirement,
+	MemoryTag					tag
+) noexcept;
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -621,6 +807,35 @@ constexpr ValueType			*	AllocateMemory(
 	}
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Allocates memory with an explicit memory tag instead of the current memory tag of the thread.
+///
+/// The tag is ignored at compile time and in shipping builds.
+template<typename ValueType>
+constexpr ValueType			*	AllocateMemory(
+	u64							count,
+	u64							alignment_requirement,
+	MemoryTag					tag
+) noexcept
+{
+	#if __cpp_if_consteval
+	if consteval
+	#else
+	if( std::is_constant_evaluated() )
+	#endif
+	{
+		return internal_::AllocateMemory_Consteval<ValueType>( count, alignment_requirement );
+	}
+	else
+	{
+		BHardAssert( count > 0, U"Cannot allocate memory, new element count must be larger than 0" );
+		BHardAssert( count < 0x0000FFFFFFFFFFFF, U"Cannot allocate memory, new element count too high, something is not right" );
+
+		return reinterpret_cast<ValueType*>( internal_::AllocateRawMemory_Runtime( count * sizeof( ValueType ), alignment_requirement, tag ) );
+	}
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -631,7 +846,7 @@ constexpr ValueType			*	ReallocateMemory(
 	u64							new_count
 ) noexcept
 {
-	static_assert( std::is_trivial_v<ValueType>, "Type must be trivial for it to be reallocated via this function" );
+	static_assert( std::is_trivial_v<ValueType> || IsTriviallyRelocatable<ValueType>::value, "Type must be trivial or trivially relocatable for it to be reallocated via this function" );
 
 	#if __cpp_if_consteval
 	if consteval
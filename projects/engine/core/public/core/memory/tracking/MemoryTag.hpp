@@ -0,0 +1,47 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/data_types/FundamentalTypes.hpp>
+
+
+
+namespace bc {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Category of an allocation, used to keep track of how much memory each part of the engine uses.
+///
+/// Allocations are tagged with the current memory tag of the allocating thread, see MemoryTagScope, or with a tag given to
+/// AllocateMemory explicitly. Reallocations keep the tag of the original allocation.
+///
+/// @note
+/// Memory tags are only tracked in development builds.
+enum class MemoryTag : u32
+{
+	UNTAGGED		= 0,	///< Allocations made outside of any memory tag scope.
+
+	CORE,					///< Core utilities which do not belong to any other category.
+	LOGGING,				///< Logger and log history.
+	THREAD,					///< Thread pool, tasks and thread synchronization.
+	FILE,					///< File reading and writing buffers.
+	WINDOW_MANAGER,			///< Windows and window events.
+	RHI,					///< Render hardware interface and renderer.
+	SCENE,					///< Scene graph and scene objects.
+	UI,						///< User interface.
+	ENGINE,					///< Engine level systems which combine other components.
+	EDITOR,					///< Editor only allocations.
+	GAME,					///< Game code.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Number of memory tags.
+constexpr u64							MEMORY_TAG_COUNT				= u64( MemoryTag::GAME ) + 1;
+
+
+
+} // memory
+} // bc
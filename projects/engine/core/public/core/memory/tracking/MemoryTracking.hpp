@@ -0,0 +1,192 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/memory/tracking/MemoryTag.hpp>
+#include <core/containers/Text.hpp>
+
+
+
+namespace bc {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Live memory statistics of a single memory tag.
+///
+/// Sizes are payload sizes requested by the user, allocation headers and size class rounding are not included.
+struct MemoryTagStatistics
+{
+	/// Number of bytes currently allocated with this tag.
+	u64											live_size						= 0;
+
+	/// Number of allocations currently alive with this tag.
+	u64											live_allocation_count			= 0;
+
+	/// Highest live_size seen so far.
+	///
+	/// Threads publish their counters in batches, so the peak may miss short spikes smaller than a batch per thread.
+	u64											peak_live_size					= 0;
+
+	/// Number of allocations made with this tag since the start of the application.
+	u64											total_allocation_count			= 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Memory statistics of every memory tag at a point in time.
+struct MemoryStatisticsSnapshot
+{
+	MemoryTagStatistics							tags[ MEMORY_TAG_COUNT ]		= {};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline const MemoryTagStatistics		&	operator[](
+		MemoryTag								tag
+	) const noexcept
+	{
+		return tags[ u64( tag ) ];
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Tags every allocation made by the current thread during the lifetime of this scope.
+///
+/// Scopes can be nested, the innermost scope wins and the previous tag is restored when a scope ends.
+///
+/// @note
+/// Compiled out of shipping builds.
+///
+/// @note
+/// Multithreading: Only affects the thread it was created on, must be destroyed on the same thread.
+class MemoryTagScope
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @param tag
+	/// Tag given to allocations made inside this scope.
+	inline explicit MemoryTagScope(
+		MemoryTag								tag
+	) noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MemoryTagScope(
+		const MemoryTagScope				&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~MemoryTagScope() noexcept;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MemoryTagScope							&	operator=(
+		const MemoryTagScope				&	other
+	) = delete;
+
+private:
+
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MemoryTag									previous_tag;
+	#endif
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gets the tag given to allocations made by the current thread.
+///
+/// @return
+/// Tag of the innermost MemoryTagScope of the current thread, MemoryTag::UNTAGGED if there is none or in shipping builds.
+BITCRAFTE_ENGINE_API
+MemoryTag										GetCurrentMemoryTag() noexcept;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Collects live memory statistics of every memory tag from every thread.
+///
+/// @note
+/// Multithreading: Any thread. Allocations made by other threads while the snapshot is being taken may or may not be included.
+///
+/// @return
+/// Statistics of every memory tag, all zero in shipping builds.
+BITCRAFTE_ENGINE_API
+MemoryStatisticsSnapshot						GetMemoryStatisticsSnapshot() noexcept;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BITCRAFTE_ENGINE_API
+TextView										MemoryTagToText(
+	MemoryTag									tag
+) noexcept;
+
+
+
+namespace internal_ {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Sets the tag given to allocations made by the current thread.
+///
+/// @note
+/// Internal function, please use MemoryTagScope instead.
+///
+/// @param tag
+/// New tag of the current thread.
+///
+/// @return
+/// Previous tag of the current thread.
+BITCRAFTE_ENGINE_API
+MemoryTag										ExchangeCurrentMemoryTag(
+	MemoryTag									tag
+) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Prints every memory tag which has more memory allocated than it had in the baseline snapshot to the system console.
+///
+/// Used by CoreComponent at shutdown.
+///
+/// @param baseline
+/// Snapshot taken before any of the reported allocations could have been made.
+///
+/// @return
+/// True if any leaks were found, always false in shipping builds.
+BITCRAFTE_ENGINE_API
+bool											ReportMemoryLeaks(
+	const MemoryStatisticsSnapshot			&	baseline
+) noexcept;
+
+
+
+} // internal_
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline MemoryTagScope::MemoryTagScope(
+	MemoryTag									tag
+) noexcept
+{
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	previous_tag = internal_::ExchangeCurrentMemoryTag( tag );
+	#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline MemoryTagScope::~MemoryTagScope() noexcept
+{
+	#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+	internal_::ExchangeCurrentMemoryTag( previous_tag );
+	#endif
+}
+
+
+
+} // memory
+} // bc
@@ -0,0 +1,497 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/Task.hpp>
+#include <core/containers/List.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace bc {
+namespace thread {
+
+class ThreadSharedData;
+class CoroutineTask;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Awaiter suspending a coroutine task until other tasks have completed.
+///
+/// Created by co_awaiting a TaskIdentifier or a List<TaskIdentifier> inside a coroutine task, the awaited tasks are added as
+/// dependencies of the coroutine task so the last one to complete queues it again.
+class TaskDependencyAwaiter
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline TaskDependencyAwaiter(
+		const TaskIdentifier						*	task_ids,
+		u64												task_id_count
+	) :
+		task_ids( task_ids ),
+		task_id_count( task_id_count )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool											await_ready() const noexcept
+	{
+		return task_id_count == 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename PromiseType>
+	inline void											await_suspend(
+		std::coroutine_handle<PromiseType>				handle
+	)
+	{
+		auto & task = *handle.promise().task;
+		for( u64 i = 0; i < task_id_count; ++i )
+		{
+			task.AddDependencyAtRuntime( task_ids[ i ] );
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											await_resume() const noexcept
+	{}
+
+private:
+	const TaskIdentifier							*	task_ids;
+	u64													task_id_count;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Return type of coroutines that are run as thread pool tasks.
+///
+/// A coroutine task is scheduled with ThreadPool::ScheduleCoroutineTask(). Inside the coroutine the following can be awaited:
+///
+/// - A TaskIdentifier or a List<TaskIdentifier>, resumes once the tasks have completed.
+/// - ResumeAfter(), resumes once the duration has passed.
+/// - TaskEvent, resumes once the event has been signaled, Eg. by an I/O completion.
+///
+/// A suspended coroutine task does not occupy a worker thread and is not polled, it is queued again by whatever it awaits.
+/// Coroutine frame is kept between suspensions so local variables survive, execution may continue on a different worker
+/// thread than it was suspended on.
+///
+/// Example:
+/// @code
+/// thread_pool.ScheduleCoroutineTask( [ & ]() -> CoroutineTask
+/// 	{
+/// 		auto loader = thread_pool.ScheduleLambdaTask( []() { LoadAssets(); } );
+/// 		co_await loader;
+/// 		co_await ResumeAfter( std::chrono::milliseconds( 10 ) );
+/// 		BuildScene();
+/// 	}
+/// );
+/// @endcode
+class CoroutineTask
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	class promise_type
+	{
+	public:
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline CoroutineTask							get_return_object()
+		{
+			return CoroutineTask( std::coroutine_handle<promise_type>::from_promise( *this ) );
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// @brief
+		/// Coroutine tasks start suspended, the body is first run by a worker thread.
+		inline std::suspend_always						initial_suspend() const noexcept
+		{
+			return {};
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// @brief
+		/// Frame is kept after the body finishes, it is destroyed with the CoroutineTask.
+		inline std::suspend_always						final_suspend() const noexcept
+		{
+			return {};
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline void										return_void() const noexcept
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline void										unhandled_exception() noexcept
+		{
+			exception = std::current_exception();
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline TaskDependencyAwaiter					await_transform(
+			const TaskIdentifier					&	task_id
+		) const noexcept
+		{
+			return TaskDependencyAwaiter( &task_id, 1 );
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline TaskDependencyAwaiter					await_transform(
+			const List<TaskIdentifier>				&	task_ids
+		) const noexcept
+		{
+			return TaskDependencyAwaiter( task_ids.Data(), task_ids.Size() );
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		template<typename AwaitableType>
+		inline AwaitableType						&&	await_transform(
+			AwaitableType							&&	awaitable
+		) const noexcept requires(
+			!std::is_same_v<std::remove_cvref_t<AwaitableType>, TaskIdentifier> &&
+			!std::is_same_v<std::remove_cvref_t<AwaitableType>, List<TaskIdentifier>>
+		)
+		{
+			return std::forward<AwaitableType>( awaitable );
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// @brief
+		/// Coroutine frames are allocated with the engine allocator.
+		static inline void							*	operator new(
+			std::size_t									size
+		)
+		{
+			return memory::AllocateMemory<u8>( size, alignof( std::max_align_t ) );
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		static inline void								operator delete(
+			void									*	location,
+			std::size_t									size
+		)
+		{
+			memory::FreeMemory( static_cast<u8*>( location ), size );
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// @brief
+		/// Task running the coroutine, set every time before the coroutine is resumed.
+		Task										*	task							= nullptr;
+
+		/// Exception thrown out of the coroutine body, rethrown on the worker thread by the task running the coroutine.
+		std::exception_ptr								exception;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	CoroutineTask() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	CoroutineTask(
+		const CoroutineTask							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline CoroutineTask(
+		CoroutineTask								&&	other
+	) noexcept :
+		handle( std::exchange( other.handle, nullptr ) )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~CoroutineTask()
+	{
+		if( handle ) handle.destroy();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	CoroutineTask									&	operator=(
+		const CoroutineTask							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline CoroutineTask							&	operator=(
+		CoroutineTask								&&	other
+	) noexcept
+	{
+		if( this == &other ) return *this;
+		if( handle ) handle.destroy();
+		handle = std::exchange( other.handle, nullptr );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if this object refers to a coroutine.
+	inline bool											IsValid() const noexcept
+	{
+		return bool( handle );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the coroutine body has run to the end.
+	inline bool											IsDone() const noexcept
+	{
+		return handle.done();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Runs the coroutine until it suspends or finishes.
+	///
+	/// Exceptions thrown out of the coroutine body are rethrown here.
+	///
+	/// @param task
+	/// Task running the coroutine, awaiters use it to register what the coroutine waits for.
+	inline void											Resume(
+		Task										&	task
+	)
+	{
+		auto & promise = handle.promise();
+		promise.task = &task;
+		handle.resume();
+		if( promise.exception ) std::rethrow_exception( std::exchange( promise.exception, nullptr ) );
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline explicit CoroutineTask(
+		std::coroutine_handle<promise_type>				coroutine_handle
+	) :
+		handle( coroutine_handle )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	std::coroutine_handle<promise_type>					handle;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Awaiter suspending a coroutine task until a point in time has been reached.
+///
+/// Created with ResumeAfter() or ResumeAt(). The task waits in the thread pool timer wheel, see Task::SetResumeDeadlineAtRuntime().
+class TaskTimerAwaiter
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline explicit TaskTimerAwaiter(
+		std::chrono::steady_clock::time_point			deadline
+	) :
+		deadline( deadline )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool											await_ready() const noexcept
+	{
+		return std::chrono::steady_clock::now() >= deadline;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											await_suspend(
+		std::coroutine_handle<CoroutineTask::promise_type>	handle
+	)
+	{
+		handle.promise().task->SetResumeDeadlineAtRuntime( deadline );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											await_resume() const noexcept
+	{}
+
+private:
+	std::chrono::steady_clock::time_point				deadline;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Suspends a coroutine task until a point in time has been reached.
+///
+/// Worker threads are not blocked and the task is not polled while waiting.
+///
+/// @param deadline
+/// Time when the coroutine task is queued again.
+///
+/// @return
+/// Awaiter to co_await inside a coroutine task.
+inline TaskTimerAwaiter									ResumeAt(
+	std::chrono::steady_clock::time_point				deadline
+)
+{
+	return TaskTimerAwaiter( deadline );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Suspends a coroutine task until a duration has passed.
+///
+/// @see ResumeAt()
+///
+/// @param duration
+/// How long to wait before the coroutine task is queued again.
+///
+/// @return
+/// Awaiter to co_await inside a coroutine task.
+template<
+	typename											RepresentationType,
+	typename											PeriodType
+>
+TaskTimerAwaiter										ResumeAfter(
+	std::chrono::duration<RepresentationType, PeriodType>	duration
+)
+{
+	return TaskTimerAwaiter( std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( duration ) );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// One shot event that coroutine tasks can wait for.
+///
+/// Meant for signaling completion of work done outside the thread pool, Eg. an I/O request. Signal() can be called from any
+/// thread, every coroutine task awaiting the event is queued again. Awaiting an event that has already been signaled does not
+/// suspend.
+///
+/// @warning
+/// Event must outlive every coroutine task awaiting it.
+class BITCRAFTE_ENGINE_API TaskEvent
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	class BITCRAFTE_ENGINE_API Awaiter : public TaskResumeCondition
+	{
+		friend class TaskEvent;
+
+	public:
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline explicit Awaiter(
+			TaskEvent								&	event
+		) :
+			event( event )
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline bool										await_ready() const noexcept
+		{
+			return event.IsSignaled();
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline void										await_suspend(
+			std::coroutine_handle<CoroutineTask::promise_type>	handle
+		)
+		{
+			handle.promise().task->SetResumeConditionAtRuntime( *this );
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline void										await_resume() const noexcept
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual bool									Arm(
+			ThreadSharedData						&	thread_shared_data,
+			Task									&	task
+		) override;
+
+	private:
+		TaskEvent									&	event;
+		ThreadSharedData							*	waiting_thread_shared_data		= nullptr;
+		Task										*	waiting_task					= nullptr;
+		Awaiter										*	next_waiter						= nullptr;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskEvent() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskEvent(
+		const TaskEvent								&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskEvent(
+		TaskEvent									&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskEvent										&	operator=(
+		const TaskEvent								&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskEvent										&	operator=(
+		TaskEvent									&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline Awaiter										operator co_await() noexcept
+	{
+		return Awaiter( *this );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Signals the event and queues every coroutine task waiting for it.
+	///
+	/// Signaling an event that has already been signaled does nothing.
+	void												Signal();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the event has been signaled.
+	///
+	/// @return
+	/// True if Signal() has been called.
+	bool												IsSignaled() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Returns a signaled event to the unsignaled state so that it can be reused.
+	///
+	/// @warning
+	/// No coroutine task may be waiting for the event.
+	void												Reset();
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waiter list value marking the event signaled.
+	static inline Awaiter							*	SignaledMarker()
+	{
+		return reinterpret_cast<Awaiter*>( std::uintptr_t( 1 ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Lock free list of awaiters waiting for the event, or SignaledMarker() once signaled.
+	std::atomic<Awaiter*>								waiters							= nullptr;
+};
+
+
+
+} // thread
+} // bc
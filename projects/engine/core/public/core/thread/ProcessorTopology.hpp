@@ -0,0 +1,84 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/containers/List.hpp>
+#include <core/thread/ThreadCreateInfo.hpp>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gets the number of logical processors, hardware threads, in the system.
+///
+/// @return
+/// Number of logical processors, at least 1.
+BITCRAFTE_ENGINE_API
+u32													GetLogicalProcessorCount();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gets one logical processor from each physical processor core this process is allowed to run on.
+///
+/// Cores with simultaneous multithreading have several logical processors, only the lowest numbered one is returned. If the
+/// processor topology cannot be read every logical processor is treated as its own core.
+///
+/// @return
+/// Logical processor indices in ascending order, one per physical core.
+BITCRAFTE_ENGINE_API
+List<u32>											GetPhysicalCoreProcessors();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gets the logical processors belonging to a NUMA node.
+///
+/// @param numa_node
+/// NUMA node to look up, systems without NUMA have a single node 0.
+///
+/// @return
+/// Logical processor indices in ascending order, empty if the node does not exist.
+BITCRAFTE_ENGINE_API
+List<u32>											GetNumaNodeProcessors(
+	u32												numa_node
+);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gets the number of worker threads the thread pool creates automatically.
+///
+/// @return
+/// One per physical core, minus one for the main thread, at least 1.
+BITCRAFTE_ENGINE_API
+u32													GetDefaultWorkerThreadCount();
+
+
+
+namespace internal_ {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Applies thread create info to the calling thread.
+///
+/// Invalid affinity or NUMA placement throws, failing to change the priority or the name only logs a warning.
+///
+/// @param create_info
+/// Settings to apply.
+///
+/// @param default_name
+/// Name used if create_info does not name the thread.
+void												ApplyThreadCreateInfo(
+	const ThreadCreateInfo						&	create_info,
+	TextView										default_name
+);
+
+} // internal_
+
+
+
+} // thread
+} // bc
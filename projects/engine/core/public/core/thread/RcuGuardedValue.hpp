@@ -0,0 +1,302 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/containers/List.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Guards a large read-mostly value by publishing immutable copies of it, read-copy-update style.
+///
+/// Readers access the currently published copy without locking or copying it. Writers make a new copy, modify it and swap it
+/// in, the old copy is retired and destroyed once no reader can be using it anymore. Readers only announce themselves in a
+/// counter picked per thread, reading scales with the number of reader threads.
+///
+/// Retired copies are reclaimed on later writes or by calling Reclaim(), writers never wait for readers.
+///
+/// For example:<br>
+///		// When creating:
+///		auto guarded_value = RcuGuardedValue<LevelSettings>();
+///		// When reading the value:
+///		guarded_value.Read( []( const LevelSettings & value ){ /* Read value */ } );
+///		// When modifying the value:
+///		guarded_value( []( LevelSettings & value ){ /* Modify the new copy */ } );
+///
+/// @tparam T
+/// Type of the value we are guarding, must be copy constructible.
+template<typename T>
+class RcuGuardedValue
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Number of reader counters, threads are spread over them so that readers rarely share a cache line.
+	static constexpr u64 READER_SLOT_COUNT = 16;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	RcuGuardedValue() :
+		current( CreateCopy() )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	RcuGuardedValue(
+		const RcuGuardedValue				&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	RcuGuardedValue(
+		RcuGuardedValue						&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	RcuGuardedValue(
+		const T								&	initial_value
+	) :
+		current( CreateCopy( initial_value ) )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Destroys the published copy and every retired copy, nobody may be reading the value anymore.
+	~RcuGuardedValue()
+	{
+		for( auto & retired_copy : retired_copies ) DestroyCopy( retired_copy.value );
+		DestroyCopy( current.load( std::memory_order_relaxed ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Publishes a modified copy of the value.
+	///
+	/// Readers keep seeing the previous copy until function returns.
+	///
+	/// @param function
+	/// Function receiving a reference to the new copy.
+	template<typename FuncT>
+	void operator()( FuncT && function )
+	{
+		auto lock_guard = std::lock_guard( writer_mutex );
+
+		auto new_copy = CreateCopy( *current.load( std::memory_order_relaxed ) );
+		try
+		{
+			function( *new_copy );
+		}
+		catch( ... )
+		{
+			DestroyCopy( new_copy );
+			throw;
+		}
+		Publish( new_copy );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Replaces the value.
+	///
+	/// @param new_value
+	/// Value to publish.
+	void Store( const T & new_value )
+	{
+		auto lock_guard = std::lock_guard( writer_mutex );
+
+		Publish( CreateCopy( new_value ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Reads the currently published copy of the value.
+	///
+	/// The copy stays alive until function returns even if a writer publishes a new one meanwhile.
+	///
+	/// @param function
+	/// Function receiving a const reference to the value, it should not keep the reference.
+	///
+	/// @return
+	/// Whatever function returns.
+	template<typename FuncT>
+	decltype( auto ) Read( FuncT && function ) const
+	{
+		auto reader = ReaderGuard( *this );
+		return function( std::as_const( *current.load( std::memory_order_acquire ) ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Destroys retired copies no reader can be using anymore.
+	///
+	/// Called by every write, only needed when a value is written rarely and the retired copies should be freed sooner.
+	void Reclaim()
+	{
+		auto lock_guard = std::lock_guard( writer_mutex );
+
+		ReclaimRetiredCopies();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of retired copies waiting to be destroyed.
+	u64 GetRetiredCount() const
+	{
+		auto lock_guard = std::lock_guard( writer_mutex );
+
+		return retired_copies.Size();
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct alignas( 64 ) ReaderSlot
+	{
+		// Readers that entered during an even and an odd epoch.
+		std::atomic<u64>					reader_counts[ 2 ]		= {};
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct RetiredCopy
+	{
+		T								*	value;
+		u64									epoch;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Counts the calling thread as a reader of the current epoch for as long as it lives.
+	class ReaderGuard
+	{
+	public:
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		ReaderGuard(
+			const RcuGuardedValue			&	guarded_value
+		)
+		{
+			auto & slot = guarded_value.reader_slots[ GetReaderSlotIndex() ];
+			while( true )
+			{
+				auto entered_epoch = guarded_value.epoch.load( std::memory_order_seq_cst );
+				reader_count = &slot.reader_counts[ entered_epoch & 1 ];
+				reader_count->fetch_add( 1, std::memory_order_seq_cst );
+
+				// Epoch may have moved on before we were counted, writer could then miss us when it checks this parity.
+				if( guarded_value.epoch.load( std::memory_order_seq_cst ) == entered_epoch ) return;
+				reader_count->fetch_sub( 1, std::memory_order_relaxed );
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		~ReaderGuard()
+		{
+			reader_count->fetch_sub( 1, std::memory_order_release );
+		}
+
+	private:
+		std::atomic<u64>				*	reader_count			= nullptr;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	static u64 GetReaderSlotIndex()
+	{
+		static std::atomic<u64> next_slot_index = 0;
+		thread_local u64 slot_index = next_slot_index.fetch_add( 1, std::memory_order_relaxed ) % READER_SLOT_COUNT;
+		return slot_index;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename ...ConstructorArgumentTypePack>
+	static T * CreateCopy( ConstructorArgumentTypePack && ...constructor_arguments )
+	{
+		auto copy = memory::AllocateMemory<T>( 1, alignof( T ) );
+		try
+		{
+			std::construct_at( copy, std::forward<ConstructorArgumentTypePack>( constructor_arguments )... );
+		}
+		catch( ... )
+		{
+			memory::FreeMemory( copy, 1 );
+			throw;
+		}
+		return copy;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	static void DestroyCopy( T * copy )
+	{
+		std::destroy_at( copy );
+		memory::FreeMemory( copy, 1 );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void Publish( T * new_copy )
+	{
+		auto old_copy = current.exchange( new_copy, std::memory_order_acq_rel );
+		retired_copies.PushBack( RetiredCopy { old_copy, epoch.load( std::memory_order_relaxed ) } );
+		ReclaimRetiredCopies();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool HasReaders( u64 parity ) const
+	{
+		for( auto & slot : reader_slots )
+		{
+			if( slot.reader_counts[ parity ].load( std::memory_order_seq_cst ) != 0 ) return true;
+		}
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void ReclaimRetiredCopies()
+	{
+		// A reader counted in epoch e may hold any copy retired in epoch e or e + 1. Epoch only moves from e + 1 to e + 2 once
+		// every reader of epoch e has left, so copies retired two epochs ago can no longer be read. Epoch is advanced as far as
+		// possible without waiting.
+		for( u64 i = 0; i < 2; ++i )
+		{
+			if( retired_copies.IsEmpty() ) return;
+
+			auto current_epoch = epoch.load( std::memory_order_relaxed );
+			if( HasReaders( ( current_epoch + 1 ) & 1 ) ) break;
+			epoch.store( current_epoch + 1, std::memory_order_seq_cst );
+		}
+
+		auto current_epoch = epoch.load( std::memory_order_relaxed );
+		u64 kept_count = 0;
+		for( u64 i = 0; i < retired_copies.Size(); ++i )
+		{
+			if( retired_copies[ i ].epoch + 2 <= current_epoch )
+			{
+				DestroyCopy( retired_copies[ i ].value );
+				continue;
+			}
+			retired_copies[ kept_count++ ] = retired_copies[ i ];
+		}
+		retired_copies.Resize( kept_count );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	std::atomic<T*>							current;
+	std::atomic<u64>						epoch					= 0;
+	mutable ReaderSlot						reader_slots[ READER_SLOT_COUNT ];
+
+	mutable std::mutex						writer_mutex;
+	List<RetiredCopy>						retired_copies;
+};
+
+
+
+} // thread
+} // bc
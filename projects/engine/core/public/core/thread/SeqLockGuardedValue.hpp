@@ -0,0 +1,192 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/data_types/FundamentalTypes.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Guards a small trivially copyable value with a sequence lock.
+///
+/// Readers never write to shared memory, they copy the value and retry if a writer changed it during the copy. Reading scales
+/// with any number of reader threads as long as writes are rare. Writers are serialized by the sequence number itself.
+///
+/// For example:<br>
+///		// When creating:
+///		auto guarded_value = SeqLockGuardedValue<CameraState>();
+///		// When reading the value:
+///		auto camera_state = guarded_value.Load();
+///		// When modifying the value:
+///		guarded_value( []( CameraState & value ){ /* Modify value */ } );
+///
+/// @tparam T
+/// Type of the value we are guarding, copied on every read so it should be no larger than a few cache lines.
+template<typename T>
+class SeqLockGuardedValue
+{
+	static_assert( std::is_trivially_copyable_v<T>, "SeqLockGuardedValue value type must be trivially copyable" );
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SeqLockGuardedValue() :
+		SeqLockGuardedValue( T {} )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SeqLockGuardedValue(
+		const SeqLockGuardedValue			&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SeqLockGuardedValue(
+		SeqLockGuardedValue					&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SeqLockGuardedValue(
+		const T								&	initial_value
+	)
+	{
+		WriteWords( initial_value );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gives exclusive access to a copy of the value, the copy is published when function returns.
+	///
+	/// @param function
+	/// Function receiving a reference to the value.
+	template<typename FuncT>
+	void operator()( FuncT && function )
+	{
+		auto current_sequence = BeginWrite();
+
+		// Writer owns the value while the sequence is odd, reading the words cannot tear.
+		auto new_value = ReadWords();
+		function( new_value );
+		WriteWords( new_value );
+
+		sequence.store( current_sequence + 2, std::memory_order_release );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Replaces the value.
+	///
+	/// @param new_value
+	/// Value to store.
+	void Store( const T & new_value )
+	{
+		auto current_sequence = BeginWrite();
+		WriteWords( new_value );
+		sequence.store( current_sequence + 2, std::memory_order_release );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets a consistent copy of the value, never blocks writers.
+	///
+	/// @return
+	/// Copy of the value as it was after some completed write.
+	T Load() const
+	{
+		while( true )
+		{
+			auto begin_sequence = sequence.load( std::memory_order_acquire );
+			if( begin_sequence & 1 )
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			auto result = ReadWords();
+
+			// Pairs with the release fence in BeginWrite(), if any word was written by a newer write the sequence has changed.
+			std::atomic_thread_fence( std::memory_order_acquire );
+			if( sequence.load( std::memory_order_relaxed ) == begin_sequence ) return result;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Reads a consistent copy of the value.
+	///
+	/// @param function
+	/// Function receiving a const reference to the copy.
+	///
+	/// @return
+	/// Whatever function returns.
+	template<typename FuncT>
+	decltype( auto ) Read( FuncT && function ) const
+	{
+		const auto copy = Load();
+		return function( copy );
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	static constexpr u64 WORD_COUNT = ( sizeof( T ) + sizeof( u64 ) - 1 ) / sizeof( u64 );
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	u64 BeginWrite()
+	{
+		// Odd sequence marks a write in progress, taking it also locks out other writers.
+		auto current_sequence = sequence.load( std::memory_order_relaxed );
+		while( true )
+		{
+			if( ( current_sequence & 1 ) == 0 &&
+				sequence.compare_exchange_weak( current_sequence, current_sequence + 1, std::memory_order_acquire, std::memory_order_relaxed )
+			)
+			{
+				break;
+			}
+			std::this_thread::yield();
+			current_sequence = sequence.load( std::memory_order_relaxed );
+		}
+		std::atomic_thread_fence( std::memory_order_release );
+		return current_sequence;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	T ReadWords() const
+	{
+		// Value is kept in relaxed atomic words so that a read racing with a write is not a data race, only a retry.
+		u64 buffer[ WORD_COUNT ];
+		for( u64 i = 0; i < WORD_COUNT; ++i ) buffer[ i ] = words[ i ].load( std::memory_order_relaxed );
+
+		T result;
+		std::memcpy( &result, buffer, sizeof( T ) );
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void WriteWords( const T & new_value )
+	{
+		u64 buffer[ WORD_COUNT ] = {};
+		std::memcpy( buffer, &new_value, sizeof( T ) );
+		for( u64 i = 0; i < WORD_COUNT; ++i ) words[ i ].store( buffer[ i ], std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	std::atomic<u64>					sequence				= 0;
+	std::atomic<u64>					words[ WORD_COUNT ];
+};
+
+
+
+} // thread
+} // bc
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Ensures that a value is always protected by a reader/writer lock when trying to access it.
+///
+/// Any number of threads may read the value at the same time, writing waits for readers to finish. Meant for values that are
+/// read much more often than written but are too large or not trivially copyable for SeqLockGuardedValue.
+///
+/// For example:<br>
+///		// When creating:
+///		auto guarded_value = SharedGuardedValue<Settings>();
+///		// When reading the value:
+///		guarded_value.Read( []( const Settings & value ){ /* Read value */ } );
+///		// When modifying the value:
+///		guarded_value( []( Settings & value ){ /* Modify value */ } );
+///
+/// @tparam T
+/// Type of the value we are guarding.
+template<typename T>
+class SharedGuardedValue
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SharedGuardedValue() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SharedGuardedValue(
+		const SharedGuardedValue			&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SharedGuardedValue(
+		SharedGuardedValue					&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	SharedGuardedValue(
+		const T								&	initial_value
+	) :
+		value( initial_value )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gives exclusive access to the value.
+	///
+	/// @param function
+	/// Function receiving a reference to the value.
+	template<typename FuncT>
+	void operator()( FuncT && function )
+	{
+		auto lock_guard = std::lock_guard( mutex );
+
+		function( value );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gives shared read access to the value, other readers may access it at the same time.
+	///
+	/// @param function
+	/// Function receiving a const reference to the value.
+	///
+	/// @return
+	/// Whatever function returns.
+	template<typename FuncT>
+	decltype( auto ) Read( FuncT && function ) const
+	{
+		auto shared_lock = std::shared_lock( mutex );
+
+		return function( std::as_const( value ) );
+	}
+
+private:
+
+	T									value;
+	mutable std::shared_mutex			mutex;
+};
+
+
+
+} // thread
+} // bc
@@ -4,10 +4,14 @@
 #include <core/containers/List.hpp>
 
 #include <core/thread/TaskState.hpp>
+#include <core/thread/TaskPriority.hpp>
+#include <core/thread/TaskInlineList.hpp>
 #include <core/thread/ThreadDescription.hpp>
 
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <algorithm>
 #include <assert.h>
 
 
@@ -20,8 +24,99 @@ namespace thread {
 class ThreadPool;
 class ThreadSharedData;
 class Thread;
+class TaskRegistry;
+class TaskInjectionQueue;
+class TaskMailbox;
+class TaskTimerWheel;
 
 using TaskIdentifier = u64;
+class Task;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Links a task to the successor list of one of its dependencies.
+///
+/// Links are owned by the depending task, one per dependency, so that a task can be linked to any number of dependencies
+/// without the dependencies needing to allocate.
+struct TaskSuccessorLink
+{
+	Task										*	successor					= nullptr;
+	TaskSuccessorLink							*	next						= nullptr;
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Contiguous range of task identifiers given to a batch of tasks scheduled together.
+struct TaskIdentifierRange
+{
+	TaskIdentifier									first_task_id				= 0;
+	u64												task_count					= 0;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool										IsEmpty() const
+	{
+		return task_count == 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline TaskIdentifier							operator[](
+		u64											index
+	) const
+	{
+		BAssert( index < task_count, U"Task identifier range index out of range" );
+		return first_task_id + index;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets every task identifier in the range, Eg. to wait for the whole batch or to use it as dependencies of other tasks.
+	inline List<TaskIdentifier>						ToList() const
+	{
+		auto result = List<TaskIdentifier> {};
+		result.Reserve( task_count );
+		for( u64 i = 0; i < task_count; ++i ) result.PushBack( first_task_id + i );
+		return result;
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Condition other than completion of other tasks that a paused task waits for before it is run again, Eg. a timer or an I/O
+/// completion.
+///
+/// Conditions are armed by the thread pool once the task has been fully paused, so a condition that is met right away cannot
+/// resume the task while it is still running.
+class TaskResumeCondition
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual											~TaskResumeCondition() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Starts waiting for the condition.
+	///
+	/// @param thread_shared_data
+	/// Thread shared data of the thread pool running the task, ThreadSharedData::ResumeTask() must be called exactly once when
+	/// the condition is met.
+	///
+	/// @param task
+	/// Paused task waiting for the condition.
+	///
+	/// @return
+	/// True if the condition is now being waited for, false if it was already met in which case ResumeTask() must not be called.
+	virtual bool									Arm(
+		ThreadSharedData						&	thread_shared_data,
+		Task									&	task
+	) = 0;
+};
 
 
 
@@ -57,9 +152,27 @@ class Task
 {
 	friend class ThreadPool;
 	friend class ThreadSharedData;
+	friend class TaskRegistry;
+	friend class TaskInjectionQueue;
+	friend class TaskMailbox;
+	friend class TaskTimerWheel;
 
 public:
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Number of thread locks stored inside the task, a task locked to more threads allocates.
+	static constexpr u64							INLINE_THREAD_LOCK_COUNT	= 2;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Number of dependencies stored inside the task, a task with more dependencies allocates.
+	static constexpr u64							INLINE_DEPENDENCY_COUNT		= 4;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	using ThreadLockList							= TaskInlineList<ThreadIdentifier, INLINE_THREAD_LOCK_COUNT>;
+	using DependencyList							= TaskInlineList<TaskIdentifier, INLINE_DEPENDENCY_COUNT>;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	inline 											Task()
 	{
@@ -88,7 +201,7 @@ public:
 	/// 
 	/// @return
 	/// Reference to an array of indices which represent threads that this task is allowed to run on.
-	inline const List<ThreadIdentifier>			&	GetThreadLocks() const
+	inline const ThreadLockList					&	GetThreadLocks() const
 	{
 		return locked_to_threads;
 	}
@@ -123,7 +236,7 @@ public:
 	/// 
 	/// @return
 	/// An array of unique identifiers to tasks that must complete before this task.
-	inline const List<u64>						&	GetDependencies() const
+	inline const DependencyList					&	GetDependencies() const
 	{
 		return dependencies;
 	}
@@ -136,9 +249,9 @@ public:
 	/// This is meant to be called from within a running task. Do not call from other threads or places.
 	/// 
 	/// @warning
-	/// Adding dependency at runtime does not pause the current thread, instead you should return TaskState::CONTINUED which will
-	/// reschedule this task afterwards. Execution does not continue where we returned but restarts the entire task at a later time,
-	/// it is the user's responsibility to track task state.
+	/// Adding dependency at runtime does not pause the current thread, instead you should return TaskExecutionResult::PAUSED which
+	/// will reschedule this task once the new dependencies have completed. Execution does not continue where we returned but
+	/// restarts the entire task at a later time, it is the user's responsibility to track task state.
 	///
 	/// @param task_id
 	///	Id of the task we want this task to depend on.
@@ -151,6 +264,57 @@ public:
 		dependencies.PushBack( task_id );
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Sets a condition the task waits for before it is run again.
+	///
+	/// @warning
+	/// This is meant to be called from within a running task which then returns TaskExecutionResult::PAUSED. The task is run again
+	/// once the condition and all dependencies added with AddDependencyAtRuntime() are met.
+	///
+	/// @param condition
+	/// Condition to wait for, must stay alive until the task is run again.
+	inline void										SetResumeConditionAtRuntime(
+		TaskResumeCondition						&	condition
+	)
+	{
+		BAssert( state == TaskState::RUNNING, "Cannot call SetResumeConditionAtRuntime on a task that is not currently running, this function must be called from within the running task" );
+		BAssert( running_thread_system_id == std::this_thread::get_id(), "Cannot call SetResumeConditionAtRuntime from a different thread from which the task is running, this function must be called from within the running task" );
+		BAssert( resume_condition == nullptr, "Cannot call SetResumeConditionAtRuntime, task already has a resume condition" );
+		resume_condition = &condition;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Sets a point in time the task waits for before it is run again.
+	///
+	/// @warning
+	/// This is meant to be called from within a running task which then returns TaskExecutionResult::PAUSED. The task is run again
+	/// once the deadline has passed and all other dependencies and conditions are met. Worker threads do not poll the task while
+	/// it waits.
+	///
+	/// @param deadline
+	/// Steady clock time after which the task may run again.
+	inline void										SetResumeDeadlineAtRuntime(
+		std::chrono::steady_clock::time_point		deadline
+	)
+	{
+		BAssert( state == TaskState::RUNNING, "Cannot call SetResumeDeadlineAtRuntime on a task that is not currently running, this function must be called from within the running task" );
+		BAssert( running_thread_system_id == std::this_thread::get_id(), "Cannot call SetResumeDeadlineAtRuntime from a different thread from which the task is running, this function must be called from within the running task" );
+		resume_deadline = std::max<i64>( 1, std::chrono::duration_cast<std::chrono::nanoseconds>( deadline.time_since_epoch() ).count() );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the priority the task was scheduled with.
+	///
+	/// @return
+	/// Priority of the task.
+	inline TaskPriority								GetPriority() const
+	{
+		return priority;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
 	/// Gets the current state of the task.
@@ -208,17 +372,61 @@ public:
 		return operator()( thread );
 	}
 
+protected:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Called instead of destroying an externally owned task once the thread pool no longer refers to it.
+	///
+	/// Tasks are normally owned by the thread pool and destroyed after they complete. Externally owned tasks, Eg. TaskGraph nodes,
+	/// are kept alive by their owner and may be scheduled again after this has been called.
+	virtual void									OnReleasedByThreadPool()
+	{}
+
 private:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	List<ThreadIdentifier>							locked_to_threads			= {};
+	using SuccessorLinkList							= TaskInlineList<TaskSuccessorLink, INLINE_DEPENDENCY_COUNT>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	ThreadLockList									locked_to_threads;
 	TaskIdentifier									task_id						= {};
-	List<TaskIdentifier>							dependencies				= {};
+	DependencyList									dependencies;
+	TaskPriority									priority					= TaskPriority::NORMAL;
+
+	// Set when the task lives in a task pool slot instead of its own allocation.
+	bool											allocated_from_task_pool	= false;
+
+	// Set when the task is owned by someone other than the thread pool, the thread pool never destroys it.
+	bool											is_externally_owned			= false;
+
+	// Set when the task stops once the thread pool starts shutting down, its timer fires right away instead of at its deadline.
+	bool											ends_on_shutdown			= false;
 
 	ThreadIdentifier								running_thread_id			= {};
 	std::thread::id									running_thread_system_id	= {};
 
 	std::atomic<TaskState>							state;
+
+	// Number of dependencies that have not completed yet, the task is queued to run when this reaches zero.
+	std::atomic<u64>								pending_dependency_count	= 0;
+	u64												linked_dependency_count		= 0;
+	SuccessorLinkList								successor_links;
+	TaskSuccessorLink							*	successor_list				= nullptr;
+	TaskResumeCondition							*	resume_condition			= nullptr;
+
+	// Steady clock time in nanoseconds the task waits for before it is queued, 0 if none. Kept while in the timer wheel.
+	i64												resume_deadline				= 0;
+
+	// Steady clock time in nanoseconds the task was last queued at, used for queue latency telemetry.
+	i64												queued_timestamp			= 0;
+
+	// Number of threads waiting for this task to complete, only modified while the task is registered.
+	u32												waiter_count				= 0;
+
+	Task										*	next_queued_task			= nullptr;
+	Task										*	next_registered_task		= nullptr;
+	Task										*	previous_registered_task	= nullptr;
 };
 
 
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/Task.hpp>
+#include <core/thread/TaskPriority.hpp>
+#include <core/memory/raw/RawMemory.hpp>
+#include <core/diagnostic/exception/Exception.hpp>
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace bc {
+namespace thread {
+
+class ThreadPool;
+
+
+
+namespace internal_ {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// State shared between a task returning a value and the futures referring to it.
+///
+/// Value is stored inline so a task with a future needs no allocations beyond the task and this state. Reference counted,
+/// the task holds one reference until it has stored its value or its failure.
+template<typename ValueType>
+class TaskFutureState
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct EmptyValue {};
+	using StoredValueType = std::conditional_t<std::is_void_v<ValueType>, EmptyValue, ValueType>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Creates a new state with one reference.
+	static inline TaskFutureState					*	Create()
+	{
+		auto state = memory::AllocateMemory<TaskFutureState>( 1, alignof( TaskFutureState ) );
+		std::construct_at( state );
+		return state;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											AddReference()
+	{
+		reference_count.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											RemoveReference()
+	{
+		if( reference_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+		{
+			std::destroy_at( this );
+			memory::FreeMemory( this, 1 );
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Stores the value and marks the state ready, called once by the task producing the value.
+	template<typename ...ValueConstructorArgumentTypePack>
+	inline void											SetValue(
+		ValueConstructorArgumentTypePack			&&	...value_constructor_arguments
+	)
+	{
+		BAssert( !IsDone(), U"Task future value can only be set once" );
+		std::construct_at( reinterpret_cast<StoredValueType*>( storage ), std::forward<ValueConstructorArgumentTypePack>( value_constructor_arguments )... );
+		status.store( Status::READY, std::memory_order_release );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Marks the state failed instead of storing a value, called once by the task producing the value.
+	///
+	/// @param failure_exception
+	/// Exception the task failed with, may be empty if the task completed without running.
+	inline void											SetFailed(
+		std::exception_ptr								failure_exception
+	)
+	{
+		BAssert( !IsDone(), U"Task future value can only be set once" );
+		exception = std::move( failure_exception );
+		status.store( Status::FAILED, std::memory_order_release );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool											IsReady() const
+	{
+		return status.load( std::memory_order_acquire ) == Status::READY;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool											HasFailed() const
+	{
+		return status.load( std::memory_order_acquire ) == Status::FAILED;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool											IsDone() const
+	{
+		return status.load( std::memory_order_acquire ) != Status::PENDING;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the exception explaining why there is no value.
+	///
+	/// Only called once the producing task has completed without a value. Task completed without running may not have marked
+	/// the state failed yet when its successors start, those get a generic exception.
+	inline std::exception_ptr							GetFailure() const
+	{
+		if( HasFailed() && exception ) return exception;
+		return std::make_exception_ptr( diagnostic::Exception{ "Task completed without producing a value" } );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline StoredValueType							&	GetValue()
+	{
+		BAssert( IsReady(), U"Task future value is not ready yet" );
+		return *std::launder( reinterpret_cast<StoredValueType*>( storage ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline												~TaskFutureState()
+	{
+		if( IsReady() ) std::destroy_at( &GetValue() );
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	enum class Status : u8
+	{
+		PENDING,
+		READY,
+		FAILED,
+	};
+
+	std::atomic<u32>									reference_count					= 1;
+	std::atomic<Status>									status							= Status::PENDING;
+	std::exception_ptr									exception;
+	alignas( StoredValueType ) u8						storage[ sizeof( StoredValueType ) ];
+};
+
+} // internal_
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Handle to the value returned by a task scheduled with ThreadPool::ScheduleLambdaTaskWithFuture().
+///
+/// Futures are cheap to copy, every copy refers to the same value. Continuations added with Then() are scheduled as tasks
+/// depending on this task, so they are queued straight from the completion of this task.
+///
+/// A task that throws, or completes without running, fails its future instead of taking the engine down. The failure is passed
+/// on to continuations without calling them and rethrown by Get().
+///
+/// @tparam ValueType
+/// Type returned by the task, may be void.
+template<typename ValueType>
+class TaskFuture
+{
+	friend class ThreadPool;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskFuture() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline TaskFuture(
+		const TaskFuture							&	other
+	) :
+		thread_pool( other.thread_pool ),
+		state( other.state ),
+		task_id( other.task_id )
+	{
+		if( state ) state->AddReference();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline TaskFuture(
+		TaskFuture									&&	other
+	) noexcept :
+		thread_pool( std::exchange( other.thread_pool, nullptr ) ),
+		state( std::exchange( other.state, nullptr ) ),
+		task_id( std::exchange( other.task_id, 0 ) )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline TaskFuture								&	operator=(
+		const TaskFuture							&	other
+	)
+	{
+		if( this == &other ) return *this;
+		if( other.state ) other.state->AddReference();
+		if( state ) state->RemoveReference();
+		thread_pool		= other.thread_pool;
+		state			= other.state;
+		task_id			= other.task_id;
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline TaskFuture								&	operator=(
+		TaskFuture									&&	other
+	) noexcept
+	{
+		if( this == &other ) return *this;
+		if( state ) state->RemoveReference();
+		thread_pool		= std::exchange( other.thread_pool, nullptr );
+		state			= std::exchange( other.state, nullptr );
+		task_id			= std::exchange( other.task_id, 0 );
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline												~TaskFuture()
+	{
+		if( state ) state->RemoveReference();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the future refers to a task.
+	///
+	/// @return
+	/// False for default constructed futures and futures of tasks that could not be scheduled.
+	inline bool											IsValid() const
+	{
+		return state != nullptr && task_id != 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the task has produced its value, never blocks.
+	inline bool											IsReady() const
+	{
+		return state != nullptr && state->IsReady();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the task failed without producing a value, never blocks.
+	inline bool											HasFailed() const
+	{
+		return state != nullptr && state->HasFailed();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the identifier of the task producing the value, can be used as a dependency of other tasks.
+	inline TaskIdentifier								GetTaskId() const
+	{
+		return task_id;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits until the task has produced its value or failed.
+	///
+	/// Returns right away if the value is ready, otherwise waits like ThreadPool::WaitForTask().
+	void												Wait() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits for the value and gets it.
+	///
+	/// If the task failed, rethrows the exception it failed with.
+	///
+	/// @return
+	/// Reference to the value stored in the future, valid as long as any future refers to it.
+	decltype( auto )									Get() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a continuation with TaskPriority::NORMAL.
+	///
+	/// @see Then( TaskPriority, LambdaType&& )
+	template<typename LambdaType>
+	auto												Then(
+		LambdaType									&&	continuation
+	) const
+	{
+		return Then( TaskPriority::NORMAL, std::forward<LambdaType>( continuation ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a continuation that runs after this task, receiving its value.
+	///
+	/// Continuation is a task depending on this task, it is queued directly when this task completes. If this task failed, the
+	/// continuation is not called and the returned future fails with the same exception.
+	///
+	/// @param priority
+	/// Priority of the continuation task.
+	///
+	/// @param continuation
+	/// Lambda receiving a reference to the value, or nothing if ValueType is void. Its return value is stored in the returned
+	/// future.
+	///
+	/// @return
+	/// Future of the continuation.
+	template<typename LambdaType>
+	auto												Then(
+		TaskPriority									priority,
+		LambdaType									&&	continuation
+	) const;
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline TaskFuture(
+		ThreadPool									*	thread_pool,
+		internal_::TaskFutureState<ValueType>		*	state
+	) :
+		thread_pool( thread_pool ),
+		state( state )
+	{}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	ThreadPool										*	thread_pool						= nullptr;
+	internal_::TaskFutureState<ValueType>			*	state							= nullptr;
+	TaskIdentifier										task_id							= 0;
+};
+
+
+
+} // thread
+} // bc
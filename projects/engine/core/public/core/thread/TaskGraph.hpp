@@ -0,0 +1,398 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/Task.hpp>
+#include <core/thread/TaskPriority.hpp>
+
+#include <core/containers/UniquePtr.hpp>
+#include <core/containers/List.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+
+
+namespace bc {
+namespace thread {
+
+class ThreadPool;
+class ThreadSharedData;
+class TaskGraph;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Timing of a single task graph node during the latest execution of the graph.
+struct TaskGraphNodeTiming
+{
+	/// Time from the start of TaskGraph::Execute() to the node starting to run.
+	std::chrono::nanoseconds						start_time						= {};
+
+	/// Time the node spent running.
+	std::chrono::nanoseconds						duration						= {};
+
+	/// False if the node was disabled or has not run yet, timings are zero in that case.
+	bool											was_run							= false;
+};
+
+
+
+namespace internal_ {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Task running a single node of a task graph.
+///
+/// Node tasks are owned by the task graph and scheduled again on every execution. When the thread pool releases a node, the
+/// node hands its successors over to the thread pool.
+class BITCRAFTE_ENGINE_API TaskGraphNodeTask : public Task
+{
+	friend class bc::thread::TaskGraph;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual TaskExecutionResult						operator()(
+		Thread									&	thread
+	) override;
+
+protected:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual void									Invoke() = 0;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual void									OnReleasedByThreadPool() override;
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskGraph									*	graph							= nullptr;
+	u32												node_index						= 0;
+	TaskPriority									node_priority					= TaskPriority::NORMAL;
+	bool											is_enabled						= true;
+
+	// Predecessors that have not completed during the current execution, the node is scheduled when this reaches zero.
+	std::atomic<u32>								pending_predecessor_count		= 0;
+	u32												predecessor_count				= 0;
+
+	// Links nodes completed without being run, Eg. disabled nodes, so their successors are released without recursion.
+	TaskGraphNodeTask							*	next_released_node				= nullptr;
+
+	i64												start_time						= 0;
+	i64												duration						= 0;
+	bool											was_run							= false;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename LambdaType>
+class TaskGraphLambdaNodeTask final : public TaskGraphNodeTask
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<typename LambdaConstructorType>
+	TaskGraphLambdaNodeTask(
+		LambdaConstructorType					&&	lambda_function
+	) :
+		lambda_function( std::forward<LambdaConstructorType>( lambda_function ) )
+	{}
+
+protected:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual void									Invoke() override
+	{
+		lambda_function();
+	}
+
+private:
+	LambdaType										lambda_function;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Task completing a task graph execution, it waits until every node has been released.
+///
+/// Gives each execution a single task identifier which can be waited for or used as a dependency of other tasks.
+class BITCRAFTE_ENGINE_API TaskGraphSinkTask :
+	public Task,
+	public TaskResumeCondition
+{
+	friend class bc::thread::TaskGraph;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual TaskExecutionResult						operator()(
+		Thread									&	thread
+	) override;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual bool									Arm(
+		ThreadSharedData						&	thread_shared_data,
+		Task									&	task
+	) override;
+
+protected:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual void									OnReleasedByThreadPool() override;
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskGraph									*	graph							= nullptr;
+	ThreadSharedData							*	thread_shared_data				= nullptr;
+};
+
+} // internal_
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Graph of tasks recorded once and executed on a thread pool as many times as needed, Eg. once per frame.
+///
+/// Nodes and edges are recorded up front and Compile() turns them into a topologically sorted graph with every node linked to
+/// its successors. Executing the graph schedules the nodes without dependencies, every other node is scheduled directly by its
+/// last completing predecessor. Nodes are kept between executions, so executing a compiled graph does not allocate memory.
+///
+/// Nodes can be disabled between executions, a disabled node is skipped but its successors still run once their other
+/// predecessors have completed.
+///
+/// Graph must not be destroyed or modified while it is executing.
+class BITCRAFTE_ENGINE_API TaskGraph
+{
+	friend class internal_::TaskGraphNodeTask;
+	friend class internal_::TaskGraphSinkTask;
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	using NodeIndex									= u32;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskGraph();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskGraph(
+		const TaskGraph							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskGraph(
+		TaskGraph								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits for the latest execution to finish before destroying the nodes.
+	~TaskGraph();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskGraph									&	operator=(
+		const TaskGraph							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskGraph									&	operator=(
+		TaskGraph								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a node with TaskPriority::NORMAL.
+	///
+	/// @see AddNode( TaskPriority, LambdaType&& )
+	template<typename LambdaType>
+	NodeIndex										AddNode(
+		LambdaType								&&	lambda_function
+	)
+	{
+		return AddNode( TaskPriority::NORMAL, std::forward<LambdaType>( lambda_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a node to the graph, the graph must be compiled again before it is executed.
+	///
+	/// @param priority
+	/// Priority the node is scheduled with.
+	///
+	/// @param lambda_function
+	/// Lambda run every time the graph is executed, takes no parameters.
+	///
+	/// @return
+	/// Index of the node, used to add edges and to refer to the node later.
+	template<typename LambdaType>
+	NodeIndex										AddNode(
+		TaskPriority								priority,
+		LambdaType								&&	lambda_function
+	)
+	{
+		BAssert( !IsExecuting(), U"Cannot add task graph node, graph is executing" );
+
+		using NodeType = internal_::TaskGraphLambdaNodeTask<std::decay_t<LambdaType>>;
+		auto node = MakeUniquePtr<NodeType>( std::forward<LambdaType>( lambda_function ) );
+		node->graph				= this;
+		node->node_index		= NodeIndex( nodes.Size() );
+		node->node_priority		= priority;
+		nodes.PushBack( std::move( node ) );
+
+		is_compiled = false;
+		return NodeIndex( nodes.Size() - 1 );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds an edge between two nodes, the graph must be compiled again before it is executed.
+	///
+	/// @param before
+	/// Node that must complete before the other node can start.
+	///
+	/// @param after
+	/// Node that runs after the other node.
+	void											AddEdge(
+		NodeIndex									before,
+		NodeIndex									after
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Sorts the nodes topologically and links every node to its successors.
+	///
+	/// Throws if the edges form a cycle.
+	void											Compile();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules every node of the compiled graph on a thread pool.
+	///
+	/// If the previous execution is still running, waits for it to finish first.
+	///
+	/// @param thread_pool
+	/// Thread pool running the nodes.
+	///
+	/// @return
+	/// Identifier of a task completing after every node has completed, can be waited for or used as a dependency of other tasks.
+	/// Returns 0 if the thread pool could not schedule tasks.
+	TaskIdentifier									Execute(
+		ThreadPool								&	thread_pool
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits until the latest execution has completed.
+	///
+	/// Main thread runs main thread tasks while waiting, like ThreadPool::WaitForTask().
+	void											Wait();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the latest execution is still running.
+	bool											IsExecuting() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Enables or disables a node for the following executions.
+	///
+	/// @param node
+	/// Node to enable or disable.
+	///
+	/// @param enabled
+	/// False skips the node, its successors run as if it had completed.
+	void											SetNodeEnabled(
+		NodeIndex									node,
+		bool										enabled
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool											IsNodeEnabled(
+		NodeIndex									node
+	) const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the timing of a node during the latest execution.
+	///
+	/// @param node
+	/// Node to get timing of.
+	///
+	/// @return
+	/// Timing of the node, only valid after the execution has completed.
+	TaskGraphNodeTiming								GetNodeTiming(
+		NodeIndex									node
+	) const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of nodes in the graph.
+	u64												GetNodeCount() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the nodes in topological order, every node comes after all of its predecessors.
+	///
+	/// @return
+	/// Node indices, only valid after Compile().
+	const List<NodeIndex>						&	GetExecutionOrder() const;
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct Edge
+	{
+		NodeIndex									before;
+		NodeIndex									after;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Releases the successors of a completed node, successors that are disabled or that the thread pool refuses are completed
+	/// without running them.
+	void											ReleaseNode(
+		internal_::TaskGraphNodeTask			*	node
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Counts one node, or the hold taken by Execute(), as completed and resumes the sink task after the last one.
+	void											CompleteNode();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void											WaitForPreviousExecution() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	List<UniquePtr<internal_::TaskGraphNodeTask>>	nodes;
+	List<Edge>										edges;
+	bool											is_compiled						= false;
+
+	// Compiled graph, successors of node i are successor_indices[ successor_offsets[ i ] ] up to successor_offsets[ i + 1 ].
+	List<NodeIndex>									execution_order;
+	List<u32>										successor_offsets;
+	List<NodeIndex>									successor_indices;
+	u64												root_node_count					= 0;
+
+	// Enabled root nodes are gathered here and handed to the thread pool as a single batch, sized by Compile().
+	List<Task*>										root_batch;
+
+	internal_::TaskGraphSinkTask					sink_task;
+	ThreadPool									*	thread_pool						= nullptr;
+	TaskIdentifier									sink_task_id					= 0;
+	i64												execution_start_time			= 0;
+
+	// Nodes not yet completed during the current execution, plus one held by Execute() while it schedules the first nodes.
+	std::atomic<u64>								remaining_node_count			= 0;
+
+	// Set from Execute() until the thread pool has released the sink task, the nodes and sink task can be reused after that.
+	std::atomic_bool								sink_in_flight					= false;
+};
+
+
+
+} // thread
+} // bc
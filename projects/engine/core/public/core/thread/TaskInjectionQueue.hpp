@@ -0,0 +1,132 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/Task.hpp>
+
+#include <atomic>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Lock-free queue used to hand tasks over to the worker threads from threads that do not own a work stealing deque.
+///
+/// Tasks are linked intrusively so pushing never allocates. Any thread may push, consumers always take the whole queue at once
+/// which keeps the queue free of the ABA problem. Consumers receive the tasks in the order they were pushed.
+class TaskInjectionQueue
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInjectionQueue() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInjectionQueue(
+		const TaskInjectionQueue				&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInjectionQueue(
+		TaskInjectionQueue						&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInjectionQueue							&	operator=(
+		const TaskInjectionQueue				&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInjectionQueue							&	operator=(
+		TaskInjectionQueue						&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Pushes a task into the queue.
+	///
+	/// @param task
+	/// Task to push, must not currently be in any other queue.
+	inline void										Push(
+		Task									*	task
+	)
+	{
+		auto old_head = head.load( std::memory_order_relaxed );
+		do
+		{
+			task->next_queued_task = old_head;
+		} while( !head.compare_exchange_weak( old_head, task, std::memory_order_release, std::memory_order_relaxed ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Pushes several tasks into the queue at once.
+	///
+	/// @param newest_task
+	/// Last task of the submission order, older tasks are linked from it through Task::next_queued_task.
+	///
+	/// @param oldest_task
+	/// First task of the submission order, end of the chain.
+	inline void										PushChain(
+		Task									*	newest_task,
+		Task									*	oldest_task
+	)
+	{
+		auto old_head = head.load( std::memory_order_relaxed );
+		do
+		{
+			oldest_task->next_queued_task = old_head;
+		} while( !head.compare_exchange_weak( old_head, newest_task, std::memory_order_release, std::memory_order_relaxed ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes every task currently in the queue.
+	///
+	/// @return
+	/// First task in the order they were pushed, following tasks are linked through Task::next_queued_task. Returns nullptr if
+	/// the queue was empty.
+	inline Task									*	PopAll()
+	{
+		if( head.load( std::memory_order_relaxed ) == nullptr ) return nullptr;
+
+		auto task = head.exchange( nullptr, std::memory_order_acquire );
+
+		// Tasks were stored newest first, reverse them to get submission order.
+		Task * reversed = nullptr;
+		while( task )
+		{
+			auto next = task->next_queued_task;
+			task->next_queued_task = reversed;
+			reversed = task;
+			task = next;
+		}
+		return reversed;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if the queue is empty.
+	///
+	/// @return
+	/// True if there was nothing in the queue at the time of calling.
+	inline bool										IsEmpty() const
+	{
+		return head.load( std::memory_order_relaxed ) == nullptr;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	alignas( 64 ) std::atomic<Task*>				head							= nullptr;
+};
+
+
+
+} // thread
+} // bc
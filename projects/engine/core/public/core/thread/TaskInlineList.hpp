@@ -0,0 +1,220 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/memory/raw/RawMemory.hpp>
+#include <core/containers/List.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// List with inline storage for a small number of values, used for per task bookkeeping.
+///
+/// Most tasks have only a few dependencies and are locked to only a few threads, storing those values inside the task itself
+/// means scheduling such a task does not allocate. Storage moves to the heap only when the inline capacity is exceeded.
+///
+/// @tparam ValueType
+/// Type of the stored values, must be trivially copyable.
+///
+/// @tparam InlineCapacity
+/// Number of values that can be stored without allocating.
+template<
+	typename										ValueType,
+	u64												InlineCapacity
+>
+class TaskInlineList
+{
+	static_assert( std::is_trivially_copyable_v<ValueType>, "Task inline list value type must be trivially copyable" );
+	static_assert( InlineCapacity > 0, "Task inline list inline capacity must be larger than 0" );
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInlineList() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInlineList(
+		const TaskInlineList					&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInlineList(
+		TaskInlineList							&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~TaskInlineList()
+	{
+		if( values != inline_values ) memory::FreeMemory( values, capacity );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInlineList								&	operator=(
+		const TaskInlineList					&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInlineList								&	operator=(
+		TaskInlineList							&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ValueType							&	operator[](
+		u64											index
+	)
+	{
+		BAssert( index < size, U"Index out of range" );
+		return values[ index ];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline const ValueType						&	operator[](
+		u64											index
+	) const
+	{
+		BAssert( index < size, U"Index out of range" );
+		return values[ index ];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline u64										Size() const
+	{
+		return size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool										IsEmpty() const
+	{
+		return size == 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ValueType							*	Data()
+	{
+		return values;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline const ValueType						*	Data() const
+	{
+		return values;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ValueType							*	begin()
+	{
+		return values;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline const ValueType						*	begin() const
+	{
+		return values;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ValueType							*	end()
+	{
+		return values + size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline const ValueType						*	end() const
+	{
+		return values + size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a value to the end of the list.
+	///
+	/// @param value
+	/// Value to add.
+	inline void										PushBack(
+		const ValueType							&	value
+	)
+	{
+		if( size == capacity ) Grow( capacity * 2 );
+		values[ size ] = value;
+		++size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds every value of a list to the end of this list.
+	///
+	/// @param other
+	/// List to copy values from.
+	inline void										Append(
+		const List<ValueType>					&	other
+	)
+	{
+		if( other.IsEmpty() ) return;
+
+		auto new_size = size + other.Size();
+		if( new_size > capacity ) Grow( std::max( new_size, capacity * 2 ) );
+		std::memcpy( values + size, other.Data(), other.Size() * sizeof( ValueType ) );
+		size = new_size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Changes the number of values in the list, new values are value initialized.
+	///
+	/// @param new_size
+	/// New number of values.
+	inline void										Resize(
+		u64											new_size
+	)
+	{
+		if( new_size > capacity ) Grow( std::max( new_size, capacity * 2 ) );
+		for( u64 i = size; i < new_size; ++i )
+		{
+			values[ i ] = ValueType {};
+		}
+		size = new_size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Removes every value, capacity is kept.
+	inline void										Clear()
+	{
+		size = 0;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void										Grow(
+		u64											new_capacity
+	)
+	{
+		auto new_values = memory::AllocateMemory<ValueType>( new_capacity, alignof( ValueType ) );
+		std::memcpy( new_values, values, size * sizeof( ValueType ) );
+		if( values != inline_values ) memory::FreeMemory( values, capacity );
+		values		= new_values;
+		capacity	= new_capacity;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	ValueType									*	values							= inline_values;
+	u64												size							= 0;
+	u64												capacity						= InlineCapacity;
+	ValueType										inline_values[ InlineCapacity ]	= {};
+};
+
+
+
+} // thread
+} // bc
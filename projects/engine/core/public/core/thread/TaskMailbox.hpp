@@ -0,0 +1,166 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/Task.hpp>
+#include <core/thread/TaskPriority.hpp>
+#include <core/thread/TaskInjectionQueue.hpp>
+
+#include <atomic>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Queue of tasks locked to a single thread.
+///
+/// Every worker thread, and the main thread, owns one mailbox. Thread locked tasks are delivered straight to the mailbox of
+/// the thread that runs them so other threads never look at them. Any thread may push to a mailbox, only the owning thread pops
+/// from it.
+///
+/// Tasks are popped highest priority first, in the order they were pushed within the same priority.
+class TaskMailbox
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskMailbox() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskMailbox(
+		const TaskMailbox						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskMailbox(
+		TaskMailbox								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskMailbox									&	operator=(
+		const TaskMailbox						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskMailbox									&	operator=(
+		TaskMailbox								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Delivers a task to the mailbox, can be called from any thread.
+	///
+	/// @param task
+	/// Task to push, must not currently be in any other queue.
+	inline void										Push(
+		Task									*	task
+	)
+	{
+		// Counted first so the count never drops below the number of tasks that can be popped.
+		task_count.fetch_add( 1, std::memory_order_relaxed );
+		incoming.Push( task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes the next task from the mailbox.
+	///
+	/// @warning
+	/// Must only be called from the thread owning the mailbox.
+	///
+	/// @return
+	/// Highest priority task that was pushed first, nullptr if the mailbox is empty.
+	inline Task									*	Pop()
+	{
+		if( task_count.load( std::memory_order_relaxed ) == 0 ) return nullptr;
+
+		SortIncoming();
+		for( auto & pending_list : pending_lists )
+		{
+			auto task = pending_list.first;
+			if( task == nullptr ) continue;
+
+			pending_list.first = task->next_queued_task;
+			if( pending_list.first == nullptr ) pending_list.last = nullptr;
+			task->next_queued_task = nullptr;
+
+			task_count.fetch_sub( 1, std::memory_order_relaxed );
+			return task;
+		}
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of tasks in the mailbox.
+	///
+	/// @return
+	/// Number of tasks at the time of calling, may include tasks that are still being pushed.
+	inline u64										GetTaskCount() const
+	{
+		return task_count.load( std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Forgets every task in the mailbox without destroying them.
+	///
+	/// @warning
+	/// No other thread may push to the mailbox at the same time.
+	inline void										Clear()
+	{
+		incoming.PopAll();
+		for( auto & pending_list : pending_lists )
+		{
+			pending_list = {};
+		}
+		task_count.store( 0, std::memory_order_relaxed );
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct PendingList
+	{
+		Task									*	first							= nullptr;
+		Task									*	last							= nullptr;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Moves delivered tasks to the pending list of their priority level, keeping their order.
+	inline void										SortIncoming()
+	{
+		auto task = incoming.PopAll();
+		while( task )
+		{
+			auto next = task->next_queued_task;
+			task->next_queued_task = nullptr;
+
+			auto & pending_list = pending_lists[ u64( task->GetPriority() ) ];
+			if( pending_list.last )	pending_list.last->next_queued_task = task;
+			else					pending_list.first = task;
+			pending_list.last = task;
+
+			task = next;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskInjectionQueue								incoming;
+
+	// Owned by the thread owning the mailbox.
+	PendingList										pending_lists[ TASK_PRIORITY_COUNT ];
+
+	alignas( 64 ) std::atomic<u64>					task_count						= 0;
+};
+
+
+
+} // thread
+} // bc
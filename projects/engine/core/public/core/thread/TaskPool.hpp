@@ -0,0 +1,162 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/containers/List.hpp>
+
+#include <mutex>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Fixed size memory slots for tasks.
+///
+/// Slots are recycled when tasks complete so that scheduling small tasks does not touch the general purpose allocator. Every
+/// worker thread has its own cache of free slots which is only accessed by that worker thread, slots move between the caches
+/// and a shared list in batches. Threads that are not worker threads share a single cache guarded by a mutex.
+///
+/// Memory is only returned to the system when the pool is destroyed.
+class BITCRAFTE_ENGINE_API TaskPool
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Size of a single slot in bytes, tasks larger than this are allocated individually.
+	static constexpr u64							SLOT_SIZE						= 512;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Alignment of every slot, tasks with stricter alignment requirements are allocated individually.
+	static constexpr u64							SLOT_ALIGNMENT					= 64;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Cache index used by threads that are not worker threads.
+	static constexpr u64							SHARED_CACHE_INDEX				= ~u64( 0 );
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs the task pool.
+	///
+	/// @param worker_count
+	/// Number of worker thread caches, worker thread indices must be smaller than this.
+	TaskPool(
+		u64											worker_count
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskPool(
+		const TaskPool							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskPool(
+		TaskPool								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Frees all memory of the pool.
+	///
+	/// @warning
+	/// Every slot must have been freed or their contents abandoned before the pool is destroyed.
+	~TaskPool();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskPool									&	operator=(
+		const TaskPool							&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskPool									&	operator=(
+		TaskPool								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes a free slot.
+	///
+	/// @param cache_index
+	/// Worker index of the calling worker thread, or SHARED_CACHE_INDEX if the calling thread is not a worker thread.
+	///
+	/// @return
+	/// Uninitialized memory of SLOT_SIZE bytes aligned to SLOT_ALIGNMENT.
+	void										*	Allocate(
+		u64											cache_index
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Returns a slot to the pool.
+	///
+	/// Slots may be freed from a different thread than they were allocated from.
+	///
+	/// @param slot
+	/// Slot returned by Allocate().
+	///
+	/// @param cache_index
+	/// Worker index of the calling worker thread, or SHARED_CACHE_INDEX if the calling thread is not a worker thread.
+	void											Free(
+		void									*	slot,
+		u64											cache_index
+	);
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Number of slots moved between a cache and the shared batch list at once, also the number of slots in a chunk.
+	static constexpr u64							BATCH_SLOT_COUNT				= 64;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct FreeSlot
+	{
+		FreeSlot								*	next;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct alignas( 64 ) Cache
+	{
+		FreeSlot								*	free_slots						= nullptr;
+		u64											free_slot_count					= 0;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void										*	AllocateFromCache(
+		Cache									&	cache
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void											FreeToCache(
+		Cache									&	cache,
+		void									*	slot
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes a batch of BATCH_SLOT_COUNT free slots from the shared batch list, allocates a new chunk if there are none.
+	FreeSlot									*	TakeBatch();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	Cache										*	worker_caches					= nullptr;
+	u64												worker_cache_count				= 0;
+
+	std::mutex										shared_cache_mutex;
+	Cache											shared_cache;
+
+	std::mutex										batch_mutex;
+	List<FreeSlot*>									free_batches;
+	List<u8*>										chunks;
+};
+
+
+
+} // thread
+} // bc
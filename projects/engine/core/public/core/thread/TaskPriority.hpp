@@ -25,6 +25,11 @@ enum class TaskPriority : u32
 	BACKGROUND,				///< Task can be run when there's absolutely nothing else happening. eg, cleanup.
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Number of task priority levels.
+constexpr u64						TASK_PRIORITY_COUNT				= u64( TaskPriority::BACKGROUND ) + 1;
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
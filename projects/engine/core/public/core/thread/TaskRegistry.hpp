@@ -0,0 +1,219 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/Task.hpp>
+
+#include <mutex>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Keeps track of every task that has been scheduled but not yet completed.
+///
+/// Tasks are linked intrusively into hash buckets so registering or removing a task never allocates and removing a task does not
+/// need to search the bucket. Buckets are grouped into shards that each have their own mutex, consecutive task identifiers land
+/// on different shards so threads scheduling and completing tasks at the same time rarely contend on the same lock.
+class BITCRAFTE_ENGINE_API TaskRegistry
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskRegistry() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskRegistry(
+		const TaskRegistry						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskRegistry(
+		TaskRegistry							&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskRegistry								&	operator=(
+		const TaskRegistry						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskRegistry								&	operator=(
+		TaskRegistry							&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Registers a task.
+	///
+	/// @param task
+	/// Task to register, its task identifier must already be set.
+	void											Add(
+		Task									*	task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Registers several tasks with consecutive task identifiers, locking each shard only once.
+	///
+	/// @param tasks
+	/// Tasks to register, task identifier of each task must be one larger than the one before it.
+	///
+	/// @param task_count
+	/// Number of tasks in the array.
+	void											AddBatch(
+		Task							*	const	*	tasks,
+		u64											task_count
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Removes a task from the registry.
+	///
+	/// @param task
+	/// Task to remove.
+	///
+	/// @return
+	/// True if the task was found and removed, false otherwise.
+	bool											Remove(
+		Task									*	task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a successor link to a registered task.
+	///
+	/// Successor list of a task is only modified while the task is registered, once a task has been removed from the registry its
+	/// successor list can be read without locking.
+	///
+	/// @param task_id
+	/// Identifier of the task the link is added to.
+	///
+	/// @param link
+	/// Link to add, must stay alive until the task has completed.
+	///
+	/// @return
+	/// True if the link was added, false if the task has already completed.
+	bool											AddSuccessor(
+		TaskIdentifier								task_id,
+		TaskSuccessorLink						*	link
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Registers the calling thread as a waiter of a task.
+	///
+	/// Task completion only signals waiting threads if the task had waiters, this keeps task completion cheap when nobody is
+	/// waiting.
+	///
+	/// @param task_id
+	/// Identifier of the task to wait for.
+	///
+	/// @return
+	/// True if the waiter was added, false if the task has already completed.
+	bool											AddWaiter(
+		TaskIdentifier								task_id
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if a task is still registered.
+	///
+	/// @param task_id
+	/// Identifier of the task to look for.
+	///
+	/// @return
+	/// True if the task has not completed yet.
+	bool											Contains(
+		TaskIdentifier								task_id
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Removes every task from the registry and passes them to a callable.
+	///
+	/// @note
+	/// Used when evacuating the thread pool, the callable is responsible for destroying the tasks.
+	///
+	/// @param callable
+	/// Called once per removed task.
+	template<typename CallableType>
+	void											RemoveAll(
+		CallableType							&&	callable
+	)
+	{
+		for( auto & shard : shards )
+		{
+			auto lock_guard = std::lock_guard( shard.mutex );
+			for( auto & bucket : shard.buckets )
+			{
+				while( bucket )
+				{
+					auto task = bucket;
+					bucket = task->next_registered_task;
+					task->next_registered_task		= nullptr;
+					task->previous_registered_task	= nullptr;
+					callable( task );
+				}
+			}
+		}
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	static constexpr u64							SHARD_COUNT						= 64;
+	static constexpr u64							BUCKETS_PER_SHARD				= 256;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct alignas( 64 ) Shard
+	{
+		std::mutex									mutex;
+		Task									*	buckets[ BUCKETS_PER_SHARD ]	= {};
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline Shard								&	GetShard(
+		TaskIdentifier								task_id
+	)
+	{
+		return shards[ task_id % SHARD_COUNT ];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// Shard mutex must be locked.
+	inline Task								*	FindTask(
+		Shard									&	shard,
+		TaskIdentifier								task_id
+	)
+	{
+		auto task = GetBucket( shard, task_id );
+		while( task && task->task_id != task_id )
+		{
+			task = task->next_registered_task;
+		}
+		return task;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline Task								*&	GetBucket(
+		Shard									&	shard,
+		TaskIdentifier								task_id
+	)
+	{
+		return shard.buckets[ ( task_id / SHARD_COUNT ) % BUCKETS_PER_SHARD ];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	Shard											shards[ SHARD_COUNT ];
+};
+
+
+
+} // thread
+} // bc
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/Task.hpp>
+
+#include <bit>
+#include <limits>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Hierarchical timer wheel holding tasks that wait for a point in time.
+///
+/// Time is divided into ticks. Each level has 64 slots, a slot on the first level covers a single tick and a slot on each
+/// following level covers all 64 slots of the level below it. Tasks are linked into slots intrusively, adding a timer and
+/// firing it are constant time regardless of how many timers there are. Timers on higher levels are moved down a level when
+/// time reaches their slot. Timers further away than the wheel can hold wait in the last slot of the top level and are placed
+/// again when that slot is reached.
+///
+/// Not thread safe, the owner must serialize access.
+class TaskTimerWheel
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Length of a single tick in nanoseconds. Timers never fire early, but may fire up to one tick late.
+	static constexpr i64								TICK_NANOSECONDS				= 1'000'000;
+	static constexpr u64								SLOT_BITS						= 6;
+	static constexpr u64								SLOT_COUNT						= u64( 1 ) << SLOT_BITS;
+	static constexpr u64								LEVEL_COUNT						= 4;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskTimerWheel() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskTimerWheel(
+		const TaskTimerWheel						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskTimerWheel(
+		TaskTimerWheel								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskTimerWheel									&	operator=(
+		const TaskTimerWheel						&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskTimerWheel									&	operator=(
+		TaskTimerWheel								&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a task to the wheel.
+	///
+	/// @param task
+	/// Task to add, Task::resume_deadline tells when it fires. Must not currently be in any queue.
+	///
+	/// @param timestamp
+	/// Current steady clock time in nanoseconds.
+	inline void											Add(
+		Task										*	task,
+		i64												timestamp
+	)
+	{
+		if( timer_count == 0 ) current_tick = u64( timestamp / TICK_NANOSECONDS );
+		++timer_count;
+
+		Insert( task, DeadlineToTick( task->resume_deadline ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Moves the wheel forward and takes every task whose deadline has passed.
+	///
+	/// @param timestamp
+	/// Current steady clock time in nanoseconds.
+	///
+	/// @return
+	/// First expired task, following tasks are linked through Task::next_queued_task. Returns nullptr if no timers expired.
+	/// Task::resume_deadline of the returned tasks is reset to 0.
+	inline Task										*	Advance(
+		i64												timestamp
+	)
+	{
+		auto target_tick = u64( timestamp / TICK_NANOSECONDS );
+		Task * expired = nullptr;
+
+		while( current_tick < target_tick )
+		{
+			if( timer_count == 0 )
+			{
+				current_tick = target_tick;
+				break;
+			}
+
+			// Nothing happens between boundaries of the lowest level holding timers, skip straight to the next one.
+			auto lowest_level = GetLowestOccupiedLevel();
+			auto next_tick = lowest_level == 0 ? current_tick + 1 : GetNextLevelBoundary( lowest_level );
+			if( next_tick > target_tick )
+			{
+				current_tick = target_tick;
+				break;
+			}
+			current_tick = next_tick;
+
+			for( u64 level = LEVEL_COUNT - 1; level > 0; --level )
+			{
+				if( ( current_tick & ( ( u64( 1 ) << ( SLOT_BITS * level ) ) - 1 ) ) != 0 ) continue;
+				Cascade( level, ( current_tick >> ( SLOT_BITS * level ) ) & ( SLOT_COUNT - 1 ), expired );
+			}
+
+			auto slot_index = current_tick & ( SLOT_COUNT - 1 );
+			auto task = TakeSlot( 0, slot_index );
+			while( task )
+			{
+				auto next = task->next_queued_task;
+				Expire( task, expired );
+				task = next;
+			}
+		}
+		return expired;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the time when the wheel next needs to be advanced.
+	///
+	/// @return
+	/// Steady clock time in nanoseconds, may be earlier than the earliest deadline if timers need to be moved down a level.
+	/// Maximum i64 value if the wheel is empty.
+	inline i64											GetNextDeadline() const
+	{
+		if( timer_count == 0 ) return std::numeric_limits<i64>::max();
+
+		auto next_tick = std::numeric_limits<u64>::max();
+		if( occupied_slots[ 0 ] )
+		{
+			// Rotate the first level so that the slot of the next tick is the lowest bit.
+			auto start = ( current_tick + 1 ) & ( SLOT_COUNT - 1 );
+			next_tick = current_tick + 1 + u64( std::countr_zero( std::rotr( occupied_slots[ 0 ], int( start ) ) ) );
+		}
+		for( u64 level = 1; level < LEVEL_COUNT; ++level )
+		{
+			if( occupied_slots[ level ] == 0 ) continue;
+			next_tick = std::min( next_tick, GetNextLevelBoundary( level ) );
+			break;
+		}
+		return i64( next_tick ) * TICK_NANOSECONDS;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes every task the predicate selects, regardless of its deadline.
+	///
+	/// Walks every occupied slot, only meant for rare events such as shutting down.
+	///
+	/// @param predicate
+	/// Called with each task in the wheel, returns true to take the task.
+	///
+	/// @return
+	/// First taken task, following tasks are linked through Task::next_queued_task. Returns nullptr if no tasks were taken.
+	/// Task::resume_deadline of the returned tasks is reset to 0.
+	template<typename PredicateType>
+	inline Task										*	TakeIf(
+		PredicateType								&&	predicate
+	)
+	{
+		Task * taken = nullptr;
+		for( u64 level = 0; level < LEVEL_COUNT; ++level )
+		{
+			auto occupied = occupied_slots[ level ];
+			while( occupied )
+			{
+				auto slot_index = u64( std::countr_zero( occupied ) );
+				occupied &= occupied - 1;
+
+				auto task = TakeSlot( level, slot_index );
+				while( task )
+				{
+					auto next = task->next_queued_task;
+					if( predicate( *task ) )	Expire( task, taken );
+					else						PushSlot( level, slot_index, task );
+					task = next;
+				}
+			}
+		}
+		return taken;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of tasks in the wheel.
+	inline u64											GetTimerCount() const
+	{
+		return timer_count;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Forgets every task in the wheel without destroying them.
+	inline void											Clear()
+	{
+		for( auto & level : slots )
+		{
+			for( auto & slot : level ) slot = nullptr;
+		}
+		for( auto & occupied : occupied_slots ) occupied = 0;
+		timer_count = 0;
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	static inline u64									DeadlineToTick(
+		i64												deadline
+	)
+	{
+		// Rounded up so that a timer never fires before its deadline.
+		return u64( ( deadline + TICK_NANOSECONDS - 1 ) / TICK_NANOSECONDS );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline u64											GetLowestOccupiedLevel() const
+	{
+		for( u64 level = 0; level < LEVEL_COUNT; ++level )
+		{
+			if( occupied_slots[ level ] ) return level;
+		}
+		return LEVEL_COUNT;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline u64											GetNextLevelBoundary(
+		u64												level
+	) const
+	{
+		auto shift = SLOT_BITS * level;
+		return ( ( current_tick >> shift ) + 1 ) << shift;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											Insert(
+		Task										*	task,
+		u64												deadline_tick
+	)
+	{
+		// Deadline may have been reached by a timestamp taken after the caller's, fire on the next tick.
+		if( deadline_tick <= current_tick ) deadline_tick = current_tick + 1;
+
+		// Lowest level where the deadline falls within the next 63 slots, slots are indexed by absolute tick so the slot being
+		// processed next on each level is always the right one.
+		for( u64 level = 0; level < LEVEL_COUNT; ++level )
+		{
+			auto shift = SLOT_BITS * level;
+			if( ( deadline_tick >> shift ) - ( current_tick >> shift ) < SLOT_COUNT )
+			{
+				PushSlot( level, ( deadline_tick >> shift ) & ( SLOT_COUNT - 1 ), task );
+				return;
+			}
+		}
+
+		auto top_shift = SLOT_BITS * ( LEVEL_COUNT - 1 );
+		PushSlot( LEVEL_COUNT - 1, ( ( current_tick >> top_shift ) + SLOT_COUNT - 1 ) & ( SLOT_COUNT - 1 ), task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											Cascade(
+		u64												level,
+		u64												slot_index,
+		Task										*&	expired
+	)
+	{
+		auto task = TakeSlot( level, slot_index );
+		while( task )
+		{
+			auto next = task->next_queued_task;
+			auto deadline_tick = DeadlineToTick( task->resume_deadline );
+			if( deadline_tick <= current_tick )	Expire( task, expired );
+			else								Insert( task, deadline_tick );
+			task = next;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											Expire(
+		Task										*	task,
+		Task										*&	expired
+	)
+	{
+		task->resume_deadline = 0;
+		task->next_queued_task = expired;
+		expired = task;
+		--timer_count;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void											PushSlot(
+		u64												level,
+		u64												slot_index,
+		Task										*	task
+	)
+	{
+		task->next_queued_task = slots[ level ][ slot_index ];
+		slots[ level ][ slot_index ] = task;
+		occupied_slots[ level ] |= u64( 1 ) << slot_index;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline Task										*	TakeSlot(
+		u64												level,
+		u64												slot_index
+	)
+	{
+		auto task = slots[ level ][ slot_index ];
+		slots[ level ][ slot_index ] = nullptr;
+		occupied_slots[ level ] &= ~( u64( 1 ) << slot_index );
+		return task;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	Task											*	slots[ LEVEL_COUNT ][ SLOT_COUNT ]	= {};
+	u64													occupied_slots[ LEVEL_COUNT ]		= {};
+	u64													current_tick						= 0;
+	u64													timer_count							= 0;
+};
+
+
+
+} // thread
+} // bc
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/containers/List.hpp>
+#include <core/containers/Text.hpp>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Operating system scheduling priority of a thread.
+enum class ThreadPriority : u32
+{
+	LOWEST			= 0,	///< Thread only runs when nothing else wants the processor.
+	BELOW_NORMAL,			///< Thread yields to normal threads.
+	NORMAL,					///< Thread keeps the priority it inherited from the thread that created it.
+	ABOVE_NORMAL,			///< Thread is preferred over normal threads, may need elevated privileges.
+	HIGHEST,				///< Thread is preferred over every other thread, may need elevated privileges.
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Tells how a thread pool thread should be set up with the operating system.
+///
+/// Settings are applied by the new thread itself before Thread::ThreadBegin() is called.
+struct ThreadCreateInfo
+{
+	/// Logical processors the thread is allowed to run on. Leave empty to let the operating system decide.
+	List<u32>										processor_affinity;
+
+	/// NUMA node the thread is allowed to run on, or -1 to ignore NUMA placement. If processor_affinity is also given, the
+	/// thread is only allowed to run on the processors that are in both.
+	i32												numa_node						= -1;
+
+	/// Scheduling priority of the thread. Failing to raise the priority is reported as a warning, not as an error.
+	ThreadPriority									priority						= ThreadPriority::NORMAL;
+
+	/// Name of the thread shown in debuggers and profilers. Linux only keeps the first 15 bytes. If left empty the thread is
+	/// named after its thread identifier.
+	Text											name;
+};
+
+
+
+} // thread
+} // bc
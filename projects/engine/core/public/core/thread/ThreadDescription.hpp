@@ -3,10 +3,12 @@
 #include <build_configuration/BuildConfigurationComponent.hpp>
 
 #include <core/thread/Thread.hpp>
+#include <core/thread/ThreadCreateInfo.hpp>
 
 #include <cstdint>
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 
@@ -18,6 +20,11 @@ namespace thread {
 
 using ThreadIdentifier = u64;
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Thread identifier of the main thread, tasks locked to it are run by ThreadPool::Run().
+constexpr ThreadIdentifier MAIN_THREAD_ID = ~ThreadIdentifier( 0 );
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +89,8 @@ public:
 	std::atomic_bool							should_exit				= false;
 	std::atomic_bool							ready_to_join			= false;
 	ThreadIdentifier							thread_id				= 0;
+	u64											worker_index			= 0;
+	ThreadCreateInfo							create_info;
 
 private:
 
@@ -98,6 +107,8 @@ private:
 		AtomicSwap( this->state, other.state );
 		AtomicSwap( this->ready_to_join, other.ready_to_join );
 		std::swap( this->thread_id, other.thread_id );
+		std::swap( this->worker_index, other.worker_index );
+		std::swap( this->create_info, other.create_info );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3,16 +3,27 @@
 #include <build_configuration/BuildConfigurationComponent.hpp>
 
 #include <core/thread/ThreadPoolCreateInfo.hpp>
+#include <core/thread/ProcessorTopology.hpp>
 #include <core/thread/ThreadDescription.hpp>
 #include <core/thread/Task.hpp>
+#include <core/thread/TaskPriority.hpp>
+#include <core/thread/TaskPool.hpp>
+#include <core/thread/CoroutineTask.hpp>
+#include <core/thread/TaskFuture.hpp>
+#include <core/thread/ThreadPoolStatistics.hpp>
 
 #include <core/utility/concepts/CallableConcepts.hpp>
 
 #include <core/containers/UniquePtr.hpp>
 #include <core/containers/List.hpp>
+#include <core/memory/raw/RawMemory.hpp>
 
 #include <thread>
+#include <memory>
+#include <mutex>
 #include <concepts>
+#include <ranges>
+#include <chrono>
 
 
 
@@ -34,6 +45,8 @@ class Task;
 /// joining threads later.
 class BITCRAFTE_ENGINE_API ThreadPool
 {
+	friend class TaskGraph;
+
 public:
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,10 +54,8 @@ public:
 	/// Starts worker threads so tasks can be scheduled.
 	///
 	/// @param create_info
-	/// Thread pool create info tells how the thread pool should be constructed.
-	/// 
-	/// @param thread_resources
-	/// This initializes thread private resources and tells how many threads should be created.
+	/// Thread pool create info tells how the thread pool should be constructed and if worker threads are created
+	/// automatically.
 	ThreadPool(
 		const ThreadPoolCreateInfo						&	create_info
 	);
@@ -53,6 +64,19 @@ public:
 	virtual													~ThreadPool();
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a new thread to the thread pool.
+	///
+	/// Thread is set up using ThreadPoolCreateInfo::default_thread_create_info.
+	///
+	/// @tparam ThreadType
+	/// Thread resource type, must be derived from bc::thread::Thread.
+	///
+	/// @param constructor_arguments
+	/// Arguments passed to the constructor of the thread resource.
+	///
+	/// @return
+	/// Identifier of the new thread.
 	template<
 		typename											ThreadType,
 		typename											...ThreadConstructorArgumentsTypePack
@@ -60,18 +84,88 @@ public:
 	ThreadIdentifier										AddThread(
 		ThreadConstructorArgumentsTypePack				&&	...constructor_arguments
 	)
+	{
+		return AddThreadWithCreateInfo<ThreadType>( create_info.default_thread_create_info, std::forward<ThreadConstructorArgumentsTypePack>( constructor_arguments )... );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a new thread to the thread pool with its own affinity, NUMA placement, priority and name.
+	///
+	/// @tparam ThreadType
+	/// Thread resource type, must be derived from bc::thread::Thread.
+	///
+	/// @param thread_create_info
+	/// Tells how the thread is set up with the operating system. Invalid affinity or NUMA placement throws.
+	///
+	/// @param constructor_arguments
+	/// Arguments passed to the constructor of the thread resource.
+	///
+	/// @return
+	/// Identifier of the new thread.
+	template<
+		typename											ThreadType,
+		typename											...ThreadConstructorArgumentsTypePack
+	>
+	ThreadIdentifier										AddThreadWithCreateInfo(
+		const ThreadCreateInfo							&	thread_create_info,
+		ThreadConstructorArgumentsTypePack				&&	...constructor_arguments
+	)
 	{
 		static_assert( std::is_base_of_v<Thread, ThreadType>, "Thread type must be derived from bc::thread::Thread" );
 		auto thread_description = MakeUniquePtr<ThreadDescription>();
 		thread_description->pool_thread		= MakeUniquePtr<ThreadType>( std::forward<ThreadConstructorArgumentsTypePack>( constructor_arguments )... );
+		thread_description->create_info		= thread_create_info;
 		return DoAddThread( std::move( thread_description ) );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Removes a thread from the thread pool.
+	///
+	/// Waits for the task the thread is running to finish. Tasks queued to the thread are handed over to other threads, tasks
+	/// locked to the thread are completed without running if none of the other threads they are locked to exist.
+	///
+	/// @param thread_id
+	/// Identifier of the thread returned by AddThread().
 	void													RemoveThread(
 		ThreadIdentifier									thread_id
 	);
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam ThreadType
+	///	Thread type we're locking this task to.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param dependencies
+	///	Sets which tasks must run before the task we're currently submitting.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											ThreadType,
+		typename											TaskType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTaskToThreadTypeWithDependencies(
+		const List<TaskIdentifier>						&	dependencies,
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		return ScheduleTaskToThreadTypeWithDependencies<ThreadType, TaskType>( TaskPriority::NORMAL, dependencies, std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
 	/// Schedules a new task to be run on a thread.
@@ -85,6 +179,9 @@ public:
 	/// @tparam ...TaskConstructorArgumentTypePack
 	/// Task constructor argument types.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param dependencies
 	///	Sets which tasks must run before the task we're currently submitting.
 	///
@@ -99,14 +196,46 @@ public:
 		typename											...TaskConstructorArgumentTypePack
 	>
 	TaskIdentifier											ScheduleTaskToThreadTypeWithDependencies(
+		TaskPriority										priority,
+		const List<TaskIdentifier>						&	dependencies,
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		auto new_task = CreateTask<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+		LockTaskToThreadType<ThreadType>( *new_task );
+		new_task->dependencies.Append( dependencies );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param dependencies
+	///	Sets which tasks must run before the task we're currently submitting.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											TaskType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTaskWithDependencies(
 		const List<TaskIdentifier>						&	dependencies,
 		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
 	) requires( std::is_base_of_v<Task, TaskType> )
 	{
-		auto unique_task = MakeUniquePtr<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
-		unique_task->locked_to_threads	= GetTaskThreadLockIDs<ThreadType>();
-		unique_task->dependencies		= dependencies;
-		return DoAddTask( std::move( unique_task ) );
+		return ScheduleTaskWithDependencies<TaskType>( TaskPriority::NORMAL, dependencies, std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -119,6 +248,9 @@ public:
 	/// @tparam ...TaskConstructorArgumentTypePack
 	/// Task constructor argument types.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param dependencies
 	///	Sets which tasks must run before the task we're currently submitting.
 	///
@@ -132,13 +264,45 @@ public:
 		typename											...TaskConstructorArgumentTypePack
 	>
 	TaskIdentifier											ScheduleTaskWithDependencies(
+		TaskPriority										priority,
 		const List<TaskIdentifier>						&	dependencies,
 		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
 	) requires( std::is_base_of_v<Task, TaskType> )
 	{
-		auto unique_task = MakeUniquePtr<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
-		unique_task->dependencies		= dependencies;
-		return DoAddTask( std::move( unique_task ) );
+		auto new_task = CreateTask<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+		new_task->dependencies.Append( dependencies );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam ThreadType
+	///	Thread type we're locking this task to.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											ThreadType,
+		typename											TaskType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTaskToThreadType(
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		return ScheduleTaskToThreadType<ThreadType, TaskType>( TaskPriority::NORMAL, std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -154,6 +318,9 @@ public:
 	/// @tparam ...TaskConstructorArgumentTypePack
 	/// Task constructor argument types.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param ...task_constructor_arguments
 	/// Arguments passed to task constructor.
 	///
@@ -165,12 +332,40 @@ public:
 		typename											...TaskConstructorArgumentTypePack
 	>
 	TaskIdentifier											ScheduleTaskToThreadType(
+		TaskPriority										priority,
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		auto new_task = CreateTask<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+		LockTaskToThreadType<ThreadType>( *new_task );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											TaskType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTask(
 		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
 	) requires( std::is_base_of_v<Task, TaskType> )
 	{
-		auto unique_task = MakeUniquePtr<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
-		unique_task->locked_to_threads	= GetTaskThreadLockIDs<ThreadType>();
-		return DoAddTask( std::move( unique_task ) );
+		return ScheduleTask<TaskType>( TaskPriority::NORMAL, std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -183,6 +378,9 @@ public:
 	/// @tparam ...TaskConstructorArgumentTypePack
 	/// Task constructor argument types.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param ...task_constructor_arguments
 	/// Arguments passed to task constructor.
 	///
@@ -193,11 +391,43 @@ public:
 		typename											...TaskConstructorArgumentTypePack
 	>
 	TaskIdentifier											ScheduleTask(
+		TaskPriority										priority,
 		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
 	) requires( std::is_base_of_v<Task, TaskType> )
 	{
-		auto unique_task = MakeUniquePtr<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
-		return DoAddTask( std::move( unique_task ) );
+		auto new_task = CreateTask<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam ThreadType
+	///	Task type we're scheduling.
+	///
+	/// @tparam LambdaType
+	///	Lambda type we're scheduling.
+	///
+	/// @param lambda_function
+	///	Lambda function we're submitting.
+	///
+	/// @param dependencies
+	///	Sets which tasks must run before the task we're currently submitting.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename ThreadType,
+		typename LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskToThreadTypeWithDependencies(
+		const List<TaskIdentifier>						&	dependencies,
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskToThreadTypeWithDependencies<ThreadType>( TaskPriority::NORMAL, dependencies, std::forward<LambdaType>( lambda_function ) );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -210,6 +440,9 @@ public:
 	/// @tparam LambdaType
 	///	Lambda type we're scheduling.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param lambda_function
 	///	Lambda function we're submitting.
 	///
@@ -223,6 +456,7 @@ public:
 		typename LambdaType
 	>
 	TaskIdentifier											ScheduleLambdaTaskToThreadTypeWithDependencies(
+		TaskPriority										priority,
 		const List<TaskIdentifier>						&	dependencies,
 		LambdaType										&&	lambda_function
 	)
@@ -237,10 +471,40 @@ public:
 			"Lambda task must return task state or nothing, Eg. '[]( Task & task ){}' or '[]( Task & task ){ return TaskExecutionResult::FINISHED; }'"
 		);
 
-		auto unique_task = MakeUniquePtr<LambdaTask<LambdaType>>( std::move( lambda_function ) );
-		unique_task->locked_to_threads	= GetTaskThreadLockIDs<ThreadType>();
-		unique_task->dependencies		= dependencies;
-		return DoAddTask( std::move( unique_task ) );
+		auto new_task = CreateTask<LambdaTask<std::decay_t<LambdaType>>>( std::forward<LambdaType>( lambda_function ) );
+		LockTaskToThreadType<ThreadType>( *new_task );
+		new_task->dependencies.Append( dependencies );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param dependencies
+	///	Sets which tasks must run before the task we're currently submitting.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskWithDependencies(
+		const List<TaskIdentifier>						&	dependencies,
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskWithDependencies( TaskPriority::NORMAL, dependencies, std::forward<LambdaType>( lambda_function ) );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -253,6 +517,9 @@ public:
 	/// @tparam ...TaskConstructorArgumentTypePack
 	/// Task constructor argument types.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param dependencies
 	///	Sets which tasks must run before the task we're currently submitting.
 	///
@@ -265,6 +532,7 @@ public:
 		typename											LambdaType
 	>
 	TaskIdentifier											ScheduleLambdaTaskWithDependencies(
+		TaskPriority										priority,
 		const List<TaskIdentifier>						&	dependencies,
 		LambdaType										&&	lambda_function
 	)
@@ -279,9 +547,39 @@ public:
 			"Lambda task must return task state or nothing, Eg. '[]( Task & task ){}' or '[]( Task & task ){ return TaskExecutionResult::FINISHED; }'"
 		);
 
-		auto unique_task = MakeUniquePtr<LambdaTask<LambdaType>>( std::move( lambda_function ) );
-		unique_task->dependencies		= dependencies;
-		return DoAddTask( std::move( unique_task ) );
+		auto new_task = CreateTask<LambdaTask<std::decay_t<LambdaType>>>( std::forward<LambdaType>( lambda_function ) );
+		new_task->dependencies.Append( dependencies );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam ThreadType
+	///	Thread type we're locking this task to.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											ThreadType,
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskToThreadType(
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskToThreadType<ThreadType>( TaskPriority::NORMAL, std::forward<LambdaType>( lambda_function ) );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -297,6 +595,9 @@ public:
 	/// @tparam ...TaskConstructorArgumentTypePack
 	/// Task constructor argument types.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param ...task_constructor_arguments
 	/// Arguments passed to task constructor.
 	///
@@ -307,6 +608,7 @@ public:
 		typename											LambdaType
 	>
 	TaskIdentifier											ScheduleLambdaTaskToThreadType(
+		TaskPriority										priority,
 		LambdaType										&&	lambda_function
 	)
 	{
@@ -320,9 +622,35 @@ public:
 			"Lambda task must return task state or nothing, Eg. '[]( Task & task ){}' or '[]( Task & task ){ return TaskExecutionResult::FINISHED; }'"
 		);
 
-		auto unique_task = MakeUniquePtr<LambdaTask<LambdaType>>();
-		unique_task->locked_to_threads	= GetTaskThreadLockIDs<ThreadType>( std::move( lambda_function ) );
-		return DoAddTask( std::move( unique_task ) );
+		auto new_task = CreateTask<LambdaTask<std::decay_t<LambdaType>>>( std::forward<LambdaType>( lambda_function ) );
+		LockTaskToThreadType<ThreadType>( *new_task );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTask(
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTask( TaskPriority::NORMAL, std::forward<LambdaType>( lambda_function ) );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -335,6 +663,9 @@ public:
 	/// @tparam ...TaskConstructorArgumentTypePack
 	/// Task constructor argument types.
 	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
 	/// @param ...task_constructor_arguments
 	/// Arguments passed to task constructor.
 	///
@@ -344,6 +675,7 @@ public:
 		typename											LambdaType
 	>
 	TaskIdentifier											ScheduleLambdaTask(
+		TaskPriority										priority,
 		LambdaType										&&	lambda_function
 	)
 	{
@@ -357,52 +689,888 @@ public:
 			"Lambda task must return task state or nothing, Eg. '[]( Task & task ){}' or '[]( Task & task ){ return TaskExecutionResult::FINISHED; }'"
 		);
 
-		auto unique_task = MakeUniquePtr<LambdaTask<LambdaType>>( std::move( lambda_function ) );
-		return DoAddTask( std::move( unique_task ) );
+		auto new_task = CreateTask<LambdaTask<std::decay_t<LambdaType>>>( std::forward<LambdaType>( lambda_function ) );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
-	/// Get the number fo tasks currently queued to be run in threads.
+	/// Schedules a new lambda task returning a value with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleLambdaTaskWithFuture( TaskPriority, const List<TaskIdentifier>&, LambdaType&& )
+	template<
+		typename											LambdaType
+	>
+	auto													ScheduleLambdaTaskWithFuture(
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskWithFuture( TaskPriority::NORMAL, {}, std::forward<LambdaType>( lambda_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task returning a value.
+	///
+	/// @see ScheduleLambdaTaskWithFuture( TaskPriority, const List<TaskIdentifier>&, LambdaType&& )
+	template<
+		typename											LambdaType
+	>
+	auto													ScheduleLambdaTaskWithFuture(
+		TaskPriority										priority,
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskWithFuture( priority, {}, std::forward<LambdaType>( lambda_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task returning a value.
+	///
+	/// Value is stored inline in the state shared by the returned future, getting a result out of a task needs no other shared
+	/// state. Continuations can be chained with TaskFuture::Then().
+	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
+	/// @param dependencies
+	///	Sets which tasks must run before the task we're currently submitting.
+	///
+	/// @param lambda_function
+	/// Lambda taking no parameters, its return value is stored in the future. May return void.
+	///
+	/// @return
+	/// Future of the value returned by the lambda. Future is invalid if the task could not be scheduled.
+	template<
+		typename											LambdaType
+	>
+	auto													ScheduleLambdaTaskWithFuture(
+		TaskPriority										priority,
+		const List<TaskIdentifier>						&	dependencies,
+		LambdaType										&&	lambda_function
+	)
+	{
+		static_assert( utility::CallableWithParameters<LambdaType>, "Future task lambda must not take parameters, Eg. '[](){ return 5; }'" );
+
+		using ValueType = std::remove_cvref_t<std::invoke_result_t<std::decay_t<LambdaType>&>>;
+		auto future = TaskFuture<ValueType>( this, internal_::TaskFutureState<ValueType>::Create() );
+
+		auto new_task = CreateTask<FutureLambdaTask<std::decay_t<LambdaType>, ValueType>>( future.state, std::forward<LambdaType>( lambda_function ) );
+		new_task->dependencies.Append( dependencies );
+		new_task->priority				= priority;
+		future.task_id					= DoAddTask( new_task );
+		return future;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a batch of tasks with TaskPriority::NORMAL, one task per element of a range.
+	///
+	/// @see ScheduleTaskBatch( TaskPriority, const List<TaskIdentifier>&, const TaskArgumentRangeType& )
+	template<
+		typename											TaskType,
+		std::ranges::input_range							TaskArgumentRangeType
+	>
+	TaskIdentifierRange										ScheduleTaskBatch(
+		const TaskArgumentRangeType						&	task_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		return ScheduleTaskBatch<TaskType>( TaskPriority::NORMAL, {}, task_arguments );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a batch of tasks, one task per element of a range.
+	///
+	/// Much cheaper than scheduling the tasks one at a time, tasks get consecutive task identifiers, are queued in a single
+	/// operation and only as many worker threads are woken up as there are tasks ready to run.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling, must be constructible from a range element.
+	///
+	/// @param priority
+	/// Priority of every task in the batch.
+	///
+	/// @param dependencies
+	///	Tasks that must run before any of the tasks in the batch.
+	///
+	/// @param task_arguments
+	/// Range of task constructor arguments, Eg. std::span, List or std::vector. Each task is constructed from one element.
+	///
+	/// @return
+	/// Range of task identifiers given to the tasks, in the order of the range elements.
+	template<
+		typename											TaskType,
+		std::ranges::input_range							TaskArgumentRangeType
+	>
+	TaskIdentifierRange										ScheduleTaskBatch(
+		TaskPriority										priority,
+		const List<TaskIdentifier>						&	dependencies,
+		const TaskArgumentRangeType						&	task_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		return DoScheduleTaskBatch( priority, dependencies, task_arguments,
+			[ this ]( const auto & task_argument ) -> Task*
+			{
+				return CreateTask<TaskType>( task_argument );
+			}
+		);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a batch of lambda tasks with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleLambdaTaskBatch( TaskPriority, const List<TaskIdentifier>&, const LambdaRangeType& )
+	template<
+		std::ranges::input_range							LambdaRangeType
+	>
+	TaskIdentifierRange										ScheduleLambdaTaskBatch(
+		const LambdaRangeType							&	lambda_functions
+	)
+	{
+		return ScheduleLambdaTaskBatch( TaskPriority::NORMAL, {}, lambda_functions );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a batch of lambda tasks, one task per lambda in a range.
+	///
+	/// Much cheaper than scheduling the tasks one at a time, tasks get consecutive task identifiers, are queued in a single
+	/// operation and only as many worker threads are woken up as there are tasks ready to run.
+	///
+	/// @param priority
+	/// Priority of every task in the batch.
+	///
+	/// @param dependencies
+	///	Tasks that must run before any of the tasks in the batch.
+	///
+	/// @param lambda_functions
+	/// Range of lambdas, Eg. std::span, List or std::vector. Each lambda is copied into its own task.
+	///
+	/// @return
+	/// Range of task identifiers given to the tasks, in the order of the lambdas.
+	template<
+		std::ranges::input_range							LambdaRangeType
+	>
+	TaskIdentifierRange										ScheduleLambdaTaskBatch(
+		TaskPriority										priority,
+		const List<TaskIdentifier>						&	dependencies,
+		const LambdaRangeType							&	lambda_functions
+	)
+	{
+		using LambdaType = std::ranges::range_value_t<LambdaRangeType>;
+		static_assert(
+			utility::CallableWithParameters<LambdaType, Task&> || utility::CallableWithParameters<LambdaType>,
+			"Task lambda must accept reference to a task or nothing, Eg. '[](){}' or '[]( Task & task ){}"
+		);
+		static_assert(
+			utility::CallableWithReturnAndParameters<LambdaType, void, Task&> || utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult, Task&> ||
+			utility::CallableWithReturnAndParameters<LambdaType, void> || utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult>,
+			"Lambda task must return task state or nothing, Eg. '[]( Task & task ){}' or '[]( Task & task ){ return TaskExecutionResult::FINISHED; }'"
+		);
+
+		return DoScheduleTaskBatch( priority, dependencies, lambda_functions,
+			[ this ]( const LambdaType & lambda_function ) -> Task*
+			{
+				return CreateTask<LambdaTask<LambdaType>>( lambda_function );
+			}
+		);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on the main thread with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleTaskToMainThread( TaskPriority, TaskConstructorArgumentTypePack&&... )
+	template<
+		typename											TaskType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTaskToMainThread(
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		return ScheduleTaskToMainThread<TaskType>( TaskPriority::NORMAL, std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on the main thread.
+	///
+	/// Main thread tasks are run from Run(), and while the main thread waits in WaitForTask(), WaitForTasks() or WaitIdle().
+	/// Worker threads never see them.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param priority
+	/// Priority of the task, ready main thread tasks with higher priority are run before tasks with lower priority.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											TaskType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTaskToMainThread(
+		TaskPriority										priority,
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		auto new_task = CreateTask<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+		new_task->locked_to_threads.PushBack( MAIN_THREAD_ID );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task to be run on the main thread with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleLambdaTaskToMainThread( TaskPriority, LambdaType&& )
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskToMainThread(
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskToMainThread( TaskPriority::NORMAL, std::forward<LambdaType>( lambda_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task to be run on the main thread.
+	///
+	/// @see ScheduleTaskToMainThread( TaskPriority, TaskConstructorArgumentTypePack&&... )
+	///
+	/// @param priority
+	/// Priority of the task, ready main thread tasks with higher priority are run before tasks with lower priority.
+	///
+	/// @param lambda_function
+	/// Lambda run on the main thread.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskToMainThread(
+		TaskPriority										priority,
+		LambdaType										&&	lambda_function
+	)
+	{
+		static_assert(
+			utility::CallableWithParameters<LambdaType, Task&> || utility::CallableWithParameters<LambdaType>,
+			"Task lambda must accept reference to a task or nothing, Eg. '[](){}' or '[]( Task & task ){}"
+		);
+		static_assert(
+			utility::CallableWithReturnAndParameters<LambdaType, void, Task&> || utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult, Task&> ||
+			utility::CallableWithReturnAndParameters<LambdaType, void> || utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult>,
+			"Lambda task must return task state or nothing, Eg. '[]( Task & task ){}' or '[]( Task & task ){ return TaskExecutionResult::FINISHED; }'"
+		);
+
+		auto new_task = CreateTask<LambdaTask<std::decay_t<LambdaType>>>( std::forward<LambdaType>( lambda_function ) );
+		new_task->locked_to_threads.PushBack( MAIN_THREAD_ID );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new coroutine task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleCoroutineTaskWithDependencies( TaskPriority, const List<TaskIdentifier>&, LambdaType&& )
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleCoroutineTask(
+		LambdaType										&&	coroutine_function
+	)
+	{
+		return ScheduleCoroutineTaskWithDependencies( TaskPriority::NORMAL, {}, std::forward<LambdaType>( coroutine_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new coroutine task to be run on a thread.
+	///
+	/// @see ScheduleCoroutineTaskWithDependencies( TaskPriority, const List<TaskIdentifier>&, LambdaType&& )
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleCoroutineTask(
+		TaskPriority										priority,
+		LambdaType										&&	coroutine_function
+	)
+	{
+		return ScheduleCoroutineTaskWithDependencies( priority, {}, std::forward<LambdaType>( coroutine_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new coroutine task to be run on a thread with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleCoroutineTaskWithDependencies( TaskPriority, const List<TaskIdentifier>&, LambdaType&& )
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleCoroutineTaskWithDependencies(
+		const List<TaskIdentifier>						&	dependencies,
+		LambdaType										&&	coroutine_function
+	)
+	{
+		return ScheduleCoroutineTaskWithDependencies( TaskPriority::NORMAL, dependencies, std::forward<LambdaType>( coroutine_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new coroutine task to be run on a thread.
+	///
+	/// Coroutine task can suspend itself with co_await, see CoroutineTask for what can be awaited. While suspended it does not
+	/// occupy a worker thread, it is queued again once what it awaits is ready and continues where it left off. Task completes
+	/// when the coroutine returns.
+	///
+	/// The lambda is kept alive inside the task and called on the first run to create the coroutine, so the coroutine may
+	/// safely refer to lambda captures for its whole lifetime.
+	///
+	/// @tparam LambdaType
+	/// Callable returning a CoroutineTask, Eg. '[]() -> CoroutineTask { co_return; }' or
+	/// '[]( Task & task ) -> CoroutineTask { co_return; }'.
+	///
+	/// @param priority
+	/// Priority of the task, also used every time the task is queued again after a suspension.
+	///
+	/// @param dependencies
+	///	Sets which tasks must run before the coroutine is first started.
+	///
+	/// @param coroutine_function
+	/// Callable creating the coroutine.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleCoroutineTaskWithDependencies(
+		TaskPriority										priority,
+		const List<TaskIdentifier>						&	dependencies,
+		LambdaType										&&	coroutine_function
+	)
+	{
+		static_assert(
+			utility::CallableWithReturnAndParameters<LambdaType, CoroutineTask, Task&> || utility::CallableWithReturnAndParameters<LambdaType, CoroutineTask>,
+			"Coroutine task lambda must return a coroutine task and accept reference to a task or nothing, Eg. '[]() -> CoroutineTask { co_return; }'"
+		);
+
+		auto new_task = CreateTask<CoroutineLambdaTask<std::decay_t<LambdaType>>>( std::forward<LambdaType>( coroutine_function ) );
+		new_task->dependencies.Append( dependencies );
+		new_task->priority				= priority;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread after a delay with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleTaskAfter( TaskPriority, std::chrono::duration, TaskConstructorArgumentTypePack&&... )
+	template<
+		typename											TaskType,
+		typename											RepresentationType,
+		typename											PeriodType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTaskAfter(
+		std::chrono::duration<RepresentationType, PeriodType>	delay,
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		return ScheduleTaskAfter<TaskType>( TaskPriority::NORMAL, delay, std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new task to be run on a thread after a delay.
+	///
+	/// Task waits in the thread pool timer wheel until the delay has passed, it is not polled and does not occupy a worker
+	/// thread. Timers have a resolution of TaskTimerWheel::TICK_NANOSECONDS, tasks never run early but may run up to one tick
+	/// late. The task counts as scheduled from the start, waiting for it also waits for the delay.
+	///
+	/// @tparam TaskType
+	///	Task type we're scheduling.
+	///
+	/// @tparam ...TaskConstructorArgumentTypePack
+	/// Task constructor argument types.
+	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
+	/// @param delay
+	/// How long to wait before the task is queued.
+	///
+	/// @param ...task_constructor_arguments
+	/// Arguments passed to task constructor.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											TaskType,
+		typename											RepresentationType,
+		typename											PeriodType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskIdentifier											ScheduleTaskAfter(
+		TaskPriority										priority,
+		std::chrono::duration<RepresentationType, PeriodType>	delay,
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	) requires( std::is_base_of_v<Task, TaskType> )
+	{
+		auto new_task = CreateTask<TaskType>( std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+		new_task->priority				= priority;
+		new_task->resume_deadline		= GetDeadlineAfter( delay );
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task to be run on a thread after a delay with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleLambdaTaskAfter( TaskPriority, std::chrono::duration, LambdaType&& )
+	template<
+		typename											RepresentationType,
+		typename											PeriodType,
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskAfter(
+		std::chrono::duration<RepresentationType, PeriodType>	delay,
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskAfter( TaskPriority::NORMAL, delay, std::forward<LambdaType>( lambda_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task to be run on a thread after a delay.
+	///
+	/// @see ScheduleTaskAfter( TaskPriority, std::chrono::duration, TaskConstructorArgumentTypePack&&... )
+	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
+	/// @param delay
+	/// How long to wait before the task is queued.
+	///
+	/// @param lambda_function
+	/// Lambda accepting a reference to a task or nothing, same as with ScheduleLambdaTask().
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											RepresentationType,
+		typename											PeriodType,
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskAfter(
+		TaskPriority										priority,
+		std::chrono::duration<RepresentationType, PeriodType>	delay,
+		LambdaType										&&	lambda_function
+	)
+	{
+		static_assert(
+			utility::CallableWithParameters<LambdaType, Task&> || utility::CallableWithParameters<LambdaType>,
+			"Task lambda must accept reference to a task or nothing, Eg. '[](){}' or '[]( Task & task ){}"
+		);
+		static_assert(
+			utility::CallableWithReturnAndParameters<LambdaType, void, Task&> || utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult, Task&> ||
+			utility::CallableWithReturnAndParameters<LambdaType, void> || utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult>,
+			"Lambda task must return task state or nothing, Eg. '[]( Task & task ){}' or '[]( Task & task ){ return TaskExecutionResult::FINISHED; }'"
+		);
+
+		auto new_task = CreateTask<LambdaTask<std::decay_t<LambdaType>>>( std::forward<LambdaType>( lambda_function ) );
+		new_task->priority				= priority;
+		new_task->resume_deadline		= GetDeadlineAfter( delay );
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task run periodically with TaskPriority::NORMAL.
+	///
+	/// @see ScheduleLambdaTaskEvery( TaskPriority, std::chrono::duration, LambdaType&& )
+	template<
+		typename											RepresentationType,
+		typename											PeriodType,
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskEvery(
+		std::chrono::duration<RepresentationType, PeriodType>	period,
+		LambdaType										&&	lambda_function
+	)
+	{
+		return ScheduleLambdaTaskEvery( TaskPriority::NORMAL, period, std::forward<LambdaType>( lambda_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a new lambda task run periodically.
+	///
+	/// Lambda is first run one period after scheduling and then once every period. Runs are kept at a fixed rate, a run that
+	/// starts late does not push later runs back. If the lambda falls more than a whole period behind, missed runs are skipped
+	/// instead of being run back to back. Between runs the task waits in the timer wheel like tasks scheduled with
+	/// ScheduleTaskAfter().
+	///
+	/// The task completes once the lambda returns false, or right away once the thread pool starts shutting down without waiting
+	/// for the next run. Until then it counts as a running task, waiting for it or for the thread pool to become idle waits for
+	/// it to stop.
+	///
+	/// @param priority
+	/// Priority of the task, ready tasks with higher priority are run before tasks with lower priority.
+	///
+	/// @param period
+	/// Time between runs, must be positive.
+	///
+	/// @param lambda_function
+	/// Lambda taking no parameters. Return true to keep running or false to stop, returning nothing runs until the thread pool
+	/// is destroyed.
+	///
+	/// @return
+	/// Unique id to the task process which can be waited upon by other submits.
+	template<
+		typename											RepresentationType,
+		typename											PeriodType,
+		typename											LambdaType
+	>
+	TaskIdentifier											ScheduleLambdaTaskEvery(
+		TaskPriority										priority,
+		std::chrono::duration<RepresentationType, PeriodType>	period,
+		LambdaType										&&	lambda_function
+	)
+	{
+		static_assert(
+			utility::CallableWithReturnAndParameters<LambdaType, bool> || utility::CallableWithReturnAndParameters<LambdaType, void>,
+			"Periodic task lambda must take no parameters and return bool or nothing, Eg. '[](){ return true; }'"
+		);
+		auto period_duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>( period );
+		BHardAssert( period_duration.count() > 0, "Failed to schedule periodic task, period must be positive" );
+
+		auto first_run = std::chrono::steady_clock::now() + period_duration;
+		auto new_task = CreateTask<PeriodicLambdaTask<std::decay_t<LambdaType>>>( this, period_duration, first_run, std::forward<LambdaType>( lambda_function ) );
+		new_task->priority				= priority;
+		new_task->resume_deadline		= std::chrono::duration_cast<std::chrono::nanoseconds>( first_run.time_since_epoch() ).count();
+		new_task->ends_on_shutdown		= true;
+		return DoAddTask( new_task );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get the number fo tasks currently queued to be run in threads.
 	///
 	/// @note
 	/// Running tasks are included.
 	///
-	/// @return
-	/// Number of tasks queued.
-	u64														GetTaskQueueCount() const;
+	/// @return
+	/// Number of tasks queued.
+	u64														GetTaskQueueCount() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get the number fo tasks currently running in threads.
+	///
+	/// @return
+	/// Number of tasks being executed.
+	u64														GetTaskRunningCount() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Get the number of tasks of a specific priority that are ready to run but have not been started yet.
+	///
+	/// @note
+	/// Tasks waiting for their dependencies and running tasks are not included.
+	///
+	/// @param priority
+	/// Priority level to query.
+	///
+	/// @return
+	/// Number of ready tasks at the priority level.
+	u64														GetTaskQueueDepth(
+		TaskPriority										priority
+	) const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes a snapshot of worker thread telemetry.
+	///
+	/// Every worker thread keeps its own counters which it updates without locking, taking a snapshot only reads them and never
+	/// stalls the worker threads. Tasks run by the main thread are not included.
+	///
+	/// @return
+	/// Statistics of each worker thread and their combined totals since the worker thread was added or since the last call to
+	/// ResetStatistics().
+	ThreadPoolStatistics									GetStatistics() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Sets every worker thread telemetry counter back to zero, Eg. to measure a single frame or level load.
+	void													ResetStatistics();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the STL thread id from thread pool index.
+	/// 
+	/// @param thread_id
+	///	Identifier of the thread.
+	/// 
+	/// @return
+	/// STL thread id. Returned id will be empty if thread was not found.
+	std::thread::id											GetThreadSystemID(
+		ThreadIdentifier									thread_id
+	) const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Runs tasks delivered to the main thread and handles exceptions raised by worker threads.
+	///
+	/// Must be called from the main thread regularly, Eg. once per frame.
+	void													Run();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits until a task has completed.
+	///
+	/// Calling thread sleeps until it is woken up by the completion of the task. Returns immediately if the task has already
+	/// completed.
+	///
+	/// @warning
+	/// Waiting from inside a task occupies the worker thread for the duration of the wait.
+	///
+	/// @param task_id
+	/// Identifier of the task to wait for.
+	void													WaitForTask(
+		TaskIdentifier										task_id
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits until all listed tasks have completed.
+	///
+	/// Calling thread sleeps until it is woken up by the completion of the tasks. Tasks that have already completed are not waited
+	/// for.
+	///
+	/// @warning
+	/// Waiting from inside a task occupies the worker thread for the duration of the wait.
+	///
+	/// @param task_ids
+	/// Identifiers of the tasks to wait for.
+	void													WaitForTasks(
+		const List<TaskIdentifier>						&	task_ids
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Waits until thread pool has no work left to do.
+	///
+	/// Calling thread sleeps until it is woken up by the completion of the last task.
+	///
+	/// @warning
+	/// Must not be called from inside a task, the task itself keeps the thread pool from becoming idle.
+	void													WaitIdle();
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
-	/// Get the number fo tasks currently running in threads.
+	/// Gets the number of worker threads in the thread pool.
 	///
 	/// @return
-	/// Number of tasks being executed.
-	u64														GetTaskRunningCount() const;
+	/// Number of worker threads.
+	u64														GetThreadCount() const;
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
-	/// Gets the STL thread id from thread pool index.
-	/// 
-	/// @param thread_id
-	///	Identifier of the thread.
-	/// 
-	/// @return
-	/// STL thread id. Returned id will be empty if thread was not found.
-	std::thread::id											GetThreadSystemID(
-		ThreadIdentifier									thread_id
-	) const;
+	/// Runs a callable for every index in a range using the worker threads, with TaskPriority::NORMAL.
+	///
+	/// @see ParallelFor( TaskPriority, u64, u64, u64, LambdaType&& )
+	template<
+		typename											LambdaType
+	>
+	void													ParallelFor(
+		u64													begin,
+		u64													end,
+		u64													grain_size,
+		LambdaType										&&	lambda_function
+	)
+	{
+		ParallelFor( TaskPriority::NORMAL, begin, end, grain_size, std::forward<LambdaType>( lambda_function ) );
+	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	void													Run();
+	/// @brief
+	/// Runs a callable for every index in a range using the worker threads.
+	///
+	/// Range is split adaptively, large chunks are handed out first and chunks get smaller as the range runs out so that threads
+	/// finishing early keep finding work near the end. Calling thread processes chunks too and returns once the whole range has
+	/// been processed, it can be called from inside a task.
+	///
+	/// If the callable throws, chunks that have not started yet are skipped and the exception is rethrown on the calling thread
+	/// once the chunks already running have finished.
+	///
+	/// @tparam LambdaType
+	/// Callable type, either takes a single index '[]( u64 index ){}' or a chunk of indices
+	/// '[]( u64 chunk_begin, u64 chunk_end ){}'.
+	///
+	/// @param priority
+	/// Priority of the helper tasks that run chunks on the worker threads.
+	///
+	/// @param begin
+	/// First index of the range.
+	///
+	/// @param end
+	/// One past the last index of the range.
+	///
+	/// @param grain_size
+	/// Smallest number of indices in a chunk, set this so that a chunk is worth more than the cost of handing it out. Zero is
+	/// treated as 1.
+	///
+	/// @param lambda_function
+	/// Callable run for each index or chunk. Called from multiple threads at the same time.
+	template<
+		typename											LambdaType
+	>
+	void													ParallelFor(
+		TaskPriority										priority,
+		u64													begin,
+		u64													end,
+		u64													grain_size,
+		LambdaType										&&	lambda_function
+	)
+	{
+		static_assert(
+			utility::CallableWithParameters<LambdaType, u64, u64> || utility::CallableWithParameters<LambdaType, u64>,
+			"Parallel for lambda must accept an index or a chunk range, Eg. '[]( u64 index ){}' or '[]( u64 chunk_begin, u64 chunk_end ){}'"
+		);
+
+		auto chunk_function = []( void * user_data, u64 chunk_begin, u64 chunk_end )
+			{
+				auto & lambda = *static_cast<std::remove_reference_t<LambdaType>*>( user_data );
+				if constexpr( utility::CallableWithParameters<LambdaType, u64, u64> )
+				{
+					lambda( chunk_begin, chunk_end );
+				}
+				else
+				{
+					for( u64 i = chunk_begin; i < chunk_end; ++i ) lambda( i );
+				}
+			};
+		DoParallelFor( priority, begin, end, grain_size, chunk_function, const_cast<void*>( static_cast<const void*>( std::addressof( lambda_function ) ) ) );
+	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
-	/// Waits until thread pool has no work left to do.
+	/// Combines values produced for every index in a range using the worker threads, with TaskPriority::NORMAL.
 	///
-	/// @warning
-	/// This can add up to a millisecond of wasted time per call and is primarily meant to be used only when shutting down.
-	void													WaitIdle();
+	/// @see ParallelReduce( TaskPriority, u64, u64, u64, const ValueType&, MapLambdaType&&, ReduceLambdaType&& )
+	template<
+		typename											ValueType,
+		typename											MapLambdaType,
+		typename											ReduceLambdaType
+	>
+	ValueType												ParallelReduce(
+		u64													begin,
+		u64													end,
+		u64													grain_size,
+		const ValueType									&	identity,
+		MapLambdaType									&&	map_function,
+		ReduceLambdaType								&&	reduce_function
+	)
+	{
+		return ParallelReduce( TaskPriority::NORMAL, begin, end, grain_size, identity, std::forward<MapLambdaType>( map_function ), std::forward<ReduceLambdaType>( reduce_function ) );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Combines values produced for every index in a range using the worker threads.
+	///
+	/// Work is split the same way as in ParallelFor(). Each chunk is reduced on its own starting from the identity value, chunk
+	/// results are then combined into the final result in the order the chunks finish.
+	///
+	/// @note
+	/// Reduce function must be associative and commutative, Eg. sum, minimum or maximum, otherwise the result depends on how
+	/// the range happened to be split.
+	///
+	/// @tparam ValueType
+	/// Type of the reduced value.
+	///
+	/// @tparam MapLambdaType
+	/// Callable producing a value for an index, Eg. '[]( u64 index ) -> ValueType {}'.
+	///
+	/// @tparam ReduceLambdaType
+	/// Callable combining two values, Eg. '[]( ValueType a, ValueType b ) -> ValueType {}'.
+	///
+	/// @param priority
+	/// Priority of the helper tasks that run chunks on the worker threads.
+	///
+	/// @param begin
+	/// First index of the range.
+	///
+	/// @param end
+	/// One past the last index of the range.
+	///
+	/// @param grain_size
+	/// Smallest number of indices in a chunk. Zero is treated as 1.
+	///
+	/// @param identity
+	/// Value that does not change the result when reduced with another value, Eg. 0 for sum. Returned for an empty range.
+	///
+	/// @param map_function
+	/// Callable run for each index. Called from multiple threads at the same time.
+	///
+	/// @param reduce_function
+	/// Callable combining two values. Called from multiple threads at the same time.
+	///
+	/// @return
+	/// Reduced value of the whole range.
+	template<
+		typename											ValueType,
+		typename											MapLambdaType,
+		typename											ReduceLambdaType
+	>
+	ValueType												ParallelReduce(
+		TaskPriority										priority,
+		u64													begin,
+		u64													end,
+		u64													grain_size,
+		const ValueType									&	identity,
+		MapLambdaType									&&	map_function,
+		ReduceLambdaType								&&	reduce_function
+	)
+	{
+		static_assert( utility::CallableWithParameters<MapLambdaType, u64>, "Parallel reduce map lambda must accept an index, Eg. '[]( u64 index ){}'" );
+		static_assert( utility::CallableWithParameters<ReduceLambdaType, ValueType, ValueType>, "Parallel reduce reduce lambda must accept two values" );
+
+		auto result = identity;
+		auto result_mutex = std::mutex {};
+		ParallelFor( priority, begin, end, grain_size, [ & ]( u64 chunk_begin, u64 chunk_end )
+			{
+				auto chunk_result = identity;
+				for( u64 i = chunk_begin; i < chunk_end; ++i )
+				{
+					chunk_result = reduce_function( std::move( chunk_result ), map_function( i ) );
+				}
+
+				auto lock_guard = std::lock_guard( result_mutex );
+				result = reduce_function( std::move( result ), std::move( chunk_result ) );
+			}
+		);
+		return result;
+	}
 
 private:
 
@@ -410,52 +1578,348 @@ private:
 	class LambdaTask : public Task
 	{
 	public:
+		template<typename LambdaConstructorType>
 		LambdaTask(
-			LambdaType										lambda_function
+			LambdaConstructorType						&&	lambda_function
 		) :
-			lambda_function( lambda_function )
+			lambda_function( std::forward<LambdaConstructorType>( lambda_function ) )
 		{}
 
 		virtual TaskExecutionResult							operator() (
 			Thread										&	thread
 		) override
 		{
-			constexpr bool non_void1 = utility::CallableWithParameters<LambdaType, void>;
-			constexpr bool non_void2 = utility::CallableWithParameters<LambdaType, void, Task&>;
-			constexpr bool non_void3 = utility::CallableWithParameters<LambdaType, TaskExecutionResult>;
-			constexpr bool non_void4 = utility::CallableWithParameters<LambdaType, TaskExecutionResult, Task&>;
-
-			if constexpr( utility::CallableWithParameters<LambdaType, void> )
+			if constexpr( utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult, Task&> )
 			{
-				lambda_function();
+				return lambda_function( *this );
+			}
+			else if constexpr( utility::CallableWithReturnAndParameters<LambdaType, TaskExecutionResult> )
+			{
+				return lambda_function();
+			}
+			else if constexpr( utility::CallableWithParameters<LambdaType, Task&> )
+			{
+				lambda_function( *this );
 				return TaskExecutionResult::FINISHED;
 			}
-			else if constexpr( utility::CallableWithParameters<LambdaType, void, Task&> )
+			else
 			{
 				lambda_function();
 				return TaskExecutionResult::FINISHED;
 			}
-			else if constexpr( utility::CallableWithParameters<LambdaType, TaskExecutionResult> )
+		}
+
+	private:
+		LambdaType											lambda_function;
+	};
+
+	template<
+		typename											LambdaType,
+		typename											ValueType
+	>
+	class FutureLambdaTask : public Task
+	{
+	public:
+		template<typename LambdaConstructorType>
+		FutureLambdaTask(
+			internal_::TaskFutureState<ValueType>		*	state,
+			LambdaConstructorType						&&	lambda_function
+		) :
+			lambda_function( std::forward<LambdaConstructorType>( lambda_function ) ),
+			state( state )
+		{
+			state->AddReference();
+		}
+
+		virtual												~FutureLambdaTask()
+		{
+			// Task was completed without running, eg. its thread was removed. Waiters see the failure once this task is gone.
+			if( !state->IsDone() ) state->SetFailed( nullptr );
+			state->RemoveReference();
+		}
+
+		virtual TaskExecutionResult							operator() (
+			Thread										&	thread
+		) override
+		{
+			// Exception is stored in the future instead of shutting down the thread pool, whoever gets the value handles it.
+			try
 			{
-				return lambda_function();
+				if constexpr( std::is_void_v<ValueType> )
+				{
+					lambda_function();
+					state->SetValue();
+				}
+				else
+				{
+					state->SetValue( lambda_function() );
+				}
 			}
-			else if constexpr( utility::CallableWithParameters<LambdaType, TaskExecutionResult, Task&> )
+			catch( ... )
 			{
-				return lambda_function();
+				state->SetFailed( std::current_exception() );
+				return TaskExecutionResult::ERROR;
+			}
+			return TaskExecutionResult::FINISHED;
+		}
+
+	private:
+		LambdaType											lambda_function;
+		internal_::TaskFutureState<ValueType>			*	state;
+	};
+
+	template<typename LambdaType>
+	class CoroutineLambdaTask : public Task
+	{
+	public:
+		template<typename LambdaConstructorType>
+		CoroutineLambdaTask(
+			LambdaConstructorType						&&	coroutine_function
+		) :
+			coroutine_function( std::forward<LambdaConstructorType>( coroutine_function ) )
+		{}
+
+		virtual TaskExecutionResult							operator() (
+			Thread										&	thread
+		) override
+		{
+			if( !coroutine.IsValid() )
+			{
+				if constexpr( utility::CallableWithParameters<LambdaType, Task&> )	coroutine = coroutine_function( *this );
+				else																coroutine = coroutine_function();
+			}
+
+			// Suspended coroutine has registered what it waits for with this task, pausing makes the thread pool wait for it.
+			coroutine.Resume( *this );
+			return coroutine.IsDone() ? TaskExecutionResult::FINISHED : TaskExecutionResult::PAUSED;
+		}
+
+	private:
+		LambdaType											coroutine_function;
+
+		// Destroyed before the lambda, the coroutine frame may refer to lambda captures.
+		CoroutineTask										coroutine;
+	};
+
+	template<typename LambdaType>
+	class PeriodicLambdaTask : public Task
+	{
+	public:
+		template<typename LambdaConstructorType>
+		PeriodicLambdaTask(
+			ThreadPool									*	thread_pool,
+			std::chrono::steady_clock::duration				period,
+			std::chrono::steady_clock::time_point			next_run,
+			LambdaConstructorType						&&	lambda_function
+		) :
+			lambda_function( std::forward<LambdaConstructorType>( lambda_function ) ),
+			thread_pool( thread_pool ),
+			period( period ),
+			next_run( next_run )
+		{}
+
+		virtual TaskExecutionResult							operator() (
+			Thread										&	thread
+		) override
+		{
+			// Timer fires early once the thread pool starts shutting down, the task stops without running again.
+			if( thread_pool->shutting_down ) return TaskExecutionResult::FINISHED;
+
+			if constexpr( utility::CallableWithReturnAndParameters<LambdaType, bool> )
+			{
+				if( !lambda_function() ) return TaskExecutionResult::FINISHED;
 			}
 			else
 			{
 				lambda_function();
 			}
+			if( thread_pool->shutting_down ) return TaskExecutionResult::FINISHED;
+
+			// Fixed rate, late runs do not shift the schedule unless a whole period was missed.
+			auto now = std::chrono::steady_clock::now();
+			next_run += period;
+			if( next_run <= now ) next_run = now + period;
+
+			SetResumeDeadlineAtRuntime( next_run );
+			return TaskExecutionResult::PAUSED;
 		}
 
 	private:
 		LambdaType											lambda_function;
+		ThreadPool										*	thread_pool;
+		std::chrono::steady_clock::duration					period;
+		std::chrono::steady_clock::time_point				next_run;
 	};
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Converts a delay to the steady clock deadline stored in Task::resume_deadline.
+	template<
+		typename											RepresentationType,
+		typename											PeriodType
+	>
+	static i64												GetDeadlineAfter(
+		std::chrono::duration<RepresentationType, PeriodType>	delay
+	)
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( delay );
+		return std::max<i64>( 1, std::chrono::duration_cast<std::chrono::nanoseconds>( deadline.time_since_epoch() ).count() );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Allocates and constructs a new task.
+	///
+	/// Tasks that fit in a task pool slot, which includes lambda tasks with small captures, are placed in a recycled slot. Larger
+	/// tasks get their own allocation. Tasks are owned by the thread shared data once scheduled and are destroyed with
+	/// ThreadSharedData::DestroyTask() after they have completed.
+	template<
+		typename											TaskType,
+		typename											...TaskConstructorArgumentTypePack
+	>
+	TaskType											*	CreateTask(
+		TaskConstructorArgumentTypePack					&&	...task_constructor_arguments
+	)
+	{
+		constexpr bool use_task_pool = sizeof( TaskType ) <= TaskPool::SLOT_SIZE && alignof( TaskType ) <= TaskPool::SLOT_ALIGNMENT;
+
+		TaskType * new_task = nullptr;
+		if constexpr( use_task_pool )	new_task = static_cast<TaskType*>( AllocateTaskSlot() );
+		else							new_task = memory::AllocateMemory<TaskType>( 1, alignof( TaskType ) );
+
+		try
+		{
+			std::construct_at( new_task, std::forward<TaskConstructorArgumentTypePack>( task_constructor_arguments )... );
+		}
+		catch( ... )
+		{
+			if constexpr( use_task_pool )	FreeTaskSlot( new_task );
+			else							memory::FreeMemory( new_task, 1 );
+			throw;
+		}
+		new_task->allocated_from_task_pool = use_task_pool;
+		return new_task;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void												*	AllocateTaskSlot();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void													FreeTaskSlot(
+		void											*	slot
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	using ParallelForChunkFunction							= void( * )( void * user_data, u64 chunk_begin, u64 chunk_end );
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void													DoParallelFor(
+		TaskPriority										priority,
+		u64													begin,
+		u64													end,
+		u64													grain_size,
+		ParallelForChunkFunction							chunk_function,
+		void											*	user_data
+	);
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	TaskIdentifier											DoAddTask(
-		UniquePtr<Task>									&&	new_task
+		Task											*	new_task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules a task the thread pool does not own, the task is handed back through Task::OnReleasedByThreadPool().
+	///
+	/// Allowed while shutting down so that work already in flight can finish scheduling its own follow up tasks.
+	///
+	/// @param task
+	/// Task to schedule, it must not currently be scheduled.
+	///
+	/// @param priority
+	/// Priority the task is queued with.
+	///
+	/// @param resume_condition
+	/// Condition the task waits for before it is queued, nullptr queues the task right away.
+	///
+	/// @return
+	/// Identifier of the task, 0 if a worker thread has raised an exception in which case the task was not scheduled.
+	TaskIdentifier											DoAddExternallyOwnedTask(
+		Task											*	task,
+		TaskPriority										priority,
+		TaskResumeCondition								*	resume_condition			= nullptr
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Schedules several tasks the thread pool does not own, tasks are queued together like DoAddTaskBatch() does.
+	///
+	/// @param tasks
+	/// Tasks to schedule, each must have been prepared with PrepareExternallyOwnedTask().
+	///
+	/// @param task_count
+	/// Number of tasks.
+	///
+	/// @return
+	/// Identifiers of the tasks, empty if a worker thread has raised an exception in which case no task was scheduled.
+	TaskIdentifierRange										DoAddExternallyOwnedTaskBatch(
+		Task										* const	*	tasks,
+		u64													task_count
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Brings a task that may have run before back to the state of a freshly created task.
+	static void												PrepareExternallyOwnedTask(
+		Task											*	task,
+		TaskPriority										priority,
+		TaskResumeCondition								*	resume_condition			= nullptr
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	template<
+		typename											RangeType,
+		typename											CreateTaskCallableType
+	>
+	TaskIdentifierRange										DoScheduleTaskBatch(
+		TaskPriority										priority,
+		const List<TaskIdentifier>						&	dependencies,
+		const RangeType									&	range,
+		CreateTaskCallableType							&&	create_task
+	)
+	{
+		auto new_tasks = List<Task*> {};
+		if constexpr( std::ranges::sized_range<RangeType> ) new_tasks.Reserve( u64( std::ranges::size( range ) ) );
+
+		try
+		{
+			for( const auto & element : range )
+			{
+				new_tasks.PushBack( nullptr );
+				new_tasks.Back() = create_task( element );
+				new_tasks.Back()->dependencies.Append( dependencies );
+				new_tasks.Back()->priority = priority;
+			}
+		}
+		catch( ... )
+		{
+			if( !new_tasks.IsEmpty() && new_tasks.Back() == nullptr ) new_tasks.PopBack();
+			DestroyUnscheduledTasks( new_tasks );
+			throw;
+		}
+		return DoAddTaskBatch( new_tasks );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskIdentifierRange										DoAddTaskBatch(
+		List<Task*>										&	new_tasks
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Destroys tasks that were created but never handed over to the thread shared data.
+	void													DestroyUnscheduledTasks(
+		List<Task*>										&	tasks
 	);
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -471,39 +1935,91 @@ private:
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	void													CheckAndHandleThreadThrow();
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Runs every task currently in the main thread mailbox.
+	///
+	/// Exceptions raised by the tasks are reported to the thread shared data and not thrown.
+	void													RunMainThreadTasks();
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	void													EvacuateThreads();
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	template<typename ThreadType>
-	List<ThreadIdentifier>									GetTaskThreadLockIDs()
+	void													LockTaskToThreadType(
+		Task											&	task
+	)
 	{
-		List<ThreadIdentifier> ret;
 		for( u64 i = 0; i < thread_description_list.Size(); i++ )
 		{
 			if( dynamic_cast<ThreadType*>( thread_description_list[ i ]->pool_thread.Get() ) != nullptr )
 			{
-				ret.PushBack( i );
+				task.locked_to_threads.PushBack( thread_description_list[ i ]->thread_id );
 			}
 		}
-		return ret;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	ThreadPoolCreateInfo									create_info					= {};
 
 	std::thread::id											main_thread_id;
+	UniquePtr<Thread>										main_thread;
 
 	UniquePtr<ThreadSharedData>								thread_shared_data;
 	List<UniquePtr<ThreadDescription>>						thread_description_list;
 
 	std::atomic<TaskIdentifier>								task_id_counter				= 0;
 	std::atomic<ThreadIdentifier>							thread_id_counter			= 0;
+	std::atomic<u64>										thread_count				= 0;
 
 	std::atomic_bool										shutting_down				= {};
 };
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ValueType>
+void TaskFuture<ValueType>::Wait() const
+{
+	BAssert( IsValid(), U"Cannot wait for task future, future does not refer to a task" );
+	if( state->IsDone() ) return;
+	thread_pool->WaitForTask( task_id );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ValueType>
+decltype( auto ) TaskFuture<ValueType>::Get() const
+{
+	Wait();
+	if( !state->IsReady() ) std::rethrow_exception( state->GetFailure() );
+	if constexpr( !std::is_void_v<ValueType> ) return ( state->GetValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ValueType>
+template<typename LambdaType>
+auto TaskFuture<ValueType>::Then(
+	TaskPriority		priority,
+	LambdaType		&&	continuation
+) const
+{
+	BAssert( IsValid(), U"Cannot add continuation to task future, future does not refer to a task" );
+
+	auto dependencies = List<TaskIdentifier> {};
+	dependencies.PushBack( task_id );
+	return thread_pool->ScheduleLambdaTaskWithFuture( priority, dependencies,
+		[ parent = *this, continuation = std::forward<LambdaType>( continuation ) ]() mutable -> decltype( auto )
+		{
+			// Parent has completed by now, no value means it failed. Rethrowing fails this future with the same exception.
+			if( !parent.state->IsReady() ) std::rethrow_exception( parent.state->GetFailure() );
+			if constexpr( std::is_void_v<ValueType> )	return continuation();
+			else										return continuation( parent.state->GetValue() );
+		}
+	);
+}
+
+
+
 } // thread
 } // bc
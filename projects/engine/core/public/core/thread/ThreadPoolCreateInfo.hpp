@@ -3,6 +3,7 @@
 #include <build_configuration/BuildConfigurationComponent.hpp>
 #include <core/containers/simple/SimpleList.hpp>
 #include <core/thread/Thread.hpp>
+#include <core/thread/ThreadCreateInfo.hpp>
 
 #include <memory>
 
@@ -16,6 +17,22 @@ namespace thread {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 struct ThreadPoolCreateInfo
 {
+	/// Used for threads added with ThreadPool::AddThread(). Threads added with ThreadPool::AddThreadWithCreateInfo() use
+	/// their own create info instead.
+	ThreadCreateInfo								default_thread_create_info;
+
+	/// If true, the thread pool creates its own worker threads when it is constructed. Workers created this way are named
+	/// "Worker N" and use default_thread_create_info priority.
+	bool											create_worker_threads			= false;
+
+	/// Number of worker threads created when create_worker_threads is true. 0 creates one worker per physical processor
+	/// core, leaving one core for the main thread.
+	u32												worker_thread_count				= 0;
+
+	/// If true, automatically created worker threads are each pinned to their own physical processor core. Cores are handed
+	/// out in order, skipping the first core which is left for the main thread. Workers wrap around if there are more workers
+	/// than cores.
+	bool											pin_worker_threads				= false;
 };
 
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/containers/List.hpp>
+#include <core/thread/ThreadDescription.hpp>
+
+#include <chrono>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Counters of a single worker thread, or of all worker threads combined, at the time the snapshot was taken.
+///
+/// Counters accumulate from when the worker thread was added or ThreadPool::ResetStatistics() was last called. Time not covered by
+/// busy or idle time was spent looking for work without finding any.
+struct WorkerThreadStatistics
+{
+	/// Identifier of the worker thread, 0 for the combined statistics of all worker threads.
+	ThreadIdentifier								thread_id						= 0;
+
+	/// Time spent running tasks, including finding them.
+	std::chrono::nanoseconds						busy_time						= {};
+
+	/// Time spent parked waiting for work.
+	std::chrono::nanoseconds						idle_time						= {};
+
+	/// Time spent blocked on thread pool internal locks that were held by another thread.
+	std::chrono::nanoseconds						lock_wait_time					= {};
+
+	/// Number of task runs, a task that pauses and resumes counts once per run.
+	u64												executed_task_count				= 0;
+
+	/// Number of times the worker thread looked for work and found none.
+	u64												failed_lookup_count				= 0;
+
+	/// Number of tasks taken from other worker threads' queues.
+	u64												steal_count						= 0;
+
+	/// Average time from a task being queued to it starting to run.
+	std::chrono::nanoseconds						average_queue_latency			= {};
+
+	/// 99th percentile of the time from a task being queued to it starting to run. Latencies are kept in a histogram, this is
+	/// the upper edge of the bucket the percentile falls in and is at most 12.5% above the exact value.
+	std::chrono::nanoseconds						p99_queue_latency				= {};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Snapshot of thread pool telemetry returned by ThreadPool::GetStatistics().
+struct ThreadPoolStatistics
+{
+	/// One entry per worker thread, in the order the worker threads were added.
+	List<WorkerThreadStatistics>					worker_threads;
+
+	/// Combined counters of all worker threads, latencies are computed over every task of every worker thread.
+	WorkerThreadStatistics							total;
+};
+
+
+
+} // thread
+} // bc
@@ -7,11 +7,20 @@
 
 #include <core/thread/ThreadDescription.hpp>
 #include <core/thread/Task.hpp>
+#include <core/thread/TaskRegistry.hpp>
+#include <core/thread/TaskInjectionQueue.hpp>
+#include <core/thread/TaskMailbox.hpp>
+#include <core/thread/TaskPool.hpp>
+#include <core/thread/TaskTimerWheel.hpp>
+#include <core/thread/ThreadPoolStatistics.hpp>
+#include <core/thread/WorkerCounters.hpp>
+#include <core/thread/WorkStealingDeque.hpp>
 
 #include <atomic>
 #include <mutex>
 #include <memory>
 #include <condition_variable>
+#include <limits>
 
 
 
@@ -31,23 +40,66 @@ class BITCRAFTE_ENGINE_API ThreadSharedData
 {
 public:
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Maximum number of worker threads that can exist in a single thread pool at the same time.
+	static constexpr u64				MAX_WORKER_THREAD_COUNT				= 256;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	ThreadSharedData() = default;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	~ThreadSharedData();
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
 	/// Finds more work in work queue that hasn't started processing yet.
 	///
+	/// Priority levels are searched from highest to lowest. Within a level work is looked for in the following order: the calling
+	/// thread's own deque, tasks injected from outside the worker threads and finally tasks stolen from other worker threads.
+	/// Tasks delivered to the calling thread's mailbox are checked before any of these.
+	///
+	/// To prevent starvation a lower priority level that has not been served for longer than its aging threshold is served first,
+	/// this guarantees every level keeps making progress however much higher priority work there is.
+	///
 	/// @param thread_description
 	/// Pointer to thread description, which contains details about an individual thread, a pointer to thread instance itself, its
 	/// index and potentially other information that is not directly stored in Thread class.
 	///
+	/// @param timestamp
+	/// Current steady clock time in nanoseconds, taken by the caller so that it can be reused for worker thread telemetry.
+	///
 	/// @return
 	/// Task that needs to be run by worker thread.
 	Task 							*	FindWork(
-		ThreadDescription			&	thread_description
+		ThreadDescription			&	thread_description,
+		i64								timestamp
 	);
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes the next task from the main thread mailbox.
+	///
+	/// @warning
+	/// Must only be called from the main thread.
+	///
+	/// @return
+	/// Task locked to the main thread that needs to be run, nullptr if there are none.
+	Task 							*	FindMainThreadWork();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if there are tasks in the main thread mailbox.
+	///
+	/// @return
+	/// True if there are tasks waiting to be run on the main thread.
+	bool								HasMainThreadWork() const;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// @brief
 	/// Signals the task completion.
+	///
+	/// Tasks depending on the completed task are queued if this was their last unfinished dependency. Task is destroyed.
 	/// 
 	/// @param task
 	///	Pointer to task that was completed.
@@ -56,11 +108,207 @@ public:
 	);
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	bool								IsTaskListEmpty();
+	/// @brief
+	/// Wakes up a parked worker thread if there are any.
+	void								NotifyWork();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Wakes up to a number of parked worker threads.
+	///
+	/// @param worker_count
+	/// Maximum number of worker threads to wake up, Eg. the number of tasks that were queued.
+	void								NotifyWorkers(
+		u64								worker_count
+	);
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Wakes up every parked worker thread.
+	///
+	/// Used when worker threads need to check their exit flags or when work is queued that only specific worker threads can run.
+	void								NotifyAllWorkers();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Announces that the calling worker thread is about to park.
+	///
+	/// Worker thread must look for work once more after calling this and then call either Park() or CancelPark(). Any work
+	/// queued after this call wakes the worker thread up from Park(), so work can never be missed between the last check and
+	/// parking.
+	///
+	/// @return
+	/// Park epoch that must be passed to Park().
+	u64									PrepareToPark();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Cancels parking after PrepareToPark() when the worker thread found work after all.
+	void								CancelPark();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Parks the calling worker thread until more work is queued or NotifyAllWorkers() is called.
+	///
+	/// Parked worker threads do not wake up periodically. One of them wakes up when the earliest timer added with AddTimer()
+	/// expires, the rest wait until they are notified.
+	///
+	/// @param prepared_park_epoch
+	/// Value returned by PrepareToPark().
+	void								Park(
+		u64								prepared_park_epoch
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if any task is ready to run but has not been started yet.
+	///
+	/// @return
+	/// True if there are queued tasks at any priority level.
+	bool								HasQueuedWork() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Blocks the calling thread until every listed task has completed.
+	///
+	/// Waiting thread is woken up exactly when one of the tasks it waits for completes. Tasks that have already completed, or
+	/// never existed, are not waited for. Returns early if a worker thread raised an exception.
+	///
+	/// @param task_ids
+	/// Pointer to the first task identifier.
+	///
+	/// @param task_id_count
+	/// Number of task identifiers.
+	///
+	/// @param wake_for_main_thread_work
+	/// If true, also returns early when tasks are delivered to the main thread mailbox so that the main thread can run them.
+	void								WaitForTasks(
+		const TaskIdentifier		*	task_ids,
+		u64								task_id_count,
+		bool							wake_for_main_thread_work			= false
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Blocks the calling thread until every scheduled task has completed.
+	///
+	/// Waiting thread is woken up when the last task completes. Returns early if a worker thread raised an exception.
+	///
+	/// @param wake_for_main_thread_work
+	/// If true, also returns early when tasks are delivered to the main thread mailbox so that the main thread can run them.
+	void								WaitIdle(
+		bool							wake_for_main_thread_work			= false
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Wakes up every thread blocked in WaitForTasks() or WaitIdle() so they can check for exceptions.
+	void								NotifyTaskWaiters();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Records an exception raised by a task or a thread, the first one raised is kept.
+	///
+	/// Worker threads are signaled to exit and every waiting thread is woken up, the main thread handles the exception.
+	///
+	/// @param exception
+	/// Exception that was raised.
+	///
+	/// @param thread_id
+	/// Identifier of the thread the exception was raised on.
+	void								ReportException(
+		const diagnostic::Exception	&	exception,
+		ThreadIdentifier				thread_id
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Checks if there are any scheduled tasks that have not completed yet.
+	///
+	/// @return
+	/// True if all scheduled tasks have completed.
+	bool								IsTaskListEmpty() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of tasks that have been scheduled but have not completed yet.
+	///
+	/// @return
+	/// Number of tasks, running tasks are included.
+	u64									GetTaskCount() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of tasks that are currently being run by worker threads.
+	///
+	/// @return
+	/// Number of running tasks.
+	u64									GetRunningTaskCount() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the number of tasks of a priority level that are ready to run but have not been started yet.
+	///
+	/// @param priority
+	/// Priority level to query.
+	///
+	/// @return
+	/// Number of ready tasks.
+	u64									GetQueuedTaskCount(
+		TaskPriority					priority
+	) const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the telemetry counters of a worker thread.
+	///
+	/// @param worker_index
+	/// Worker queue index of the worker thread, see ThreadDescription::worker_index.
+	WorkerCounters					&	GetWorkerCounters(
+		u64								worker_index
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes a snapshot of the telemetry counters of every worker thread.
+	///
+	/// @return
+	/// Statistics of each registered worker thread and their combined totals.
+	ThreadPoolStatistics				GetStatistics() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Sets the telemetry counters of every worker thread back to zero.
+	void								ResetStatistics();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds a new task to be run by the worker threads.
+	///
+	/// If called from a worker thread the task is pushed to the worker thread's own deque, otherwise it is pushed to the
+	/// injection queue.
+	///
+	/// @param new_task
+	/// Task to add, thread shared data takes ownership of the task. Task must have been created with ThreadPool::CreateTask().
 	void								AddTask(
-		UniquePtr<Task>				&&	new_task
+		Task						*	new_task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Adds several new tasks to be run by the worker threads at once.
+	///
+	/// Tasks that are ready to run are pushed to the queues of their priority level in one operation per level and just enough
+	/// parked worker threads are woken up to run them.
+	///
+	/// @param new_tasks
+	/// Tasks to add, thread shared data takes ownership of the tasks. Tasks must have consecutive task identifiers.
+	///
+	/// @param new_task_count
+	/// Number of tasks in the array.
+	void								AddTaskBatch(
+		Task				*	const	*	new_tasks,
+		u64								new_task_count
 	);
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,10 +324,127 @@ public:
 	);
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	std::mutex							thread_wakeup_mutex;
-	std::condition_variable				thread_wakeup;
+	/// @brief
+	/// Signals that a resume condition of a paused task has been met.
+	///
+	/// Called by TaskResumeCondition implementations, may be called from any thread. Task is queued once this was the last
+	/// thing it was waiting for.
+	///
+	/// @param task
+	/// Paused task whose resume condition was met.
+	void								ResumeTask(
+		Task						*	task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Resumes a paused task once its resume deadline has been reached.
+	///
+	/// Timers are kept in a timer wheel and fired by the worker threads when they look for work, parked worker threads wake up
+	/// for the earliest timer.
+	///
+	/// @param task
+	/// Paused task to resume, Task::resume_deadline tells when. ResumeTask() is called for it when the timer fires.
+	///
+	/// @return
+	/// True if the timer was added, false if the deadline has already passed, in which case ResumeTask() is not called.
+	bool								AddTimer(
+		Task						*	task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Fires the timers of tasks which stop once the thread pool starts shutting down.
+	///
+	/// Such tasks are resumed right away instead of at their deadline, timers they add after this fire right away as well.
+	/// Called once when the thread pool starts shutting down.
+	void								FireShutdownTimers();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Reserves a work stealing deque for a new worker thread.
+	///
+	/// @note
+	/// Must be called before the worker thread is started.
+	///
+	/// @return
+	/// Index of the worker deques, stored in ThreadDescription::worker_index.
+	u64									AcquireWorkerQueue();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Releases a work stealing deque of a worker thread so that it can be reused by a new worker thread.
+	///
+	/// Tasks left in the deques are handed over to other worker threads. Tasks locked to the thread are delivered to other
+	/// threads they are locked to, or failed if there are none.
+	///
+	/// @note
+	/// Must be called after the worker thread has been joined.
+	///
+	/// @param worker_index
+	/// Index of the worker deque returned by AcquireWorkerQueue().
+	void								ReleaseWorkerQueue(
+		u64								worker_index
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Marks the calling thread as a worker thread of this thread pool.
+	///
+	/// Tasks scheduled from a worker thread are pushed to the worker thread's own deque. Tasks locked to the worker thread are
+	/// delivered to its mailbox from now on.
+	///
+	/// @param thread_description
+	/// Description of the calling worker thread.
+	void								RegisterWorkerThread(
+		ThreadDescription			&	thread_description
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Clears the worker thread mark from the calling thread.
+	void								UnregisterWorkerThread();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Destroys every task that has not yet completed.
+	///
+	/// @warning
+	/// All worker threads must have been joined before calling this.
+	void								EvacuateTasks();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Takes a task pool slot for a new task.
+	///
+	/// @return
+	/// Uninitialized memory of TaskPool::SLOT_SIZE bytes.
+	void							*	AllocateTaskSlot();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Returns a task pool slot that was not used for a task after all.
+	///
+	/// @param slot
+	/// Slot returned by AllocateTaskSlot().
+	void								FreeTaskSlot(
+		void						*	slot
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Destroys a task created with ThreadPool::CreateTask().
+	///
+	/// Tasks living in a task pool slot return the slot to the pool.
+	///
+	/// @param task
+	/// Task to destroy.
+	void								DestroyTask(
+		Task						*	task
+	);
 
-	std::atomic_bool					threads_should_exit;
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	std::atomic_bool					threads_should_exit					= false;
 
 	std::mutex							thread_exception_mutex;
 	std::atomic_bool					thread_exception_raised				= false;
@@ -87,8 +452,157 @@ public:
 	std::atomic<ThreadIdentifier>		thread_exception_id					= 0;
 	diagnostic::Exception				thread_exception;
 
-	mutable std::mutex					task_list_mutex;
-	List<UniquePtr<Task>>				task_list;
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Links the task to the successor lists of its dependencies that have not been linked yet and arms its resume condition.
+	///
+	/// @return
+	/// True if every dependency has already completed and the resume condition, if any, was already met so the task can be
+	/// queued. False if the last dependency to complete, or the resume condition, will queue the task.
+	bool								LinkDependencies(
+		Task						*	task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Queues of a single worker thread, work stealing deques, one per priority level, and a mailbox for tasks locked to it.
+	struct WorkerQueues
+	{
+		WorkStealingDeque<Task*>		priority_queues[ TASK_PRIORITY_COUNT ];
+		TaskMailbox						mailbox;
+		WorkerCounters					counters;
+
+		/// Identifier of the worker thread using these queues, 0 while unused.
+		std::atomic<ThreadIdentifier>	thread_id							= 0;
+
+		/// Number of threads delivering a task to the mailbox right now, the mailbox is only emptied once no deliveries are left.
+		std::atomic<u64>				mailbox_delivery_count				= 0;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Bookkeeping of a single priority level, kept on separate cache lines as every worker thread updates them.
+	struct alignas( 64 ) PriorityLevel
+	{
+		/// Number of tasks that are ready to run at this priority level.
+		std::atomic<u64>				queued_task_count					= 0;
+
+		/// Time when a task of this priority level was last started, or when the level became non-empty. Used for aging.
+		std::atomic<i64>				last_served_time					= 0;
+	};
+
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool								FindWorkAtPriority(
+		WorkerQueues				&	own_queues,
+		u64								own_worker_index,
+		u64								priority_index,
+		Task						*&	out_task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool								TakeInjectedWork(
+		WorkStealingDeque<Task*>	&	own_queue,
+		TaskInjectionQueue			&	injection_queue,
+		Task						*&	out_task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool								StealWork(
+		u64								own_worker_index,
+		u64								priority_index,
+		Task						*&	out_task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void								StartTask(
+		Task						*	task,
+		ThreadDescription			&	thread_description,
+		i64								timestamp
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	void								MarkTaskRunning(
+		Task						*	task,
+		ThreadIdentifier				thread_id
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Delivers a thread locked task to the mailbox of a thread it is locked to.
+	///
+	/// If the task is locked to several worker threads, the one with the fewest tasks in its mailbox gets it. If none of the
+	/// threads exist anymore the task is completed without running, the same way as a task returning TaskExecutionResult::ERROR.
+	void								QueueThreadLockedTask(
+		Task						*	task
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Queues a task that is ready to run.
+	///
+	/// @param task
+	/// Task to queue.
+	///
+	/// @param allow_own_queue
+	/// If true and called from a worker thread, the task is pushed to the worker thread's own deque. If false the task is always
+	/// pushed to the injection queue.
+	void								QueueTask(
+		Task						*	task,
+		bool							allow_own_queue						= true
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Resumes tasks of every timer whose deadline has passed and moves the timer wheel forward.
+	void								FireExpiredTimers(
+		i64								timestamp
+	);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the task pool cache of the calling thread.
+	u64									GetTaskPoolCacheIndex() const;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	TaskPool							task_pool							= TaskPool( MAX_WORKER_THREAD_COUNT );
+	TaskRegistry						task_registry;
+	TaskInjectionQueue					injection_queues[ TASK_PRIORITY_COUNT ];
+	PriorityLevel						priority_levels[ TASK_PRIORITY_COUNT ];
+
+	std::atomic<WorkerQueues*>			worker_queues[ MAX_WORKER_THREAD_COUNT ]	= {};
+	std::atomic<u64>					worker_queue_count					= 0;
+	List<u64>							free_worker_queue_indices;
+
+	TaskMailbox							main_thread_mailbox;
+
+	alignas( 64 ) std::atomic<u64>		task_count							= 0;
+	alignas( 64 ) std::atomic<u64>		running_task_count					= 0;
+
+	// Worker thread parking, park epoch is advanced every time parked worker threads are notified.
+	alignas( 64 ) std::atomic<u64>		park_epoch							= 0;
+	std::atomic<u64>					parked_thread_count					= 0;
+	std::mutex							park_mutex;
+	std::condition_variable				park_condition;
+
+	// Deadline the parked worker thread watching the timers wakes up at, only one parked worker thread waits for the timers at a
+	// time so that a deadline does not wake all of them. Maximum i64 value if no worker thread is watching. Guarded by
+	// park_mutex.
+	i64									watched_timer_deadline				= std::numeric_limits<i64>::max();
+
+	// Timers of paused tasks. Next timer deadline is when the timer wheel next needs to be advanced, read without the lock when
+	// looking for work.
+	alignas( 64 ) std::atomic<i64>		next_timer_deadline					= std::numeric_limits<i64>::max();
+	std::mutex							timer_mutex;
+	TaskTimerWheel						timer_wheel;
+	bool								are_shutdown_timers_fired			= false;	// Guarded by timer_mutex.
+
+	// Threads waiting for tasks to complete.
+	alignas( 64 ) std::atomic<u64>		idle_waiter_count					= 0;
+	std::mutex							task_waiter_mutex;
+	std::condition_variable				task_waiter_condition;
 };
 
 
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/memory/raw/RawMemory.hpp>
+#include <core/containers/List.hpp>
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Chase-Lev work stealing deque.
+///
+/// A single owner thread may push and pop values at the bottom of the deque, any number of other threads may steal values from
+/// the top of the deque. Owner operations are wait-free except when the deque grows, steal is lock-free.
+///
+/// Buffers that are replaced when the deque grows are not freed immediately as a thief may still be reading from them, they are
+/// retired and freed when the deque is destroyed.
+///
+/// @warning
+/// Push() and Pop() must only be called by the owner thread.
+///
+/// @tparam ValueType
+/// Type of the stored values, must be trivially copyable, typically a pointer.
+template<typename ValueType>
+class WorkStealingDeque
+{
+	static_assert( std::is_trivially_copyable_v<ValueType>, "Work stealing deque value type must be trivially copyable" );
+
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Constructs the deque.
+	///
+	/// @param initial_capacity
+	/// Number of values the deque can hold before it needs to grow. Must be a power of 2.
+	inline WorkStealingDeque(
+		u64											initial_capacity				= 256
+	)
+	{
+		BHardAssert( initial_capacity > 0 && ( initial_capacity & ( initial_capacity - 1 ) ) == 0, U"Work stealing deque capacity must be power of 2" );
+		buffer.store( CreateRingBuffer( initial_capacity ), std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	WorkStealingDeque(
+		const WorkStealingDeque					&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	WorkStealingDeque(
+		WorkStealingDeque						&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~WorkStealingDeque()
+	{
+		DestroyRingBuffer( buffer.load( std::memory_order_relaxed ) );
+		for( auto retired_buffer : retired_buffers )
+		{
+			DestroyRingBuffer( retired_buffer );
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	WorkStealingDeque							&	operator=(
+		const WorkStealingDeque					&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	WorkStealingDeque							&	operator=(
+		WorkStealingDeque						&&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Pushes a value to the bottom of the deque.
+	///
+	/// @warning
+	/// Owner thread only.
+	///
+	/// @param value
+	/// Value to push.
+	inline void										Push(
+		ValueType									value
+	)
+	{
+		auto b				= bottom.load( std::memory_order_relaxed );
+		auto t				= top.load( std::memory_order_acquire );
+		auto ring_buffer	= buffer.load( std::memory_order_relaxed );
+
+		if( b - t > i64( ring_buffer->capacity ) - 1 )
+		{
+			ring_buffer = Grow( ring_buffer, b, t );
+		}
+
+		ring_buffer->Put( b, value );
+		std::atomic_thread_fence( std::memory_order_release );
+		bottom.store( b + 1, std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Pops the most recently pushed value from the bottom of the deque.
+	///
+	/// @warning
+	/// Owner thread only.
+	///
+	/// @param out_value
+	/// Receives the popped value on success.
+	///
+	/// @return
+	/// True if a value was popped, false if the deque was empty or the last value was stolen.
+	inline bool										Pop(
+		ValueType								&	out_value
+	)
+	{
+		auto b				= bottom.load( std::memory_order_relaxed ) - 1;
+		auto ring_buffer	= buffer.load( std::memory_order_relaxed );
+		bottom.store( b, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		auto t				= top.load( std::memory_order_relaxed );
+
+		if( t > b )
+		{
+			// Deque was empty.
+			bottom.store( b + 1, std::memory_order_relaxed );
+			return false;
+		}
+
+		out_value = ring_buffer->Get( b );
+		if( t != b ) return true;
+
+		// Last value, race against thieves.
+		auto won = top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+		bottom.store( b + 1, std::memory_order_relaxed );
+		return won;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Steals the oldest value from the top of the deque.
+	///
+	/// Can be called from any thread.
+	///
+	/// @param out_value
+	/// Receives the stolen value on success.
+	///
+	/// @return
+	/// True if a value was stolen, false if the deque was empty or another thread won the race for the value.
+	inline bool										Steal(
+		ValueType								&	out_value
+	)
+	{
+		auto t = top.load( std::memory_order_acquire );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		auto b = bottom.load( std::memory_order_acquire );
+
+		if( t >= b ) return false;
+
+		auto ring_buffer	= buffer.load( std::memory_order_acquire );
+		auto value			= ring_buffer->Get( t );
+		if( !top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+		{
+			return false;
+		}
+
+		out_value = value;
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the approximate number of values in the deque.
+	///
+	/// @return
+	/// Number of values, may be out of date by the time it is returned if other threads are using the deque.
+	inline u64										ApproximateSize() const
+	{
+		auto b = bottom.load( std::memory_order_relaxed );
+		auto t = top.load( std::memory_order_relaxed );
+		return b > t ? u64( b - t ) : 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Drops every value in the deque.
+	///
+	/// @warning
+	/// Must not be called while any other thread is using the deque.
+	inline void										Clear()
+	{
+		top.store( 0, std::memory_order_relaxed );
+		bottom.store( 0, std::memory_order_relaxed );
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct RingBuffer
+	{
+		u64											capacity;
+		u64											mask;
+		std::atomic<ValueType>					*	values;
+
+		inline void									Put(
+			i64										index,
+			ValueType								value
+		)
+		{
+			values[ u64( index ) & mask ].store( value, std::memory_order_relaxed );
+		}
+
+		inline ValueType							Get(
+			i64										index
+		) const
+		{
+			return values[ u64( index ) & mask ].load( std::memory_order_relaxed );
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline RingBuffer							*	CreateRingBuffer(
+		u64											capacity
+	)
+	{
+		auto ring_buffer		= memory::AllocateMemory<RingBuffer>( 1, alignof( RingBuffer ) );
+		auto values				= memory::AllocateMemory<std::atomic<ValueType>>( capacity, alignof( std::atomic<ValueType> ) );
+		for( u64 i = 0; i < capacity; ++i )
+		{
+			std::construct_at( values + i );
+		}
+		return std::construct_at( ring_buffer, RingBuffer { capacity, capacity - 1, values } );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void										DestroyRingBuffer(
+		RingBuffer								*	ring_buffer
+	)
+	{
+		memory::FreeMemory( ring_buffer->values, ring_buffer->capacity );
+		memory::FreeMemory( ring_buffer, 1 );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline RingBuffer							*	Grow(
+		RingBuffer								*	old_ring_buffer,
+		i64											b,
+		i64											t
+	)
+	{
+		auto new_ring_buffer = CreateRingBuffer( old_ring_buffer->capacity * 2 );
+		for( auto i = t; i < b; ++i )
+		{
+			new_ring_buffer->Put( i, old_ring_buffer->Get( i ) );
+		}
+		retired_buffers.PushBack( old_ring_buffer );
+		buffer.store( new_ring_buffer, std::memory_order_release );
+		return new_ring_buffer;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	alignas( 64 ) std::atomic<i64>					top								= 0;
+	alignas( 64 ) std::atomic<i64>					bottom							= 0;
+	alignas( 64 ) std::atomic<RingBuffer*>			buffer							= nullptr;
+
+	List<RingBuffer*>								retired_buffers;
+};
+
+
+
+} // thread
+} // bc
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <core/thread/ThreadPoolStatistics.hpp>
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <algorithm>
+
+
+
+namespace bc {
+namespace thread {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Plain copy of the counters of one or more worker threads, used to build ThreadPoolStatistics.
+struct WorkerCounterValues
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Latencies are kept in a log-linear histogram, every power of two is split into 8 buckets. Latencies above 2^40
+	/// nanoseconds, about 18 minutes, land in the last bucket.
+	static constexpr u64							LATENCY_SUB_BUCKET_BITS			= 3;
+	static constexpr u64							LATENCY_SUB_BUCKET_COUNT		= u64( 1 ) << LATENCY_SUB_BUCKET_BITS;
+	static constexpr u64							LATENCY_MAX_BIT					= 40;
+	static constexpr u64							LATENCY_BUCKET_COUNT			= ( LATENCY_MAX_BIT - LATENCY_SUB_BUCKET_BITS + 1 ) * LATENCY_SUB_BUCKET_COUNT;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the histogram bucket of a latency.
+	static constexpr u64							GetLatencyBucket(
+		u64											latency
+	)
+	{
+		if( latency < LATENCY_SUB_BUCKET_COUNT ) return latency;
+
+		auto top_bit = u64( std::bit_width( latency ) ) - 1;
+		if( top_bit >= LATENCY_MAX_BIT ) return LATENCY_BUCKET_COUNT - 1;
+
+		auto sub_bucket = ( latency >> ( top_bit - LATENCY_SUB_BUCKET_BITS ) ) & ( LATENCY_SUB_BUCKET_COUNT - 1 );
+		return ( top_bit - LATENCY_SUB_BUCKET_BITS + 1 ) * LATENCY_SUB_BUCKET_COUNT + sub_bucket;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Gets the largest latency that lands in a histogram bucket.
+	static constexpr u64							GetLatencyBucketUpperEdge(
+		u64											bucket
+	)
+	{
+		if( bucket < LATENCY_SUB_BUCKET_COUNT ) return bucket;
+
+		auto top_bit = bucket / LATENCY_SUB_BUCKET_COUNT + LATENCY_SUB_BUCKET_BITS - 1;
+		auto sub_bucket = bucket % LATENCY_SUB_BUCKET_COUNT;
+		auto shift = top_bit - LATENCY_SUB_BUCKET_BITS;
+		return ( ( LATENCY_SUB_BUCKET_COUNT + sub_bucket + 1 ) << shift ) - 1;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline WorkerCounterValues					&	operator+=(
+		const WorkerCounterValues				&	other
+	)
+	{
+		busy_nanoseconds		+= other.busy_nanoseconds;
+		idle_nanoseconds		+= other.idle_nanoseconds;
+		lock_wait_nanoseconds	+= other.lock_wait_nanoseconds;
+		executed_task_count		+= other.executed_task_count;
+		failed_lookup_count		+= other.failed_lookup_count;
+		steal_count				+= other.steal_count;
+		latency_sum_nanoseconds	+= other.latency_sum_nanoseconds;
+		for( u64 i = 0; i < LATENCY_BUCKET_COUNT; ++i ) latency_histogram[ i ] += other.latency_histogram[ i ];
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Converts the counters to statistics, computing the latency average and percentile.
+	inline WorkerThreadStatistics					ToStatistics(
+		ThreadIdentifier							thread_id
+	) const
+	{
+		auto statistics = WorkerThreadStatistics {};
+		statistics.thread_id				= thread_id;
+		statistics.busy_time				= std::chrono::nanoseconds( busy_nanoseconds );
+		statistics.idle_time				= std::chrono::nanoseconds( idle_nanoseconds );
+		statistics.lock_wait_time			= std::chrono::nanoseconds( lock_wait_nanoseconds );
+		statistics.executed_task_count		= executed_task_count;
+		statistics.failed_lookup_count		= failed_lookup_count;
+		statistics.steal_count				= steal_count;
+
+		u64 latency_count = 0;
+		for( auto count : latency_histogram ) latency_count += count;
+		if( latency_count == 0 ) return statistics;
+
+		statistics.average_queue_latency = std::chrono::nanoseconds( latency_sum_nanoseconds / latency_count );
+
+		// Smallest bucket that has at least 99% of the latencies at or below it.
+		auto p99_rank = latency_count - latency_count / 100;
+		u64 accumulated_count = 0;
+		for( u64 i = 0; i < LATENCY_BUCKET_COUNT; ++i )
+		{
+			accumulated_count += latency_histogram[ i ];
+			if( accumulated_count < p99_rank ) continue;
+
+			statistics.p99_queue_latency = std::chrono::nanoseconds( GetLatencyBucketUpperEdge( i ) );
+			break;
+		}
+		return statistics;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	u64												busy_nanoseconds				= 0;
+	u64												idle_nanoseconds				= 0;
+	u64												lock_wait_nanoseconds			= 0;
+	u64												executed_task_count				= 0;
+	u64												failed_lookup_count				= 0;
+	u64												steal_count						= 0;
+	u64												latency_sum_nanoseconds			= 0;
+	u64												latency_histogram[ LATENCY_BUCKET_COUNT ]	= {};
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Telemetry counters of a single worker thread.
+///
+/// Only the worker thread owning the counters updates them, any thread may read them at any time without locking. Counters are
+/// on their own cache lines so updating them never contends with other worker threads.
+class alignas( 64 ) WorkerCounters
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void										AddBusyTime(
+		i64											nanoseconds
+	)
+	{
+		busy_nanoseconds.fetch_add( u64( std::max<i64>( nanoseconds, 0 ) ), std::memory_order_relaxed );
+		executed_task_count.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void										AddIdleTime(
+		i64											nanoseconds
+	)
+	{
+		idle_nanoseconds.fetch_add( u64( std::max<i64>( nanoseconds, 0 ) ), std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void										AddLockWaitTime(
+		i64											nanoseconds
+	)
+	{
+		lock_wait_nanoseconds.fetch_add( u64( std::max<i64>( nanoseconds, 0 ) ), std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void										AddFailedLookup()
+	{
+		failed_lookup_count.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline void										AddSteal()
+	{
+		steal_count.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Records the time a task spent queued before it started running.
+	inline void										AddQueueLatency(
+		i64											nanoseconds
+	)
+	{
+		auto latency = u64( std::max<i64>( nanoseconds, 0 ) );
+		latency_sum_nanoseconds.fetch_add( latency, std::memory_order_relaxed );
+		latency_histogram[ WorkerCounterValues::GetLatencyBucket( latency ) ].fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Copies the current counter values.
+	///
+	/// Counters are read one by one while the worker thread may be updating them, values of different counters may be off by a
+	/// task from each other.
+	inline WorkerCounterValues						Read() const
+	{
+		auto values = WorkerCounterValues {};
+		values.busy_nanoseconds			= busy_nanoseconds.load( std::memory_order_relaxed );
+		values.idle_nanoseconds			= idle_nanoseconds.load( std::memory_order_relaxed );
+		values.lock_wait_nanoseconds	= lock_wait_nanoseconds.load( std::memory_order_relaxed );
+		values.executed_task_count		= executed_task_count.load( std::memory_order_relaxed );
+		values.failed_lookup_count		= failed_lookup_count.load( std::memory_order_relaxed );
+		values.steal_count				= steal_count.load( std::memory_order_relaxed );
+		values.latency_sum_nanoseconds	= latency_sum_nanoseconds.load( std::memory_order_relaxed );
+		for( u64 i = 0; i < WorkerCounterValues::LATENCY_BUCKET_COUNT; ++i )
+		{
+			values.latency_histogram[ i ] = latency_histogram[ i ].load( std::memory_order_relaxed );
+		}
+		return values;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// @brief
+	/// Sets every counter back to zero, may be called from any thread.
+	inline void										Reset()
+	{
+		busy_nanoseconds.store( 0, std::memory_order_relaxed );
+		idle_nanoseconds.store( 0, std::memory_order_relaxed );
+		lock_wait_nanoseconds.store( 0, std::memory_order_relaxed );
+		executed_task_count.store( 0, std::memory_order_relaxed );
+		failed_lookup_count.store( 0, std::memory_order_relaxed );
+		steal_count.store( 0, std::memory_order_relaxed );
+		latency_sum_nanoseconds.store( 0, std::memory_order_relaxed );
+		for( auto & bucket : latency_histogram ) bucket.store( 0, std::memory_order_relaxed );
+	}
+
+private:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Updated with atomic adds rather than load and store so that Reset() from another thread is never undone.
+	std::atomic<u64>								busy_nanoseconds				= 0;
+	std::atomic<u64>								idle_nanoseconds				= 0;
+	std::atomic<u64>								lock_wait_nanoseconds			= 0;
+	std::atomic<u64>								executed_task_count				= 0;
+	std::atomic<u64>								failed_lookup_count				= 0;
+	std::atomic<u64>								steal_count						= 0;
+	std::atomic<u64>								latency_sum_nanoseconds			= 0;
+	std::atomic<u64>								latency_histogram[ WorkerCounterValues::LATENCY_BUCKET_COUNT ]	= {};
+};
+
+
+
+namespace internal_ {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Sets the counters lock wait time of the calling thread is recorded to.
+///
+/// @param counters
+/// Counters of the calling worker thread, nullptr to stop recording.
+BITCRAFTE_ENGINE_API
+void												SetCurrentWorkerCounters(
+	WorkerCounters								*	counters
+);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Adds lock wait time to the counters of the calling worker thread, does nothing on other threads.
+BITCRAFTE_ENGINE_API
+void												RecordLockWaitTime(
+	i64												nanoseconds
+);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Lock guard that records how long the calling worker thread was blocked on the lock.
+///
+/// Lock is tried first, time is only measured when another thread holds the lock so the uncontended case costs nothing extra.
+template<typename MutexType>
+class MeasuredLockGuard
+{
+public:
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline explicit MeasuredLockGuard(
+		MutexType								&	mutex
+	) :
+		mutex( mutex )
+	{
+		if( mutex.try_lock() ) return;
+
+		auto wait_start = std::chrono::steady_clock::now();
+		mutex.lock();
+		RecordLockWaitTime( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - wait_start ).count() );
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MeasuredLockGuard(
+		const MeasuredLockGuard					&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	MeasuredLockGuard							&	operator=(
+		const MeasuredLockGuard					&	other
+	) = delete;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	inline ~MeasuredLockGuard()
+	{
+		mutex.unlock();
+	}
+
+private:
+	MutexType									&	mutex;
+};
+
+} // internal_
+
+
+
+} // thread
+} // bc
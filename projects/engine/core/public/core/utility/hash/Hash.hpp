@@ -0,0 +1,183 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+#include <core/data_types/FundamentalTypes.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+
+
+namespace bc {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Mixes the bits of a 64 bit value so that every input bit affects every output bit.
+///
+/// Hash tables use both the lowest and the highest bits of a hash, plain integer values need to be mixed before they can be
+/// used as a hash.
+///
+/// @param value
+/// Value to mix.
+///
+/// @return
+/// Mixed value.
+constexpr u64											MixHash(
+	u64													value
+) noexcept
+{
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ULL;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBULL;
+	value ^= value >> 31;
+	return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Combines two hashes into one.
+///
+/// Order matters, combining a with b results in a different hash than combining b with a.
+///
+/// @param seed
+/// Hash calculated so far.
+///
+/// @param value
+/// Hash of the next value.
+///
+/// @return
+/// Combined hash.
+constexpr u64											HashCombine(
+	u64													seed,
+	u64													value
+) noexcept
+{
+	return MixHash( seed ^ ( value + 0x9E3779B97F4A7C15ULL + ( seed << 6 ) + ( seed >> 2 ) ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Calculates a hash from a range of characters.
+///
+/// Each character is hashed as a whole value, text with the same characters results in the same hash regardless of the
+/// container it is stored in.
+///
+/// @tparam CharacterType
+/// Type of the characters, eg. char or char32_t.
+///
+/// @param data
+/// Pointer to the first character.
+///
+/// @param size
+/// Number of characters.
+///
+/// @return
+/// Hash of the characters.
+template<typename CharacterType>
+constexpr u64											HashCharacters(
+	const CharacterType								*	data,
+	u64													size
+) noexcept
+{
+	u64 hash = 0xCBF29CE484222325ULL;
+	for( u64 i = 0; i < size; ++i )
+	{
+		hash ^= u64( data[ i ] );
+		hash *= 0x100000001B3ULL;
+	}
+	return MixHash( hash ^ size );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Customisation point for hashing values, used by hashed containers such as HashMap.
+///
+/// Fundamental values, enums and pointers are hashed out of the box, other types opt in by specializing this struct with a
+/// call operator which returns a u64 hash. Values which compare equal must result in the same hash. The hash should have
+/// well mixed bits, use MixHash and HashCombine to build it from the hashes of the members.
+///
+/// Usage example:
+/// @code
+/// template<>
+/// struct bc::Hash<MyType>
+/// {
+/// 	constexpr bc::u64 operator()( const MyType & value ) const noexcept
+/// 	{
+/// 		return bc::HashCombine( bc::Hash<int> {}( value.a ), bc::Hash<int> {}( value.b ) );
+/// 	}
+/// };
+///
+/// auto hash = bc::Hash<MyType> {}( my_value );
+/// @endcode
+///
+/// @tparam Type
+/// Type to hash.
+template<typename Type>
+struct Hash;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Type> requires( std::is_integral_v<Type> || std::is_enum_v<Type> )
+struct Hash<Type>
+{
+	constexpr u64										operator()(
+		Type											value
+	) const noexcept
+	{
+		return MixHash( static_cast<u64>( value ) );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Floating point values are hashed by their bit pattern, positive and negative zero result in the same hash.
+template<typename Type> requires( std::is_floating_point_v<Type> && ( sizeof( Type ) == 4 || sizeof( Type ) == 8 ) )
+struct Hash<Type>
+{
+	constexpr u64										operator()(
+		Type											value
+	) const noexcept
+	{
+		if( value == Type {} ) return MixHash( 0 );
+		using BitsType = std::conditional_t<sizeof( Type ) == 4, u32, u64>;
+		return MixHash( std::bit_cast<BitsType>( value ) );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Pointers are hashed by their address, pointed to value is not used.
+template<typename Type>
+struct Hash<Type*>
+{
+	u64													operator()(
+		const Type									*	value
+	) const noexcept
+	{
+		return MixHash( static_cast<u64>( reinterpret_cast<uintptr_t>( value ) ) );
+	}
+};
+
+#if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+namespace tests {
+enum class HashTestEnum : u32 { A, B };
+static_assert( Hash<u32> {}( 5 ) == Hash<u32> {}( 5 ) );
+static_assert( Hash<u32> {}( 5 ) != Hash<u32> {}( 6 ) );
+static_assert( Hash<const i64> {}( -1 ) == Hash<i64> {}( -1 ) );
+static_assert( Hash<HashTestEnum> {}( HashTestEnum::A ) != Hash<HashTestEnum> {}( HashTestEnum::B ) );
+static_assert( Hash<f32> {}( 0.0f ) == Hash<f32> {}( -0.0f ) );
+static_assert( Hash<f64> {}( 1.0 ) != Hash<f64> {}( 2.0 ) );
+static_assert( HashCharacters( "abc", 3 ) == HashCharacters( U"abc", 3 ) );
+static_assert( HashCharacters( "abc", 3 ) != HashCharacters( "abd", 3 ) );
+static_assert( HashCombine( 1, 2 ) != HashCombine( 2, 1 ) );
+} // tests
+#endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+
+
+
+} // bc
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <build_configuration/BuildConfigurationComponent.hpp>
+
+#include <type_traits>
+
+
+
+namespace bc {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Test if a type can be moved to another memory location with a plain memory copy.
+///
+/// Relocating a value means move constructing it to a new location and destructing the old one. For trivially relocatable
+/// types the same result is achieved by copying the bytes and forgetting the old location, without calling the move constructor
+/// or the destructor. Containers use this to grow, insert and erase with memcpy and memmove.
+///
+/// Trivially copyable types are always trivially relocatable, other types opt in by specializing this struct. A type may opt in
+/// only if it has no pointers into itself and nothing outside of it points to it, eg. owning pointers or containers that store
+/// their data on the heap.
+///
+/// Usage example:
+/// @code
+/// template<>
+/// struct bc::IsTriviallyRelocatable<MyType> : std::true_type {};
+///
+/// constexpr bool is_relocatable = bc::IsTriviallyRelocatable<MyType>::value;
+/// @endcode
+///
+/// @tparam Type
+/// Type to check.
+template<typename Type>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<Type>> {};
+
+template<typename Type>
+struct IsTriviallyRelocatable<const Type> : IsTriviallyRelocatable<Type> {};
+
+#if BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+namespace tests {
+struct IsTriviallyRelocatableTestNonTrivial { IsTriviallyRelocatableTestNonTrivial( IsTriviallyRelocatableTestNonTrivial && ) {} };
+static_assert( IsTriviallyRelocatable<int>::value == true );
+static_assert( IsTriviallyRelocatable<const float*>::value == true );
+static_assert( IsTriviallyRelocatable<IsTriviallyRelocatableTestNonTrivial>::value == false );
+static_assert( IsTriviallyRelocatable<const IsTriviallyRelocatableTestNonTrivial>::value == false );
+} // tests
+#endif // BITCRAFTE_ENGINE_DEVELOPMENT_BUILD
+
+
+
+} // bc
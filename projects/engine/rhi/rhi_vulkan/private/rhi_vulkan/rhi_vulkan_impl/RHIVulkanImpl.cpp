@@ -20,7 +20,7 @@ void* VKAPI_PTR VulkanMemoryAllocationFunction(
 	VkSystemAllocationScope						allocationScope
 )
 {
-	return bc::memory::internal_::AllocateRawMemory_Runtime( size, alignment );
+	return bc::memory::internal_::AllocateRawMemory_Runtime( size, alignment, bc::memory::MemoryTag::RHI );
 }
 
 void* VKAPI_PTR VulkanMemoryReallocationFunction(
@@ -0,0 +1,388 @@
+
+#include <gtest/gtest.h>
+
+#include <core/containers/FlatMap.hpp>
+#include <core/containers/List.hpp>
+#include <core/containers/Map.hpp>
+#include <core/memory/allocator/LinearArena.hpp>
+
+#include <map>
+#include <random>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, BasicInit )
+{
+	using A = bc::FlatMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+	{
+		A a;
+		EXPECT_EQ( a.Size(), 0 );
+
+		A b {};
+		EXPECT_EQ( b.Size(), 0 );
+
+		A c = {};
+		EXPECT_EQ( c.Size(), 0 );
+
+		EXPECT_TRUE( a.IsEmpty() );
+		EXPECT_TRUE( b.IsEmpty() );
+		EXPECT_TRUE( c.IsEmpty() );
+	}
+	{
+		A a { P( 2, 10 ), P( 1, 5 ) };
+		EXPECT_EQ( a.Size(), 2 );
+		EXPECT_FALSE( a.IsEmpty() );
+		EXPECT_EQ( ( a.begin() + 0 )->first, 1 );
+		EXPECT_EQ( ( a.begin() + 1 )->first, 2 );
+
+		A b = { P( 1, 5 ), P( 1, 10 ) };
+		EXPECT_EQ( b.Size(), 1 );
+		EXPECT_EQ( b[ 1 ], 10 );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, InsertEmplaceValue )
+{
+	using A = bc::FlatMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	A a;
+
+	// Regular insert.
+	{
+		auto insert_value = P( 5, 5 );
+		auto it = a.Insert( insert_value );
+		EXPECT_EQ( it->first, 5 );
+		EXPECT_EQ( a[ 5 ], 5 );
+		EXPECT_EQ( a.Size(), 1 );
+	}
+	// Inserted value to same key, does not increase size but updates value.
+	{
+		auto insert_value = P( 5, 10 );
+		a.Insert( insert_value );
+		EXPECT_EQ( a[ 5 ], 10 );
+		EXPECT_EQ( a.Size(), 1 );
+	}
+	// Insert in front, middle and back.
+	{
+		a.Insert( P( 1, 1 ) );
+		a.Emplace( 3, 3 );
+		a.Emplace( 9, 9 );
+		auto it = a.Emplace( 7, 7 );
+		EXPECT_EQ( it->second, 7 );
+		EXPECT_EQ( it.GetIndex(), 3 );
+		EXPECT_EQ( a.Size(), 5 );
+
+		uint32_t expected_keys[] = { 1, 3, 5, 7, 9 };
+		for( size_t i = 0; i < 5; ++i ) {
+			EXPECT_EQ( ( a.begin() + i )->first, expected_keys[ i ] );
+		}
+	}
+	// Index operator creates missing elements in order.
+	{
+		a[ 4 ] = 44;
+		EXPECT_EQ( a.Size(), 6 );
+		EXPECT_EQ( ( a.begin() + 2 )->first, 4 );
+		EXPECT_EQ( ( a.begin() + 2 )->second, 44 );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, FindKey )
+{
+	using A = bc::FlatMap<uint32_t, uint32_t>;
+
+	A a;
+	for( uint32_t i = 0; i < 100; ++i ) {
+		a.Emplace( i * 2, i );
+	}
+	for( uint32_t i = 0; i < 100; ++i ) {
+		auto it = a.Find( i * 2 );
+		ASSERT_NE( it, a.end() );
+		EXPECT_EQ( it->second, i );
+		EXPECT_EQ( a.Find( i * 2 + 1 ), a.end() );
+		EXPECT_TRUE( a.HasMember( i * 2 ) );
+		EXPECT_FALSE( a.HasMember( i * 2 + 1 ) );
+	}
+
+	const A & b = a;
+	EXPECT_EQ( b.Find( 10 )->second, 5 );
+	EXPECT_EQ( b.Find( 11 ), b.end() );
+	EXPECT_EQ( b.Front().first, 0 );
+	EXPECT_EQ( b.Back().first, 198 );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, Erase )
+{
+	using A = bc::FlatMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	A a { P( 1, 10 ), P( 2, 20 ), P( 3, 30 ), P( 4, 40 ), P( 5, 50 ), P( 6, 60 ) };
+
+	auto it = a.Erase( 3 );
+	EXPECT_EQ( a.Size(), 5 );
+	EXPECT_EQ( it->first, 4 );
+	EXPECT_FALSE( a.HasMember( 3 ) );
+
+	it = a.Erase( 100 );
+	EXPECT_EQ( a.Size(), 5 );
+	EXPECT_EQ( it, a.end() );
+
+	it = a.Erase( a.begin() );
+	EXPECT_EQ( a.Size(), 4 );
+	EXPECT_EQ( it->first, 2 );
+
+	it = a.Erase( a.end() - 1 );
+	EXPECT_EQ( a.Size(), 3 );
+	EXPECT_EQ( it, a.end() );
+
+	it = a.Erase( a.begin(), a.begin() + 2 );
+	EXPECT_EQ( a.Size(), 1 );
+	EXPECT_EQ( it->first, 5 );
+
+	a.Clear();
+	EXPECT_TRUE( a.IsEmpty() );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, Append )
+{
+	using A = bc::FlatMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	// Appended keys are merged in order, duplicates keep the last value.
+	{
+		A a { P( 2, 20 ), P( 4, 40 ), P( 6, 60 ) };
+		a.Append( { P( 5, 50 ), P( 1, 10 ), P( 4, 41 ), P( 7, 70 ), P( 5, 51 ) } );
+		EXPECT_EQ( a.Size(), 6 );
+
+		A expected { P( 1, 10 ), P( 2, 20 ), P( 4, 41 ), P( 5, 51 ), P( 6, 60 ), P( 7, 70 ) };
+		EXPECT_EQ( a, expected );
+	}
+	// Append from other containers.
+	{
+		A a { P( 1, 10 ), P( 3, 30 ) };
+		A b { P( 2, 20 ), P( 3, 31 ) };
+		a += b;
+		EXPECT_EQ( a.Size(), 3 );
+		EXPECT_EQ( a[ 3 ], 31 );
+
+		auto m = bc::Map<uint32_t, uint32_t> { P( 0, 0 ), P( 10, 100 ) };
+		a.Append( m );
+		EXPECT_EQ( a.Size(), 5 );
+		EXPECT_EQ( a.Front().first, 0 );
+		EXPECT_EQ( a.Back().first, 10 );
+
+		auto l = bc::List<P> { P( 11, 110 ), P( 0, 1 ), P( 11, 111 ) };
+		a.Append( l );
+		EXPECT_EQ( a.Size(), 6 );
+		EXPECT_EQ( a[ 0 ], 1 );
+		EXPECT_EQ( a[ 11 ], 111 );
+	}
+	// Append compared against std::map.
+	{
+		A a;
+		std::map<uint32_t, uint32_t> baseline;
+		std::default_random_engine gen( 1234 );
+		std::uniform_int_distribution<uint32_t> distribution( 0, 500 );
+		for( uint32_t round = 0; round < 10; ++round ) {
+			auto batch = bc::Map<uint32_t, uint32_t> {};
+			for( uint32_t i = 0; i < 100; ++i ) {
+				auto key = distribution( gen );
+				batch[ key ] = round * 1000 + i;
+			}
+			for( auto & pair : batch ) baseline[ pair.first ] = pair.second;
+			a.Append( batch );
+		}
+		EXPECT_EQ( a.Size(), baseline.size() );
+		auto it = a.begin();
+		for( auto & [ key, value ] : baseline ) {
+			EXPECT_EQ( it->first, key );
+			EXPECT_EQ( it->second, value );
+			++it;
+		}
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, MoveableOnlyStructure )
+{
+	struct MoveableOnly
+	{
+		MoveableOnly( size_t value ) : v1( value ) {};
+		MoveableOnly( const MoveableOnly & other ) = delete;
+		MoveableOnly( MoveableOnly && other ) = default;
+		MoveableOnly & operator=( const MoveableOnly & other ) = delete;
+		MoveableOnly & operator=( MoveableOnly && other ) = default;
+		size_t v1 = {};
+	};
+
+	using A = bc::FlatMap<uint32_t, MoveableOnly>;
+	using P = bc::Pair<uint32_t, MoveableOnly>;
+
+	A a;
+	a.Insert( P( 3, MoveableOnly( 20 ) ) );
+	a.Insert( P( 1, MoveableOnly( 5 ) ) );
+	a.Emplace( 2, MoveableOnly( 10 ) );
+	EXPECT_EQ( a.Size(), 3 );
+	EXPECT_EQ( ( a.begin() + 0 )->second.v1, 5 );
+	EXPECT_EQ( ( a.begin() + 1 )->second.v1, 10 );
+	EXPECT_EQ( ( a.begin() + 2 )->second.v1, 20 );
+
+	A b = std::move( a );
+	EXPECT_EQ( a.Size(), 0 );
+	EXPECT_EQ( b.Size(), 3 );
+
+	A c; c = std::move( b );
+	EXPECT_EQ( b.Size(), 0 );
+	EXPECT_EQ( c.Size(), 3 );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class FlatMap_CtorDtorCounted
+{
+public:
+	static int32_t constructed_counter;
+
+	size_t data = 0;
+
+	FlatMap_CtorDtorCounted() { ++constructed_counter; }
+	FlatMap_CtorDtorCounted( const FlatMap_CtorDtorCounted & other ) : data( other.data ) { ++constructed_counter; }
+	FlatMap_CtorDtorCounted( FlatMap_CtorDtorCounted && other ) : data( other.data ) { ++constructed_counter; }
+	~FlatMap_CtorDtorCounted() { --constructed_counter; }
+	FlatMap_CtorDtorCounted & operator=( const FlatMap_CtorDtorCounted & other ) = default;
+	FlatMap_CtorDtorCounted & operator=( FlatMap_CtorDtorCounted && other ) = default;
+	bool operator==( const FlatMap_CtorDtorCounted & other ) const { return data == other.data; }
+};
+
+int32_t FlatMap_CtorDtorCounted::constructed_counter	= 0;
+
+TEST( FlatMapContainer, CtorDtorCounter )
+{
+	FlatMap_CtorDtorCounted::constructed_counter	= 0;
+
+	using A = bc::FlatMap<size_t, FlatMap_CtorDtorCounted>;
+	using P = bc::Pair<size_t, FlatMap_CtorDtorCounted>;
+
+	{
+		A a;
+
+		a.Insert( P( 3, {} ) );
+		a.Insert( P( 2, FlatMap_CtorDtorCounted() ) );
+		a.Emplace( 1, FlatMap_CtorDtorCounted {} );
+		EXPECT_EQ( a.Size(), 3 );
+		EXPECT_EQ( FlatMap_CtorDtorCounted::constructed_counter, 3 );
+
+		a.Erase( a.begin() + 1 );
+		EXPECT_EQ( a.Size(), 2 );
+		EXPECT_EQ( FlatMap_CtorDtorCounted::constructed_counter, 2 );
+
+		a.Clear();
+		EXPECT_EQ( FlatMap_CtorDtorCounted::constructed_counter, 0 );
+	}
+	{
+		A a;
+		for( size_t i = 0; i < 50; ++i ) {
+			a.Emplace( 49 - i, {} );
+		}
+		a.Append( { P( 10, {} ), P( 60, {} ), P( 10, {} ) } );
+		EXPECT_EQ( a.Size(), 51 );
+		EXPECT_EQ( FlatMap_CtorDtorCounted::constructed_counter, 51 );
+
+		a.Erase( a.begin(), a.end() - 5 );
+		EXPECT_EQ( a.Size(), 5 );
+
+		A b = a;
+		EXPECT_EQ( FlatMap_CtorDtorCounted::constructed_counter, 10 );
+		EXPECT_EQ( a, b );
+	}
+	EXPECT_EQ( FlatMap_CtorDtorCounted::constructed_counter, 0 );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, SelfAssignment )
+{
+	using A = bc::FlatMap<uint32_t, uint32_t>;
+	using P = A::ContainedPairType;
+
+	A original { P{ 5, 50 }, P{ 10, 100 }, P{ 20, 200 }, P{ 50, 500 }, P{ 200, 2000 } };
+	{
+		A a = original;
+		a = a;
+		EXPECT_EQ( a.Size(), 5 );
+		EXPECT_EQ( a, original );
+	}
+	{
+		A a = original;
+		a.Append( a );
+		EXPECT_EQ( a.Size(), 5 );
+		EXPECT_EQ( a, original );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( FlatMapContainer, ArenaAllocator )
+{
+	auto arena = bc::memory::LinearArena( 1024 * 1024 );
+	{
+		auto a = bc::ArenaFlatMap<uint32_t, uint32_t>( &arena );
+		for( uint32_t i = 0; i < 1000; ++i ) a.Emplace( 999 - i, i + 1 );
+		EXPECT_EQ( a.Size(), 1000 );
+		EXPECT_EQ( a[ 500 ], 500 );
+		EXPECT_EQ( a.Front().first, 0 );
+		EXPECT_GT( arena.GetUsedSize(), 0 );
+	}
+	// Appending unsorted batches with duplicates sorts them in the list capacity, compared against std::map.
+	{
+		auto a = bc::ArenaFlatMap<uint32_t, uint32_t>( &arena );
+		auto reference = std::map<uint32_t, uint32_t> {};
+		auto random_engine = std::default_random_engine( 42 );
+		auto key_distribution = std::uniform_int_distribution<uint32_t>( 0, 3000 );
+		for( uint32_t round = 0; round < 4; ++round ) {
+			auto batch = bc::List<bc::Pair<uint32_t, uint32_t>> {};
+			for( uint32_t i = 0; i < 1000; ++i ) {
+				auto key = key_distribution( random_engine );
+				batch.PushBack( bc::Pair<uint32_t, uint32_t>( key, round * 1000 + i ) );
+				reference[ key ] = round * 1000 + i;
+			}
+			a.Append( batch );
+			ASSERT_EQ( a.Size(), reference.size() );
+			auto it = a.begin();
+			for( auto & [ key, value ] : reference ) {
+				EXPECT_EQ( it->first, key );
+				EXPECT_EQ( it->second, value );
+				++it;
+			}
+		}
+	}
+}
+
+
+
+} // containers
+} // core
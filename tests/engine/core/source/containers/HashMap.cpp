@@ -0,0 +1,912 @@
+#include <gtest/gtest.h>
+
+#include <core/containers/HashMap.hpp>
+#include <core/containers/Text.hpp>
+#include <core/containers/UniquePtr.hpp>
+#include <core/math/Vector.hpp>
+#include <core/memory/allocator/LinearArena.hpp>
+
+#include <random>
+#include <unordered_map>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, BasicInit )
+{
+	using A = bc::HashMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+	{
+		A a;
+		EXPECT_EQ( a.Size(), 0 );
+
+		A b {};
+		EXPECT_EQ( b.Size(), 0 );
+
+		A c = {};
+		EXPECT_EQ( c.Size(), 0 );
+
+		A d = A();
+		EXPECT_EQ( d.Size(), 0 );
+
+		A e = A {};
+		EXPECT_EQ( e.Size(), 0 );
+
+		EXPECT_TRUE( a.IsEmpty() );
+		EXPECT_TRUE( b.IsEmpty() );
+		EXPECT_TRUE( c.IsEmpty() );
+		EXPECT_TRUE( d.IsEmpty() );
+		EXPECT_TRUE( e.IsEmpty() );
+		EXPECT_EQ( a.begin(), a.end() );
+	}
+	{
+		A a { P( 1, 5 ), P( 2, 10 ) };
+		EXPECT_EQ( a.Size(), 2 );
+		EXPECT_FALSE( a.IsEmpty() );
+
+		A b = { P( 1, 5 ), P( 1, 10 ) };
+		EXPECT_EQ( b.Size(), 1 );
+		EXPECT_FALSE( b.IsEmpty() );
+		EXPECT_EQ( b[ 1 ], 10 );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, InsertEmplaceValue )
+{
+	using A = bc::HashMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	{
+		A a;
+
+		// Regular insert.
+		{
+			auto insert_value = P( 1, 5 );
+			a.Insert( insert_value );
+			EXPECT_EQ( a[ 1 ], 5 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// Inserted value to same key, does not increase size but updates value.
+		{
+			auto insert_value = P( 1, 10 );
+			a.Insert( insert_value );
+			EXPECT_EQ( a[ 1 ], 10 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// same as above but for moved values
+		{
+			auto insert_value = P( 2, 5 );
+			a.Insert( std::move( insert_value ) );
+			EXPECT_EQ( a[ 2 ], 5 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+		{
+			auto insert_value = P( 2, 10 );
+			a.Insert( std::move( insert_value ) );
+			EXPECT_EQ( a[ 2 ], 10 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+	}
+	{
+		A a;
+
+		// Regular emplace.
+		{
+			uint32_t insert_key = 1;
+			uint32_t insert_value = 5;
+			a.Emplace( insert_key, insert_value );
+			EXPECT_EQ( a[ 1 ], 5 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// Inserted value to same key, does not increase size but updates value.
+		{
+			uint32_t insert_key = 1;
+			uint32_t insert_value = 10;
+			a.Emplace( insert_key, insert_value );
+			EXPECT_EQ( a[ 1 ], 10 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// same as above but for moved values
+		{
+			a.Emplace( 2, 5 );
+			EXPECT_EQ( a[ 2 ], 5 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+		{
+			a.Emplace( 2, 10 );
+			EXPECT_EQ( a[ 2 ], 10 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class HashMap_InsertObject
+{
+public:
+	HashMap_InsertObject() = default;
+	HashMap_InsertObject( size_t value ) : value( value ) {}
+	HashMap_InsertObject( const HashMap_InsertObject & other ) = default;
+	HashMap_InsertObject( HashMap_InsertObject && other ) = default;
+
+	HashMap_InsertObject & operator=( const HashMap_InsertObject & other ) = default;
+	HashMap_InsertObject & operator=( HashMap_InsertObject && other ) = default;
+
+	bool operator==( const HashMap_InsertObject & other ) const { return value == other.value; }
+
+	size_t value = 0;
+};
+
+TEST( HashMapContainer, InsertEmplaceObject )
+{
+	using A = bc::HashMap<uint32_t, HashMap_InsertObject>;
+	using P = bc::Pair<uint32_t, HashMap_InsertObject>;
+
+	{
+		A a;
+
+		// Regular insert.
+		{
+			P insert_value = { 1, HashMap_InsertObject( 5 ) };
+			a.Insert( insert_value );
+			EXPECT_EQ( a[ 1 ], 5 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// Inserted value to same key, does not increase size but updates value.
+		{
+			auto insert_value = P( 1, 10 );
+			a.Insert( insert_value );
+			EXPECT_EQ( a[ 1 ], 10 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// same as above but for moved values
+		{
+			auto insert_value = P( 2, 5 );
+			a.Insert( std::move( insert_value ) );
+			EXPECT_EQ( a[ 2 ], 5 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+		{
+			auto insert_value = P( 2, 10 );
+			a.Insert( std::move( insert_value ) );
+			EXPECT_EQ( a[ 2 ], 10 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+	}
+	{
+		A a;
+
+		// Regular emplace.
+		{
+			uint32_t insert_key = 1;
+			HashMap_InsertObject insert_value = 5;
+			a.Emplace( insert_key, insert_value );
+			EXPECT_EQ( a[ 1 ], 5 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// Inserted value to same key, does not increase size but updates value.
+		{
+			uint32_t insert_key = 1;
+			HashMap_InsertObject insert_value = 10;
+			a.Emplace( insert_key, insert_value );
+			EXPECT_EQ( a[ 1 ], 10 );
+			EXPECT_EQ( a.Size(), 1 );
+		}
+		// same as above but for moved values
+		{
+			a.Emplace( 2, HashMap_InsertObject( 5 ) );
+			EXPECT_EQ( a[ 2 ], 5 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+		{
+			a.Emplace( 2, HashMap_InsertObject( 10 ) );
+			EXPECT_EQ( a[ 2 ], 10 );
+			EXPECT_EQ( a.Size(), 2 );
+		}
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, Iterator )
+{
+	using A = bc::HashMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	{
+		A a;
+		auto it = a.begin();
+		auto temp_it = it;
+		EXPECT_EQ( it, a.end() );
+		EXPECT_FALSE( it.IsValid() );
+		EXPECT_THROW( ++temp_it, bc::diagnostic::Exception );
+		temp_it = it;
+		EXPECT_THROW( --temp_it, bc::diagnostic::Exception );
+		EXPECT_THROW( *it, bc::diagnostic::Exception );
+	}
+	{
+		A a { P( 1, 5 ), P( 2, 10 ), P( 3, 20 ), P( 4, 50 ), P( 5, 100 ) };
+
+		// Every element is visited exactly once, order is not defined.
+		uint32_t key_sum = 0;
+		uint32_t value_sum = 0;
+		uint64_t count = 0;
+		for( auto it = a.begin(); it != a.end(); ++it ) {
+			EXPECT_TRUE( it.IsValid() );
+			key_sum += it->first;
+			value_sum += ( *it ).second;
+			++count;
+		}
+		EXPECT_EQ( count, 5 );
+		EXPECT_EQ( key_sum, 15 );
+		EXPECT_EQ( value_sum, 185 );
+
+		// Iterating backwards visits the same elements in reverse order.
+		auto forward = std::vector<uint32_t> {};
+		for( auto & pair : a ) forward.push_back( pair.first );
+		auto it = a.end();
+		for( auto f = forward.rbegin(); f != forward.rend(); ++f ) {
+			--it;
+			EXPECT_EQ( it->first, *f );
+		}
+		EXPECT_EQ( it, a.begin() );
+		auto temp_it = it;
+		EXPECT_THROW( --temp_it, bc::diagnostic::Exception );
+
+		EXPECT_EQ( a.begin() + 5, a.end() );
+		EXPECT_EQ( a.end() - 5, a.begin() );
+		temp_it = a.end();
+		EXPECT_THROW( ++temp_it, bc::diagnostic::Exception );
+		EXPECT_THROW( *a.end(), bc::diagnostic::Exception );
+
+		// Values can be modified through the iterator.
+		for( auto & pair : a ) pair.second += 1;
+		EXPECT_EQ( a[ 1 ], 6 );
+		EXPECT_EQ( a[ 5 ], 101 );
+
+		// Const iterators.
+		const A & c = a;
+		uint32_t const_key_sum = 0;
+		for( auto cit = c.cbegin(); cit != c.cend(); ++cit ) const_key_sum += cit->first;
+		EXPECT_EQ( const_key_sum, 15 );
+		A::ConstIterator converted = a.begin();
+		EXPECT_EQ( converted, a.begin() );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, Erase )
+{
+	using A = bc::HashMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	{
+		A a { P( 1, 5 ), P( 2, 10 ), P( 3, 20 ), P( 4, 50 ), P( 5, 100 ) };
+		EXPECT_EQ( a.Size(), 5 );
+
+		a.Erase( 3 );
+		EXPECT_EQ( a.Size(), 4 );
+		EXPECT_FALSE( a.HasMember( 3 ) );
+		EXPECT_TRUE( a.HasMember( 1 ) );
+		EXPECT_TRUE( a.HasMember( 2 ) );
+		EXPECT_TRUE( a.HasMember( 4 ) );
+		EXPECT_TRUE( a.HasMember( 5 ) );
+
+		// Erasing key that does not exist does nothing.
+		EXPECT_EQ( a.Erase( 3 ), a.end() );
+		EXPECT_EQ( a.Size(), 4 );
+
+		auto first_key = a.begin()->first;
+		auto next = a.Erase( a.begin() );
+		EXPECT_EQ( next, a.begin() );
+		EXPECT_EQ( a.Size(), 3 );
+		EXPECT_FALSE( a.HasMember( first_key ) );
+	}
+	{
+		A a { P( 1, 5 ), P( 2, 10 ), P( 3, 20 ), P( 4, 50 ), P( 5, 100 ) };
+
+		auto kept_key = ( a.begin() + 2 )->first;
+		auto result = a.Erase( a.begin(), a.begin() + 2 );
+		EXPECT_EQ( result, a.begin() );
+		EXPECT_EQ( a.Size(), 3 );
+		EXPECT_EQ( a.begin()->first, kept_key );
+
+		a.Erase( a.begin(), a.end() );
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( a.begin(), a.end() );
+	}
+	{
+		// Erase while iterating.
+		A a;
+		for( uint32_t i = 0; i < 100; ++i ) a.Emplace( i, i * 2 );
+		for( auto it = a.begin(); it != a.end(); ) {
+			if( it->first % 2 ) it = a.Erase( it );
+			else ++it;
+		}
+		EXPECT_EQ( a.Size(), 50 );
+		for( uint32_t i = 0; i < 100; ++i ) EXPECT_EQ( a.HasMember( i ), i % 2 == 0 );
+	}
+	{
+		A a { P( 1, 5 ), P( 2, 10 ) };
+		EXPECT_THROW( a.Erase( a.begin() - 1 ), bc::diagnostic::Exception );
+		EXPECT_THROW( a.Erase( a.begin() + 2 ), bc::diagnostic::Exception );
+		EXPECT_THROW( a.Erase( a.end() ), bc::diagnostic::Exception );
+		A b { P( 1, 5 ) };
+		EXPECT_THROW( a.Erase( b.begin() ), bc::diagnostic::Exception );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, Append )
+{
+	using A = bc::HashMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	{
+		A a { P( 1, 5 ), P( 2, 10 ), P( 3, 20 ) };
+		A b { P( 4, 50 ), P( 5, 100 ), P( 3, 200 ) };
+		a.Append( b );
+		EXPECT_EQ( a.Size(), 5 );
+		EXPECT_EQ( a[ 3 ], 200 );
+		EXPECT_EQ( a[ 5 ], 100 );
+
+		a.Append( { P( 6, 1 ), P( 7, 2 ), P( 8, 3 ), P( 9, 4 ) } );
+		EXPECT_EQ( a.Size(), 9 );
+		for( uint32_t i = 1; i <= 9; ++i ) EXPECT_TRUE( a.HasMember( i ) );
+	}
+	{
+		A a { P( 1, 5 ), P( 2, 10 ) };
+		a += { P( 3, 20 ), P( 4, 50 ) };
+		a += A { P( 5, 100 ), P( 1, 1 ) };
+		EXPECT_EQ( a.Size(), 5 );
+		EXPECT_EQ( a[ 1 ], 1 );
+		EXPECT_EQ( a[ 5 ], 100 );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, FindKey )
+{
+	using A = bc::HashMap<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	{
+		A a;
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( a.Find( 1 ), a.end() );
+		EXPECT_FALSE( a.HasMember( 1 ) );
+	}
+	{
+		A a = { P( 1, 5 ), P( 2, 10 ), P( 3, 20 ) };
+		EXPECT_EQ( a.Size(), 3 );
+
+		EXPECT_EQ( a.Find( 1 )->second, 5 );
+		EXPECT_EQ( a.Find( 2 )->second, 10 );
+		EXPECT_EQ( a.Find( 3 )->second, 20 );
+
+		EXPECT_EQ( a.Find( 0 ), a.end() );
+		EXPECT_EQ( a.Find( 4 ), a.end() );
+		EXPECT_EQ( a.Find( 9 ), a.end() );
+
+		const A & c = a;
+		EXPECT_EQ( c.Find( 2 )->second, 10 );
+		EXPECT_EQ( c.Find( 4 ), c.end() );
+	}
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, IndexOperator )
+{
+	using A = bc::HashMap<uint32_t, uint32_t>;
+
+	A a;
+
+	a[ 1 ] = 5;
+	EXPECT_EQ( a.Size(), 1 );
+	EXPECT_EQ( a[ 1 ], 5 );
+
+	a[ 1 ] = 10;
+	EXPECT_EQ( a.Size(), 1 );
+	EXPECT_EQ( a[ 1 ], 10 );
+
+	a[ 2 ] = 20;
+	EXPECT_EQ( a.Size(), 2 );
+	EXPECT_EQ( a[ 1 ], 10 );
+	EXPECT_EQ( a[ 2 ], 20 );
+
+	a[ 5 ] = 100;
+	a[ 4 ] = 200;
+	a[ 3 ] = 1000;
+	EXPECT_EQ( a.Size(), 5 );
+	EXPECT_EQ( a[ 3 ], 1000 );
+	EXPECT_EQ( a[ 4 ], 200 );
+	EXPECT_EQ( a[ 5 ], 100 );
+
+	// Missing key is default constructed.
+	EXPECT_EQ( a[ 6 ], 0 );
+	EXPECT_EQ( a.Size(), 6 );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, StructureBasicInit )
+{
+	struct Simple
+	{
+		size_t v1;
+		uint32_t v2;
+		float v3;
+		double v4;
+	};
+
+	using A = bc::HashMap<uint32_t, Simple>;
+	using P = bc::Pair<uint32_t, Simple>;
+
+	{
+		A a;
+		A b {};
+		A c = {};
+		A d = A();
+		A e = A {};
+
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( b.Size(), 0 );
+		EXPECT_EQ( c.Size(), 0 );
+		EXPECT_EQ( d.Size(), 0 );
+		EXPECT_EQ( e.Size(), 0 );
+	}
+	{
+		A a {
+			P( 1, { 5, 10, 20.0f, 50.0 } ),
+			P( 2, {} )
+		};
+
+		EXPECT_EQ( a.Size(), 2 );
+
+		EXPECT_EQ( a.Find( 1 )->second.v1, 5 );
+		EXPECT_EQ( a.Find( 1 )->second.v2, 10 );
+		EXPECT_FLOAT_EQ( a.Find( 1 )->second.v3, 20.0f );
+		EXPECT_DOUBLE_EQ( a.Find( 1 )->second.v4, 50.0 );
+
+		EXPECT_EQ( a.Find( 2 )->second.v1, 0 );
+		EXPECT_EQ( a.Find( 2 )->second.v2, 0 );
+		EXPECT_FLOAT_EQ( a.Find( 2 )->second.v3, 0.0f );
+		EXPECT_DOUBLE_EQ( a.Find( 2 )->second.v4, 0.0 );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, StructureCopy )
+{
+	struct Simple
+	{
+		size_t v1;
+		uint32_t v2;
+		float v3;
+		double v4;
+	};
+
+	using A = bc::HashMap<uint32_t, Simple>;
+	using P = bc::Pair<uint32_t, Simple>;
+
+	A a {
+		P( 1, { 5, 10, 20.0f, 50.0 } ),
+		P( 2, {} )
+	};
+	A b = a;
+
+	EXPECT_EQ( a.Size(), 2 );
+	EXPECT_EQ( b.Size(), 2 );
+
+	EXPECT_EQ( a.Find( 1 )->second.v1, b.Find( 1 )->second.v1 );
+	EXPECT_EQ( a.Find( 1 )->second.v2, b.Find( 1 )->second.v2 );
+	EXPECT_FLOAT_EQ( a.Find( 1 )->second.v3, b.Find( 1 )->second.v3 );
+	EXPECT_DOUBLE_EQ( a.Find( 1 )->second.v4, b.Find( 1 )->second.v4 );
+
+	// Make sure a copy is made.
+	b.Find( 1 )->second.v1 = 600;
+	EXPECT_EQ( a.Find( 1 )->second.v1, 5 );
+	EXPECT_EQ( b.Find( 1 )->second.v1, 600 );
+
+	A c { P { 1, { 700 } } };
+	EXPECT_EQ( c.Size(), 1 );
+	EXPECT_EQ( c.Find( 1 )->second.v1, 700 );
+
+	c = b;
+	EXPECT_EQ( c.Size(), b.Size() );
+	EXPECT_EQ( c.Find( 1 )->second.v1, 600 );
+	EXPECT_EQ( c.Find( 2 )->second.v1, 0 );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, StructureMove )
+{
+	struct Simple
+	{
+		size_t v1;
+		uint32_t v2;
+		float v3;
+		double v4;
+	};
+
+	using A = bc::HashMap<uint32_t, Simple>;
+	using P = bc::Pair<uint32_t, Simple>;
+
+	// Construct original.
+	A a {
+		P( 1, { 5, 10, 20.0f, 50.0 } ),
+		P( 2, {} )
+	};
+	EXPECT_EQ( a.Size(), 2 );
+
+	// Move construct.
+	A b = std::move( a );
+	EXPECT_EQ( a.Size(), 0 );
+	EXPECT_EQ( a.Find( 1 ), a.end() );
+	EXPECT_EQ( b.Size(), 2 );
+	EXPECT_EQ( b.Find( 1 )->second.v1, 5 );
+
+	// Move assign.
+	A c; c = std::move( b );
+	EXPECT_EQ( a.Size(), 0 );
+	EXPECT_EQ( b.Size(), 0 );
+	EXPECT_EQ( c.Size(), 2 );
+	EXPECT_EQ( c.Find( 1 )->second.v1, 5 );
+	EXPECT_EQ( c.Find( 1 )->second.v2, 10 );
+	EXPECT_FLOAT_EQ( c.Find( 1 )->second.v3, 20.0f );
+	EXPECT_DOUBLE_EQ( c.Find( 1 )->second.v4, 50.0 );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, MoveableOnlyStructure )
+{
+	struct MoveableOnly
+	{
+		MoveableOnly( size_t value ) : v1( value ) {};
+		MoveableOnly( const MoveableOnly & other ) = delete;
+		MoveableOnly( MoveableOnly && other ) = default;
+		MoveableOnly & operator=( const MoveableOnly & other ) = delete;
+		MoveableOnly & operator=( MoveableOnly && other ) = default;
+		size_t v1 = {};
+	};
+
+	using A = bc::HashMap<uint32_t, MoveableOnly>;
+	using P = bc::Pair<uint32_t, MoveableOnly>;
+	{
+		A a;
+		a.Insert( P( 1, MoveableOnly( 5 ) ) );
+		a.Insert( P( 2, MoveableOnly( 10 ) ) );
+		a.Insert( P( 3, MoveableOnly( 20 ) ) );
+		EXPECT_EQ( a.Size(), 3 );
+		EXPECT_EQ( a.Find( 1 )->second.v1, 5 );
+		EXPECT_EQ( a.Find( 2 )->second.v1, 10 );
+		EXPECT_EQ( a.Find( 3 )->second.v1, 20 );
+	}
+	{
+		A a;
+		a.Emplace( 1, MoveableOnly( 5 ) );
+		a.Emplace( 2, MoveableOnly( 10 ) );
+		a.Emplace( 3, MoveableOnly( 20 ) );
+		a.Emplace( 3, MoveableOnly( 30 ) );
+		EXPECT_EQ( a.Size(), 3 );
+		EXPECT_EQ( a.Find( 3 )->second.v1, 30 );
+
+		// Expecting compile time error for this:
+		// A b = a;
+
+		A b = std::move( a );
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( b.Size(), 3 );
+
+		A c; c = std::move( b );
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( b.Size(), 0 );
+		EXPECT_EQ( c.Size(), 3 );
+	}
+	{
+		// Growing moves the values to the new table.
+		using U = bc::HashMap<uint32_t, bc::UniquePtr<uint32_t>>;
+		U u;
+		for( uint32_t i = 0; i < 1000; ++i ) u.Emplace( uint32_t( i ), bc::MakeUniquePtr<uint32_t>( i * 3 ) );
+		EXPECT_EQ( u.Size(), 1000 );
+		for( uint32_t i = 0; i < 1000; ++i ) ASSERT_EQ( *u.Find( i )->second, i * 3 );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class HashMap_CtorDtorCounted
+{
+public:
+	static int32_t constructed_counter;
+
+	size_t data = 0;
+
+	HashMap_CtorDtorCounted() { ++constructed_counter; }
+	HashMap_CtorDtorCounted( const HashMap_CtorDtorCounted & other ) : data( other.data ) { ++constructed_counter; }
+	HashMap_CtorDtorCounted( HashMap_CtorDtorCounted && other ) : data( other.data ) { ++constructed_counter; }
+	~HashMap_CtorDtorCounted() { --constructed_counter; }
+	HashMap_CtorDtorCounted & operator=( const HashMap_CtorDtorCounted & other ) = default;
+	HashMap_CtorDtorCounted & operator=( HashMap_CtorDtorCounted && other ) = default;
+	bool operator==( const HashMap_CtorDtorCounted & other ) const { return data == other.data; }
+};
+
+int32_t HashMap_CtorDtorCounted::constructed_counter	= 0;
+
+TEST( HashMapContainer, CtorDtorCounter )
+{
+	HashMap_CtorDtorCounted::constructed_counter	= 0;
+
+	using A = bc::HashMap<size_t, HashMap_CtorDtorCounted>;
+	using P = bc::Pair<size_t, HashMap_CtorDtorCounted>;
+
+	{
+		A a;
+
+		a.Insert( P( 1, {} ) );
+		a.Insert( P( 2, HashMap_CtorDtorCounted() ) );
+		a.Insert( P( 3, HashMap_CtorDtorCounted {} ) );
+		EXPECT_EQ( a.Size(), 3 );
+
+		a.Emplace( 4, {} );
+		a.Emplace( 5, HashMap_CtorDtorCounted() );
+		a.Emplace( 6, HashMap_CtorDtorCounted {} );
+		EXPECT_EQ( a.Size(), 6 );
+
+		a.Erase( a.begin() + 2 );
+		EXPECT_EQ( a.Size(), 5 );
+
+		a.Erase( a.begin() + 2 );
+		EXPECT_EQ( a.Size(), 4 );
+
+		a.Clear();
+
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( HashMap_CtorDtorCounted::constructed_counter, 0 );
+	}
+	{
+		A a;
+
+		for( size_t i = 0; i < 50; ++i ) {
+			a.Emplace( i, {} );
+		}
+		EXPECT_EQ( a.Size(), 50 );
+		EXPECT_EQ( HashMap_CtorDtorCounted::constructed_counter, 50 );
+
+		a.Erase( a.begin() );
+		EXPECT_EQ( a.Size(), 49 );
+
+		a.Erase( a.end() - 1 );
+		EXPECT_EQ( a.Size(), 48 );
+
+		a.Erase( a.begin() + 10 );
+		EXPECT_EQ( a.Size(), 47 );
+
+		a.Erase( a.begin(), a.end() - 5 );
+		EXPECT_EQ( a.Size(), 5 );
+		EXPECT_EQ( HashMap_CtorDtorCounted::constructed_counter, 5 );
+
+		A b = a;
+		EXPECT_EQ( HashMap_CtorDtorCounted::constructed_counter, 10 );
+		EXPECT_EQ( a, b );
+
+		a.Clear();
+		b.Clear();
+
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( HashMap_CtorDtorCounted::constructed_counter, 0 );
+	}
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, SelfAssignment )
+{
+	{
+		using A = bc::HashMap<uint32_t, uint32_t>;
+		using P = A::ContainedPairType;
+
+		A original { P{ 5, 50 }, P{ 10, 100 }, P{ 20, 200 }, P{ 50, 500 }, P{ 200, 2000 } };
+		{
+			A a = original;
+			a = a;
+			EXPECT_EQ( a.Size(), 5 );
+			EXPECT_EQ( a, original );
+		}
+		{
+			A a = original;
+			a.Append( a );
+
+			EXPECT_EQ( a.Size(), 5 );
+			A comp { P{ 200, 2000 }, P{ 50, 500 }, P{ 20, 200 }, P{ 10, 100 }, P{ 5, 50 } };
+			EXPECT_EQ( a, comp );
+			comp[ 5 ] = 0;
+			EXPECT_NE( a, comp );
+		}
+	}
+	{
+		HashMap_CtorDtorCounted::constructed_counter		= 0;
+
+		using A = bc::HashMap<uint32_t, HashMap_CtorDtorCounted>;
+		using P = A::ContainedPairType;
+		A a;
+		a.Insert( P { 5, HashMap_CtorDtorCounted() } );
+		a.Insert( P { 10, HashMap_CtorDtorCounted() } );
+		a.Insert( P { 20, HashMap_CtorDtorCounted() } );
+		for( size_t i = 0; i < 5; i++ ) {
+			a.Insert( P { uint32_t( i ), HashMap_CtorDtorCounted() } );
+			a = a;
+			a.Append( a );
+		}
+		a.Clear();
+
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( HashMap_CtorDtorCounted::constructed_counter, 0 );
+	}
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, TextKeys )
+{
+	using A = bc::HashMap<bc::Text, uint32_t>;
+	using P = A::ContainedPairType;
+
+	A a { P( "first", 1 ), P( "second", 2 ), P( "a text key long enough to be stored on the heap", 3 ) };
+	EXPECT_EQ( a.Size(), 3 );
+	EXPECT_EQ( a[ "first" ], 1 );
+	EXPECT_EQ( a[ "second" ], 2 );
+	EXPECT_EQ( a[ "a text key long enough to be stored on the heap" ], 3 );
+	EXPECT_FALSE( a.HasMember( "third" ) );
+
+	for( uint32_t i = 0; i < 200; ++i ) {
+		auto number = std::to_string( i );
+		auto key = bc::Text( "key " );
+		key.Append( bc::TextView( number.c_str(), number.size() ) );
+		a.Emplace( std::move( key ), uint32_t( i ) );
+	}
+	EXPECT_EQ( a.Size(), 203 );
+	EXPECT_EQ( a[ "key 150" ], 150 );
+
+	// Text and text views with the same characters hash the same.
+	EXPECT_EQ( bc::Hash<bc::Text> {}( "abc" ), bc::Hash<bc::TextView> {}( bc::TextView( "abc" ) ) );
+	EXPECT_EQ( bc::Hash<bc::Text> {}( "abc" ), bc::Hash<bc::Text32> {}( U"abc" ) );
+	EXPECT_NE( bc::Hash<bc::Text> {}( "abc" ), bc::Hash<bc::Text> {}( "abd" ) );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, VectorKeys )
+{
+	using A = bc::HashMap<bc::math::Vec2i32, uint32_t>;
+
+	A a;
+	for( int32_t y = 0; y < 32; ++y ) {
+		for( int32_t x = 0; x < 32; ++x ) {
+			a.Emplace( bc::math::Vec2i32 { x, y }, uint32_t( y * 32 + x ) );
+		}
+	}
+	EXPECT_EQ( a.Size(), 32 * 32 );
+	EXPECT_EQ( a[ bc::math::Vec2i32( 5, 7 ) ], 7 * 32 + 5 );
+	EXPECT_EQ( a[ bc::math::Vec2i32( 7, 5 ) ], 5 * 32 + 7 );
+	EXPECT_FALSE( a.HasMember( bc::math::Vec2i32( 32, 0 ) ) );
+
+	EXPECT_NE( bc::Hash<bc::math::Vec3f32> {}( { 1.0f, 2.0f, 3.0f } ), bc::Hash<bc::math::Vec3f32> {}( { 3.0f, 2.0f, 1.0f } ) );
+	EXPECT_EQ( bc::Hash<bc::math::Vec4u64> {}( { 1, 2, 3, 4 } ), bc::Hash<bc::math::Vec4u64> {}( { 1, 2, 3, 4 } ) );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, GrowAndReserve )
+{
+	using A = bc::HashMap<uint64_t, uint64_t>;
+
+	A a;
+	EXPECT_EQ( a.Capacity(), 0 );
+	a.Reserve( 100 );
+	auto reserved_capacity = a.Capacity();
+	EXPECT_GE( reserved_capacity * 7 / 8, 100 );
+	for( uint64_t i = 0; i < 100; ++i ) a.Emplace( i, i );
+	EXPECT_EQ( a.Capacity(), reserved_capacity );
+
+	// Inserting and erasing the same amount of elements over and over does not grow the map.
+	for( uint64_t round = 0; round < 50; ++round ) {
+		for( uint64_t i = 0; i < 50; ++i ) a.Erase( i + round * 50 );
+		for( uint64_t i = 0; i < 50; ++i ) a.Emplace( i + round * 50 + 100, i );
+		ASSERT_EQ( a.Size(), 100 );
+	}
+	EXPECT_EQ( a.Capacity(), reserved_capacity );
+	for( uint64_t i = 0; i < 2500; ++i ) EXPECT_FALSE( a.HasMember( i ) );
+	for( uint64_t i = 2500; i < 2600; ++i ) EXPECT_TRUE( a.HasMember( i ) );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, ArenaAllocator )
+{
+	auto arena = bc::memory::LinearArena( 1024 * 1024 );
+	{
+		auto a = bc::ArenaHashMap<uint32_t, uint32_t>( &arena );
+		for( uint32_t i = 0; i < 1000; ++i ) a.Emplace( i, i + 1 );
+		EXPECT_EQ( a.Size(), 1000 );
+		EXPECT_EQ( a[ 500 ], 501 );
+		EXPECT_GT( arena.GetUsedSize(), 0 );
+	}
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( HashMapContainer, RandomInsertErase )
+{
+	using A = bc::HashMap<int, int>;
+
+	constexpr int test_count = 20000;
+
+	A a;
+	std::unordered_map<int, int> baseline;
+
+	std::default_random_engine gen( 1234 );
+	std::uniform_int_distribution<int> selection( 0, 3 );
+	std::uniform_int_distribution<int> distribution( 0, test_count / 4 );
+
+	for( int i = 0; i < test_count; ++i ) {
+		auto key = distribution( gen );
+		if( selection( gen ) == 0 ) {
+			a.Erase( key );
+			baseline.erase( key );
+		} else {
+			a[ key ] = i;
+			baseline[ key ] = i;
+		}
+	}
+	EXPECT_EQ( a.Size(), baseline.size() );
+	for( auto & [ key, value ] : baseline ) {
+		auto it = a.Find( key );
+		ASSERT_NE( it, a.end() );
+		EXPECT_EQ( it->second, value );
+	}
+	size_t iterated_count = 0;
+	for( auto & pair : a ) {
+		ASSERT_EQ( baseline.count( pair.first ), 1 );
+		++iterated_count;
+	}
+	EXPECT_EQ( iterated_count, baseline.size() );
+}
+
+
+
+} // containers
+} // core
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 
 #include <core/containers/List.hpp>
+#include <core/containers/Text.hpp>
+#include <core/containers/UniquePtr.hpp>
 
 
 
@@ -764,6 +766,114 @@ TEST( ListContainer, SelfAssignment )
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ListContainer, PopFrontLastValue )
+{
+	List_CtorDtorCounted::constructed_counter		= 0;
+	{
+		using A = bc::List<List_CtorDtorCounted>;
+		A a;
+		a.PushBack( {} );
+		a.PopFront();
+		EXPECT_EQ( a.Size(), 0 );
+		EXPECT_EQ( List_CtorDtorCounted::constructed_counter, 0 );
+
+		a.Resize( 3 );
+		a.PopFront();
+		a.PopFront();
+		EXPECT_EQ( a.Size(), 1 );
+		EXPECT_EQ( List_CtorDtorCounted::constructed_counter, 1 );
+	}
+	EXPECT_EQ( List_CtorDtorCounted::constructed_counter, 0 );
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct List_RelocatableCounted
+{
+	static int32_t constructed_counter;
+	static int32_t moved_counter;
+	int32_t data = 0;
+	List_RelocatableCounted() { ++constructed_counter; }
+	List_RelocatableCounted( int32_t data ) : data( data ) { ++constructed_counter; }
+	List_RelocatableCounted( const List_RelocatableCounted & other ) : data( other.data ) { ++constructed_counter; }
+	List_RelocatableCounted( List_RelocatableCounted && other ) : data( other.data ) { ++constructed_counter; ++moved_counter; }
+	~List_RelocatableCounted() { --constructed_counter; }
+	List_RelocatableCounted & operator=( const List_RelocatableCounted & other ) = default;
+	List_RelocatableCounted & operator=( List_RelocatableCounted && other ) { data = other.data; ++moved_counter; return *this; }
+};
+int32_t List_RelocatableCounted::constructed_counter	= 0;
+int32_t List_RelocatableCounted::moved_counter			= 0;
+
+} // containers
+} // core
+
+template<>
+struct bc::IsTriviallyRelocatable<core::containers::List_RelocatableCounted> : std::true_type {};
+
+namespace core {
+namespace containers {
+
+TEST( ListContainer, TriviallyRelocatableValues )
+{
+	List_RelocatableCounted::constructed_counter	= 0;
+	List_RelocatableCounted::moved_counter			= 0;
+	{
+		using A = bc::List<List_RelocatableCounted>;
+		A a;
+		for( int32_t i = 0; i < 100; ++i ) a.PushBack( List_RelocatableCounted( i ) );
+		a.Reserve( 1000 );
+
+		// Growing, inserting and erasing relocate existing values without moving them one by one.
+		auto moved_before = List_RelocatableCounted::moved_counter;
+		a.Insert( a.begin() + 10, List_RelocatableCounted( -1 ), 5 );
+		a.PushFront( List_RelocatableCounted( -2 ) );
+		a.Erase( a.begin() + 20, a.begin() + 30 );
+		a.PopFront();
+		a.Reserve( 100000 );
+		EXPECT_EQ( List_RelocatableCounted::moved_counter - moved_before, 1 );
+
+		ASSERT_EQ( a.Size(), 95 );
+		for( int32_t i = 0; i < 10; ++i ) EXPECT_EQ( a[ i ].data, i );
+		for( int32_t i = 10; i < 15; ++i ) EXPECT_EQ( a[ i ].data, -1 );
+		for( int32_t i = 15; i < 19; ++i ) EXPECT_EQ( a[ i ].data, i - 5 );
+		for( int32_t i = 19; i < 95; ++i ) EXPECT_EQ( a[ i ].data, i + 5 );
+		EXPECT_EQ( List_RelocatableCounted::constructed_counter, 95 );
+	}
+	EXPECT_EQ( List_RelocatableCounted::constructed_counter, 0 );
+
+	{
+		using A = bc::List<bc::UniquePtr<int32_t>>;
+		A a;
+		for( int32_t i = 0; i < 1000; ++i ) a.PushBack( bc::MakeUniquePtr<int32_t>( i ) );
+		a.PushFront( bc::MakeUniquePtr<int32_t>( -1 ) );
+		a.Erase( a.begin() + 1, a.begin() + 11 );
+		a.PopFront();
+
+		ASSERT_EQ( a.Size(), 990 );
+		for( int32_t i = 0; i < 990; ++i ) EXPECT_EQ( *a[ i ], i + 10 );
+	}
+
+	{
+		using A = bc::List<bc::Text>;
+		A a;
+		for( int32_t i = 0; i < 100; ++i ) a.PushBack( bc::Text( "Relocated text value which does not fit small storage" ) );
+		a.Insert( a.begin() + 50, bc::Text( "Inserted" ) );
+		a.Erase( a.begin() );
+
+		ASSERT_EQ( a.Size(), 100 );
+		EXPECT_EQ( a[ 49 ], "Inserted" );
+		EXPECT_EQ( a[ 99 ], "Relocated text value which does not fit small storage" );
+
+		auto nested = bc::List<A> {};
+		for( int32_t i = 0; i < 50; ++i ) nested.PushFront( a );
+		EXPECT_EQ( nested.Size(), 50 );
+		EXPECT_EQ( nested[ 10 ][ 49 ], "Inserted" );
+	}
+}
+
+
 
 } // containers
 } // core
@@ -1,6 +1,7 @@
 
 #include <gtest/gtest.h>
 
+#include <core/containers/List.hpp>
 #include <core/containers/Map.hpp>
 
 
@@ -1208,5 +1209,59 @@ TEST( MapContainer, SelfAssignment )
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MapContainer, FromSorted )
+{
+	using A = bc::Map<uint32_t, uint32_t>;
+	using P = bc::Pair<uint32_t, uint32_t>;
+
+	{
+		auto a = A::FromSorted( bc::List<P> {} );
+		EXPECT_TRUE( a.IsEmpty() );
+		a.Emplace( 1, 1 );
+		EXPECT_EQ( a.Size(), 1 );
+	}
+	for( uint32_t count : { 1, 2, 3, 7, 8, 100, 1000 } ) {
+		auto sorted = bc::List<P> {};
+		for( uint32_t i = 0; i < count; ++i ) sorted.PushBack( P( i * 2, i ) );
+
+		auto a = A::FromSorted( sorted );
+		EXPECT_EQ( a.Size(), count );
+		for( uint32_t i = 0; i < count; ++i ) {
+			EXPECT_EQ( ( a.begin() + i )->first, i * 2 );
+			EXPECT_EQ( a[ i * 2 ], i );
+		}
+		EXPECT_EQ( a.Find( 1 ), a.end() );
+
+		// Tree must still work normally after bulk construction.
+		for( uint32_t i = 0; i < count; ++i ) a.Emplace( i * 2 + 1, i );
+		EXPECT_EQ( a.Size(), count * 2 );
+		for( uint32_t i = 0; i < count; ++i ) a.Erase( i * 2 );
+		EXPECT_EQ( a.Size(), count );
+		for( uint32_t i = 0; i < count; ++i ) {
+			EXPECT_EQ( ( a.begin() + i )->first, i * 2 + 1 );
+		}
+	}
+	{
+		A original { P{ 5, 50 }, P{ 10, 100 }, P{ 20, 200 } };
+		auto a = A::FromSorted( original );
+		EXPECT_EQ( a, original );
+	}
+	{
+		Map_CtorDtorCounted::constructed_counter = 0;
+
+		using B = bc::Map<size_t, Map_CtorDtorCounted>;
+		auto sorted = bc::List<B::ContainedPairType> {};
+		for( size_t i = 0; i < 20; ++i ) sorted.PushBack( B::ContainedPairType( i, {} ) );
+		{
+			auto b = B::FromSorted( sorted );
+			EXPECT_EQ( Map_CtorDtorCounted::constructed_counter, 40 );
+		}
+		EXPECT_EQ( Map_CtorDtorCounted::constructed_counter, 20 );
+	}
+}
+
+
+
 } // containers
 } // core
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+
+#include <core/containers/MpmcQueue.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+namespace mpmc_queue_test {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Counts live instances so that tests can check every value is destroyed exactly once.
+struct CountedValue
+{
+	static inline std::atomic<int64_t> live_count = 0;
+
+	CountedValue() { ++live_count; }
+	CountedValue( uint64_t value ) : value( value ) { ++live_count; }
+	CountedValue( const CountedValue & other ) : value( other.value ) { ++live_count; }
+	CountedValue( CountedValue && other ) noexcept : value( other.value ) { ++live_count; }
+	~CountedValue() { --live_count; }
+	CountedValue & operator=( const CountedValue & other ) = default;
+	CountedValue & operator=( CountedValue && other ) noexcept = default;
+
+	uint64_t value = 0;
+};
+
+} // mpmc_queue_test
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MpmcQueueContainer, Basic )
+{
+	auto queue = bc::MpmcQueue<uint32_t>( 3 );
+	EXPECT_EQ( queue.GetCapacity(), 4 );
+	EXPECT_TRUE( queue.IsEmpty() );
+
+	uint32_t value = 0;
+	EXPECT_FALSE( queue.TryPop( value ) );
+
+	EXPECT_TRUE( queue.TryPush( 1 ) );
+	EXPECT_TRUE( queue.TryPush( 2 ) );
+	EXPECT_TRUE( queue.TryEmplace( 3u ) );
+	EXPECT_TRUE( queue.TryPush( 4 ) );
+	EXPECT_FALSE( queue.TryPush( 5 ) );
+	EXPECT_EQ( queue.ApproximateSize(), 4 );
+
+	EXPECT_TRUE( queue.TryPop( value ) );
+	EXPECT_EQ( value, 1 );
+	EXPECT_TRUE( queue.TryPush( 5 ) );
+
+	for( uint32_t expected = 2; expected <= 5; ++expected )
+	{
+		EXPECT_TRUE( queue.TryPop( value ) );
+		EXPECT_EQ( value, expected );
+	}
+	EXPECT_FALSE( queue.TryPop( value ) );
+	EXPECT_TRUE( queue.IsEmpty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MpmcQueueContainer, Batch )
+{
+	auto queue = bc::MpmcQueue<uint32_t>( 8 );
+
+	uint32_t source[ 12 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+	EXPECT_EQ( queue.TryPushBatch( source, 5 ), 5 );
+	EXPECT_EQ( queue.TryPushBatch( source + 5, 7 ), 3 );
+	EXPECT_EQ( queue.TryPushBatch( source + 8, 4 ), 0 );
+
+	uint32_t destination[ 12 ] = {};
+	EXPECT_EQ( queue.TryPopBatch( destination, 6 ), 6 );
+	for( uint32_t i = 0; i < 6; ++i ) EXPECT_EQ( destination[ i ], i );
+
+	// Wraps around the end of the ring.
+	EXPECT_EQ( queue.TryPushBatch( source + 8, 4 ), 4 );
+	EXPECT_EQ( queue.TryPopBatch( destination, 12 ), 6 );
+	for( uint32_t i = 0; i < 6; ++i ) EXPECT_EQ( destination[ i ], i + 6 );
+	EXPECT_EQ( queue.TryPopBatch( destination, 12 ), 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MpmcQueueContainer, ValueLifetime )
+{
+	using namespace mpmc_queue_test;
+
+	{
+		auto queue = bc::MpmcQueue<CountedValue>( 16 );
+		for( uint64_t i = 0; i < 10; ++i ) EXPECT_TRUE( queue.TryEmplace( i ) );
+		EXPECT_EQ( CountedValue::live_count, 10 );
+
+		auto value = CountedValue {};
+		EXPECT_TRUE( queue.TryPop( value ) );
+		EXPECT_EQ( value.value, 0 );
+		EXPECT_EQ( CountedValue::live_count, 10 );
+
+		queue.Clear();
+		EXPECT_EQ( CountedValue::live_count, 1 );
+		EXPECT_TRUE( queue.IsEmpty() );
+
+		for( uint64_t i = 0; i < 16; ++i ) EXPECT_TRUE( queue.TryEmplace( i ) );
+		EXPECT_EQ( CountedValue::live_count, 17 );
+	}
+	EXPECT_EQ( CountedValue::live_count, 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MpmcQueueContainer, Stress )
+{
+	constexpr uint64_t producer_count = 4;
+	constexpr uint64_t consumer_count = 4;
+	constexpr uint64_t values_per_producer = 50000;
+
+	// Values encode their producer in the high bits and a per producer sequence number in the low bits.
+	auto queue = bc::MpmcQueue<uint64_t>( 128 );
+	auto received_counts = std::vector<std::atomic<uint32_t>>( producer_count * values_per_producer );
+	auto order_violation_count = std::atomic<uint64_t> { 0 };
+	auto total_received_count = std::atomic<uint64_t> { 0 };
+
+	auto threads = std::vector<std::thread> {};
+	for( uint64_t p = 0; p < producer_count; ++p )
+	{
+		threads.emplace_back( [ &, p ]()
+			{
+				uint64_t batch[ 6 ];
+				uint64_t next = 0;
+				while( next < values_per_producer )
+				{
+					if( p % 2 )
+					{
+						if( queue.TryPush( ( p << 32 ) | next ) ) ++next;
+						else std::this_thread::yield();
+						continue;
+					}
+					uint64_t batch_count = 0;
+					for( ; batch_count < 6 && next + batch_count < values_per_producer; ++batch_count )
+					{
+						batch[ batch_count ] = ( p << 32 ) | ( next + batch_count );
+					}
+					auto pushed_count = queue.TryPushBatch( batch, batch_count );
+					if( pushed_count == 0 ) std::this_thread::yield();
+					next += pushed_count;
+				}
+			}
+		);
+	}
+	for( uint64_t c = 0; c < consumer_count; ++c )
+	{
+		threads.emplace_back( [ &, c ]()
+			{
+				// Every consumer sees the values of one producer in increasing order.
+				uint64_t last_seen[ producer_count ];
+				for( auto & last : last_seen ) last = ~uint64_t( 0 );
+
+				uint64_t batch[ 5 ];
+				while( total_received_count.load() < producer_count * values_per_producer )
+				{
+					auto popped_count = c % 2 ? queue.TryPopBatch( batch, 5 ) : uint64_t( queue.TryPop( batch[ 0 ] ) );
+					if( popped_count == 0 )
+					{
+						std::this_thread::yield();
+						continue;
+					}
+					for( uint64_t i = 0; i < popped_count; ++i )
+					{
+						auto producer = batch[ i ] >> 32;
+						auto sequence = batch[ i ] & 0xFFFFFFFF;
+						if( last_seen[ producer ] != ~uint64_t( 0 ) && last_seen[ producer ] >= sequence ) ++order_violation_count;
+						last_seen[ producer ] = sequence;
+						++received_counts[ producer * values_per_producer + sequence ];
+					}
+					total_received_count += popped_count;
+				}
+			}
+		);
+	}
+	for( auto & thread : threads ) thread.join();
+
+	uint64_t wrong_count = 0;
+	for( auto & count : received_counts )
+	{
+		if( count != 1 ) ++wrong_count;
+	}
+	EXPECT_EQ( wrong_count, 0 );
+	EXPECT_EQ( order_violation_count, 0 );
+	EXPECT_EQ( total_received_count, producer_count * values_per_producer );
+	EXPECT_TRUE( queue.IsEmpty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MpmcQueueContainer, StressValueLifetime )
+{
+	using namespace mpmc_queue_test;
+
+	{
+		constexpr uint64_t thread_count = 4;
+		constexpr uint64_t values_per_thread = 20000;
+
+		// Threads both push and pop, whatever is left in the queue is destroyed by it.
+		auto queue = bc::MpmcQueue<CountedValue>( 32 );
+		auto popped_count = std::atomic<uint64_t> { 0 };
+		auto threads = std::vector<std::thread> {};
+		for( uint64_t t = 0; t < thread_count; ++t )
+		{
+			threads.emplace_back( [ & ]()
+				{
+					auto value = CountedValue {};
+					for( uint64_t i = 0; i < values_per_thread; ++i )
+					{
+						while( !queue.TryEmplace( i ) )
+						{
+							if( queue.TryPop( value ) ) ++popped_count;
+						}
+						if( i % 2 && queue.TryPop( value ) ) ++popped_count;
+					}
+				}
+			);
+		}
+		for( auto & thread : threads ) thread.join();
+
+		EXPECT_EQ( uint64_t( CountedValue::live_count ), queue.ApproximateSize() );
+		EXPECT_EQ( popped_count + queue.ApproximateSize(), thread_count * values_per_thread );
+	}
+	EXPECT_EQ( CountedValue::live_count, 0 );
+}
+
+
+
+} // containers
+} // core
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <core/containers/SpscQueue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+namespace spsc_queue_test {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Counts live instances so that tests can check every value is destroyed exactly once.
+struct CountedValue
+{
+	static inline std::atomic<int64_t> live_count = 0;
+
+	CountedValue() { ++live_count; }
+	CountedValue( uint64_t value ) : value( value ) { ++live_count; }
+	CountedValue( const CountedValue & other ) : value( other.value ) { ++live_count; }
+	CountedValue( CountedValue && other ) noexcept : value( other.value ) { ++live_count; }
+	~CountedValue() { --live_count; }
+	CountedValue & operator=( const CountedValue & other ) = default;
+	CountedValue & operator=( CountedValue && other ) noexcept = default;
+
+	uint64_t value = 0;
+};
+
+} // spsc_queue_test
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SpscQueueContainer, Basic )
+{
+	auto queue = bc::SpscQueue<uint32_t>( 3 );
+	EXPECT_EQ( queue.GetCapacity(), 4 );
+	EXPECT_TRUE( queue.IsEmpty() );
+
+	uint32_t value = 0;
+	EXPECT_FALSE( queue.TryPop( value ) );
+
+	EXPECT_TRUE( queue.TryPush( 1 ) );
+	EXPECT_TRUE( queue.TryPush( 2 ) );
+	EXPECT_TRUE( queue.TryEmplace( 3u ) );
+	EXPECT_TRUE( queue.TryPush( 4 ) );
+	EXPECT_FALSE( queue.TryPush( 5 ) );
+	EXPECT_EQ( queue.ApproximateSize(), 4 );
+
+	EXPECT_TRUE( queue.TryPop( value ) );
+	EXPECT_EQ( value, 1 );
+	EXPECT_TRUE( queue.TryPush( 5 ) );
+
+	for( uint32_t expected = 2; expected <= 5; ++expected )
+	{
+		EXPECT_TRUE( queue.TryPop( value ) );
+		EXPECT_EQ( value, expected );
+	}
+	EXPECT_FALSE( queue.TryPop( value ) );
+	EXPECT_TRUE( queue.IsEmpty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SpscQueueContainer, Batch )
+{
+	auto queue = bc::SpscQueue<uint32_t>( 8 );
+
+	uint32_t source[ 12 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+	EXPECT_EQ( queue.TryPushBatch( source, 5 ), 5 );
+	EXPECT_EQ( queue.TryPushBatch( source + 5, 7 ), 3 );
+	EXPECT_EQ( queue.TryPushBatch( source + 8, 4 ), 0 );
+
+	uint32_t destination[ 12 ] = {};
+	EXPECT_EQ( queue.TryPopBatch( destination, 6 ), 6 );
+	for( uint32_t i = 0; i < 6; ++i ) EXPECT_EQ( destination[ i ], i );
+
+	// Wraps around the end of the ring.
+	EXPECT_EQ( queue.TryPushBatch( source + 8, 4 ), 4 );
+	EXPECT_EQ( queue.TryPopBatch( destination, 12 ), 6 );
+	for( uint32_t i = 0; i < 6; ++i ) EXPECT_EQ( destination[ i ], i + 6 );
+	EXPECT_EQ( queue.TryPopBatch( destination, 12 ), 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SpscQueueContainer, ValueLifetime )
+{
+	using namespace spsc_queue_test;
+
+	{
+		auto queue = bc::SpscQueue<CountedValue>( 16 );
+		for( uint64_t i = 0; i < 10; ++i ) EXPECT_TRUE( queue.TryEmplace( i ) );
+		EXPECT_EQ( CountedValue::live_count, 10 );
+
+		auto value = CountedValue {};
+		EXPECT_TRUE( queue.TryPop( value ) );
+		EXPECT_EQ( value.value, 0 );
+		EXPECT_EQ( CountedValue::live_count, 10 );
+
+		queue.Clear();
+		EXPECT_EQ( CountedValue::live_count, 1 );
+		EXPECT_TRUE( queue.IsEmpty() );
+
+		for( uint64_t i = 0; i < 16; ++i ) EXPECT_TRUE( queue.TryEmplace( i ) );
+		EXPECT_EQ( CountedValue::live_count, 17 );
+	}
+	EXPECT_EQ( CountedValue::live_count, 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SpscQueueContainer, Stress )
+{
+	constexpr uint64_t value_count = 200000;
+
+	auto queue = bc::SpscQueue<uint64_t>( 64 );
+	auto producer = std::thread( [ & ]()
+		{
+			uint64_t batch[ 7 ];
+			uint64_t next = 0;
+			while( next < value_count )
+			{
+				// Alternate single and batch pushes to exercise both paths.
+				if( next % 3 )
+				{
+					if( queue.TryPush( next ) ) ++next;
+					else std::this_thread::yield();
+					continue;
+				}
+				uint64_t batch_count = 0;
+				for( ; batch_count < 7 && next + batch_count < value_count; ++batch_count ) batch[ batch_count ] = next + batch_count;
+				auto pushed_count = queue.TryPushBatch( batch, batch_count );
+				if( pushed_count == 0 ) std::this_thread::yield();
+				next += pushed_count;
+			}
+		}
+	);
+
+	uint64_t expected = 0;
+	uint64_t mismatch_count = 0;
+	uint64_t batch[ 5 ];
+	while( expected < value_count )
+	{
+		auto popped_count = queue.TryPopBatch( batch, 5 );
+		if( popped_count == 0 ) std::this_thread::yield();
+		for( uint64_t i = 0; i < popped_count; ++i )
+		{
+			if( batch[ i ] != expected ) ++mismatch_count;
+			++expected;
+		}
+	}
+	producer.join();
+
+	EXPECT_EQ( mismatch_count, 0 );
+	EXPECT_TRUE( queue.IsEmpty() );
+}
+
+
+
+} // containers
+} // core
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <core/containers/Text.hpp>
+#include <core/containers/simple/SimpleFlatMap.hpp>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SimpleFlatMapContainer, BasicInit )
+{
+	using A = bc::internal_::SimpleFlatMap<uint32_t, uint32_t>;
+	using P = A::ContainedPairType;
+
+	A a;
+	EXPECT_EQ( a.Size(), 0 );
+
+	A b {};
+	EXPECT_EQ( b.Size(), 0 );
+
+	A c = { P( 2, 10 ), P( 1, 5 ) };
+	EXPECT_EQ( c.Size(), 2 );
+	EXPECT_EQ( c.Front().first, 1 );
+	EXPECT_EQ( c[ 1 ], 5 );
+	EXPECT_EQ( c[ 2 ], 10 );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SimpleFlatMapContainer, InsertFindErase )
+{
+	using A = bc::internal_::SimpleFlatMap<uint32_t, uint32_t>;
+
+	A a;
+	for( uint32_t i = 0; i < 100; ++i ) {
+		a.Emplace( 99 - i, i );
+	}
+	EXPECT_EQ( a.Size(), 100 );
+	EXPECT_EQ( a[ 99 ], 0 );
+	EXPECT_EQ( a[ 0 ], 99 );
+
+	a.Erase( 50 );
+	EXPECT_EQ( a.Size(), 99 );
+	EXPECT_EQ( a.Find( 50 ), a.end() );
+
+	A b = a;
+	EXPECT_EQ( a, b );
+};
+
+
+
+} // containers
+} // core
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <core/containers/Text.hpp>
+#include <core/containers/simple/SimpleHashMap.hpp>
+#include <core/containers/simple/SimpleText.hpp>
+
+
+
+namespace core {
+namespace containers {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SimpleHashMapContainer, BasicInit )
+{
+	using A = bc::internal_::SimpleHashMap<uint32_t, uint32_t>;
+	using P = A::ContainedPairType;
+
+	A a;
+	EXPECT_EQ( a.Size(), 0 );
+
+	A b {};
+	EXPECT_EQ( b.Size(), 0 );
+
+	A c = { P( 1, 5 ), P( 2, 10 ) };
+	EXPECT_EQ( c.Size(), 2 );
+	EXPECT_EQ( c[ 1 ], 5 );
+	EXPECT_EQ( c[ 2 ], 10 );
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( SimpleHashMapContainer, InsertFindErase )
+{
+	using A = bc::internal_::SimpleHashMap<bc::internal_::SimpleText, uint32_t>;
+
+	A a;
+	for( uint32_t i = 0; i < 100; ++i ) {
+		auto key = bc::internal_::SimpleText( "key " );
+		key.PushBack( char( 'A' + i % 26 ) );
+		key.PushBack( char( 'A' + i / 26 ) );
+		a.Emplace( std::move( key ), uint32_t( i ) );
+	}
+	EXPECT_EQ( a.Size(), 100 );
+	EXPECT_EQ( a[ "key BA" ], 1 );
+	EXPECT_EQ( a[ "key AB" ], 26 );
+
+	a.Erase( "key AB" );
+	EXPECT_EQ( a.Size(), 99 );
+	EXPECT_EQ( a.Find( "key AB" ), a.end() );
+
+	A b = a;
+	EXPECT_EQ( a, b );
+};
+
+
+
+} // containers
+} // core
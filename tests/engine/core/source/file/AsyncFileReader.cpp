@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+
+#include <core/CoreComponent.hpp>
+#include <core/conversion/text/utf/UTFConversion.hpp>
+#include <core/file/AsyncFileReader.hpp>
+#include <core/thread/ThreadPool.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+
+namespace core {
+namespace file {
+
+
+
+namespace async_file_reader_test {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Creates files in a temporary directory and removes them afterwards.
+class TestFiles
+{
+public:
+	TestFiles()
+	{
+		directory = std::filesystem::temp_directory_path() / ( "bitcrafte_async_file_reader_" + std::to_string( std::rand() ) );
+		std::filesystem::create_directories( directory );
+	}
+
+	~TestFiles()
+	{
+		std::filesystem::remove_all( directory );
+	}
+
+	// Creates a file where byte i is ( i * 7 + seed ) % 251, returns its path.
+	bc::Text32 Create( const std::string & name, size_t size, uint8_t seed = 0 )
+	{
+		auto path = directory / name;
+		auto contents = std::vector<char>( size );
+		for( size_t i = 0; i < size; ++i ) contents[ i ] = char( ExpectedByte( i, seed ) );
+		std::ofstream( path, std::ios::binary ).write( contents.data(), std::streamsize( size ) );
+		return ToText32( path );
+	}
+
+	bc::Text32 GetMissingPath()
+	{
+		return ToText32( directory / "missing.bin" );
+	}
+
+	static uint8_t ExpectedByte( size_t index, uint8_t seed )
+	{
+		return uint8_t( ( index * 7 + seed ) % 251 );
+	}
+
+	static bool ContentsMatch( const bc::file::FileReadHandle & handle, size_t offset, uint8_t seed = 0 )
+	{
+		for( size_t i = 0; i < handle.GetSize(); ++i )
+		{
+			if( handle.GetData()[ i ] != ExpectedByte( offset + i, seed ) ) return false;
+		}
+		return true;
+	}
+
+private:
+	static bc::Text32 ToText32( const std::filesystem::path & path )
+	{
+		auto path_text = path.string();
+		return bc::conversion::ToUTF32( bc::TextView( path_text.data(), path_text.size() ) );
+	}
+
+	std::filesystem::path directory;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class TestThread : public bc::thread::Thread
+{
+public:
+	TestThread() = default;
+	void ThreadBegin() override {}
+	void ThreadEnd() noexcept override {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+std::unique_ptr<bc::CoreComponent> CreateCoreWithWorkers()
+{
+	auto core_create_info = bc::CoreComponentCreateInfo {};
+	core_create_info.logger_create_info.disabled = true;
+	auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+	for( size_t i = 0; i < 2; ++i ) core->GetThreadPool()->AddThread<TestThread>();
+	return core;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Runs a test once with io_uring and once with the blocking fallback.
+template<typename TestFunctionType>
+void ForEachReaderKind( TestFunctionType && test_function )
+{
+	for( auto use_io_uring : { true, false } )
+	{
+		auto core = CreateCoreWithWorkers();
+		auto create_info = bc::file::AsyncFileReaderCreateInfo {};
+		create_info.use_io_uring = use_io_uring;
+		{
+			auto reader = bc::file::AsyncFileReader( *core->GetThreadPool(), create_info );
+			if( !use_io_uring ) EXPECT_FALSE( reader.IsUsingIoUring() );
+			test_function( reader );
+		}
+		core->GetThreadPool()->WaitIdle();
+	}
+}
+
+} // async_file_reader_test
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReader, ReadWholeFile )
+{
+	using namespace async_file_reader_test;
+
+	auto files = TestFiles {};
+	auto small_path = files.Create( "small.bin", 1000, 3 );
+	auto large_path = files.Create( "large.bin", 5'000'000, 5 );
+	auto empty_path = files.Create( "empty.bin", 0 );
+
+	ForEachReaderKind( [ & ]( bc::file::AsyncFileReader & reader )
+		{
+			auto small = reader.ReadFileAsync( small_path );
+			auto large = reader.ReadFileAsync( large_path );
+			auto empty = reader.ReadFileAsync( empty_path );
+			small.Wait();
+			large.Wait();
+			empty.Wait();
+
+			EXPECT_TRUE( small.IsDone() );
+			EXPECT_FALSE( small.HasFailed() );
+			EXPECT_EQ( small.GetSize(), 1000 );
+			EXPECT_TRUE( TestFiles::ContentsMatch( small, 0, 3 ) );
+
+			EXPECT_FALSE( large.HasFailed() );
+			EXPECT_EQ( large.GetSize(), 5'000'000 );
+			EXPECT_TRUE( TestFiles::ContentsMatch( large, 0, 5 ) );
+
+			EXPECT_TRUE( empty.IsDone() );
+			EXPECT_FALSE( empty.HasFailed() );
+			EXPECT_EQ( empty.GetSize(), 0 );
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReader, ReadRange )
+{
+	using namespace async_file_reader_test;
+
+	auto files = TestFiles {};
+	auto path = files.Create( "range.bin", 10000, 11 );
+
+	ForEachReaderKind( [ & ]( bc::file::AsyncFileReader & reader )
+		{
+			auto middle = reader.ReadFileAsync( path, 1234, 500 );
+			auto tail = reader.ReadFileAsync( path, 9000 );
+			auto past_end = reader.ReadFileAsync( path, 9900, 1000 );
+			auto beyond_end = reader.ReadFileAsync( path, 20000, 10 );
+
+			middle.Wait();
+			EXPECT_EQ( middle.GetSize(), 500 );
+			EXPECT_TRUE( TestFiles::ContentsMatch( middle, 1234, 11 ) );
+
+			tail.Wait();
+			EXPECT_EQ( tail.GetSize(), 1000 );
+			EXPECT_TRUE( TestFiles::ContentsMatch( tail, 9000, 11 ) );
+
+			// Reads stop at the end of the file.
+			past_end.Wait();
+			EXPECT_FALSE( past_end.HasFailed() );
+			EXPECT_EQ( past_end.GetSize(), 100 );
+			EXPECT_TRUE( TestFiles::ContentsMatch( past_end, 9900, 11 ) );
+
+			beyond_end.Wait();
+			EXPECT_FALSE( beyond_end.HasFailed() );
+			EXPECT_EQ( beyond_end.GetSize(), 0 );
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReader, ReadIntoDestination )
+{
+	using namespace async_file_reader_test;
+
+	auto files = TestFiles {};
+	auto path = files.Create( "destination.bin", 4096, 17 );
+
+	ForEachReaderKind( [ & ]( bc::file::AsyncFileReader & reader )
+		{
+			auto destination = std::vector<uint8_t>( 2000, 0 );
+			auto handle = reader.ReadFileAsync( path, 100, destination.size(), destination.data() );
+			handle.Wait();
+
+			EXPECT_EQ( handle.GetData(), destination.data() );
+			EXPECT_EQ( handle.GetSize(), 2000 );
+			EXPECT_TRUE( TestFiles::ContentsMatch( handle, 100, 17 ) );
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReader, MissingFile )
+{
+	using namespace async_file_reader_test;
+
+	auto files = TestFiles {};
+	auto path = files.GetMissingPath();
+
+	ForEachReaderKind( [ & ]( bc::file::AsyncFileReader & reader )
+		{
+			auto handle = reader.ReadFileAsync( path );
+			EXPECT_TRUE( handle.IsDone() );
+			EXPECT_TRUE( handle.HasFailed() );
+			EXPECT_NE( handle.GetErrorCode(), 0 );
+			EXPECT_EQ( handle.GetSize(), 0 );
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReader, ReadManyFiles )
+{
+	using namespace async_file_reader_test;
+
+	// More files than the queue depth, some reads wait in the pending list.
+	constexpr size_t file_count = 600;
+
+	auto files = TestFiles {};
+	auto paths = std::vector<bc::Text32> {};
+	for( size_t i = 0; i < file_count; ++i ) paths.push_back( files.Create( std::to_string( i ) + ".bin", 100 + i * 13, uint8_t( i ) ) );
+
+	ForEachReaderKind( [ & ]( bc::file::AsyncFileReader & reader )
+		{
+			auto requests = bc::List<bc::file::FileReadRequest> {};
+			for( auto & path : paths ) requests.PushBack( bc::file::FileReadRequest { path } );
+			auto handles = reader.ReadFilesAsync( requests );
+			ASSERT_EQ( handles.Size(), file_count );
+
+			size_t mismatch_count = 0;
+			for( size_t i = 0; i < file_count; ++i )
+			{
+				handles[ i ].Wait();
+				if( handles[ i ].HasFailed() || handles[ i ].GetSize() != 100 + i * 13 ) ++mismatch_count;
+				else if( !TestFiles::ContentsMatch( handles[ i ], 0, uint8_t( i ) ) ) ++mismatch_count;
+			}
+			EXPECT_EQ( mismatch_count, 0 );
+
+			// Handles are released here, their pooled buffers are reused by the next reads.
+			handles.Clear();
+			auto handle = reader.ReadFileAsync( paths[ 1 ] );
+			handle.Wait();
+			EXPECT_TRUE( TestFiles::ContentsMatch( handle, 0, 1 ) );
+		}
+	);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( AsyncFileReader, CoroutineAwait )
+{
+	using namespace async_file_reader_test;
+
+	auto files = TestFiles {};
+	auto paths = std::vector<bc::Text32> {};
+	for( size_t i = 0; i < 16; ++i ) paths.push_back( files.Create( std::to_string( i ) + ".bin", 50000, uint8_t( i ) ) );
+
+	ForEachReaderKind( [ & ]( bc::file::AsyncFileReader & reader )
+		{
+			auto core = bc::GetCore();
+			auto thread_pool = core->GetThreadPool();
+
+			auto match_count = std::atomic<size_t> { 0 };
+			for( size_t i = 0; i < paths.size(); ++i )
+			{
+				thread_pool->ScheduleCoroutineTask( [ &reader, &paths, &match_count, i ]() -> bc::thread::CoroutineTask
+					{
+						auto handle = reader.ReadFileAsync( paths[ i ] );
+						co_await handle;
+						if( handle.IsDone() && handle.GetSize() == 50000 && TestFiles::ContentsMatch( handle, 0, uint8_t( i ) ) )
+						{
+							++match_count;
+						}
+					}
+				);
+			}
+			thread_pool->WaitIdle();
+			EXPECT_EQ( match_count, paths.size() );
+		}
+	);
+}
+
+
+
+} // file
+} // core
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <core/memory/allocator/LinearArena.hpp>
+#include <core/containers/List.hpp>
+#include <core/containers/Map.hpp>
+#include <core/containers/Text.hpp>
+
+#include <tuple>
+#include <vector>
+
+
+
+namespace core {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArena, AllocateAndReset )
+{
+	auto arena = bc::memory::LinearArena( 1024 );
+	EXPECT_EQ( arena.GetReservedSize(), 0 );
+
+	auto first = reinterpret_cast<uint8_t*>( arena.Allocate( 3, 1 ) );
+	auto second = reinterpret_cast<uint64_t*>( arena.Allocate( 4 * sizeof( uint64_t ), alignof( uint64_t ) ) );
+	auto third = reinterpret_cast<uint8_t*>( arena.Allocate( 100, 64 ) );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( second ) % alignof( uint64_t ), 0 );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( third ) % 64, 0 );
+	EXPECT_GT( reinterpret_cast<uint8_t*>( second ), first + 2 );
+	EXPECT_GE( third, reinterpret_cast<uint8_t*>( second + 4 ) );
+	EXPECT_EQ( arena.GetReservedSize(), 1024 );
+	EXPECT_GE( arena.GetUsedSize(), 3 + 4 * sizeof( uint64_t ) + 100 );
+
+	arena.Reset();
+	EXPECT_EQ( arena.GetUsedSize(), 0 );
+	EXPECT_EQ( arena.Allocate( 3, 1 ), first );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArena, ChainedBlocksMergeOnReset )
+{
+	auto arena = bc::memory::LinearArena( 1024 );
+
+	// Fill more than one block, including an allocation larger than a block.
+	auto allocations = std::vector<std::pair<uint8_t*, uint64_t>> {};
+	for( uint64_t i = 0; i < 20; ++i )
+	{
+		auto size = i == 10 ? uint64_t( 5000 ) : uint64_t( 200 );
+		auto data = reinterpret_cast<uint8_t*>( arena.Allocate( size, 16 ) );
+		for( uint64_t j = 0; j < size; ++j ) data[ j ] = uint8_t( i );
+		allocations.push_back( { data, size } );
+	}
+	for( uint64_t i = 0; i < allocations.size(); ++i )
+	{
+		auto [ data, size ] = allocations[ i ];
+		for( uint64_t j = 0; j < size; ++j ) ASSERT_EQ( data[ j ], uint8_t( i ) );
+	}
+
+	auto reserved_size = arena.GetReservedSize();
+	EXPECT_GT( reserved_size, 1024 );
+
+	// Next frame of the same size fits in the single merged block.
+	arena.Reset();
+	EXPECT_EQ( arena.GetReservedSize(), reserved_size );
+	for( uint64_t i = 0; i < 20; ++i ) std::ignore = arena.Allocate( i == 10 ? 5000 : 200, 16 );
+	EXPECT_EQ( arena.GetReservedSize(), reserved_size );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArena, ResizeAndFreeMostRecent )
+{
+	auto arena = bc::memory::LinearArena( 1024 );
+
+	auto first = arena.Allocate( 16, 8 );
+	auto second = arena.Allocate( 16, 8 );
+	EXPECT_FALSE( arena.IsResizeableInPlace( first, 32 ) );
+	EXPECT_TRUE( arena.IsResizeableInPlace( second, 32 ) );
+	EXPECT_FALSE( arena.IsResizeableInPlace( second, 2048 ) );
+
+	arena.ResizeInPlace( second, 32 );
+	auto used_size = arena.GetUsedSize();
+
+	// Freeing anything but the most recent allocation does nothing.
+	arena.Free( first, 16 );
+	EXPECT_EQ( arena.GetUsedSize(), used_size );
+
+	arena.Free( second, 32 );
+	EXPECT_EQ( arena.GetUsedSize(), used_size - 32 );
+	EXPECT_EQ( arena.Allocate( 16, 8 ), second );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArena, ArenaList )
+{
+	auto arena = bc::memory::LinearArena( 4096 );
+	{
+		auto list = bc::ArenaList<uint32_t>( &arena );
+		EXPECT_EQ( list.GetAllocator().GetArena(), &arena );
+
+		// Only allocation in the arena, grows in place without moving.
+		list.PushBack( 0 );
+		auto data = list.Data();
+		for( uint32_t i = 1; i < 500; ++i ) list.PushBack( i );
+		EXPECT_EQ( list.Data(), data );
+		for( uint32_t i = 0; i < 500; ++i ) ASSERT_EQ( list[ i ], i );
+
+		// Copies and moves keep allocating from the same arena.
+		auto copy = list;
+		EXPECT_EQ( copy.GetAllocator().GetArena(), &arena );
+		EXPECT_EQ( copy, list );
+
+		auto moved = std::move( copy );
+		EXPECT_EQ( moved.GetAllocator().GetArena(), &arena );
+		EXPECT_EQ( moved.Size(), 500 );
+
+		// Growing past the block moves the list to a new block.
+		for( uint32_t i = 500; i < 5000; ++i ) list.PushBack( i );
+		for( uint32_t i = 0; i < 5000; ++i ) ASSERT_EQ( list[ i ], i );
+
+		// Views are shared with heap lists.
+		auto heap_list = bc::List<uint32_t>( bc::ListView<uint32_t>( list ) );
+		EXPECT_EQ( heap_list.Size(), 5000 );
+		EXPECT_EQ( heap_list[ 4999 ], 4999 );
+	}
+	arena.Reset();
+	EXPECT_EQ( arena.GetUsedSize(), 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArena, ArenaListNonTrivial )
+{
+	auto arena = bc::memory::LinearArena();
+	{
+		auto list = bc::ArenaList<bc::Text>( &arena );
+		for( uint64_t i = 0; i < 100; ++i ) list.PushBack( bc::Text( 'a', i + 1 ) );
+		list.Erase( list.begin() + 10 );
+		list.Insert( list.begin(), bc::Text { "inserted" } );
+		EXPECT_EQ( list.Size(), 100 );
+		EXPECT_EQ( list[ 0 ], "inserted" );
+		EXPECT_EQ( list[ 1 ].Size(), 1 );
+		EXPECT_EQ( list[ 11 ].Size(), 12 );
+	}
+	arena.Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArena, ArenaTextAndMap )
+{
+	auto arena = bc::memory::LinearArena();
+	{
+		auto text = bc::ArenaText( &arena );
+		text = "scratch";
+		text += " text";
+		EXPECT_EQ( text, "scratch text" );
+		EXPECT_EQ( text.GetAllocator().GetArena(), &arena );
+
+		auto map = bc::ArenaMap<uint32_t, uint32_t>( &arena );
+		for( uint32_t i = 0; i < 1000; ++i ) map.Insert( bc::Pair( i, i * 2 ) );
+		EXPECT_EQ( map.Size(), 1000 );
+		for( uint32_t i = 0; i < 1000; ++i ) ASSERT_EQ( map[ i ], i * 2 );
+		map.Erase( 500 );
+		EXPECT_EQ( map.Size(), 999 );
+		EXPECT_EQ( map.Find( 500 ), map.end() );
+
+		// Copy assignment copies the allocator along with the contents, like the copy constructor.
+		auto other_arena = bc::memory::LinearArena( 4096 );
+		auto assigned = bc::ArenaMap<uint32_t, uint32_t>( &other_arena );
+		assigned.Insert( bc::Pair( 5000u, 1u ) );
+		assigned = map;
+		EXPECT_EQ( assigned.GetAllocator().GetArena(), &arena );
+		EXPECT_EQ( assigned, map );
+
+		auto copy = map;
+		EXPECT_EQ( copy.GetAllocator().GetArena(), &arena );
+
+		auto moved = bc::ArenaMap<uint32_t, uint32_t>( &other_arena );
+		moved = std::move( copy );
+		EXPECT_EQ( moved.GetAllocator().GetArena(), &arena );
+		EXPECT_EQ( moved.Size(), 999 );
+	}
+	arena.Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( LinearArena, ArenaListWithoutArena )
+{
+	// Without an arena, allocations go to the engine heap.
+	auto list = bc::ArenaList<uint32_t> {};
+	EXPECT_EQ( list.GetAllocator().GetArena(), nullptr );
+	for( uint32_t i = 0; i < 1000; ++i ) list.PushBack( i );
+	EXPECT_TRUE( bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( list.Data() ) );
+}
+
+
+
+} // memory
+} // core
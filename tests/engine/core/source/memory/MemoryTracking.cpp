@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <core/memory/raw/RawMemory.hpp>
+#include <core/memory/tracking/MemoryTracking.hpp>
+#include <core/containers/List.hpp>
+
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace memory {
+
+
+
+#if BITCRAFTE_GAME_DEVELOPMENT_BUILD
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MemoryTracking, NestedTagScopes )
+{
+	EXPECT_EQ( bc::memory::GetCurrentMemoryTag(), bc::memory::MemoryTag::UNTAGGED );
+	{
+		auto outer_scope = bc::memory::MemoryTagScope( bc::memory::MemoryTag::SCENE );
+		EXPECT_EQ( bc::memory::GetCurrentMemoryTag(), bc::memory::MemoryTag::SCENE );
+		{
+			auto inner_scope = bc::memory::MemoryTagScope( bc::memory::MemoryTag::RHI );
+			EXPECT_EQ( bc::memory::GetCurrentMemoryTag(), bc::memory::MemoryTag::RHI );
+		}
+		EXPECT_EQ( bc::memory::GetCurrentMemoryTag(), bc::memory::MemoryTag::SCENE );
+	}
+	EXPECT_EQ( bc::memory::GetCurrentMemoryTag(), bc::memory::MemoryTag::UNTAGGED );
+
+	// Scopes only affect the thread they were created on.
+	auto scope = bc::memory::MemoryTagScope( bc::memory::MemoryTag::SCENE );
+	auto other_thread_tag = bc::memory::MemoryTag::GAME;
+	std::thread( [ & ]() { other_thread_tag = bc::memory::GetCurrentMemoryTag(); } ).join();
+	EXPECT_EQ( other_thread_tag, bc::memory::MemoryTag::UNTAGGED );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MemoryTracking, AllocationsAreTagged )
+{
+	uint8_t * scoped = nullptr;
+	{
+		auto scope = bc::memory::MemoryTagScope( bc::memory::MemoryTag::SCENE );
+		scoped = bc::memory::AllocateMemory<uint8_t>( 100, 1 );
+	}
+	auto explicit_tag = bc::memory::AllocateMemory<uint8_t>( 100, 1, bc::memory::MemoryTag::RHI );
+	auto untagged = bc::memory::AllocateMemory<uint8_t>( 100, 1 );
+
+	EXPECT_EQ( bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( scoped )->tag, bc::memory::MemoryTag::SCENE );
+	EXPECT_EQ( bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( explicit_tag )->tag, bc::memory::MemoryTag::RHI );
+	EXPECT_EQ( bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( untagged )->tag, bc::memory::MemoryTag::UNTAGGED );
+
+	// Reallocation keeps the original tag, both in place and when moved.
+	scoped = bc::memory::ReallocateMemory( scoped, 100, 110 );
+	EXPECT_EQ( bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( scoped )->tag, bc::memory::MemoryTag::SCENE );
+	scoped = bc::memory::ReallocateMemory( scoped, 110, 100000 );
+	EXPECT_EQ( bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( scoped )->tag, bc::memory::MemoryTag::SCENE );
+
+	bc::memory::FreeMemory( scoped, 100000 );
+	bc::memory::FreeMemory( explicit_tag, 100 );
+	bc::memory::FreeMemory( untagged, 100 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MemoryTracking, LiveStatistics )
+{
+	auto tag = bc::memory::MemoryTag::EDITOR;
+	auto before = bc::memory::GetMemoryStatisticsSnapshot()[ tag ];
+
+	auto allocations = std::vector<uint8_t*> {};
+	uint64_t allocated_size = 0;
+	{
+		auto scope = bc::memory::MemoryTagScope( tag );
+		for( uint64_t i = 1; i <= 1000; ++i )
+		{
+			allocations.push_back( bc::memory::AllocateMemory<uint8_t>( i * 10, 1 ) );
+			allocated_size += i * 10;
+		}
+	}
+
+	auto during = bc::memory::GetMemoryStatisticsSnapshot()[ tag ];
+	EXPECT_EQ( during.live_size - before.live_size, allocated_size );
+	EXPECT_EQ( during.live_allocation_count - before.live_allocation_count, 1000 );
+	EXPECT_EQ( during.total_allocation_count - before.total_allocation_count, 1000 );
+	EXPECT_GE( during.peak_live_size, during.live_size );
+
+	// Resizing changes the live size without adding an allocation.
+	allocations[ 0 ] = bc::memory::ReallocateMemory( allocations[ 0 ], 10, 50 );
+	auto resized = bc::memory::GetMemoryStatisticsSnapshot()[ tag ];
+	EXPECT_EQ( resized.live_size - during.live_size, 40 );
+	EXPECT_EQ( resized.live_allocation_count, during.live_allocation_count );
+	allocated_size += 40;
+
+	// Free half on another thread, the freeing thread is charged for it.
+	std::thread( [ & ]()
+		{
+			for( uint64_t i = 0; i < 500; ++i ) bc::memory::FreeMemory( allocations[ i ], 1 );
+		}
+	).join();
+	for( uint64_t i = 500; i < 1000; ++i ) bc::memory::FreeMemory( allocations[ i ], 1 );
+
+	auto after = bc::memory::GetMemoryStatisticsSnapshot()[ tag ];
+	EXPECT_EQ( after.live_size, before.live_size );
+	EXPECT_EQ( after.live_allocation_count, before.live_allocation_count );
+	EXPECT_EQ( after.total_allocation_count - before.total_allocation_count, 1000 );
+	EXPECT_GE( after.peak_live_size, before.live_size + allocated_size );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MemoryTracking, ContainersInTagScope )
+{
+	auto tag = bc::memory::MemoryTag::UI;
+	auto before = bc::memory::GetMemoryStatisticsSnapshot()[ tag ];
+	{
+		auto scope = bc::memory::MemoryTagScope( tag );
+		auto list = bc::List<uint64_t> {};
+		for( uint64_t i = 0; i < 1000; ++i ) list.PushBack( i );
+
+		EXPECT_GE( bc::memory::GetMemoryStatisticsSnapshot()[ tag ].live_size - before.live_size, 1000 * sizeof( uint64_t ) );
+	}
+	EXPECT_EQ( bc::memory::GetMemoryStatisticsSnapshot()[ tag ].live_size, before.live_size );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MemoryTracking, LeakReport )
+{
+	auto baseline = bc::memory::GetMemoryStatisticsSnapshot();
+	EXPECT_FALSE( bc::memory::internal_::ReportMemoryLeaks( baseline ) );
+
+	auto leak = bc::memory::AllocateMemory<uint8_t>( 64, 1, bc::memory::MemoryTag::GAME );
+	EXPECT_TRUE( bc::memory::internal_::ReportMemoryLeaks( baseline ) );
+
+	bc::memory::FreeMemory( leak, 64 );
+	EXPECT_FALSE( bc::memory::internal_::ReportMemoryLeaks( baseline ) );
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MemoryTracking, CompiledOut )
+{
+	auto scope = bc::memory::MemoryTagScope( bc::memory::MemoryTag::SCENE );
+	EXPECT_EQ( bc::memory::GetCurrentMemoryTag(), bc::memory::MemoryTag::UNTAGGED );
+
+	auto data = bc::memory::AllocateMemory<uint8_t>( 100, 1, bc::memory::MemoryTag::SCENE );
+	EXPECT_EQ( bc::memory::GetMemoryStatisticsSnapshot()[ bc::memory::MemoryTag::SCENE ].live_size, 0 );
+	EXPECT_FALSE( bc::memory::internal_::ReportMemoryLeaks( {} ) );
+	bc::memory::FreeMemory( data, 100 );
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( MemoryTracking, MemoryTagToText )
+{
+	EXPECT_EQ( bc::memory::MemoryTagToText( bc::memory::MemoryTag::UNTAGGED ), "UNTAGGED" );
+	EXPECT_EQ( bc::memory::MemoryTagToText( bc::memory::MemoryTag::GAME ), "GAME" );
+}
+
+
+
+} // memory
+} // core
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <core/memory/raw/RawMemory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemory, AllocateSizesAndAlignments )
+{
+	auto sizes = std::vector<uint64_t> { 1, 7, 64, 100, 129, 256, 257, 1000, 4096, 70000, 262144, 262145, 1000000, 3000000 };
+	auto alignments = std::vector<uint64_t> { 1, 8, 64, 256, 4096, 0x8000 };
+	auto allocations = std::vector<std::pair<uint8_t*, uint64_t>> {};
+
+	for( auto size : sizes )
+	{
+		for( auto alignment : alignments )
+		{
+			auto data = bc::memory::AllocateMemory<uint8_t>( size, alignment );
+			ASSERT_NE( data, nullptr );
+			EXPECT_EQ( reinterpret_cast<uintptr_t>( data ) % alignment, 0 );
+
+			auto header = bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( data );
+			ASSERT_TRUE( header );
+			EXPECT_EQ( header->payload_size, size );
+			EXPECT_GE( header->system_allocation_size, bc::memory::internal_::CalculateMinimumRequiredSystemMemoryAllocationSize( size, alignment ) );
+
+			for( uint64_t i = 0; i < size; ++i ) data[ i ] = uint8_t( i + size );
+			allocations.push_back( { data, size } );
+		}
+	}
+
+	// Check that no allocation overlapped another.
+	for( auto & [ data, size ] : allocations )
+	{
+		for( uint64_t i = 0; i < size; ++i ) ASSERT_EQ( data[ i ], uint8_t( i + size ) );
+		bc::memory::FreeMemory( data, size );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemory, SmallAllocationHeader )
+{
+	auto data = bc::memory::AllocateMemory<uint32_t>( 3, alignof( uint32_t ) );
+	auto header = bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( data );
+	ASSERT_TRUE( header );
+	EXPECT_EQ( header->payload_location, data );
+	EXPECT_EQ( header->payload_size, 3 * sizeof( uint32_t ) );
+
+	auto header_size = reinterpret_cast<uintptr_t>( data ) - reinterpret_cast<uintptr_t>( header->system_allocated_location );
+	if( bc::memory::internal_::IsCompactMemoryAllocationHeaderUsed( header->system_allocation_size, alignof( uint32_t ) ) )
+	{
+		EXPECT_EQ( header_size, sizeof( bc::memory::internal_::CompactMemoryAllocationHeader ) );
+		EXPECT_EQ( header->system_allocation_size, 64 );
+	}
+	else
+	{
+		EXPECT_EQ( header_size, sizeof( bc::memory::internal_::MemoryAllocationHeader ) );
+	}
+
+	// Growing and shrinking in place keeps the payload and the header kind.
+	for( uint32_t i = 0; i < 3; ++i ) data[ i ] = i;
+	ASSERT_TRUE( bc::memory::IsInPlaceReallocateable( data, 4 ) );
+	EXPECT_EQ( bc::memory::InPlaceReallocateMemory( data, 3, 4 ), data );
+	EXPECT_EQ( bc::memory::InPlaceReallocateMemory( data, 4, 1 ), data );
+
+	auto resized_header = bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( data );
+	ASSERT_TRUE( resized_header );
+	EXPECT_EQ( resized_header->payload_size, sizeof( uint32_t ) );
+	EXPECT_EQ( resized_header->system_allocated_location, header->system_allocated_location );
+	EXPECT_EQ( resized_header->system_allocation_size, header->system_allocation_size );
+	EXPECT_EQ( data[ 0 ], 0 );
+
+	bc::memory::FreeMemory( data, 1 );
+
+	// Over aligned allocations always use the full header.
+	auto aligned_data = bc::memory::AllocateMemory<uint8_t>( 8, 64 );
+	auto aligned_header = bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( aligned_data );
+	ASSERT_TRUE( aligned_header );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( aligned_data ) - reinterpret_cast<uintptr_t>( aligned_header->system_allocated_location ), sizeof( bc::memory::internal_::MemoryAllocationHeader ) );
+	bc::memory::FreeMemory( aligned_data, 8 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemory, ReuseFreedMemory )
+{
+	auto first = bc::memory::AllocateMemory<uint32_t>( 50, alignof( uint32_t ) );
+	bc::memory::FreeMemory( first, 50 );
+
+	auto second = bc::memory::AllocateMemory<uint32_t>( 50, alignof( uint32_t ) );
+	EXPECT_EQ( first, second );
+	bc::memory::FreeMemory( second, 50 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemory, Reallocate )
+{
+	auto data = bc::memory::AllocateMemory<uint32_t>( 3, alignof( uint32_t ) );
+	for( uint32_t i = 0; i < 3; ++i ) data[ i ] = i;
+
+	// Small allocations are rounded up to their size class, growing within the class does not move the payload.
+	EXPECT_TRUE( bc::memory::IsInPlaceReallocateable( data, 8 ) );
+	auto in_place = bc::memory::InPlaceReallocateMemory( data, 3, 8 );
+	EXPECT_EQ( in_place, data );
+	EXPECT_EQ( bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( data )->payload_size, 8 * sizeof( uint32_t ) );
+
+	uint64_t count = 8;
+	for( uint64_t new_count : { uint64_t( 1000 ), uint64_t( 100000 ), uint64_t( 1000 ), uint64_t( 5 ) } )
+	{
+		data = bc::memory::ReallocateMemory( data, count, new_count );
+		for( uint32_t i = 0; i < 3; ++i ) ASSERT_EQ( data[ i ], i );
+		for( uint64_t i = 3; i < new_count; ++i ) data[ i ] = uint32_t( i );
+		count = new_count;
+	}
+	bc::memory::FreeMemory( data, count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemory, ReallocateLarge )
+{
+	// Large allocations are remapped by the operating system when possible, alignments above the page size are copied instead.
+	for( uint64_t alignment : { uint64_t( 8 ), uint64_t( 4096 ), uint64_t( 0x8000 ) } )
+	{
+		uint64_t count = 100000;
+		auto data = bc::memory::AllocateMemory<uint64_t>( count, alignment );
+		for( uint64_t i = 0; i < count; ++i ) data[ i ] = i * 3;
+
+		for( uint64_t new_count : { uint64_t( 1000000 ), uint64_t( 8000000 ), uint64_t( 500000 ), uint64_t( 9000000 ) } )
+		{
+			data = bc::memory::ReallocateMemory( data, count, new_count );
+			EXPECT_EQ( reinterpret_cast<uintptr_t>( data ) % alignment, 0 );
+
+			auto header = bc::memory::internal_::GetMemoryAllocationHeaderFromUserPointer( data );
+			ASSERT_TRUE( header );
+			EXPECT_EQ( header->payload_size, new_count * sizeof( uint64_t ) );
+			EXPECT_EQ( header->payload_alignment_requirement, alignment );
+
+			auto common_count = std::min( count, new_count );
+			for( uint64_t i = 0; i < common_count; ++i ) ASSERT_EQ( data[ i ], i * 3 );
+			for( uint64_t i = common_count; i < new_count; ++i ) data[ i ] = i * 3;
+			count = new_count;
+		}
+		bc::memory::FreeMemory( data, count );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( RawMemory, Stress )
+{
+	constexpr uint64_t THREAD_COUNT				= 4;
+	constexpr uint64_t ALLOCATIONS_PER_THREAD	= 20000;
+
+	// Every thread allocates, half of the allocations are freed by the next thread to exercise cross thread frees.
+	auto handed_over = std::vector<std::vector<std::pair<uint64_t*, uint64_t>>>( THREAD_COUNT );
+	auto threads = std::vector<std::thread> {};
+	auto errors = std::atomic<uint64_t> { 0 };
+	auto ready_count = std::atomic<uint64_t> { 0 };
+
+	for( uint64_t t = 0; t < THREAD_COUNT; ++t )
+	{
+		threads.emplace_back( [ &, t ]()
+			{
+				auto kept = std::vector<std::pair<uint64_t*, uint64_t>> {};
+				uint64_t random = t * 7919 + 1;
+				for( uint64_t i = 0; i < ALLOCATIONS_PER_THREAD; ++i )
+				{
+					random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+					auto count = 1 + ( random >> 33 ) % ( i % 100 == 0 ? 40000 : 200 );
+					auto data = bc::memory::AllocateMemory<uint64_t>( count, alignof( uint64_t ) );
+					for( uint64_t j = 0; j < count; ++j ) data[ j ] = uint64_t( data ) + j;
+					if( i % 2 ) handed_over[ t ].push_back( { data, count } );
+					else kept.push_back( { data, count } );
+
+					if( kept.size() > 64 )
+					{
+						auto [ old_data, old_count ] = kept.front();
+						for( uint64_t j = 0; j < old_count; ++j ) if( old_data[ j ] != uint64_t( old_data ) + j ) ++errors;
+						bc::memory::FreeMemory( old_data, old_count );
+						kept.erase( kept.begin() );
+					}
+				}
+				for( auto & [ data, count ] : kept ) bc::memory::FreeMemory( data, count );
+
+				++ready_count;
+				while( ready_count < THREAD_COUNT ) std::this_thread::yield();
+
+				for( auto & [ data, count ] : handed_over[ ( t + 1 ) % THREAD_COUNT ] )
+				{
+					for( uint64_t j = 0; j < count; ++j ) if( data[ j ] != uint64_t( data ) + j ) ++errors;
+					bc::memory::FreeMemory( data, count );
+				}
+			}
+		);
+	}
+	for( auto & thread : threads ) thread.join();
+
+	EXPECT_EQ( errors, 0 );
+}
+
+
+
+} // memory
+} // core
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <core/memory/allocator/StackAllocator.hpp>
+#include <core/containers/List.hpp>
+#include <core/containers/Text.hpp>
+
+#include <tuple>
+
+
+
+namespace core {
+namespace memory {
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( StackAllocator, Markers )
+{
+	auto stack = bc::memory::StackAllocator( 4096 );
+	EXPECT_EQ( stack.GetCapacity(), 4096 );
+	EXPECT_EQ( stack.GetUsedSize(), 0 );
+
+	auto first = stack.Allocate( 100, 8 );
+	auto marker = stack.GetMarker();
+	EXPECT_EQ( marker, 100 );
+
+	auto second = stack.Allocate( 200, 64 );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( second ) % 64, 0 );
+	std::ignore = stack.Allocate( 300, 16 );
+	EXPECT_GE( stack.GetUsedSize(), 600 );
+
+	// Everything after the marker is freed, the next allocation reuses the same memory.
+	stack.RewindToMarker( marker );
+	EXPECT_EQ( stack.GetUsedSize(), 100 );
+	EXPECT_EQ( stack.Allocate( 200, 64 ), second );
+
+	stack.RewindToMarker( 0 );
+	EXPECT_EQ( stack.Allocate( 100, 8 ), first );
+	stack.RewindToMarker( 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( StackAllocator, NestedScopes )
+{
+	auto stack = bc::memory::StackAllocator( 4096 );
+	{
+		auto outer_scope = bc::memory::StackAllocatorScope( stack );
+		std::ignore = stack.Allocate( 128, 8 );
+		{
+			auto inner_scope = bc::memory::StackAllocatorScope( stack );
+			std::ignore = stack.Allocate( 1024, 8 );
+			EXPECT_EQ( stack.GetUsedSize(), 128 + 1024 );
+		}
+		EXPECT_EQ( stack.GetUsedSize(), 128 );
+	}
+	EXPECT_EQ( stack.GetUsedSize(), 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( StackAllocator, StackContainers )
+{
+	auto stack = bc::memory::StackAllocator( 64 * 1024 );
+	{
+		auto scope = bc::memory::StackAllocatorScope( stack );
+
+		auto list = bc::StackList<uint64_t>( &stack );
+		list.PushBack( 0 );
+		auto data = list.Data();
+		for( uint64_t i = 1; i < 1000; ++i ) list.PushBack( i * i );
+		EXPECT_EQ( list.Size(), 1000 );
+		EXPECT_EQ( list[ 999 ], 999 * 999 );
+		EXPECT_EQ( list.GetAllocator().GetArena(), &stack );
+
+		// Growing the most recent allocation happens in place.
+		EXPECT_EQ( list.Data(), data );
+		EXPECT_GE( stack.GetUsedSize(), 1000 * sizeof( uint64_t ) );
+
+		auto text = bc::StackText32( &stack );
+		text = U"Stack text";
+		text += U" grows";
+		EXPECT_EQ( text, U"Stack text grows" );
+	}
+	EXPECT_EQ( stack.GetUsedSize(), 0 );
+}
+
+
+
+} // memory
+} // core
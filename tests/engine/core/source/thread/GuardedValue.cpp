@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <core/thread/GuardedValue.hpp>
+#include <core/thread/SharedGuardedValue.hpp>
+#include <core/thread/SeqLockGuardedValue.hpp>
+#include <core/thread/RcuGuardedValue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+
+namespace core {
+namespace thread {
+
+
+
+namespace guarded_value_test {
+
+constexpr size_t reader_count = 4;
+constexpr size_t write_count = 2000;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Every field is derived from the first, a reader seeing mismatching fields saw a partial write.
+struct Snapshot
+{
+	size_t first	= 0;
+	size_t second	= 0;
+	size_t third	= 0;
+	size_t fourth	= 0;
+
+	void Set( size_t value )
+	{
+		first	= value;
+		second	= value * 2;
+		third	= value * 3;
+		fourth	= ~value;
+	}
+
+	bool IsConsistent() const
+	{
+		return second == first * 2 && third == first * 3 && fourth == ~first;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Counts live instances so that tests can check retired copies are destroyed.
+struct CountedSnapshot
+{
+	static inline std::atomic<int64_t> live_count = 0;
+
+	CountedSnapshot() { ++live_count; }
+	CountedSnapshot( const CountedSnapshot & other ) : values( other.values ) { ++live_count; }
+	~CountedSnapshot() { --live_count; }
+
+	std::vector<size_t> values = std::vector<size_t>( 64, 0 );
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Runs reader threads until the writer is done, returns the number of inconsistent reads.
+template<typename ReadFunctionType, typename WriteFunctionType>
+size_t RunReadersAndWriter(
+	ReadFunctionType		&&	read,
+	WriteFunctionType		&&	write
+)
+{
+	auto writer_done = std::atomic_bool { false };
+	auto inconsistent_count = std::atomic<size_t> { 0 };
+	auto readers = std::vector<std::thread> {};
+	for( size_t i = 0; i < reader_count; ++i )
+	{
+		readers.emplace_back( [ & ]()
+			{
+				do
+				{
+					if( !read() ) ++inconsistent_count;
+				} while( !writer_done );
+			}
+		);
+	}
+	for( size_t i = 1; i <= write_count; ++i )
+	{
+		write( i );
+		if( i % 64 == 0 ) std::this_thread::yield();
+	}
+	writer_done = true;
+	for( auto & reader : readers ) reader.join();
+	return inconsistent_count;
+}
+
+} // guarded_value_test
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( GuardedValue, Basic )
+{
+	auto guarded_value = bc::thread::GuardedValue<int>( 5 );
+	guarded_value( []( int & value ) { value += 2; } );
+	guarded_value( []( int & value ) { EXPECT_EQ( value, 7 ); } );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( GuardedValue, Shared )
+{
+	using namespace guarded_value_test;
+
+	auto initial_value = Snapshot {};
+	initial_value.Set( 0 );
+	auto guarded_value = bc::thread::SharedGuardedValue<Snapshot>( initial_value );
+	EXPECT_EQ( guarded_value.Read( []( const Snapshot & value ) { return value.IsConsistent(); } ), true );
+
+	auto inconsistent_count = RunReadersAndWriter(
+		[ & ]() { return guarded_value.Read( []( const Snapshot & value ) { return value.IsConsistent(); } ); },
+		[ & ]( size_t i ) { guarded_value( [ i ]( Snapshot & value ) { value.Set( i ); } ); }
+	);
+	EXPECT_EQ( inconsistent_count, 0 );
+	EXPECT_EQ( guarded_value.Read( []( const Snapshot & value ) { return value.first; } ), write_count );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( GuardedValue, SeqLock )
+{
+	using namespace guarded_value_test;
+
+	auto guarded_value = bc::thread::SeqLockGuardedValue<Snapshot>();
+	EXPECT_EQ( guarded_value.Load().first, 0 );
+
+	guarded_value.Store( Snapshot { 1, 2, 3, ~size_t( 1 ) } );
+	EXPECT_EQ( guarded_value.Load().third, 3 );
+
+	auto inconsistent_count = RunReadersAndWriter(
+		[ & ]() { return guarded_value.Load().IsConsistent(); },
+		[ & ]( size_t i )
+		{
+			if( i % 2 )
+			{
+				guarded_value( [ i ]( Snapshot & value ) { value.Set( i ); } );
+			}
+			else
+			{
+				auto snapshot = Snapshot {};
+				snapshot.Set( i );
+				guarded_value.Store( snapshot );
+			}
+		}
+	);
+	EXPECT_EQ( inconsistent_count, 0 );
+	EXPECT_EQ( guarded_value.Read( []( const Snapshot & value ) { return value.first; } ), write_count );
+
+	// Concurrent writers are serialized, no increment is lost.
+	auto counter = bc::thread::SeqLockGuardedValue<size_t>( 0 );
+	auto writers = std::vector<std::thread> {};
+	for( size_t i = 0; i < 4; ++i )
+	{
+		writers.emplace_back( [ & ]()
+			{
+				for( size_t w = 0; w < 10000; ++w ) counter( []( size_t & value ) { ++value; } );
+			}
+		);
+	}
+	for( auto & writer : writers ) writer.join();
+	EXPECT_EQ( counter.Load(), 40000 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( GuardedValue, Rcu )
+{
+	using namespace guarded_value_test;
+
+	{
+		auto guarded_value = bc::thread::RcuGuardedValue<CountedSnapshot>();
+		EXPECT_EQ( CountedSnapshot::live_count, 1 );
+
+		auto inconsistent_count = RunReadersAndWriter(
+			[ & ]()
+			{
+				return guarded_value.Read( []( const CountedSnapshot & value )
+					{
+						for( auto v : value.values )
+						{
+							if( v != value.values[ 0 ] ) return false;
+						}
+						return true;
+					}
+				);
+			},
+			[ & ]( size_t i )
+			{
+				guarded_value( [ i ]( CountedSnapshot & value )
+					{
+						for( auto & v : value.values ) v = i;
+					}
+				);
+			}
+		);
+		EXPECT_EQ( inconsistent_count, 0 );
+		EXPECT_EQ( guarded_value.Read( []( const CountedSnapshot & value ) { return value.values.back(); } ), write_count );
+
+		// Retired copies do not pile up, with no readers left everything but the published copy is destroyed.
+		guarded_value.Reclaim();
+		EXPECT_EQ( guarded_value.GetRetiredCount(), 0 );
+		EXPECT_EQ( CountedSnapshot::live_count, 1 );
+
+		// Copy being read stays alive while a new one is published.
+		guarded_value.Read( [ & ]( const CountedSnapshot & value )
+			{
+				auto old_first = value.values[ 0 ];
+				auto writer = std::thread( [ & ]()
+					{
+						guarded_value( []( CountedSnapshot & value ) { value.values[ 0 ] = 0; } );
+						guarded_value.Reclaim();
+					}
+				);
+				writer.join();
+				EXPECT_EQ( value.values[ 0 ], old_first );
+				EXPECT_GE( guarded_value.GetRetiredCount(), 1 );
+			}
+		);
+		guarded_value.Reclaim();
+		EXPECT_EQ( guarded_value.GetRetiredCount(), 0 );
+		EXPECT_EQ( guarded_value.Read( []( const CountedSnapshot & value ) { return value.values[ 0 ]; } ), 0 );
+	}
+	EXPECT_EQ( CountedSnapshot::live_count, 0 );
+}
+
+
+
+} // thread
+} // core
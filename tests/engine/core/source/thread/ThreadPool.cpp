@@ -3,6 +3,24 @@
 
 #include <core/CoreComponent.hpp>
 #include <core/thread/ThreadPool.hpp>
+#include <core/thread/TaskGraph.hpp>
+#include <core/thread/WorkerCounters.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+#if defined( BITCRAFTE_PLATFORM_LINUX )
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
 
 
 
@@ -89,6 +107,1577 @@ TEST( ThreadPool, ThrowAtThreadConstruction )
 	}
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, ThreadCreateInfo )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		struct ThreadSettings
+		{
+			std::string				name;
+			std::vector<bc::u32>	processors;
+			int						nice_value		= 0;
+		};
+
+		class SettingsThread : public bc::thread::Thread
+		{
+		public:
+			SettingsThread( ThreadSettings & settings ) : settings( settings ) {}
+			void ThreadBegin() override
+			{
+				#if defined( BITCRAFTE_PLATFORM_LINUX )
+				char name[ 16 ] = {};
+				pthread_getname_np( pthread_self(), name, sizeof( name ) );
+				settings.name = name;
+
+				cpu_set_t affinity;
+				CPU_ZERO( &affinity );
+				pthread_getaffinity_np( pthread_self(), sizeof( affinity ), &affinity );
+				for( bc::u32 i = 0; i < CPU_SETSIZE; ++i )
+				{
+					if( CPU_ISSET( i, &affinity ) ) settings.processors.push_back( i );
+				}
+
+				errno = 0;
+				settings.nice_value = getpriority( PRIO_PROCESS, id_t( gettid() ) );
+				#endif
+			}
+			void ThreadEnd() noexcept override {}
+			ThreadSettings & settings;
+		};
+
+		auto core_processors = bc::thread::GetPhysicalCoreProcessors();
+		ASSERT_FALSE( core_processors.IsEmpty() );
+		EXPECT_GE( bc::thread::GetLogicalProcessorCount(), core_processors.Size() );
+		EXPECT_GE( bc::thread::GetDefaultWorkerThreadCount(), 1 );
+		EXPECT_FALSE( bc::thread::GetNumaNodeProcessors( 0 ).IsEmpty() );
+
+		auto named_settings = ThreadSettings {};
+		auto create_info = bc::thread::ThreadCreateInfo {};
+		create_info.name = "Renderer thread name";
+		create_info.processor_affinity.PushBack( core_processors.Back() );
+		create_info.priority = bc::thread::ThreadPriority::LOWEST;
+		thread_pool->AddThreadWithCreateInfo<SettingsThread>( create_info, named_settings );
+
+		auto default_settings = ThreadSettings {};
+		auto default_thread_id = thread_pool->AddThread<SettingsThread>( default_settings );
+
+		#if defined( BITCRAFTE_PLATFORM_LINUX )
+		EXPECT_EQ( named_settings.name, "Renderer thread" );
+		EXPECT_EQ( named_settings.processors, std::vector<bc::u32>{ core_processors.Back() } );
+		EXPECT_EQ( named_settings.nice_value, 19 );
+
+		EXPECT_EQ( default_settings.name, "Worker " + std::to_string( default_thread_id ) );
+		#endif
+
+		auto invalid_create_info = bc::thread::ThreadCreateInfo {};
+		invalid_create_info.numa_node = 1 << 20;
+		EXPECT_THROW( thread_pool->AddThreadWithCreateInfo<SettingsThread>( invalid_create_info, default_settings ), bc::diagnostic::Exception );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, CreateWorkerThreads )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		core_create_info.thread_pool_create_info.create_worker_threads = true;
+		core_create_info.thread_pool_create_info.pin_worker_threads = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		EXPECT_EQ( thread_pool->GetThreadCount(), bc::thread::GetDefaultWorkerThreadCount() );
+
+		std::atomic<bc::u64> counter = 0;
+		for( bc::u64 i = 0; i < 100; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( [ &counter ]() { counter.fetch_add( 1 ); } );
+		}
+		thread_pool->WaitIdle();
+		EXPECT_EQ( counter.load(), 100 );
+	}
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		core_create_info.thread_pool_create_info.create_worker_threads = true;
+		core_create_info.thread_pool_create_info.worker_thread_count = 3;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+
+		EXPECT_EQ( core->GetThreadPool()->GetThreadCount(), 3 );
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, ScheduleLambdaTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto counter = std::atomic<size_t> {};
+		for( size_t i = 0; i < 10000; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } );
+		}
+		thread_pool->ScheduleLambdaTask( [ &counter ]( bc::thread::Task & task ) { ++counter; } );
+		thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; return bc::thread::TaskExecutionResult::FINISHED; } );
+		thread_pool->WaitIdle();
+
+		EXPECT_EQ( counter, 10002 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+		EXPECT_EQ( thread_pool->GetTaskRunningCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, ScheduleFromTask )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto counter = std::atomic<size_t> {};
+		for( size_t i = 0; i < 100; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( [ &counter, thread_pool ]()
+				{
+					for( size_t c = 0; c < 100; ++c )
+					{
+						thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } );
+					}
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+
+		EXPECT_EQ( counter, 10000 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, ScheduleBatch )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		class AddTask : public bc::thread::Task
+		{
+		public:
+			AddTask( std::pair<std::atomic<size_t>*, size_t> argument ) : counter( argument.first ), amount( argument.second ) {}
+			bc::thread::TaskExecutionResult operator()( bc::thread::Thread & thread ) override
+			{
+				counter->fetch_add( amount );
+				return bc::thread::TaskExecutionResult::FINISHED;
+			}
+			std::atomic<size_t> * counter;
+			size_t amount;
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Batch waits for a shared dependency, task depending on the whole batch runs last.
+		auto gate = std::atomic_bool { false };
+		auto gate_task = thread_pool->ScheduleLambdaTask( [ &gate ]() { gate = true; } );
+
+		auto counter = std::atomic<size_t> {};
+		auto lambdas = std::vector<std::function<void()>> {};
+		for( size_t i = 0; i < 1000; ++i )
+		{
+			lambdas.push_back( [ &counter, &gate ]() { EXPECT_TRUE( gate ); counter.fetch_add( 1 ); } );
+		}
+		auto lambda_batch = thread_pool->ScheduleLambdaTaskBatch( bc::thread::TaskPriority::HIGH, { gate_task }, lambdas );
+		EXPECT_EQ( lambda_batch.task_count, 1000 );
+		EXPECT_EQ( lambda_batch[ 999 ], lambda_batch.first_task_id + 999 );
+
+		auto after_batch_count = std::atomic<size_t> {};
+		thread_pool->ScheduleLambdaTaskWithDependencies( lambda_batch.ToList(), [ &counter, &after_batch_count ]()
+			{
+				after_batch_count = counter.load();
+			}
+		);
+
+		auto arguments = bc::List<std::pair<std::atomic<size_t>*, size_t>> {};
+		for( size_t i = 1; i <= 100; ++i ) arguments.PushBack( { &counter, i * 1000 } );
+		auto task_batch = thread_pool->ScheduleTaskBatch<AddTask>( arguments );
+		EXPECT_EQ( task_batch.first_task_id, lambda_batch.first_task_id + 1001 );
+		EXPECT_EQ( task_batch.task_count, 100 );
+
+		EXPECT_TRUE( thread_pool->ScheduleLambdaTaskBatch( std::vector<std::function<void()>> {} ).IsEmpty() );
+
+		thread_pool->WaitIdle();
+		EXPECT_GE( after_batch_count, 1000 );
+		EXPECT_EQ( counter, 1000 + 5050 * 1000 );
+
+		// Batches scheduled from worker threads go to the worker thread's own queues.
+		counter = 0;
+		for( size_t i = 0; i < 10; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( [ &counter, thread_pool ]()
+				{
+					auto child_lambdas = std::vector<std::function<void()>>( 100, [ &counter ]() { counter.fetch_add( 1 ); } );
+					thread_pool->ScheduleLambdaTaskBatch( child_lambdas );
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+		EXPECT_EQ( counter, 1000 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, Futures )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto default_future = bc::thread::TaskFuture<int> {};
+		EXPECT_FALSE( default_future.IsValid() );
+		EXPECT_FALSE( default_future.IsReady() );
+
+		auto number_future = thread_pool->ScheduleLambdaTaskWithFuture( []() { return 21; } );
+		EXPECT_TRUE( number_future.IsValid() );
+		EXPECT_EQ( number_future.Get(), 21 );
+		EXPECT_TRUE( number_future.IsReady() );
+
+		// Chained continuations, each receives the value of the previous task.
+		auto text_future = thread_pool->ScheduleLambdaTaskWithFuture( []() { return std::vector<int>{ 1, 2, 3 }; } )
+			.Then( []( std::vector<int> & values ) { values.push_back( 4 ); return values.size(); } )
+			.Then( bc::thread::TaskPriority::HIGH, []( size_t count ) { return std::string( count, 'x' ); } );
+		EXPECT_EQ( text_future.Get(), "xxxx" );
+
+		// Several continuations on the same future, and a void future.
+		auto counter = std::atomic<int> {};
+		auto shared_future = thread_pool->ScheduleLambdaTaskWithFuture( []() { return 10; } );
+		auto continuations = std::vector<bc::thread::TaskFuture<void>> {};
+		for( int i = 0; i < 50; ++i )
+		{
+			continuations.push_back( shared_future.Then( [ &counter ]( const int & value ) { counter.fetch_add( value ); } ) );
+		}
+		auto after_all = thread_pool->ScheduleLambdaTaskWithFuture( []() {} ).Then( [ &counter ]() { return counter.load(); } );
+		for( auto & continuation : continuations ) continuation.Wait();
+		EXPECT_EQ( counter, 500 );
+		after_all.Wait();
+
+		// Future task id can be used as a dependency of regular tasks.
+		auto dependency_future = thread_pool->ScheduleLambdaTaskWithFuture( []() { return 5; } );
+		auto dependent_value = std::atomic<int> {};
+		auto dependent_task = thread_pool->ScheduleLambdaTaskWithDependencies( { dependency_future.GetTaskId() }, [ &dependent_value, dependency_future ]()
+			{
+				dependent_value = dependency_future.Get() * 2;
+			}
+		);
+		thread_pool->WaitForTask( dependent_task );
+		EXPECT_EQ( dependent_value, 10 );
+
+		// Values outlive their tasks, copies refer to the same value.
+		auto copy = number_future;
+		thread_pool->WaitIdle();
+		EXPECT_EQ( copy.Get(), 21 );
+		EXPECT_EQ( &copy.Get(), &number_future.Get() );
+
+		// Throwing parent fails its whole chain, continuations are not called and the pool keeps running.
+		auto continuation_call_count = std::atomic<int> {};
+		auto failed_future = thread_pool->ScheduleLambdaTaskWithFuture( []() -> int { throw std::runtime_error( "Parent failed" ); } );
+		auto failed_chain = failed_future
+			.Then( [ &continuation_call_count ]( int value ) { continuation_call_count.fetch_add( 1 ); return value * 2; } )
+			.Then( [ &continuation_call_count ]( int ) { continuation_call_count.fetch_add( 1 ); } );
+		EXPECT_THROW( failed_chain.Get(), std::runtime_error );
+		EXPECT_TRUE( failed_chain.HasFailed() );
+		EXPECT_FALSE( failed_chain.IsReady() );
+		EXPECT_THROW( failed_future.Get(), std::runtime_error );
+		EXPECT_TRUE( failed_future.HasFailed() );
+		EXPECT_EQ( continuation_call_count, 0 );
+		EXPECT_EQ( thread_pool->ScheduleLambdaTaskWithFuture( []() { return 7; } ).Get(), 7 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, Dependencies )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Each task in the chain must observe the value written by the previous task.
+		auto value = std::atomic<size_t> {};
+		auto failures = std::atomic<size_t> {};
+		auto previous = thread_pool->ScheduleLambdaTask( [ &value ]() { value = 1; } );
+		for( size_t i = 1; i < 200; ++i )
+		{
+			previous = thread_pool->ScheduleLambdaTaskWithDependencies( { previous }, [ &value, &failures, i ]()
+				{
+					if( value != i ) ++failures;
+					value = i + 1;
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+
+		EXPECT_EQ( value, 200 );
+		EXPECT_EQ( failures, 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, FanInDependencies )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto dependencies = bc::List<bc::thread::TaskIdentifier> {};
+		for( size_t i = 0; i < 1000; ++i )
+		{
+			dependencies.PushBack( thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } ) );
+		}
+		auto observed_count = std::atomic<size_t> {};
+		auto fan_in_task = thread_pool->ScheduleLambdaTaskWithDependencies( dependencies, [ &counter, &observed_count ]()
+			{
+				observed_count = counter.load();
+			}
+		);
+		thread_pool->ScheduleLambdaTaskWithDependencies( { fan_in_task, dependencies.Front() }, [ &counter ]() { ++counter; } );
+		thread_pool->WaitIdle();
+
+		EXPECT_EQ( observed_count, 1000 );
+		EXPECT_EQ( counter, 1001 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, AddDependencyAtRuntime )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto run_count = std::atomic<size_t> {};
+		auto child_finished = std::atomic_bool {};
+		auto child_finished_before_resume = std::atomic_bool {};
+		thread_pool->ScheduleLambdaTask( [ & ]( bc::thread::Task & task )
+			{
+				if( run_count++ == 0 )
+				{
+					auto child = thread_pool->ScheduleLambdaTask( [ & ]()
+						{
+							std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+							child_finished = true;
+						}
+					);
+					task.AddDependencyAtRuntime( child );
+					return bc::thread::TaskExecutionResult::PAUSED;
+				}
+				child_finished_before_resume = child_finished.load();
+				return bc::thread::TaskExecutionResult::FINISHED;
+			}
+		);
+		thread_pool->WaitIdle();
+
+		EXPECT_EQ( run_count, 2 );
+		EXPECT_TRUE( child_finished_before_resume );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, Priorities )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		thread_pool->AddThread<TestThread>();
+
+		// Keep the only worker thread busy until every task has been scheduled.
+		auto blocker_started = std::atomic_bool {};
+		auto release_blocker = std::atomic_bool {};
+		thread_pool->ScheduleLambdaTask( bc::thread::TaskPriority::REALTIME, [ & ]()
+			{
+				blocker_started = true;
+				while( !release_blocker ) std::this_thread::yield();
+			}
+		);
+		while( !blocker_started ) std::this_thread::yield();
+
+		auto order_mutex = std::mutex {};
+		auto order = std::vector<bc::thread::TaskPriority> {};
+		auto priorities = std::vector<bc::thread::TaskPriority> {
+			bc::thread::TaskPriority::BACKGROUND,
+			bc::thread::TaskPriority::NORMAL,
+			bc::thread::TaskPriority::LOW,
+			bc::thread::TaskPriority::HIGH,
+			bc::thread::TaskPriority::REALTIME,
+			bc::thread::TaskPriority::BELOW_NORMAL,
+			bc::thread::TaskPriority::ABOVE_NORMAL,
+		};
+		for( auto priority : priorities )
+		{
+			for( size_t i = 0; i < 3; ++i )
+			{
+				thread_pool->ScheduleLambdaTask( priority, [ &order_mutex, &order, priority ]()
+					{
+						auto lock_guard = std::lock_guard( order_mutex );
+						order.push_back( priority );
+					}
+				);
+			}
+		}
+		EXPECT_EQ( thread_pool->GetTaskQueueDepth( bc::thread::TaskPriority::LOW ), 3 );
+		EXPECT_EQ( thread_pool->GetTaskQueueDepth( bc::thread::TaskPriority::REALTIME ), 3 );
+
+		release_blocker = true;
+		thread_pool->WaitIdle();
+
+		ASSERT_EQ( order.size(), 21 );
+		EXPECT_TRUE( std::is_sorted( order.begin(), order.end() ) );
+		EXPECT_EQ( thread_pool->GetTaskQueueDepth( bc::thread::TaskPriority::LOW ), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, PriorityAging )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		thread_pool->AddThread<TestThread>();
+
+		// High priority task keeps rescheduling itself, background task must still get to run eventually.
+		auto background_ran = std::atomic_bool {};
+		auto give_up_time = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+		thread_pool->ScheduleLambdaTask( bc::thread::TaskPriority::HIGH, [ & ]()
+			{
+				if( background_ran || std::chrono::steady_clock::now() > give_up_time ) return bc::thread::TaskExecutionResult::FINISHED;
+				return bc::thread::TaskExecutionResult::PAUSED;
+			}
+		);
+		thread_pool->ScheduleLambdaTask( bc::thread::TaskPriority::BACKGROUND, [ & ]() { background_ran = true; } );
+		thread_pool->WaitIdle();
+
+		EXPECT_TRUE( background_ran );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, ThreadLockedTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+		class LockedThread : public bc::thread::Thread
+		{
+		public:
+			LockedThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 3; ++i ) thread_pool->AddThread<TestThread>();
+		auto locked_thread_id = thread_pool->AddThread<LockedThread>();
+		auto locked_thread_system_id = thread_pool->GetThreadSystemID( locked_thread_id );
+
+		auto wrong_thread = std::atomic<size_t> {};
+		auto counter = std::atomic<size_t> {};
+		for( size_t i = 0; i < 500; ++i )
+		{
+			thread_pool->ScheduleLambdaTaskToThreadType<LockedThread>( [ &wrong_thread, &counter, locked_thread_system_id ]()
+				{
+					if( std::this_thread::get_id() != locked_thread_system_id ) ++wrong_thread;
+					++counter;
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+
+		EXPECT_EQ( counter, 500 );
+		EXPECT_EQ( wrong_thread, 0 );
+
+		// Tasks locked to a thread type with several threads are spread over all of them.
+		class SharedLockedThread : public bc::thread::Thread
+		{
+		public:
+			SharedLockedThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+		auto shared_thread_system_ids = std::array<std::thread::id, 2> {};
+		for( auto & shared_thread_system_id : shared_thread_system_ids )
+		{
+			shared_thread_system_id = thread_pool->GetThreadSystemID( thread_pool->AddThread<SharedLockedThread>() );
+		}
+
+		auto run_counts = std::array<std::atomic<size_t>, 2> {};
+		for( size_t i = 0; i < 200; ++i )
+		{
+			thread_pool->ScheduleLambdaTaskToThreadType<SharedLockedThread>( [ &wrong_thread, &run_counts, shared_thread_system_ids ]()
+				{
+					auto it = std::find( shared_thread_system_ids.begin(), shared_thread_system_ids.end(), std::this_thread::get_id() );
+					if( it == shared_thread_system_ids.end() )
+					{
+						++wrong_thread;
+						return;
+					}
+					++run_counts[ it - shared_thread_system_ids.begin() ];
+					std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+
+		EXPECT_EQ( wrong_thread, 0 );
+		EXPECT_EQ( run_counts[ 0 ] + run_counts[ 1 ], 200 );
+		EXPECT_GT( run_counts[ 0 ], 0 );
+		EXPECT_GT( run_counts[ 1 ], 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, RemoveThreadWithLockedTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+		class LockedThread : public bc::thread::Thread
+		{
+		public:
+			LockedThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Tasks still in the mailbox of a removed thread fail, their dependents and waiters are released.
+		auto locked_thread_id = thread_pool->AddThread<LockedThread>();
+		thread_pool->ScheduleLambdaTaskToThreadType<LockedThread>( []() { std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) ); } );
+
+		auto locked_counter = std::atomic<size_t> {};
+		auto locked_tasks = bc::List<bc::thread::TaskIdentifier> {};
+		for( size_t i = 0; i < 10; ++i )
+		{
+			locked_tasks.PushBack( thread_pool->ScheduleLambdaTaskToThreadType<LockedThread>( [ &locked_counter ]() { ++locked_counter; } ) );
+		}
+		auto dependent_counter = std::atomic<size_t> {};
+		auto dependent = thread_pool->ScheduleLambdaTaskWithDependencies( locked_tasks, [ &dependent_counter ]() { ++dependent_counter; } );
+
+		thread_pool->RemoveThread( locked_thread_id );
+		thread_pool->WaitForTasks( locked_tasks );
+		thread_pool->WaitForTask( dependent );
+		EXPECT_EQ( locked_counter, 0 );
+		EXPECT_EQ( dependent_counter, 1 );
+
+		// Task locked to a thread which is removed before its dependencies complete fails once queued.
+		locked_thread_id = thread_pool->AddThread<LockedThread>();
+		auto release_blocked = std::atomic<bool> { false };
+		auto blocked = thread_pool->ScheduleLambdaTask( [ &release_blocked ]() { release_blocked.wait( false ); } );
+		auto locked = thread_pool->ScheduleLambdaTaskToThreadTypeWithDependencies<LockedThread>( { blocked }, [ &locked_counter ]() { ++locked_counter; } );
+		dependent = thread_pool->ScheduleLambdaTaskWithDependencies( { locked }, [ &dependent_counter ]() { ++dependent_counter; } );
+
+		thread_pool->RemoveThread( locked_thread_id );
+		release_blocked = true;
+		release_blocked.notify_all();
+		thread_pool->WaitForTask( dependent );
+		thread_pool->WaitIdle();
+		EXPECT_EQ( locked_counter, 0 );
+		EXPECT_EQ( dependent_counter, 2 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, MainThreadTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto main_thread_system_id = std::this_thread::get_id();
+		auto wrong_thread = std::atomic<size_t> {};
+		auto counter = std::atomic<size_t> {};
+		auto MainThreadWork = [ &wrong_thread, &counter, main_thread_system_id ]()
+			{
+				if( std::this_thread::get_id() != main_thread_system_id ) ++wrong_thread;
+				++counter;
+			};
+
+		// Main thread tasks scheduled from worker threads wait for the main thread to run them.
+		thread_pool->ScheduleLambdaTask( [ thread_pool, MainThreadWork ]()
+			{
+				for( size_t i = 0; i < 10; ++i ) thread_pool->ScheduleLambdaTaskToMainThread( MainThreadWork );
+			}
+		);
+		thread_pool->ScheduleLambdaTaskToMainThread( MainThreadWork );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+		EXPECT_EQ( counter, 0 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 11 );
+
+		core->Run();
+		EXPECT_EQ( counter, 11 );
+		EXPECT_EQ( wrong_thread, 0 );
+
+		// Waiting on the main thread runs main thread tasks, including ones that the awaited task depends on.
+		auto main_thread_task = thread_pool->ScheduleLambdaTaskToMainThread( MainThreadWork );
+		auto dependent = thread_pool->ScheduleLambdaTaskWithDependencies( { main_thread_task }, [ thread_pool, MainThreadWork ]()
+			{
+				thread_pool->ScheduleLambdaTaskToMainThread( MainThreadWork );
+			}
+		);
+		thread_pool->WaitForTask( dependent );
+		thread_pool->WaitIdle();
+		EXPECT_EQ( counter, 13 );
+		EXPECT_EQ( wrong_thread, 0 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, WaitForTask )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Blocked task keeps the thread pool busy, waiting for a single task must not wait for it.
+		auto release_blocked = std::atomic<bool> { false };
+		thread_pool->ScheduleLambdaTask( [ &release_blocked ]() { release_blocked.wait( false ); } );
+
+		auto finished = std::atomic<bool> { false };
+		auto task_id = thread_pool->ScheduleLambdaTask( [ &finished ]()
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+				finished = true;
+			}
+		);
+		thread_pool->WaitForTask( task_id );
+		EXPECT_TRUE( finished );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 1 );
+
+		// Completed task is not waited for.
+		thread_pool->WaitForTask( task_id );
+
+		release_blocked = true;
+		release_blocked.notify_all();
+		thread_pool->WaitIdle();
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, WaitForTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto counter = std::atomic<size_t> {};
+		auto task_ids = bc::List<bc::thread::TaskIdentifier> {};
+		for( size_t i = 0; i < 1000; ++i )
+		{
+			task_ids.PushBack( thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } ) );
+		}
+		thread_pool->WaitForTasks( task_ids );
+		EXPECT_EQ( counter, 1000 );
+
+		// Worker threads park between tasks, every single task must still wake one of them up.
+		for( size_t i = 0; i < 1000; ++i )
+		{
+			auto task_id = thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } );
+			thread_pool->WaitForTask( task_id );
+			EXPECT_EQ( counter, 1001 + i );
+		}
+
+		thread_pool->WaitIdle();
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, TaskPooling )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Slots of completed tasks are reused by tasks scheduled later.
+		auto task_addresses_mutex = std::mutex {};
+		auto first_task_addresses = std::vector<const void*> {};
+		auto second_task_addresses = std::vector<const void*> {};
+		for( auto task_addresses : { &first_task_addresses, &second_task_addresses } )
+		{
+			for( size_t i = 0; i < 1000; ++i )
+			{
+				thread_pool->ScheduleLambdaTask( [ &task_addresses_mutex, task_addresses ]( bc::thread::Task & task )
+					{
+						auto lock_guard = std::lock_guard( task_addresses_mutex );
+						task_addresses->push_back( &task );
+					}
+				);
+			}
+			thread_pool->WaitIdle();
+		}
+		std::sort( first_task_addresses.begin(), first_task_addresses.end() );
+		EXPECT_TRUE( std::any_of( second_task_addresses.begin(), second_task_addresses.end(), [ &first_task_addresses ]( const void * address )
+			{
+				return std::binary_search( first_task_addresses.begin(), first_task_addresses.end(), address );
+			}
+		) );
+
+		// Lambdas too large for a slot get their own allocation.
+		auto counter = std::atomic<size_t> {};
+		auto large_capture = std::array<size_t, 256> {};
+		large_capture.back() = 5;
+		thread_pool->ScheduleLambdaTask( [ &counter, large_capture ]() { counter += large_capture.back(); } );
+		thread_pool->WaitIdle();
+		EXPECT_EQ( counter, 5 );
+
+		// More dependencies than fit inside the task.
+		auto dependencies = bc::List<bc::thread::TaskIdentifier> {};
+		for( size_t i = 0; i < 20; ++i )
+		{
+			dependencies.PushBack( thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } ) );
+		}
+		auto counter_at_dependent = std::atomic<size_t> {};
+		thread_pool->ScheduleLambdaTaskWithDependencies( dependencies, [ &counter, &counter_at_dependent ]( bc::thread::Task & task )
+			{
+				counter_at_dependent = counter.load();
+				EXPECT_EQ( task.GetDependencies().Size(), 20 );
+			}
+		);
+		thread_pool->WaitIdle();
+		EXPECT_EQ( counter_at_dependent, 25 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, ParallelFor )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		// Runs on the calling thread alone when there are no worker threads.
+		auto visit_counts = std::vector<std::atomic<size_t>>( 10000 );
+		thread_pool->ParallelFor( 0, visit_counts.size(), 16, [ &visit_counts ]( bc::u64 index ) { ++visit_counts[ index ]; } );
+		EXPECT_TRUE( std::all_of( visit_counts.begin(), visit_counts.end(), []( auto & count ) { return count == 1; } ) );
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		thread_pool->ParallelFor( 0, visit_counts.size(), 1, [ &visit_counts ]( bc::u64 index ) { ++visit_counts[ index ]; } );
+		EXPECT_TRUE( std::all_of( visit_counts.begin(), visit_counts.end(), []( auto & count ) { return count == 2; } ) );
+
+		// Chunks never overlap and respect the grain size except for the last chunk.
+		thread_pool->ParallelFor( 100, visit_counts.size(), 64, [ &visit_counts ]( bc::u64 chunk_begin, bc::u64 chunk_end )
+			{
+				EXPECT_TRUE( chunk_end - chunk_begin >= 64 || chunk_end == visit_counts.size() );
+				for( auto i = chunk_begin; i < chunk_end; ++i ) ++visit_counts[ i ];
+			}
+		);
+		EXPECT_TRUE( std::all_of( visit_counts.begin(), visit_counts.begin() + 100, []( auto & count ) { return count == 2; } ) );
+		EXPECT_TRUE( std::all_of( visit_counts.begin() + 100, visit_counts.end(), []( auto & count ) { return count == 3; } ) );
+
+		// Empty range.
+		thread_pool->ParallelFor( 10, 10, 1, []( bc::u64 index ) { ADD_FAILURE(); } );
+
+		// Nested inside tasks, worker threads help each other instead of blocking.
+		auto counter = std::atomic<size_t> {};
+		for( size_t i = 0; i < 8; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( [ thread_pool, &counter ]()
+				{
+					thread_pool->ParallelFor( 0, 1000, 10, [ &counter ]( bc::u64 index ) { ++counter; } );
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+		EXPECT_EQ( counter, 8000 );
+
+		// Exceptions are rethrown on the calling thread and the remaining chunks are skipped.
+		counter = 0;
+		EXPECT_THROW(
+			thread_pool->ParallelFor( 0, 100000, 1, [ &counter ]( bc::u64 index )
+				{
+					if( index == 50 ) bc::diagnostic::Throw( "Test" );
+					++counter;
+				}
+			),
+			bc::diagnostic::Exception
+		);
+		EXPECT_LT( counter, 100000 );
+
+		thread_pool->WaitIdle();
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, ParallelReduce )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto sum = thread_pool->ParallelReduce( 0, 100000, 100, bc::u64 { 0 },
+			[]( bc::u64 index ) { return index; },
+			[]( bc::u64 a, bc::u64 b ) { return a + b; }
+		);
+		EXPECT_EQ( sum, bc::u64( 100000 ) * 99999 / 2 );
+
+		auto values = std::vector<bc::i64>( 5000 );
+		for( size_t i = 0; i < values.size(); ++i ) values[ i ] = bc::i64( ( i * 7919 ) % 5003 ) - 2500;
+		auto maximum = thread_pool->ParallelReduce( 0, values.size(), 1, std::numeric_limits<bc::i64>::min(),
+			[ &values ]( bc::u64 index ) { return values[ index ]; },
+			[]( bc::i64 a, bc::i64 b ) { return std::max( a, b ); }
+		);
+		EXPECT_EQ( maximum, *std::max_element( values.begin(), values.end() ) );
+
+		auto empty = thread_pool->ParallelReduce( 5, 5, 1, bc::u64 { 42 },
+			[]( bc::u64 index ) { return index; },
+			[]( bc::u64 a, bc::u64 b ) { return a + b; }
+		);
+		EXPECT_EQ( empty, 42 );
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, CoroutineAwaitTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Local state of the coroutine survives suspensions, awaited tasks have completed when the coroutine continues.
+		auto result = std::atomic<size_t> { 0 };
+		thread_pool->ScheduleCoroutineTask( [ thread_pool, &result ]() -> bc::thread::CoroutineTask
+			{
+				auto step_count = size_t { 0 };
+				auto first_finished = std::atomic<bool> { false };
+				auto first = thread_pool->ScheduleLambdaTask( [ &first_finished ]()
+					{
+						std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+						first_finished = true;
+					}
+				);
+				co_await first;
+				EXPECT_TRUE( first_finished );
+				++step_count;
+
+				auto counter = std::atomic<size_t> { 0 };
+				auto others = bc::List<bc::thread::TaskIdentifier> {};
+				for( size_t i = 0; i < 10; ++i )
+				{
+					others.PushBack( thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } ) );
+				}
+				co_await others;
+				EXPECT_EQ( counter, 10 );
+				++step_count;
+
+				// Task that has already completed does not keep the coroutine suspended.
+				co_await first;
+				++step_count;
+
+				result = step_count;
+			}
+		);
+		thread_pool->WaitIdle();
+		EXPECT_EQ( result, 3 );
+
+		// Other tasks can depend on a coroutine task, it completes when the coroutine returns.
+		auto coroutine_finished = std::atomic<bool> { false };
+		auto coroutine_id = thread_pool->ScheduleCoroutineTask( [ thread_pool, &coroutine_finished ]() -> bc::thread::CoroutineTask
+			{
+				co_await thread_pool->ScheduleLambdaTask( []() { std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) ); } );
+				coroutine_finished = true;
+			}
+		);
+		auto dependent_saw_finished = std::atomic<bool> { false };
+		thread_pool->ScheduleLambdaTaskWithDependencies( { coroutine_id }, [ &coroutine_finished, &dependent_saw_finished ]()
+			{
+				dependent_saw_finished = coroutine_finished.load();
+			}
+		);
+		thread_pool->WaitIdle();
+		EXPECT_TRUE( dependent_saw_finished );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, CoroutineAwaitTimer )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto elapsed = std::atomic<std::chrono::steady_clock::duration> { std::chrono::steady_clock::duration::zero() };
+		auto start = std::chrono::steady_clock::now();
+		thread_pool->ScheduleCoroutineTask( [ &elapsed, start ]() -> bc::thread::CoroutineTask
+			{
+				co_await bc::thread::ResumeAfter( std::chrono::milliseconds( 30 ) );
+				elapsed = std::chrono::steady_clock::now() - start;
+			}
+		);
+
+		// Suspended coroutine does not occupy a worker thread, other tasks keep running while it waits.
+		auto counter = std::atomic<size_t> { 0 };
+		for( size_t i = 0; i < 100; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } );
+		}
+		while( counter != 100 ) std::this_thread::yield();
+		EXPECT_EQ( elapsed.load(), std::chrono::steady_clock::duration::zero() );
+
+		thread_pool->WaitIdle();
+		EXPECT_GE( elapsed.load(), std::chrono::milliseconds( 30 ) );
+
+		// Timers fire in deadline order regardless of the order they were added in.
+		auto order_mutex = std::mutex {};
+		auto order = std::vector<size_t> {};
+		for( size_t i = 0; i < 4; ++i )
+		{
+			thread_pool->ScheduleCoroutineTask( [ i, &order_mutex, &order ]() -> bc::thread::CoroutineTask
+				{
+					co_await bc::thread::ResumeAfter( std::chrono::milliseconds( 40 - i * 10 ) );
+					auto lock_guard = std::lock_guard( order_mutex );
+					order.push_back( i );
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+		EXPECT_EQ( order, ( std::vector<size_t> { 3, 2, 1, 0 } ) );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, CoroutineAwaitEvent )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto event = bc::thread::TaskEvent {};
+		auto resumed_count = std::atomic<size_t> { 0 };
+		for( size_t i = 0; i < 4; ++i )
+		{
+			thread_pool->ScheduleCoroutineTask( [ &event, &resumed_count ]() -> bc::thread::CoroutineTask
+				{
+					co_await event;
+					++resumed_count;
+				}
+			);
+		}
+
+		// Event is signaled from outside the thread pool, as an I/O completion would be.
+		std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+		EXPECT_EQ( resumed_count, 0 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 4 );
+		EXPECT_EQ( thread_pool->GetTaskRunningCount(), 0 );
+
+		event.Signal();
+		thread_pool->WaitIdle();
+		EXPECT_EQ( resumed_count, 4 );
+
+		// Awaiting an event that has already been signaled continues right away.
+		thread_pool->ScheduleCoroutineTask( [ &event, &resumed_count ]() -> bc::thread::CoroutineTask
+			{
+				co_await event;
+				++resumed_count;
+			}
+		);
+		thread_pool->WaitIdle();
+		EXPECT_EQ( resumed_count, 5 );
+
+		event.Reset();
+		EXPECT_FALSE( event.IsSignaled() );
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, DelayedTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		class DelayedTask : public bc::thread::Task
+		{
+		public:
+			DelayedTask( std::atomic<std::chrono::steady_clock::time_point> & run_time ) : run_time( run_time ) {}
+			bc::thread::TaskExecutionResult operator()( bc::thread::Thread & thread ) override
+			{
+				run_time = std::chrono::steady_clock::now();
+				return bc::thread::TaskExecutionResult::FINISHED;
+			}
+			std::atomic<std::chrono::steady_clock::time_point> & run_time;
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		auto start = std::chrono::steady_clock::now();
+		auto run_time = std::atomic<std::chrono::steady_clock::time_point> {};
+		auto task_id = thread_pool->ScheduleTaskAfter<DelayedTask>( std::chrono::milliseconds( 20 ), run_time );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 1 );
+		EXPECT_EQ( thread_pool->GetTaskRunningCount(), 0 );
+
+		// Waiting for a delayed task also waits for its delay.
+		thread_pool->WaitForTask( task_id );
+		EXPECT_GE( run_time.load() - start, std::chrono::milliseconds( 20 ) );
+
+		// Delayed tasks can be depended on like any other task.
+		auto dependent_ran = std::atomic_bool { false };
+		start = std::chrono::steady_clock::now();
+		auto delayed_id = thread_pool->ScheduleLambdaTaskAfter( bc::thread::TaskPriority::HIGH, std::chrono::milliseconds( 10 ), [](){} );
+		thread_pool->ScheduleLambdaTaskWithDependencies( { delayed_id }, [ &dependent_ran ](){ dependent_ran = true; } );
+		thread_pool->WaitIdle();
+		EXPECT_TRUE( dependent_ran );
+		EXPECT_GE( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 10 ) );
+
+		// Many timers with delays spread over several timer wheel levels, none may run before its deadline.
+		constexpr size_t timer_count = 1000;
+		auto early_count = std::atomic<size_t> { 0 };
+		auto run_count = std::atomic<size_t> { 0 };
+		start = std::chrono::steady_clock::now();
+		for( size_t i = 0; i < timer_count; ++i )
+		{
+			auto delay = std::chrono::microseconds( ( i * 7919 ) % 300'000 );
+			thread_pool->ScheduleLambdaTaskAfter( delay, [ &early_count, &run_count, start, delay ]()
+				{
+					if( std::chrono::steady_clock::now() - start < delay ) ++early_count;
+					++run_count;
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+		EXPECT_EQ( run_count, timer_count );
+		EXPECT_EQ( early_count, 0 );
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, PeriodicTasks )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Periodic task runs until its lambda returns false, each run one period after the previous one.
+		auto run_times = std::vector<std::chrono::steady_clock::time_point> {};
+		auto start = std::chrono::steady_clock::now();
+		auto task_id = thread_pool->ScheduleLambdaTaskEvery( std::chrono::milliseconds( 5 ), [ &run_times ]()
+			{
+				run_times.push_back( std::chrono::steady_clock::now() );
+				return run_times.size() < 5;
+			}
+		);
+		thread_pool->WaitForTask( task_id );
+		ASSERT_EQ( run_times.size(), 5 );
+		for( size_t i = 0; i < run_times.size(); ++i )
+		{
+			// Fixed rate, run N is never earlier than N periods from the start.
+			EXPECT_GE( run_times[ i ] - start, std::chrono::milliseconds( 5 * ( i + 1 ) ) );
+		}
+
+		// Paused periodic task does not occupy a worker thread between runs.
+		auto stop = std::atomic_bool { false };
+		auto periodic_count = std::atomic<size_t> { 0 };
+		thread_pool->ScheduleLambdaTaskEvery( bc::thread::TaskPriority::LOW, std::chrono::milliseconds( 2 ), [ &stop, &periodic_count ]()
+			{
+				++periodic_count;
+				return !stop.load();
+			}
+		);
+		auto counter = std::atomic<size_t> { 0 };
+		for( size_t i = 0; i < 100; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( [ &counter ]() { ++counter; } );
+		}
+		while( counter != 100 ) std::this_thread::yield();
+		while( periodic_count < 3 ) std::this_thread::yield();
+		stop = true;
+		thread_pool->WaitIdle();
+		EXPECT_EQ( thread_pool->GetTaskQueueCount(), 0 );
+
+		// Periodic tasks that never stop themselves stop as soon as the thread pool is destroyed, without waiting for their next
+		// run.
+		thread_pool->ScheduleLambdaTaskEvery( std::chrono::milliseconds( 1 ), [ &periodic_count ]() { ++periodic_count; } );
+		auto long_period_count = std::atomic<size_t> { 0 };
+		thread_pool->ScheduleLambdaTaskEvery( std::chrono::seconds( 60 ), [ &long_period_count ]() { ++long_period_count; } );
+		auto shutdown_start = std::chrono::steady_clock::now();
+		core.reset();
+		EXPECT_LT( std::chrono::steady_clock::now() - shutdown_start, std::chrono::seconds( 10 ) );
+		EXPECT_EQ( long_period_count, 0 );
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, Statistics )
+{
+	// Latency histogram buckets are at most one eighth wide relative to the values in them.
+	for( bc::u64 latency : { 0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 1000ull, 123'456ull, 999'999'999ull } )
+	{
+		auto bucket = bc::thread::WorkerCounterValues::GetLatencyBucket( latency );
+		auto upper_edge = bc::thread::WorkerCounterValues::GetLatencyBucketUpperEdge( bucket );
+		EXPECT_GE( upper_edge, latency );
+		EXPECT_LE( upper_edge, latency + latency / 8 );
+		if( bucket > 0 ) EXPECT_LT( bc::thread::WorkerCounterValues::GetLatencyBucketUpperEdge( bucket - 1 ), latency );
+	}
+
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 2; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Worker threads park right away, parked time counts as idle.
+		std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+		auto statistics = thread_pool->GetStatistics();
+		ASSERT_EQ( statistics.worker_threads.Size(), 2 );
+		EXPECT_EQ( statistics.total.executed_task_count, 0 );
+		EXPECT_NE( statistics.worker_threads[ 0 ].thread_id, statistics.worker_threads[ 1 ].thread_id );
+
+		constexpr size_t task_count = 1000;
+		for( size_t i = 0; i < task_count; ++i )
+		{
+			thread_pool->ScheduleLambdaTask( []()
+				{
+					volatile size_t accumulator = 0;
+					for( size_t i = 0; i < 1000; ++i ) accumulator += i;
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+
+		// Counters are updated right after a task completes, the last ones may land just after the thread pool became idle.
+		auto wait_start = std::chrono::steady_clock::now();
+		while( thread_pool->GetStatistics().total.executed_task_count < task_count && std::chrono::steady_clock::now() - wait_start < std::chrono::seconds( 5 ) )
+		{
+			std::this_thread::yield();
+		}
+		statistics = thread_pool->GetStatistics();
+		EXPECT_EQ( statistics.total.executed_task_count, task_count );
+		EXPECT_EQ( statistics.worker_threads[ 0 ].executed_task_count + statistics.worker_threads[ 1 ].executed_task_count, task_count );
+		EXPECT_GT( statistics.total.busy_time.count(), 0 );
+		EXPECT_GT( statistics.total.idle_time.count(), 0 );
+		EXPECT_GT( statistics.total.average_queue_latency.count(), 0 );
+		EXPECT_GE( statistics.total.p99_queue_latency, statistics.total.average_queue_latency );
+		EXPECT_GT( statistics.total.failed_lookup_count, 0 );
+
+		thread_pool->ResetStatistics();
+		statistics = thread_pool->GetStatistics();
+		EXPECT_EQ( statistics.total.executed_task_count, 0 );
+		EXPECT_EQ( statistics.total.busy_time.count(), 0 );
+		EXPECT_EQ( statistics.total.average_queue_latency.count(), 0 );
+		EXPECT_EQ( statistics.total.p99_queue_latency.count(), 0 );
+
+		// Delayed tasks count their latency from when they became ready, not from when they were scheduled.
+		thread_pool->ScheduleLambdaTaskAfter( std::chrono::milliseconds( 50 ), [](){} );
+		thread_pool->WaitIdle();
+		while( thread_pool->GetStatistics().total.executed_task_count < 1 ) std::this_thread::yield();
+		EXPECT_LT( thread_pool->GetStatistics().total.p99_queue_latency, std::chrono::milliseconds( 50 ) );
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST( ThreadPool, TaskGraph )
+{
+	{
+		auto core_create_info = bc::CoreComponentCreateInfo {};
+		core_create_info.logger_create_info.disabled = true;
+		auto core = std::make_unique<bc::CoreComponent>( core_create_info );
+		auto thread_pool = core->GetThreadPool();
+
+		class TestThread : public bc::thread::Thread
+		{
+		public:
+			TestThread() = default;
+			void ThreadBegin() override {}
+			void ThreadEnd() noexcept override {}
+		};
+
+		for( size_t i = 0; i < 4; ++i ) thread_pool->AddThread<TestThread>();
+
+		// Diamond followed by a chain, every node records its position in the run order.
+		std::atomic<size_t> run_counter = 0;
+		std::array<std::atomic<size_t>, 6> run_order = {};
+		std::array<std::atomic<size_t>, 6> run_count = {};
+
+		auto graph = bc::thread::TaskGraph {};
+		std::array<bc::thread::TaskGraph::NodeIndex, 6> nodes = {};
+		for( size_t i = 0; i < nodes.size(); ++i )
+		{
+			nodes[ i ] = graph.AddNode( [ &, i ]()
+				{
+					std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+					run_order[ i ] = run_counter++;
+					++run_count[ i ];
+				}
+			);
+		}
+		graph.AddEdge( nodes[ 0 ], nodes[ 1 ] );
+		graph.AddEdge( nodes[ 0 ], nodes[ 2 ] );
+		graph.AddEdge( nodes[ 1 ], nodes[ 3 ] );
+		graph.AddEdge( nodes[ 2 ], nodes[ 3 ] );
+		graph.AddEdge( nodes[ 3 ], nodes[ 4 ] );
+		graph.AddEdge( nodes[ 4 ], nodes[ 5 ] );
+		graph.Compile();
+
+		ASSERT_EQ( graph.GetNodeCount(), 6 );
+		ASSERT_EQ( graph.GetExecutionOrder().Size(), 6 );
+		EXPECT_EQ( graph.GetExecutionOrder()[ 0 ], nodes[ 0 ] );
+		EXPECT_EQ( graph.GetExecutionOrder()[ 5 ], nodes[ 5 ] );
+
+		// Same graph executed every frame.
+		constexpr size_t frame_count = 100;
+		for( size_t frame = 0; frame < frame_count; ++frame )
+		{
+			run_counter = 0;
+			auto task_id = graph.Execute( *thread_pool );
+			EXPECT_NE( task_id, 0 );
+			graph.Wait();
+			EXPECT_FALSE( graph.IsExecuting() );
+
+			EXPECT_EQ( run_order[ 0 ], 0 );
+			EXPECT_LT( run_order[ 1 ], run_order[ 3 ] );
+			EXPECT_LT( run_order[ 2 ], run_order[ 3 ] );
+			EXPECT_EQ( run_order[ 3 ], 3 );
+			EXPECT_EQ( run_order[ 4 ], 4 );
+			EXPECT_EQ( run_order[ 5 ], 5 );
+		}
+		for( auto & count : run_count ) EXPECT_EQ( count, frame_count );
+
+		// Timings follow the graph order.
+		for( auto node : nodes )
+		{
+			auto timing = graph.GetNodeTiming( node );
+			EXPECT_TRUE( timing.was_run );
+			EXPECT_GE( timing.duration, std::chrono::microseconds( 100 ) );
+		}
+		EXPECT_GE( graph.GetNodeTiming( nodes[ 3 ] ).start_time, graph.GetNodeTiming( nodes[ 1 ] ).start_time + graph.GetNodeTiming( nodes[ 1 ] ).duration );
+		EXPECT_GE( graph.GetNodeTiming( nodes[ 5 ] ).start_time, graph.GetNodeTiming( nodes[ 4 ] ).start_time + graph.GetNodeTiming( nodes[ 4 ] ).duration );
+
+		// Disabled nodes are skipped, their successors still run.
+		graph.SetNodeEnabled( nodes[ 1 ], false );
+		graph.SetNodeEnabled( nodes[ 4 ], false );
+		EXPECT_FALSE( graph.IsNodeEnabled( nodes[ 1 ] ) );
+		graph.Execute( *thread_pool );
+		graph.Wait();
+		EXPECT_EQ( run_count[ 1 ], frame_count );
+		EXPECT_EQ( run_count[ 4 ], frame_count );
+		EXPECT_EQ( run_count[ 5 ], frame_count + 1 );
+		EXPECT_FALSE( graph.GetNodeTiming( nodes[ 1 ] ).was_run );
+		EXPECT_TRUE( graph.GetNodeTiming( nodes[ 2 ] ).was_run );
+
+		// Graph can be executed back to back and used as a dependency of regular tasks.
+		graph.SetNodeEnabled( nodes[ 1 ], true );
+		graph.SetNodeEnabled( nodes[ 4 ], true );
+		std::atomic<size_t> dependent_ran_early_count = 0;
+		for( size_t i = 0; i < 10; ++i )
+		{
+			auto graph_task_id = graph.Execute( *thread_pool );
+			auto expected_run_count = frame_count + 2 + i;
+			thread_pool->ScheduleLambdaTaskWithDependencies( { graph_task_id }, [ &, expected_run_count ]()
+				{
+					if( run_count[ 5 ] < expected_run_count ) ++dependent_ran_early_count;
+				}
+			);
+		}
+		thread_pool->WaitIdle();
+		EXPECT_EQ( dependent_ran_early_count, 0 );
+		EXPECT_EQ( run_count[ 0 ], frame_count + 11 );
+
+		// Cycles are rejected when compiling.
+		auto cyclic_graph = bc::thread::TaskGraph {};
+		auto a = cyclic_graph.AddNode( [](){} );
+		auto b = cyclic_graph.AddNode( [](){} );
+		auto c = cyclic_graph.AddNode( [](){} );
+		cyclic_graph.AddEdge( a, b );
+		cyclic_graph.AddEdge( b, c );
+		cyclic_graph.AddEdge( c, b );
+		EXPECT_THROW( cyclic_graph.Compile(), bc::diagnostic::Exception );
+
+		// Empty graph completes right away.
+		auto empty_graph = bc::thread::TaskGraph {};
+		empty_graph.Compile();
+		EXPECT_NE( empty_graph.Execute( *thread_pool ), 0 );
+		empty_graph.Wait();
+	}
+};
 
 
 } // thread